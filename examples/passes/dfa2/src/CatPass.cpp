@@ -42,11 +42,16 @@ namespace {
       errs() << "Data flow reachable analysis\n";
       for (auto& inst : instructions(mainF)){
         errs() << " Next are the instructions reachable from " << inst << "\n";
-        auto& outSet = dfr->OUT(&inst);
-        for (auto reachInst : outSet){
+
+        /*
+         * The result is dense: iterate over its bit vector rather than materializing the set of every instruction.
+         */
+        for (auto index : dfr->OUTBits(&inst).set_bits()){
+          auto reachInst = dfr->getValueOfIndex(index);
           errs() << "   " << *reachInst << "\n";
         }
       }
+      delete dfr;
 
       return false;
     }
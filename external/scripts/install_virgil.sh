@@ -0,0 +1,11 @@
+#!/bin/bash
+
+# Set the installation directory
+installDir=$PDG_INSTALL_DIR ;
+if test "$installDir" == "" ; then
+  installDir="`realpath ../install`"  ;
+fi
+mkdir -p ${installDir}/include/virgil ;
+
+# Install the headers of the thread pool used by the NOELLE runtime
+cp virgil/include/*.hpp ${installDir}/include/virgil/ ;
@@ -22,9 +22,38 @@ namespace llvm::noelle {
 
         static uint32_t getNumberOfPhysicalCores (void);
 
+        static uint32_t getNumberOfNUMANodes (void);
+
+        /*
+         * Number of last-level caches (e.g., one per socket or per core complex).
+         */
+        static uint32_t getNumberOfLastLevelCaches (void);
+
+        /*
+         * Size of a single last-level cache (0 if unknown).
+         */
+        static uint64_t getLastLevelCacheBytes (void);
+
         static int32_t getCacheLineBytes (void);
 
       private:
+
+        /*
+         * Placement of a logical core within the machine.
+         */
+        struct LogicalCore {
+          uint32_t ID;
+          uint32_t physicalCoreID;
+          uint32_t lastLevelCacheID;
+          uint32_t NUMANodeID;
+        };
+
+        /*
+         * Topology of the online logical cores described by /sys/devices/system/cpu (empty if it is not available).
+         */
+        static const std::vector<LogicalCore> & getTopology (void);
+
+        static uint64_t lastLevelCacheBytes;
   };
 
 }
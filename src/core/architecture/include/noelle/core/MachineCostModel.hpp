@@ -0,0 +1,90 @@
+/*
+ * Copyright 2016 - 2021  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "noelle/core/SystemHeaders.hpp"
+
+namespace llvm::noelle {
+
+  /*
+   * Latencies of the instructions and of the NOELLE runtime on the current machine.
+   *
+   * The latencies are measured by noelle-calibrate, which writes them to a cost table (one "name cycles" pair per line).
+   * Without a cost table, every instruction costs 1 and a queue transfer costs 100, so latencies are expressed in instructions rather than in cycles.
+   */
+  class MachineCostModel {
+    public:
+      MachineCostModel ();
+
+      /*
+       * Load the cost table @fileName.
+       *
+       * @return false if the file cannot be read.
+       */
+      bool loadCostTable (const std::string &fileName);
+
+      /*
+       * Return true if a cost table has been loaded.
+       */
+      bool isCalibrated (void) const ;
+
+      /*
+       * Return the latency of an execution of @inst.
+       * The latency of a call only includes the call itself: the instructions executed by the callee cost getInstructionLatency() each.
+       */
+      double getInstructionLatency (Instruction *inst) const ;
+
+      /*
+       * Return the latency of a simple integer instruction.
+       */
+      double getInstructionLatency (void) const ;
+
+      /*
+       * Return the latency of sending a value of @bitWidth bits from a DSWP stage to another.
+       */
+      double getQueueLatency (uint32_t bitWidth) const ;
+
+      /*
+       * Return the latency of dispatching and joining the tasks of a DOALL loop.
+       * If it has not been measured, the latency is the one that makes the minimum parallel invocation execute defaultMinimumParallelInvocationInstructions instructions.
+       */
+      double getDOALLDispatchLatency (void) const ;
+
+      /*
+       * Return the minimum latency of a loop invocation that amortizes the dispatch of its parallel tasks.
+       */
+      double getMinimumParallelInvocationLatency (void) const ;
+
+      /*
+       * Return the latency of passing a HELIX sequential segment from a core to the next one.
+       */
+      double getHELIXSignalLatency (void) const ;
+
+      /*
+       * Number of times the latency of a loop invocation must exceed the latency of dispatching its tasks.
+       * A factor of 10 keeps the dispatch overhead within 10% of the sequential invocation.
+       * This is a policy rather than a property of the machine, so noelle-calibrate does not measure it.
+       */
+      static constexpr double dispatchAmortizationFactor = 10;
+
+      /*
+       * Minimum number of instructions of a loop invocation to parallelize it when the dispatch latency of the machine is unknown.
+       */
+      static constexpr double defaultMinimumParallelInvocationInstructions = 2000;
+
+    private:
+      std::unordered_map<std::string, double> costs;
+      bool calibrated;
+
+      double getCost (const std::string &name, double defaultCost) const ;
+  };
+
+}
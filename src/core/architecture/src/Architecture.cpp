@@ -9,9 +9,12 @@
  * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "noelle/core/Architecture.hpp"
+#include "NoelleTopology.hpp"
 
 namespace llvm::noelle {
 
+uint64_t Architecture::lastLevelCacheBytes = 0;
+
 Architecture::Architecture (){
   return ;
 }
@@ -21,11 +24,80 @@ uint32_t Architecture::getNumberOfLogicalCores (void){
 }
 
 uint32_t Architecture::getNumberOfPhysicalCores (void){
-  return getNumberOfLogicalCores() / 2;
+
+  /*
+   * Fall back to assume 2-way SMT when the topology is not available.
+   */
+  auto &topology = Architecture::getTopology();
+  if (topology.empty()){
+    return getNumberOfLogicalCores() / 2;
+  }
+
+  std::set<uint32_t> physicalCores;
+  for (auto &core : topology){
+    physicalCores.insert(core.physicalCoreID);
+  }
+
+  return physicalCores.size();
+}
+
+uint32_t Architecture::getNumberOfNUMANodes (void){
+  std::set<uint32_t> nodes;
+  for (auto &core : Architecture::getTopology()){
+    nodes.insert(core.NUMANodeID);
+  }
+
+  return std::max<uint32_t>(nodes.size(), 1);
+}
+
+uint32_t Architecture::getNumberOfLastLevelCaches (void){
+  std::set<uint32_t> caches;
+  for (auto &core : Architecture::getTopology()){
+    caches.insert(core.lastLevelCacheID);
+  }
+
+  return std::max<uint32_t>(caches.size(), 1);
+}
+
+uint64_t Architecture::getLastLevelCacheBytes (void){
+  Architecture::getTopology();
+
+  return Architecture::lastLevelCacheBytes;
 }
 
 int32_t Architecture::getCacheLineBytes (void){
   return 64;
 }
 
+const std::vector<Architecture::LogicalCore> & Architecture::getTopology (void){
+  static std::vector<LogicalCore> topology;
+  static bool computed = false;
+
+  /*
+   * Check if we have already computed the topology.
+   */
+  if (computed){
+    return topology;
+  }
+  computed = true;
+
+  /*
+   * Describe every logical core (see NOELLE_readTopology).
+   */
+  for (auto &core : NOELLE_readTopology()){
+    LogicalCore logicalCore;
+    logicalCore.ID = core.ID;
+    logicalCore.physicalCoreID = core.physicalCoreID;
+    logicalCore.lastLevelCacheID = core.lastLevelCacheID;
+    logicalCore.NUMANodeID = core.NUMANodeID;
+    topology.push_back(logicalCore);
+
+    if (core.lastLevelCacheBytes > 0){
+      Architecture::lastLevelCacheBytes = core.lastLevelCacheBytes;
+    }
+  }
+
+  return topology;
+}
+
 }
@@ -0,0 +1,162 @@
+/*
+ * Copyright 2016 - 2021  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <fstream>
+
+#include "noelle/core/MachineCostModel.hpp"
+
+namespace llvm::noelle {
+
+MachineCostModel::MachineCostModel ()
+  : calibrated{false}
+  {
+
+  return ;
+}
+
+bool MachineCostModel::loadCostTable (const std::string &fileName){
+  std::ifstream table(fileName);
+  if (!table.good()){
+    return false;
+  }
+
+  /*
+   * Read the costs.
+   * Lines that start with # are comments.
+   */
+  std::string line;
+  while (std::getline(table, line)){
+    if (  false
+          || line.empty()
+          || (line[0] == '#')
+       ){
+      continue ;
+    }
+    std::istringstream lineStream(line);
+    std::string name;
+    double cycles;
+    if (!(lineStream >> name >> cycles)){
+      continue ;
+    }
+    this->costs[name] = cycles;
+  }
+  this->calibrated = true;
+
+  /*
+   * Tables written by older versions of noelle-calibrate do not include the dispatch of DOALL loops.
+   */
+  if (this->costs.find("doall_dispatch") == this->costs.end()){
+    errs() << "MachineCostModel: Warning = the cost table " << fileName << " does not include doall_dispatch, so loop invocations must execute at least " << MachineCostModel::defaultMinimumParallelInvocationInstructions << " instructions to be parallelized\n";
+  }
+
+  return true;
+}
+
+bool MachineCostModel::isCalibrated (void) const {
+  return this->calibrated;
+}
+
+double MachineCostModel::getCost (const std::string &name, double defaultCost) const {
+  auto costIt = this->costs.find(name);
+  if (costIt == this->costs.end()){
+    return defaultCost;
+  }
+
+  return costIt->second;
+}
+
+double MachineCostModel::getInstructionLatency (Instruction *inst) const {
+  if (!this->calibrated){
+    return 1;
+  }
+
+  /*
+   * Memory instructions.
+   */
+  auto intLatency = this->getCost("instruction_int", 1);
+  if (isa<LoadInst>(inst)){
+    return this->getCost("instruction_load", intLatency);
+  }
+  if (isa<StoreInst>(inst)){
+    return this->getCost("instruction_store", intLatency);
+  }
+  if (isa<CallBase>(inst)){
+    return this->getCost("instruction_call", intLatency);
+  }
+
+  /*
+   * Arithmetic instructions.
+   */
+  switch (inst->getOpcode()){
+    case Instruction::Mul:
+      return this->getCost("instruction_int_mul", intLatency);
+    case Instruction::UDiv:
+    case Instruction::SDiv:
+    case Instruction::URem:
+    case Instruction::SRem:
+      return this->getCost("instruction_int_div", intLatency);
+    case Instruction::FAdd:
+    case Instruction::FSub:
+    case Instruction::FMul:
+    case Instruction::FNeg:
+      return this->getCost("instruction_fp", intLatency);
+    case Instruction::FDiv:
+    case Instruction::FRem:
+      return this->getCost("instruction_fp_div", intLatency);
+  }
+
+  return intLatency;
+}
+
+double MachineCostModel::getInstructionLatency (void) const {
+  return this->getCost("instruction_int", 1);
+}
+
+double MachineCostModel::getQueueLatency (uint32_t bitWidth) const {
+  if (!this->calibrated){
+    return 100;
+  }
+
+  /*
+   * Values wider than 64 bits are sent as multiple 64-bit values.
+   */
+  if (bitWidth <= 8){
+    return this->getCost("dswp_queue_8", 100);
+  }
+  if (bitWidth <= 16){
+    return this->getCost("dswp_queue_16", 100);
+  }
+  if (bitWidth <= 32){
+    return this->getCost("dswp_queue_32", 100);
+  }
+  auto transfers = (bitWidth + 63) / 64;
+
+  return transfers * this->getCost("dswp_queue_64", 100);
+}
+
+double MachineCostModel::getDOALLDispatchLatency (void) const {
+
+  /*
+   * Without a measured latency, the dispatch is assumed to cost as much as the default minimum invocation amortizes.
+   */
+  auto defaultLatency = (MachineCostModel::defaultMinimumParallelInvocationInstructions / MachineCostModel::dispatchAmortizationFactor) * this->getInstructionLatency();
+
+  return this->getCost("doall_dispatch", defaultLatency);
+}
+
+double MachineCostModel::getMinimumParallelInvocationLatency (void) const {
+  return MachineCostModel::dispatchAmortizationFactor * this->getDOALLDispatchLatency();
+}
+
+double MachineCostModel::getHELIXSignalLatency (void) const {
+  return this->getCost("helix_signal", 0);
+}
+
+}
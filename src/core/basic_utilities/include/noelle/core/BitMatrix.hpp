@@ -9,8 +9,12 @@ namespace llvm {
 // BitMatrix is a NxN bit-matrix that depicts whether a relation R
 // holds for a pair with indices (i,j) (i.e., R(i,j) = 0/1)
 // BitMatrix is intended for a dense, asymmetric relation R.
+//
+// Rows are stored as contiguous arrays of 64-bit words, padded to a multiple
+// of WordsPerBlock words, so row-level operations process one word (and, once
+// vectorized by the compiler, one block of words) at a time.
 struct BitMatrix {
-  BitMatrix(uint32_t n = 1) : N(n), bv(n * n) {}
+  BitMatrix(uint32_t n = 1) { resize(n); }
 
   // Returns the size of BitVector
   uint32_t count() const;
@@ -27,27 +31,42 @@ struct BitMatrix {
 
   // Computes the transitive closure.
   // For example, given a adjacency matrix, it converts it to a connectivity
-  // matrix, where (i,j) is set if there is a directed path from i to j
+  // matrix, where (i,j) is set if there is a directed path from i to j.
+  // If the relation is acyclic, rows are closed in reverse topological order
+  // with one row OR per edge; otherwise a word-parallel Warshall is used.
   void transitiveClosure();
 
+  // Computes the transitive closure of an acyclic relation given the reverse
+  // topological order of its elements (successors before predecessors).
+  void transitiveClosureOfDAG(const std::vector<uint32_t> &reverseTopologicalOrder);
+
+  // Row-level operations: row[dstRow] |= row[srcRow] and
+  // row[dstRow] &= row[srcRow]. They return true if row[dstRow] changed.
+  bool orRow(uint32_t dstRow, uint32_t srcRow);
+  bool andRow(uint32_t dstRow, uint32_t srcRow);
+
+  // Returns the number of cols related to row
+  uint32_t countRow(uint32_t row) const;
+
   // Emits to fout the BitMatrix
   void dump(raw_ostream &fout) const;
 
 private:
+  static constexpr uint32_t WordsPerBlock = 4;
+
   uint32_t N;
-  BitVector bv;
+  uint32_t wordsPerRow;
+  std::vector<uint64_t> words;
 
-  // For a given row returns the first col that is set.
-  // Returns -1 if none found.
-  int32_t firstSuccessor(uint32_t row) const;
+  uint64_t *rowBegin(uint32_t row);
+  const uint64_t *rowBegin(uint32_t row) const;
 
-  // For a given row returns the first col after prev (col>prev) that is set.
-  // Returns -1 if none found.
-  int32_t nextSuccessor(uint32_t row, uint32_t prev) const;
+  // Computes the reverse topological order of the relation.
+  // Returns false if the relation has a cycle.
+  bool computeReverseTopologicalOrder(std::vector<uint32_t> &order) const;
 
-  // Returns the index corresponding to a pair (row.col)
-  // i.e., idx = row * N + col
-  uint32_t idx(uint32_t row, uint32_t col) const;
+  // Transitive closure that does not require the relation to be acyclic.
+  void warshallClosure();
 };
 
 } // namespace llvm
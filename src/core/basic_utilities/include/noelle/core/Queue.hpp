@@ -20,6 +20,7 @@ namespace llvm {
       std::vector<Type *> queueElementTypes;
       std::vector<Function *> queuePushes;
       std::vector<Function *> queuePops;
+      std::vector<Function *> queueFlushes;
       std::vector<Type *> queueTypes;
   };
 
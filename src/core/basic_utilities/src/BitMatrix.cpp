@@ -4,114 +4,184 @@ namespace llvm {
 
 void BitMatrix::resize(uint32_t n) {
   N = n;
-  bv.clear();
-  bv.resize(n * n);
+  wordsPerRow = (n + 63) / 64;
+  wordsPerRow = ((wordsPerRow + WordsPerBlock - 1) / WordsPerBlock) * WordsPerBlock;
+  words.clear();
+  words.resize(((uint64_t)n) * wordsPerRow, 0);
 }
 
-uint32_t BitMatrix::idx(uint32_t row, uint32_t col) const {
+uint64_t *BitMatrix::rowBegin(uint32_t row) {
   assert(row < N);
-  assert(col < N);
-  return row * N + col;
+  return words.data() + ((uint64_t)row) * wordsPerRow;
+}
+
+const uint64_t *BitMatrix::rowBegin(uint32_t row) const {
+  assert(row < N);
+  return words.data() + ((uint64_t)row) * wordsPerRow;
 }
 
-uint32_t BitMatrix::count() const { return bv.count(); }
+uint32_t BitMatrix::count() const {
+  uint32_t c = 0;
+  for (auto word : words) {
+    c += countPopulation(word);
+  }
+
+  return c;
+}
+
+uint32_t BitMatrix::countRow(uint32_t row) const {
+  auto r = rowBegin(row);
+  uint32_t c = 0;
+  for (uint32_t w = 0; w < wordsPerRow; ++w) {
+    c += countPopulation(r[w]);
+  }
+
+  return c;
+}
 
 void BitMatrix::set(uint32_t row, uint32_t col, bool v) {
-  const uint32_t i = idx(row, col);
+  assert(col < N);
+  auto &word = rowBegin(row)[col / 64];
+  const uint64_t mask = ((uint64_t)1) << (col % 64);
 
   if (v) {
-    bv.set(i);
+    word |= mask;
   } else {
-    bv.reset(i);
+    word &= ~mask;
   }
 }
 
 bool BitMatrix::test(uint32_t row, uint32_t col) const {
-  const uint32_t i = idx(row, col);
+  assert(col < N);
+  const uint64_t word = rowBegin(row)[col / 64];
 
-  return bv.test(i);
+  return (word >> (col % 64)) & 1;
 }
 
-int32_t BitMatrix::firstSuccessor(uint32_t row) const {
-  const uint32_t rowBegin = N * row;
-  int32_t next = -1;
-
-  if (0 == rowBegin) {
-    next = bv.find_first();
-  } else {
-    next = bv.find_next(rowBegin - 1);
-  }
-
-  if (-1 == next) {
-    return -1;
-  }
+bool BitMatrix::orRow(uint32_t dstRow, uint32_t srcRow) {
+  auto dst = rowBegin(dstRow);
+  auto src = rowBegin(srcRow);
 
-  const uint32_t rowEnd = rowBegin + N;
-  if (((uint32_t)next) >= rowEnd) {
-    return -1;
+  uint64_t changed = 0;
+  for (uint32_t w = 0; w < wordsPerRow; ++w) {
+    const uint64_t merged = dst[w] | src[w];
+    changed |= merged ^ dst[w];
+    dst[w] = merged;
   }
 
-  return next - rowBegin;
+  return changed != 0;
 }
 
-int32_t BitMatrix::nextSuccessor(uint32_t row, uint32_t prev) const {
-  int32_t next = bv.find_next(N * row + prev);
-  if (-1 == next) {
-    return -1;
-  }
+bool BitMatrix::andRow(uint32_t dstRow, uint32_t srcRow) {
+  auto dst = rowBegin(dstRow);
+  auto src = rowBegin(srcRow);
 
-  const uint32_t rowBegin = N * row;
-  const uint32_t rowEnd = rowBegin + N;
-  if (((uint32_t)next) >= rowEnd) {
-    return -1;
+  uint64_t changed = 0;
+  for (uint32_t w = 0; w < wordsPerRow; ++w) {
+    const uint64_t merged = dst[w] & src[w];
+    changed |= merged ^ dst[w];
+    dst[w] = merged;
   }
 
-  return next - rowBegin;
+  return changed != 0;
 }
 
-void BitMatrix::transitiveClosure() {
-  uint32_t nAdd = 0;
-
-  typedef std::list<uint32_t> Worklist;
-  Worklist worklist;
-  for (uint32_t i = 0; i < N; ++i) {
-    worklist.push_back(i);
-  }
+bool BitMatrix::computeReverseTopologicalOrder(std::vector<uint32_t> &order) const {
+  order.clear();
+  order.reserve(N);
+
+  // Iterative DFS: an element is appended after all its successors.
+  // 0 = not visited, 1 = on the DFS stack, 2 = done
+  std::vector<uint8_t> state(N, 0);
+  std::vector<std::pair<uint32_t, uint32_t>> stack; // (row, next col to scan)
+  for (uint32_t root = 0; root < N; ++root) {
+    if (state[root] != 0) {
+      continue;
+    }
+    state[root] = 1;
+    stack.push_back({root, 0});
+
+    while (!stack.empty()) {
+      auto row = stack.back().first;
+      auto col = stack.back().second;
+      auto r = rowBegin(row);
+
+      // Find the next successor of row starting from col.
+      int64_t next = -1;
+      for (uint32_t w = col / 64; w < wordsPerRow && next == -1; ++w) {
+        uint64_t word = r[w];
+        if (w == col / 64) {
+          word &= ~((((uint64_t)1) << (col % 64)) - 1);
+        }
+        if (word != 0) {
+          next = ((int64_t)w) * 64 + countTrailingZeros(word);
+        }
+      }
 
-  while (!worklist.empty()) {
-    uint32_t i = worklist.front();
-    worklist.pop_front();
+      if (next == -1) {
+        state[row] = 2;
+        order.push_back(row);
+        stack.pop_back();
+        continue;
+      }
 
-    bool changedI = false;
+      stack.back().second = next + 1;
+      if (next == row) {
+        continue;
+      }
+      if (state[next] == 1) {
+        return false;
+      }
+      if (state[next] == 0) {
+        state[next] = 1;
+        stack.push_back({(uint32_t)next, 0});
+      }
+    }
+  }
 
-    // (i->j)
-    for (int32_t j = firstSuccessor(i); j != -1; j = nextSuccessor(i, j)) {
-      // bit-wise or row[i] |= row[j]
+  return true;
+}
 
-      // (j->k)
-      for (int32_t k = firstSuccessor(j); k != -1; k = nextSuccessor(j, k)) {
-        // but not (i->k)
-        if (!test(i, k)) {
-          changedI = true;
-          ++nAdd;
-          set(i, k);
+void BitMatrix::transitiveClosureOfDAG(const std::vector<uint32_t> &reverseTopologicalOrder) {
+  assert(reverseTopologicalOrder.size() == N);
+
+  // Successors are closed before their predecessors, so OR-ing the row of each
+  // direct successor is enough to close a row.
+  std::vector<uint64_t> directSuccessors(wordsPerRow);
+  for (auto i : reverseTopologicalOrder) {
+    auto r = rowBegin(i);
+    std::copy(r, r + wordsPerRow, directSuccessors.begin());
+
+    for (uint32_t w = 0; w < wordsPerRow; ++w) {
+      for (uint64_t word = directSuccessors[w]; word != 0; word &= word - 1) {
+        const uint32_t j = w * 64 + countTrailingZeros(word);
+        if (j != i) {
+          orRow(i, j);
         }
       }
     }
+  }
+}
 
-    if (changedI) {
-      for (uint32_t p = 0; p < N; ++p) {
-        if (test(p, i)) {
-          if (std::find(worklist.begin(), worklist.end(), p) ==
-              worklist.end()) {
-            worklist.push_back(p);
-          }
-        }
+void BitMatrix::warshallClosure() {
+  for (uint32_t k = 0; k < N; ++k) {
+    for (uint32_t i = 0; i < N; ++i) {
+      if (test(i, k)) {
+        orRow(i, k);
       }
     }
   }
 }
 
+void BitMatrix::transitiveClosure() {
+  std::vector<uint32_t> order;
+  if (computeReverseTopologicalOrder(order)) {
+    transitiveClosureOfDAG(order);
+  } else {
+    warshallClosure();
+  }
+}
+
 void BitMatrix::dump(raw_ostream &fout) const {
   for (uint32_t row = 0; row < N; ++row) {
     for (uint32_t col = 0; col < N; ++col) {
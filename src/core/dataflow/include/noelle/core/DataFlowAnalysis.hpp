@@ -24,6 +24,10 @@ namespace llvm::noelle {
        */
       DataFlowAnalysis ();
 
+      /*
+       * The results of the analyses below are dense (see DataFlowResult::isDense).
+       * Their sets can be read either through the bit-vector-based API (e.g., OUTBits), which is what NOELLE uses, or through the set-based API, which materializes and stores the set of every instruction requested.
+       */
       DataFlowResult * runReachableAnalysis (Function *f);
 
       DataFlowResult * runReachableAnalysis (Function *f, std::function<bool (Instruction *i)> filter);
@@ -58,6 +58,35 @@ namespace llvm::noelle {
         std::function<void (std::set<Value *>& OUT, Instruction *successor, DataFlowResult *df)> computeOUT
         ) ;
 
+      /*
+       * Dense data-flow analyses.
+       *
+       * GEN and KILL are computed through the set-based API of DataFlowResult.
+       * Then, the values that belong to at least one GEN or KILL set are numbered once and IN and OUT are computed with word-wise operations on bit vectors:
+       *   Forward:  IN[i] = U OUT[p] (or intersection if @meetIsIntersection is true) for every predecessor p of i;  OUT[i] = GEN[i] U (IN[i] - KILL[i])
+       *   Backward: OUT[i] = U IN[s] for every successor s of i;  IN[i] = GEN[i] U (OUT[i] - KILL[i])
+       *
+       * The returned result is dense; its set-based API is still available for existing analyses.
+       *
+       * The equations are solved at basic block granularity.
+       * If @onlyBasicBlockBoundaries is true, the result keeps only the sets at the boundaries of basic blocks and the sets of an instruction are recomputed when queried.
+       * This reduces the memory needed by the result by roughly the average number of instructions per basic block.
+       */
+      DataFlowResult * applyForwardUsingBitVectors (
+        Function *f,
+        std::function<void (Instruction *, DataFlowResult *)> computeGEN,
+        std::function<void (Instruction *, DataFlowResult *)> computeKILL,
+        bool meetIsIntersection,
+        bool onlyBasicBlockBoundaries
+        ) ;
+
+      DataFlowResult * applyBackwardUsingBitVectors (
+        Function *f,
+        std::function<void (Instruction *, DataFlowResult *)> computeGEN,
+        std::function<void (Instruction *, DataFlowResult *)> computeKILL,
+        bool onlyBasicBlockBoundaries
+        ) ;
+
     protected:
       void computeGENAndKILL (
         Function *f, 
@@ -66,6 +95,27 @@ namespace llvm::noelle {
         DataFlowResult *df
         );
 
+      DataFlowResult * computeDenseGENAndKILL (
+        Function *f, 
+        std::function<void (Instruction *, DataFlowResult *)> computeGEN,
+        std::function<void (Instruction *, DataFlowResult *)> computeKILL,
+        bool onlyBasicBlockBoundaries,
+        bool isForward
+        );
+
+      void computeBasicBlockGENAndKILL (
+        Function *f, 
+        DataFlowResult *df,
+        bool isForward,
+        std::vector<BitVector> &basicBlockGEN,
+        std::vector<BitVector> &basicBlockKILL
+        );
+
+      void computeInstructionSetsFromBasicBlockSets (
+        Function *f, 
+        DataFlowResult *df
+        );
+
     private:
       DataFlowResult * applyCustomizableForwardAnalysis (
         Function *f,
@@ -22,16 +22,138 @@ namespace llvm::noelle {
        */
       DataFlowResult ();
 
+      /*
+       * Constructor of a dense result.
+       * The instructions of @f and the values given as input are numbered once.
+       * Every set of the result is a bit vector indexed by the number of the values it includes.
+       *
+       * If @onlyBasicBlockBoundaries is true, IN and OUT are stored only at the boundaries of basic blocks.
+       * Sets of instructions are then recomputed from the boundaries when queried (see DataFlowEngine).
+       */
+      DataFlowResult (Function *f, std::vector<Value *> const &values);
+
+      DataFlowResult (Function *f, std::vector<Value *> const &values, bool onlyBasicBlockBoundaries, bool isForward);
+
+      /*
+       * Set-based API.
+       *
+       * For dense results, the set of an instruction is materialized from its bit vector the first time it is requested.
+       * The set is then stored with the instruction, so the returned reference stays valid and changes to it are seen by the next requests, as for sparse results.
+       * Changes of the returned set are not reflected in the bit vector.
+       * Clients that query many instructions should use the bit-vector-based API, which does not materialize sets.
+       */
       std::set<Value *>& GEN (Instruction *inst);
       std::set<Value *>& KILL (Instruction *inst);
       std::set<Value *>& IN (Instruction *inst);
       std::set<Value *>& OUT (Instruction *inst);
 
+      /*
+       * Bit-vector-based API (dense results only).
+       */
+      bool isDense (void) const ;
+
+      uint32_t getNumberOfValues (void) const ;
+
+      /*
+       * Return the number assigned to @v or -1 if @v cannot belong to the sets of this result.
+       */
+      int64_t getIndexOfValue (Value *v) const ;
+
+      Value * getValueOfIndex (uint32_t index) const ;
+
+      bool storesOnlyBasicBlockBoundaries (void) const ;
+
+      /*
+       * GEN and KILL bit vectors are available only if sets are stored for every instruction.
+       */
+      BitVector & GENBits (Instruction *inst);
+      BitVector & KILLBits (Instruction *inst);
+
+      /*
+       * If only the sets at the boundaries of basic blocks are stored, the returned bit vector is computed on demand.
+       * In this case, the reference is valid until the next query and changes to it are not persistent.
+       */
+      BitVector & INBits (Instruction *inst);
+      BitVector & OUTBits (Instruction *inst);
+
+      /*
+       * Sets at the boundaries of a basic block (available only if sets are stored at basic block granularity).
+       * IN is the set at the entry of @bb and OUT the one at its exit.
+       */
+      BitVector & INBits (BasicBlock *bb);
+      BitVector & OUTBits (BasicBlock *bb);
+
     private:
       std::map<Instruction *, std::set<Value *>> gens;
       std::map<Instruction *, std::set<Value *>> kills;
       std::map<Instruction *, std::set<Value *>> ins;
       std::map<Instruction *, std::set<Value *>> outs;
+
+      /*
+       * Dense representation.
+       */
+      bool dense;
+      bool onlyBasicBlockBoundaries;
+      bool isForward;
+      std::vector<Value *> indexToValue;
+      DenseMap<Value *, uint32_t> valueToIndex;
+      DenseMap<Instruction *, uint32_t> instructionToIndex;
+      std::vector<SmallVector<uint32_t, 1>> genIndices;
+      std::vector<SmallVector<uint32_t, 1>> killIndices;
+
+      /*
+       * Sets of instructions (instruction granularity).
+       */
+      std::vector<BitVector> genBits;
+      std::vector<BitVector> killBits;
+      std::vector<BitVector> inBits;
+      std::vector<BitVector> outBits;
+
+      /*
+       * Sets of basic blocks (basic block granularity).
+       */
+      DenseMap<BasicBlock *, uint32_t> basicBlockToIndex;
+      std::vector<BitVector> basicBlockInBits;
+      std::vector<BitVector> basicBlockOutBits;
+
+      /*
+       * Least-recently-used cache of the sets of the instructions of basic blocks (basic block granularity).
+       */
+      struct ExpandedBasicBlock {
+        BasicBlock *bb;
+        uint64_t lastUse;
+        std::vector<BitVector> ins;
+        std::vector<BitVector> outs;
+      };
+      static constexpr uint32_t expandedBasicBlocksCacheSize = 8;
+      std::vector<ExpandedBasicBlock> expandedBasicBlocks;
+      uint64_t expandedBasicBlocksClock;
+
+      std::set<Value *> & fetchSet (
+        std::map<Instruction *, std::set<Value *>> &sets, 
+        std::vector<SmallVector<uint32_t, 1>> *indices,
+        bool isIN,
+        Instruction *inst
+        );
+
+      std::set<Value *> & materializeSet (
+        std::map<Instruction *, std::set<Value *>> &kind,
+        std::vector<SmallVector<uint32_t, 1>> *indices,
+        bool isIN,
+        Instruction *inst
+        );
+
+      BitVector & fetchBits (std::vector<BitVector> &bits, Instruction *inst);
+
+      ExpandedBasicBlock & expandBasicBlock (BasicBlock *bb);
+
+      uint32_t getIndexOfInstruction (Instruction *inst) const ;
+
+      void addToGEN (Instruction *inst, uint32_t valueIndex);
+
+      void addToKILL (Instruction *inst, uint32_t valueIndex);
+
+      friend class DataFlowEngine;
   };
 
 }
@@ -21,14 +21,18 @@ DataFlowResult * DataFlowAnalysis::getFullSets (
     Function *f)
   {
 
-  auto df = new DataFlowResult{};
+  /*
+   * Every instruction belongs to every set.
+   * Use a dense result to avoid materializing a quadratic number of set elements.
+   */
+  std::vector<Value *> values;
   for (auto& inst : instructions(*f)){
-    auto& inSetOfInst = df->IN(&inst);
-    auto& outSetOfInst = df->OUT(&inst);
-    for (auto& inst2 : instructions(*f)){
-      inSetOfInst.insert(&inst2);
-      outSetOfInst.insert(&inst2);
-    }
+    values.push_back(&inst);
+  }
+  auto df = new DataFlowResult(f, values);
+  for (auto& inst : instructions(*f)){
+    df->INBits(&inst).set();
+    df->OUTBits(&inst).set();
   }
 
   return df;
@@ -67,28 +71,17 @@ DataFlowResult * DataFlowAnalysis::runReachableAnalysis (
   auto computeKILL = [](Instruction *, DataFlowResult *) {
     return ;
   };
-  auto computeOUT = [](std::set<Value *>& OUT, Instruction *succ, DataFlowResult *df) {
-    auto& inS = df->IN(succ);
-    OUT.insert(inS.begin(), inS.end());
-    return ;
-  } ;
-  auto computeIN = [](std::set<Value *>& IN, Instruction *inst, DataFlowResult *df) {
-    auto& genI = df->GEN(inst);
-    auto& outI = df->OUT(inst);
-
-    /*
-     * IN[i] = GEN[i] U OUT[i]
-     */
-    IN.insert(genI.begin(), genI.end());
-    IN.insert(outI.begin(), outI.end());
-
-    return ;
-  };
 
   /*
    * Run the data flow analysis needed to identify the instructions that could be executed from a given point.
+   *
+   * The equations are:
+   *   OUT[i] = U IN[s] for every successor s of i
+   *   IN[i] = GEN[i] U OUT[i]
+   * so we can rely on the dense engine.
+   * Clients query only a few instructions (e.g., memory instructions for the PDG), so we store only the sets at the boundaries of basic blocks.
    */
-  auto df = dfa.applyBackward(f, computeGEN, computeKILL, computeIN, computeOUT);
+  auto df = dfa.applyBackwardUsingBitVectors(f, computeGEN, computeKILL, true);
 
   return df;
 }
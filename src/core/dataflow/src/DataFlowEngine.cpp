@@ -412,3 +412,347 @@ DataFlowResult * DataFlowEngine::applyCustomizableForwardAnalysis (
 
   return df;
 }
+
+DataFlowResult * DataFlowEngine::computeDenseGENAndKILL (
+    Function *f, 
+    std::function<void (Instruction *, DataFlowResult *)> computeGEN,
+    std::function<void (Instruction *, DataFlowResult *)> computeKILL,
+    bool onlyBasicBlockBoundaries,
+    bool isForward
+    ){
+
+  /*
+   * Compute the GENs and KILLs using sets.
+   */
+  auto sparseDF = new DataFlowResult{};
+  computeGENAndKILL(f, computeGEN, computeKILL, sparseDF);
+
+  /*
+   * Collect the values that can belong to the sets.
+   * Values are numbered in the order they are found to make the numbering deterministic.
+   */
+  std::vector<Value *> values;
+  std::unordered_set<Value *> valuesFound;
+  auto collectValues = [&values, &valuesFound](std::set<Value *> &s){
+    for (auto v : s){
+      if (valuesFound.find(v) != valuesFound.end()){
+        continue ;
+      }
+      valuesFound.insert(v);
+      values.push_back(v);
+    }
+  };
+  for (auto& inst : instructions(*f)){
+    collectValues(sparseDF->GEN(&inst));
+    collectValues(sparseDF->KILL(&inst));
+  }
+
+  /*
+   * Create the dense result.
+   */
+  auto df = new DataFlowResult(f, values, onlyBasicBlockBoundaries, isForward);
+  for (auto& inst : instructions(*f)){
+    for (auto v : sparseDF->GEN(&inst)){
+      df->addToGEN(&inst, df->getIndexOfValue(v));
+    }
+    for (auto v : sparseDF->KILL(&inst)){
+      df->addToKILL(&inst, df->getIndexOfValue(v));
+    }
+  }
+
+  /*
+   * Free the memory.
+   */
+  delete sparseDF;
+
+  return df;
+}
+
+void DataFlowEngine::computeBasicBlockGENAndKILL (
+    Function *f, 
+    DataFlowResult *df,
+    bool isForward,
+    std::vector<BitVector> &basicBlockGEN,
+    std::vector<BitVector> &basicBlockKILL
+    ){
+
+  /*
+   * Compose the transfer functions of the instructions of every basic block.
+   *
+   * Applying GEN[i2] U (X - KILL[i2]) after GEN[i1] U (X - KILL[i1]) is equivalent to applying GEN U (X - KILL) where:
+   *   GEN = GEN[i2] U (GEN[i1] - KILL[i2])
+   *   KILL = KILL[i1] U KILL[i2]
+   */
+  auto numberOfValues = df->getNumberOfValues();
+  basicBlockGEN.assign(df->basicBlockToIndex.size(), BitVector(numberOfValues));
+  basicBlockKILL.assign(df->basicBlockToIndex.size(), BitVector(numberOfValues));
+  auto composeInstruction = [df](Instruction *i, BitVector &gen, BitVector &kill){
+    auto instIndex = df->getIndexOfInstruction(i);
+    for (auto index : df->killIndices[instIndex]){
+      gen.reset(index);
+      kill.set(index);
+    }
+    for (auto index : df->genIndices[instIndex]){
+      gen.set(index);
+    }
+  };
+  for (auto& bb : *f){
+    auto bbIndex = df->basicBlockToIndex[&bb];
+    auto &gen = basicBlockGEN[bbIndex];
+    auto &kill = basicBlockKILL[bbIndex];
+    if (isForward){
+      for (auto &i : bb){
+        composeInstruction(&i, gen, kill);
+      }
+    } else {
+      for (auto &i : make_range(bb.rbegin(), bb.rend())){
+        composeInstruction(&i, gen, kill);
+      }
+    }
+  }
+
+  return ;
+}
+
+void DataFlowEngine::computeInstructionSetsFromBasicBlockSets (
+    Function *f, 
+    DataFlowResult *df
+    ){
+
+  /*
+   * Check if the sets of instructions need to be stored.
+   */
+  if (df->storesOnlyBasicBlockBoundaries()){
+    return ;
+  }
+
+  /*
+   * Compute the sets of every instruction starting from the ones at the boundaries of its basic block.
+   */
+  for (auto& bb : *f){
+    auto &expandedBB = df->expandBasicBlock(&bb);
+    auto firstIndex = df->getIndexOfInstruction(&*bb.begin());
+    for (auto offset = 0u; offset < expandedBB.ins.size(); offset++){
+      df->inBits[firstIndex + offset] = std::move(expandedBB.ins[offset]);
+      df->outBits[firstIndex + offset] = std::move(expandedBB.outs[offset]);
+    }
+  }
+  df->expandedBasicBlocks.clear();
+
+  return ;
+}
+
+DataFlowResult * DataFlowEngine::applyForwardUsingBitVectors (
+    Function *f,
+    std::function<void (Instruction *, DataFlowResult *)> computeGEN,
+    std::function<void (Instruction *, DataFlowResult *)> computeKILL,
+    bool meetIsIntersection,
+    bool onlyBasicBlockBoundaries
+    ){
+
+  /*
+   * Compute the GENs and KILLs of instructions and basic blocks.
+   */
+  auto df = this->computeDenseGENAndKILL(f, computeGEN, computeKILL, onlyBasicBlockBoundaries, true);
+  std::vector<BitVector> basicBlockGEN;
+  std::vector<BitVector> basicBlockKILL;
+  this->computeBasicBlockGENAndKILL(f, df, true, basicBlockGEN, basicBlockKILL);
+
+  /*
+   * Initialize the OUT sets.
+   *
+   * For intersection-based analyses, the OUT sets start from the universe.
+   */
+  if (meetIsIntersection){
+    for (auto& bb : *f){
+      df->OUTBits(&bb).set();
+    }
+  }
+
+  /*
+   * Define the transfer function of a basic block: OUT[bb] = GEN[bb] U (IN[bb] - KILL[bb])
+   * It returns true if OUT[bb] changed.
+   */
+  BitVector newOUT(df->getNumberOfValues());
+  auto computeOUT = [df, &newOUT, &basicBlockGEN, &basicBlockKILL](BasicBlock *bb) -> bool {
+    auto bbIndex = df->basicBlockToIndex[bb];
+    newOUT = df->INBits(bb);
+    newOUT.reset(basicBlockKILL[bbIndex]);
+    newOUT |= basicBlockGEN[bbIndex];
+    auto& outBitsOfBB = df->OUTBits(bb);
+    if (newOUT == outBitsOfBB){
+      return false;
+    }
+    outBitsOfBB = newOUT;
+    return true;
+  };
+
+  /*
+   * Create the working list by adding all basic blocks to it.
+   */
+  std::list<BasicBlock *> workingList;
+  std::unordered_map<BasicBlock *, bool> workingListContent;
+  for (auto& bb : *f){
+    workingList.push_back(&bb);
+    workingListContent[&bb] = true;
+  }
+
+  /* 
+   * Compute the INs and OUTs iteratively until the working list is empty.
+   */
+  std::unordered_set<BasicBlock *> computedOnce;
+  while (!workingList.empty()){
+
+    /* 
+     * Fetch a basic block that needs to be processed.
+     */
+    auto bb = workingList.front();
+    workingList.pop_front();
+    workingListContent[bb] = false;
+
+    /* 
+     * Compute IN[bb]
+     */
+    auto& inBitsOfBB = df->INBits(bb);
+    auto isFirstPredecessor = true;
+    for (auto predecessorBB : predecessors(bb)){
+      auto& outBitsOfPredecessor = df->OUTBits(predecessorBB);
+      if (!meetIsIntersection){
+        inBitsOfBB |= outBitsOfPredecessor;
+        continue ;
+      }
+      if (isFirstPredecessor){
+        inBitsOfBB = outBitsOfPredecessor;
+      } else {
+        inBitsOfBB &= outBitsOfPredecessor;
+      }
+      isFirstPredecessor = false;
+    }
+
+    /* 
+     * Compute OUT[bb]
+     */
+    auto changed = computeOUT(bb);
+    if (  true
+          && (!changed)
+          && (computedOnce.find(bb) != computedOnce.end())
+       ){
+      continue ;
+    }
+    computedOnce.insert(bb);
+
+    /* 
+     * Add successors of the current basic block to the working list.
+     */
+    for (auto succBB : successors(bb)){
+      if (workingListContent[succBB]){
+        continue ;
+      }
+      workingList.push_back(succBB);
+      workingListContent[succBB] = true;
+    }
+  }
+
+  /*
+   * Compute the sets of the instructions if needed.
+   */
+  this->computeInstructionSetsFromBasicBlockSets(f, df);
+
+  return df;
+}
+
+DataFlowResult * DataFlowEngine::applyBackwardUsingBitVectors (
+    Function *f,
+    std::function<void (Instruction *, DataFlowResult *)> computeGEN,
+    std::function<void (Instruction *, DataFlowResult *)> computeKILL,
+    bool onlyBasicBlockBoundaries
+    ){
+
+  /*
+   * Compute the GENs and KILLs of instructions and basic blocks.
+   */
+  auto df = this->computeDenseGENAndKILL(f, computeGEN, computeKILL, onlyBasicBlockBoundaries, false);
+  std::vector<BitVector> basicBlockGEN;
+  std::vector<BitVector> basicBlockKILL;
+  this->computeBasicBlockGENAndKILL(f, df, false, basicBlockGEN, basicBlockKILL);
+
+  /*
+   * Define the transfer function of a basic block: IN[bb] = GEN[bb] U (OUT[bb] - KILL[bb])
+   * It returns true if IN[bb] changed.
+   */
+  BitVector newIN(df->getNumberOfValues());
+  auto computeIN = [df, &newIN, &basicBlockGEN, &basicBlockKILL](BasicBlock *bb) -> bool {
+    auto bbIndex = df->basicBlockToIndex[bb];
+    newIN = df->OUTBits(bb);
+    newIN.reset(basicBlockKILL[bbIndex]);
+    newIN |= basicBlockGEN[bbIndex];
+    auto& inBitsOfBB = df->INBits(bb);
+    if (newIN == inBitsOfBB){
+      return false;
+    }
+    inBitsOfBB = newIN;
+    return true;
+  };
+
+  /*
+   * Create the working list by adding all basic blocks to it.
+   */
+  std::list<BasicBlock *> workingList;
+  std::unordered_map<BasicBlock *, bool> workingListContent;
+  for (auto& bb : *f){
+    workingList.push_front(&bb);
+    workingListContent[&bb] = true;
+  }
+
+  /* 
+   * Compute the INs and OUTs iteratively until the working list is empty.
+   */
+  std::unordered_set<BasicBlock *> computedOnce;
+  while (!workingList.empty()){
+
+    /* 
+     * Fetch a basic block that needs to be processed.
+     */
+    auto bb = workingList.front();
+    workingList.pop_front();
+    workingListContent[bb] = false;
+
+    /* 
+     * Compute OUT[bb]
+     */
+    auto& outBitsOfBB = df->OUTBits(bb);
+    for (auto successorBB : successors(bb)){
+      outBitsOfBB |= df->INBits(successorBB);
+    }
+
+    /* 
+     * Compute IN[bb]
+     */
+    auto changed = computeIN(bb);
+    if (  true
+          && (!changed)
+          && (computedOnce.find(bb) != computedOnce.end())
+       ){
+      continue ;
+    }
+    computedOnce.insert(bb);
+
+    /* 
+     * Add predecessors of the current basic block to the working list.
+     */
+    for (auto predBB : predecessors(bb)){
+      if (workingListContent[predBB]){
+        continue ;
+      }
+      workingList.push_back(predBB);
+      workingListContent[predBB] = true;
+    }
+  }
+
+  /*
+   * Compute the sets of the instructions if needed.
+   */
+  this->computeInstructionSetsFromBasicBlockSets(f, df);
+
+  return df;
+}
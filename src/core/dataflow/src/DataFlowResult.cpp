@@ -13,30 +13,340 @@
 using namespace llvm;
 using namespace llvm::noelle;
 
-DataFlowResult::DataFlowResult (){
+DataFlowResult::DataFlowResult ()
+  : dense{false}
+  , onlyBasicBlockBoundaries{false}
+  , isForward{true}
+  , expandedBasicBlocksClock{0}
+  {
+  return ;
+}
+
+DataFlowResult::DataFlowResult (Function *f, std::vector<Value *> const &values)
+  : DataFlowResult(f, values, false, true)
+  {
+  return ;
+}
+
+DataFlowResult::DataFlowResult (Function *f, std::vector<Value *> const &values, bool onlyBasicBlockBoundaries, bool isForward)
+  : dense{true}
+  , onlyBasicBlockBoundaries{onlyBasicBlockBoundaries}
+  , isForward{isForward}
+  , expandedBasicBlocksClock{0}
+  {
+  assert(f != nullptr);
+
+  /*
+   * Number the values that can belong to the sets.
+   */
+  for (auto v : values){
+    if (this->valueToIndex.find(v) != this->valueToIndex.end()){
+      continue ;
+    }
+    this->valueToIndex[v] = this->indexToValue.size();
+    this->indexToValue.push_back(v);
+  }
+  auto numberOfValues = this->indexToValue.size();
+
+  /*
+   * Number the instructions.
+   * Instructions of a basic block get consecutive numbers.
+   */
+  uint32_t numberOfInstructions = 0;
+  for (auto &inst : instructions(*f)){
+    this->instructionToIndex[&inst] = numberOfInstructions;
+    numberOfInstructions++;
+  }
+  this->genIndices.resize(numberOfInstructions);
+  this->killIndices.resize(numberOfInstructions);
+
+  /*
+   * Number the basic blocks and allocate their sets.
+   */
+  uint32_t numberOfBasicBlocks = 0;
+  for (auto &bb : *f){
+    this->basicBlockToIndex[&bb] = numberOfBasicBlocks;
+    numberOfBasicBlocks++;
+  }
+  this->basicBlockInBits.resize(numberOfBasicBlocks, BitVector(numberOfValues));
+  this->basicBlockOutBits.resize(numberOfBasicBlocks, BitVector(numberOfValues));
+
+  /*
+   * Allocate the sets of the instructions.
+   */
+  if (!this->onlyBasicBlockBoundaries){
+    this->genBits.resize(numberOfInstructions, BitVector(numberOfValues));
+    this->killBits.resize(numberOfInstructions, BitVector(numberOfValues));
+    this->inBits.resize(numberOfInstructions, BitVector(numberOfValues));
+    this->outBits.resize(numberOfInstructions, BitVector(numberOfValues));
+  }
+  this->expandedBasicBlocks.reserve(DataFlowResult::expandedBasicBlocksCacheSize);
+
   return ;
 }
 
 std::set<Value *>& DataFlowResult::GEN (Instruction *inst){
-  auto& s = this->gens[inst];
+  auto& s = this->fetchSet(this->gens, &this->genIndices, false, inst);
 
   return s;
 }
 
 std::set<Value *>& DataFlowResult::KILL (Instruction *inst){
-  auto& s = this->kills[inst];
+  auto& s = this->fetchSet(this->kills, &this->killIndices, false, inst);
 
   return s;
 }
 
 std::set<Value *>& DataFlowResult::IN (Instruction *inst){
-  auto& s = this->ins[inst];
+  auto& s = this->fetchSet(this->ins, nullptr, true, inst);
 
   return s;
 }
 
 std::set<Value *>& DataFlowResult::OUT (Instruction *inst){
-  auto& s = this->outs[inst];
+  auto& s = this->fetchSet(this->outs, nullptr, false, inst);
 
   return s;
 }
+
+bool DataFlowResult::isDense (void) const {
+  return this->dense;
+}
+
+bool DataFlowResult::storesOnlyBasicBlockBoundaries (void) const {
+  return this->onlyBasicBlockBoundaries;
+}
+
+uint32_t DataFlowResult::getNumberOfValues (void) const {
+  return this->indexToValue.size();
+}
+
+int64_t DataFlowResult::getIndexOfValue (Value *v) const {
+  auto it = this->valueToIndex.find(v);
+  if (it == this->valueToIndex.end()){
+    return -1;
+  }
+
+  return it->second;
+}
+
+Value * DataFlowResult::getValueOfIndex (uint32_t index) const {
+  assert(index < this->indexToValue.size());
+
+  return this->indexToValue[index];
+}
+
+BitVector & DataFlowResult::GENBits (Instruction *inst){
+  assert(!this->onlyBasicBlockBoundaries && "GEN bit vectors are not stored at basic block granularity");
+
+  return this->fetchBits(this->genBits, inst);
+}
+
+BitVector & DataFlowResult::KILLBits (Instruction *inst){
+  assert(!this->onlyBasicBlockBoundaries && "KILL bit vectors are not stored at basic block granularity");
+
+  return this->fetchBits(this->killBits, inst);
+}
+
+BitVector & DataFlowResult::INBits (Instruction *inst){
+  if (!this->onlyBasicBlockBoundaries){
+    return this->fetchBits(this->inBits, inst);
+  }
+
+  /*
+   * Compute the sets of the instructions of the basic block of @inst.
+   */
+  auto bb = inst->getParent();
+  auto &expandedBB = this->expandBasicBlock(bb);
+  auto offset = this->getIndexOfInstruction(inst) - this->getIndexOfInstruction(&*bb->begin());
+
+  return expandedBB.ins[offset];
+}
+
+BitVector & DataFlowResult::OUTBits (Instruction *inst){
+  if (!this->onlyBasicBlockBoundaries){
+    return this->fetchBits(this->outBits, inst);
+  }
+
+  /*
+   * Compute the sets of the instructions of the basic block of @inst.
+   */
+  auto bb = inst->getParent();
+  auto &expandedBB = this->expandBasicBlock(bb);
+  auto offset = this->getIndexOfInstruction(inst) - this->getIndexOfInstruction(&*bb->begin());
+
+  return expandedBB.outs[offset];
+}
+
+BitVector & DataFlowResult::INBits (BasicBlock *bb){
+  assert(this->dense && "The bit-vector API is available only for dense data-flow results");
+  auto bbIt = this->basicBlockToIndex.find(bb);
+  assert(bbIt != this->basicBlockToIndex.end());
+
+  return this->basicBlockInBits[bbIt->second];
+}
+
+BitVector & DataFlowResult::OUTBits (BasicBlock *bb){
+  assert(this->dense && "The bit-vector API is available only for dense data-flow results");
+  auto bbIt = this->basicBlockToIndex.find(bb);
+  assert(bbIt != this->basicBlockToIndex.end());
+
+  return this->basicBlockOutBits[bbIt->second];
+}
+
+DataFlowResult::ExpandedBasicBlock & DataFlowResult::expandBasicBlock (BasicBlock *bb){
+  this->expandedBasicBlocksClock++;
+
+  /*
+   * Check the cache.
+   */
+  for (auto &expandedBB : this->expandedBasicBlocks){
+    if (expandedBB.bb == bb){
+      expandedBB.lastUse = this->expandedBasicBlocksClock;
+      return expandedBB;
+    }
+  }
+
+  /*
+   * Pick the entry to use: a new one if the cache is not full, the least recently used one otherwise.
+   */
+  ExpandedBasicBlock *entry = nullptr;
+  if (this->expandedBasicBlocks.size() < DataFlowResult::expandedBasicBlocksCacheSize){
+    this->expandedBasicBlocks.push_back(ExpandedBasicBlock{});
+    entry = &this->expandedBasicBlocks.back();
+  } else {
+    entry = &this->expandedBasicBlocks[0];
+    for (auto &expandedBB : this->expandedBasicBlocks){
+      if (expandedBB.lastUse < entry->lastUse){
+        entry = &expandedBB;
+      }
+    }
+  }
+  entry->bb = bb;
+  entry->lastUse = this->expandedBasicBlocksClock;
+
+  /*
+   * Compute the sets of the instructions of @bb starting from the ones at its boundaries.
+   * Every instruction i applies the transfer function GEN[i] U (X - KILL[i]).
+   */
+  auto numberOfInstructions = bb->size();
+  auto numberOfValues = this->getNumberOfValues();
+  entry->ins.resize(numberOfInstructions, BitVector(numberOfValues));
+  entry->outs.resize(numberOfInstructions, BitVector(numberOfValues));
+  auto firstIndex = this->getIndexOfInstruction(&*bb->begin());
+  auto bbIndex = this->basicBlockToIndex[bb];
+  if (this->isForward){
+    BitVector current = this->basicBlockInBits[bbIndex];
+    for (auto offset = 0u; offset < numberOfInstructions; offset++){
+      entry->ins[offset] = current;
+      for (auto index : this->killIndices[firstIndex + offset]){
+        current.reset(index);
+      }
+      for (auto index : this->genIndices[firstIndex + offset]){
+        current.set(index);
+      }
+      entry->outs[offset] = current;
+    }
+
+  } else {
+    BitVector current = this->basicBlockOutBits[bbIndex];
+    for (auto offset = numberOfInstructions; offset > 0; offset--){
+      entry->outs[offset - 1] = current;
+      for (auto index : this->killIndices[firstIndex + offset - 1]){
+        current.reset(index);
+      }
+      for (auto index : this->genIndices[firstIndex + offset - 1]){
+        current.set(index);
+      }
+      entry->ins[offset - 1] = current;
+    }
+  }
+
+  return *entry;
+}
+
+uint32_t DataFlowResult::getIndexOfInstruction (Instruction *inst) const {
+  auto instIt = this->instructionToIndex.find(inst);
+  assert(instIt != this->instructionToIndex.end());
+
+  return instIt->second;
+}
+
+void DataFlowResult::addToGEN (Instruction *inst, uint32_t valueIndex){
+  auto instIndex = this->getIndexOfInstruction(inst);
+  this->genIndices[instIndex].push_back(valueIndex);
+  if (!this->onlyBasicBlockBoundaries){
+    this->genBits[instIndex].set(valueIndex);
+  }
+
+  return ;
+}
+
+void DataFlowResult::addToKILL (Instruction *inst, uint32_t valueIndex){
+  auto instIndex = this->getIndexOfInstruction(inst);
+  this->killIndices[instIndex].push_back(valueIndex);
+  if (!this->onlyBasicBlockBoundaries){
+    this->killBits[instIndex].set(valueIndex);
+  }
+
+  return ;
+}
+
+std::set<Value *> & DataFlowResult::fetchSet (
+  std::map<Instruction *, std::set<Value *>> &sets, 
+  std::vector<SmallVector<uint32_t, 1>> *indices,
+  bool isIN,
+  Instruction *inst
+  ){
+
+  /*
+   * Sets of dense results are materialized from their bit vectors when they are requested for the first time.
+   * From then on, the set is stored as the ones of sparse results are.
+   */
+  auto setIt = sets.find(inst);
+  if (setIt != sets.end()){
+    return setIt->second;
+  }
+  if (  true
+        && this->dense
+        && (this->instructionToIndex.find(inst) != this->instructionToIndex.end())
+     ){
+    return this->materializeSet(sets, indices, isIN, inst);
+  }
+
+  /*
+   * Sets of sparse results are stored as they are.
+   */
+  return sets[inst];
+}
+
+std::set<Value *> & DataFlowResult::materializeSet (
+  std::map<Instruction *, std::set<Value *>> &kind,
+  std::vector<SmallVector<uint32_t, 1>> *indices,
+  bool isIN,
+  Instruction *inst
+  ){
+  auto &values = kind[inst];
+
+  /*
+   * Materialize the set.
+   */
+  if (indices != nullptr){
+    for (auto index : (*indices)[this->getIndexOfInstruction(inst)]){
+      values.insert(this->indexToValue[index]);
+    }
+    return values;
+  }
+  auto &instBits = isIN ? this->INBits(inst) : this->OUTBits(inst);
+  for (auto index : instBits.set_bits()){
+    values.insert(this->indexToValue[index]);
+  }
+
+  return values;
+}
+
+BitVector & DataFlowResult::fetchBits (std::vector<BitVector> &bits, Instruction *inst){
+  assert(this->dense && "The bit-vector API is available only for dense data-flow results");
+
+  return bits[this->getIndexOfInstruction(inst)];
+}
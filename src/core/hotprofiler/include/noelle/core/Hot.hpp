@@ -113,6 +113,62 @@ namespace llvm::noelle {
 
       double getAverageTotalInstructionsPerIteration (LoopStructure *loop) const ;
 
+      /*
+       * Return an estimate of the variance of the number of instructions (including the ones executed by the callees) executed by an iteration of @loop.
+       *
+       * The profile does not track single iterations.
+       * Hence, each basic block of @loop is modeled as executed by an iteration independently from the others:
+       * a block executed at most once per iteration follows a Bernoulli distribution, while a block of a nested loop follows a Poisson one.
+       */
+      double getVarianceOfTotalInstructionsPerIteration (LoopStructure *loop) const ;
+
+      /*
+       * Return true if the histograms of @loop have been collected (see noelle-prof-coverage --loops).
+       */
+      bool isLoopHistogramAvailable (LoopStructure *loop) const ;
+
+      /*
+       * Return the @quantile (between 0 and 1) of the number of iterations executed by an invocation of @loop.
+       *
+       * The histogram is kept in power-of-two buckets, so the value is interpolated within its bucket.
+       */
+      double getLoopIterationsPerInvocationQuantile (LoopStructure *loop, double quantile) const ;
+
+      /*
+       * Return the @quantile (between 0 and 1) of the number of cycles spent by an iteration of @loop.
+       *
+       * The cost of an iteration is averaged within each sampled invocation.
+       */
+      double getLoopCyclesPerIterationQuantile (LoopStructure *loop, double quantile) const ;
+
+      void setLoopHistograms (BasicBlock *header, std::vector<uint64_t> iterationsHistogram, std::vector<uint64_t> cyclesHistogram);
+
+      /*
+       * =========================== Dependences =================================
+       */
+
+      /*
+       * Return true if the loop-carried memory dependence @dependence of @loop has been profiled (see noelle-prof-dependences).
+       */
+      bool isDependenceProfileAvailable (LoopStructure *loop, DGEdge<Value> *dependence) const ;
+
+      /*
+       * Return the number of times the destination of @dependence has been executed within @loop.
+       */
+      uint64_t getDependenceChecks (LoopStructure *loop, DGEdge<Value> *dependence) const ;
+
+      /*
+       * Return the number of times the destination of @dependence accessed memory accessed by its source in an earlier iteration of the same invocation of @loop.
+       */
+      uint64_t getDependenceManifestations (LoopStructure *loop, DGEdge<Value> *dependence) const ;
+
+      /*
+       * Return true if @dependence has been profiled, the profiled inputs exercised it, and it never manifested across the iterations of @loop.
+       */
+      bool hasDependenceNeverManifested (LoopStructure *loop, DGEdge<Value> *dependence) const ;
+
+      void setDependenceProfile (BasicBlock *header, Instruction *fromInst, Instruction *toInst, uint64_t checks, uint64_t manifestations);
+
       /*
        * =========================== Functions ==================================
        */
@@ -165,6 +221,9 @@ namespace llvm::noelle {
       std::unordered_map<Function *, uint64_t> functionSelfInstructions;
       std::unordered_map<Function *, uint64_t> functionTotalInstructions;
       std::unordered_map<Instruction *, uint64_t> instructionTotalInstructions;
+      std::unordered_map<BasicBlock *, std::vector<uint64_t>> loopIterationsHistograms;
+      std::unordered_map<BasicBlock *, std::vector<uint64_t>> loopCyclesHistograms;
+      std::unordered_map<BasicBlock *, std::map<std::pair<Value *, Value *>, std::pair<uint64_t, uint64_t>>> dependenceProfiles;
       uint64_t moduleNumberOfInstructionsExecuted;
 
       void computeTotalInstructions (Module &M); 
@@ -174,6 +233,8 @@ namespace llvm::noelle {
       void setFunctionTotalInstructions (Function *f, uint64_t totalInstructions) ;
 
       bool isFunctionTotalInstructionsAvailable (Function &F) const ;
+
+      static double getHistogramQuantile (const std::vector<uint64_t> &histogram, double quantile) ;
   };
 
 }
@@ -73,6 +73,80 @@ void HotProfiler::analyzeProfiles (Module &M){
     }
   }
 
+  /*
+   * Fetch the loop histograms embedded by noelle-meta-prof-embed.
+   * They are attached to the terminator of the header of the loops.
+   */
+  auto parseHistogram = [](Instruction *inst, const std::string &metadataName) -> std::vector<uint64_t> {
+    std::vector<uint64_t> histogram;
+    auto metadata = inst->getMetadata(metadataName);
+    if (metadata == nullptr){
+      return histogram;
+    }
+    auto histogramString = cast<MDString>(metadata->getOperand(0))->getString();
+    SmallVector<StringRef, 65> counters;
+    histogramString.split(counters, ' ', -1, false);
+    for (auto counter : counters){
+      uint64_t value = 0;
+      counter.getAsInteger(10, value);
+      histogram.push_back(value);
+    }
+
+    return histogram;
+  };
+  for (auto &F : M){
+    for (auto &bb : F){
+      auto terminator = bb.getTerminator();
+      if (  false
+            || (terminator == nullptr)
+            || (terminator->getMetadata("noelle.prof.loop.iterations") == nullptr)
+         ){
+        continue ;
+      }
+      auto iterationsHistogram = parseHistogram(terminator, "noelle.prof.loop.iterations");
+      auto cyclesHistogram = parseHistogram(terminator, "noelle.prof.loop.iteration_cycles");
+      this->hot.setLoopHistograms(&bb, iterationsHistogram, cyclesHistogram);
+    }
+  }
+
+  /*
+   * Fetch the dependence profiles embedded by noelle-meta-dep-embed.
+   * A destination refers to the IDs of the source and of the loop (the terminator of its header) of each of its profiled dependences.
+   */
+  for (auto &F : M){
+    std::unordered_map<MDNode *, Instruction *> sources;
+    std::unordered_map<MDNode *, BasicBlock *> headers;
+    std::vector<Instruction *> destinations;
+    for (auto &inst : instructions(F)){
+      if (auto sourceID = inst.getMetadata("noelle.prof.dependence.source.id")){
+        sources[sourceID] = &inst;
+      }
+      if (auto loopID = inst.getMetadata("noelle.prof.dependence.loop.id")){
+        headers[loopID] = inst.getParent();
+      }
+      if (inst.getMetadata("noelle.prof.dependences") != nullptr){
+        destinations.push_back(&inst);
+      }
+    }
+    for (auto destination : destinations){
+      auto dependencesM = destination->getMetadata("noelle.prof.dependences");
+      for (auto &dependenceOperand : dependencesM->operands()){
+        auto dependenceM = cast<MDNode>(dependenceOperand);
+        auto sourceIt = sources.find(cast<MDNode>(dependenceM->getOperand(0)));
+        auto headerIt = headers.find(cast<MDNode>(dependenceM->getOperand(1)));
+        if (  false
+              || (sourceIt == sources.end())
+              || (headerIt == headers.end())
+           ){
+          continue ;
+        }
+        auto checks = mdconst::extract<ConstantInt>(dependenceM->getOperand(2))->getZExtValue();
+        auto manifestations = mdconst::extract<ConstantInt>(dependenceM->getOperand(3))->getZExtValue();
+        this->hot.setDependenceProfile(headerIt->second, sourceIt->second, destination, checks, manifestations);
+      }
+    }
+  }
+
   /*
    * Compute the global counters.
    */
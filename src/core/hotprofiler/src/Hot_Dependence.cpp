@@ -0,0 +1,61 @@
+/*
+ * Copyright 2016 - 2020  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/Hot.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+bool Hot::isDependenceProfileAvailable (LoopStructure *loop, DGEdge<Value> *dependence) const {
+  auto header = loop->getHeader();
+  auto loopIt = this->dependenceProfiles.find(header);
+  if (loopIt == this->dependenceProfiles.end()){
+    return false;
+  }
+  auto &loopDependences = loopIt->second;
+
+  return loopDependences.find({ dependence->getOutgoingT(), dependence->getIncomingT() }) != loopDependences.end();
+}
+
+uint64_t Hot::getDependenceChecks (LoopStructure *loop, DGEdge<Value> *dependence) const {
+  if (!this->isDependenceProfileAvailable(loop, dependence)){
+    return 0;
+  }
+  auto &loopDependences = this->dependenceProfiles.at(loop->getHeader());
+
+  return loopDependences.at({ dependence->getOutgoingT(), dependence->getIncomingT() }).first;
+}
+
+uint64_t Hot::getDependenceManifestations (LoopStructure *loop, DGEdge<Value> *dependence) const {
+  if (!this->isDependenceProfileAvailable(loop, dependence)){
+    return 0;
+  }
+  auto &loopDependences = this->dependenceProfiles.at(loop->getHeader());
+
+  return loopDependences.at({ dependence->getOutgoingT(), dependence->getIncomingT() }).second;
+}
+
+bool Hot::hasDependenceNeverManifested (LoopStructure *loop, DGEdge<Value> *dependence) const {
+  if (  false
+        || (!this->isDependenceProfileAvailable(loop, dependence))
+        || (this->getDependenceChecks(loop, dependence) == 0)
+     ){
+    return false;
+  }
+
+  return this->getDependenceManifestations(loop, dependence) == 0;
+}
+
+void Hot::setDependenceProfile (BasicBlock *header, Instruction *fromInst, Instruction *toInst, uint64_t checks, uint64_t manifestations){
+  this->dependenceProfiles[header][{ fromInst, toInst }] = { checks, manifestations };
+
+  return ;
+}
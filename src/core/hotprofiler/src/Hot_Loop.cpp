@@ -153,6 +153,49 @@ double Hot::getAverageTotalInstructionsPerIteration (LoopStructure *loop) const
   return instsPerIteration;
 }
 
+double Hot::getVarianceOfTotalInstructionsPerIteration (LoopStructure *loop) const {
+
+  /*
+   * Fetch the total number of iterations executed.
+   */
+  auto loopIterations = this->getIterations(loop);
+  if (loopIterations == 0){
+    return 0;
+  }
+
+  /*
+   * Accumulate the variance contributed by every basic block of the loop.
+   */
+  double variance = 0;
+  for (auto bb : loop->getBasicBlocks()){
+
+    /*
+     * Fetch the average cost of an execution of the current block.
+     */
+    auto bbInvocations = this->getInvocations(bb);
+    if (bbInvocations == 0){
+      continue ;
+    }
+    auto cost = ((double)this->getTotalInstructions(bb)) / ((double)bbInvocations);
+
+    /*
+     * Compute the average number of executions of the current block per iteration.
+     */
+    auto executionsPerIteration = ((double)bbInvocations) / ((double)loopIterations);
+
+    /*
+     * Add the variance of the instructions executed by the block in an iteration.
+     */
+    if (executionsPerIteration <= 1){
+      variance += cost * cost * executionsPerIteration * (1 - executionsPerIteration);
+    } else {
+      variance += cost * cost * executionsPerIteration;
+    }
+  }
+
+  return variance;
+}
+
 uint64_t Hot::getIterations (LoopStructure *l) const {
 
   /*
@@ -185,3 +228,84 @@ uint64_t Hot::getIterations (LoopStructure *l) const {
 
   return loopIterations;
 }
+
+bool Hot::isLoopHistogramAvailable (LoopStructure *loop) const {
+  auto header = loop->getHeader();
+
+  return this->loopIterationsHistograms.find(header) != this->loopIterationsHistograms.end();
+}
+
+double Hot::getLoopIterationsPerInvocationQuantile (LoopStructure *loop, double quantile) const {
+  auto header = loop->getHeader();
+  auto histogramIt = this->loopIterationsHistograms.find(header);
+  if (histogramIt == this->loopIterationsHistograms.end()){
+    return 0;
+  }
+
+  return Hot::getHistogramQuantile(histogramIt->second, quantile);
+}
+
+double Hot::getLoopCyclesPerIterationQuantile (LoopStructure *loop, double quantile) const {
+  auto header = loop->getHeader();
+  auto histogramIt = this->loopCyclesHistograms.find(header);
+  if (histogramIt == this->loopCyclesHistograms.end()){
+    return 0;
+  }
+
+  return Hot::getHistogramQuantile(histogramIt->second, quantile);
+}
+
+void Hot::setLoopHistograms (BasicBlock *header, std::vector<uint64_t> iterationsHistogram, std::vector<uint64_t> cyclesHistogram){
+  this->loopIterationsHistograms[header] = std::move(iterationsHistogram);
+  if (cyclesHistogram.size() > 0){
+    this->loopCyclesHistograms[header] = std::move(cyclesHistogram);
+  }
+
+  return ;
+}
+
+double Hot::getHistogramQuantile (const std::vector<uint64_t> &histogram, double quantile){
+
+  /*
+   * Fetch the number of samples.
+   */
+  uint64_t samples = 0;
+  for (auto counter : histogram){
+    samples += counter;
+  }
+  if (samples == 0){
+    return 0;
+  }
+
+  /*
+   * Find the bucket that includes the quantile.
+   * Bucket 0 includes the value 0, and bucket k includes the values in [2^(k-1), 2^k).
+   */
+  quantile = std::min(std::max(quantile, 0.0), 1.0);
+  auto target = quantile * ((double)samples);
+  uint64_t samplesBefore = 0;
+  for (auto bucket = 0u; bucket < histogram.size(); bucket++){
+    auto counter = histogram[bucket];
+    if (  false
+          || (counter == 0)
+          || (((double)(samplesBefore + counter)) < target)
+       ){
+      samplesBefore += counter;
+      continue ;
+    }
+    if (bucket == 0){
+      return 0;
+    }
+
+    /*
+     * Interpolate linearly within the bucket.
+     */
+    auto low = std::ldexp(1.0, bucket - 1);
+    auto high = std::ldexp(1.0, bucket);
+    auto fraction = (target - ((double)samplesBefore)) / ((double)counter);
+
+    return low + fraction * (high - low);
+  }
+
+  return 0;
+}
@@ -61,6 +61,13 @@ namespace llvm::noelle {
 
       const SCEV * getStepSCEV (void) const;
 
+      /*
+       * Return true if scalar evolution proved that the IV does not wrap around when its values are interpreted as unsigned (signed) integers.
+       */
+      bool hasNoUnsignedWrap (void) const ;
+
+      bool hasNoSignedWrap (void) const ;
+
       bool isIVInstruction (Instruction *I) const;
 
       bool isDerivedFromIVInstructions (Instruction *I) const;
@@ -110,6 +117,12 @@ namespace llvm::noelle {
        */
       const SCEV *stepSCEV;
 
+      /*
+       * The no-wrap flags of the SCEV of the loop entry PHI
+       */
+      bool noUnsignedWrap;
+      bool noSignedWrap;
+
       /*
        * A single constant or loop external value representing the step recurrence
        */
@@ -22,7 +22,7 @@ InductionVariable::InductionVariable  (
   LoopEnvironment &loopEnv,
   ScalarEvolutionReferentialExpander &referentialExpander
 ) : scc{scc}, loopEntryPHI{loopEntryPHI}, startValue{nullptr},
-    stepSCEV{nullptr}, computationOfStepValue{}, isComputedStepValueLoopInvariant{false} {
+    stepSCEV{nullptr}, noUnsignedWrap{false}, noSignedWrap{false}, computationOfStepValue{}, isComputedStepValueLoopInvariant{false} {
 
   /*
    * Fetch initial value of induction variable
@@ -268,7 +268,10 @@ void InductionVariable::deriveStepValue (
    */
   auto loopEntrySCEV = SE.getSCEV(loopEntryPHI);
   assert(loopEntrySCEV->getSCEVType() == SCEVTypes::scAddRecExpr);
-  this->stepSCEV = cast<SCEVAddRecExpr>(loopEntrySCEV)->getStepRecurrence(SE);
+  auto loopEntryAddRec = cast<SCEVAddRecExpr>(loopEntrySCEV);
+  this->stepSCEV = loopEntryAddRec->getStepRecurrence(SE);
+  this->noUnsignedWrap = loopEntryAddRec->hasNoUnsignedWrap();
+  this->noSignedWrap = loopEntryAddRec->hasNoSignedWrap();
 
   switch (stepSCEV->getSCEVType()) {
     case SCEVTypes::scConstant:
@@ -413,6 +416,14 @@ const SCEV * InductionVariable::getStepSCEV (void) const {
   return stepSCEV;
 }
 
+bool InductionVariable::hasNoUnsignedWrap (void) const {
+  return this->noUnsignedWrap;
+}
+
+bool InductionVariable::hasNoSignedWrap (void) const {
+  return this->noSignedWrap;
+}
+
 std::vector<Instruction *> InductionVariable::getComputationOfStepValue(void) const {
   return computationOfStepValue;
 }
@@ -234,18 +234,39 @@ Value * LoopGoverningIVUtility::generateCodeToComputeTheTripCount (
 
   /*
    * Compute the delta.
+   * The loop does not execute any step when the start value is already past the last one.
+   * This is checked with the signedness of the loop condition because the delta would wrap around otherwise.
+   * Equality conditions have no signedness, so the one of the IV is used: its values are unsigned only if scalar evolution proved they do not wrap around as unsigned integers but could as signed ones.
    */
   Value *delta = nullptr;
+  Value *isPastTheLastValue = nullptr;
+  Value *stepSize = IV.getSingleComputedStepValue();
+  auto headerCmp = this->attribution.getHeaderCmpInst();
+  auto isUnsigned = headerCmp->isUnsigned();
+  if (headerCmp->isEquality()){
+    isUnsigned = (  true
+                    && IV.hasNoUnsignedWrap()
+                    && (!IV.hasNoSignedWrap())
+                 );
+  }
   if (IV.isStepValuePositive()){
     delta = builder.CreateSub(lastValue, startValue);
+    isPastTheLastValue = isUnsigned ? builder.CreateICmpULT(lastValue, startValue) : builder.CreateICmpSLT(lastValue, startValue);
   } else {
     delta = builder.CreateSub(startValue, lastValue);
+    isPastTheLastValue = isUnsigned ? builder.CreateICmpULT(startValue, lastValue) : builder.CreateICmpSLT(startValue, lastValue);
+    stepSize = builder.CreateNeg(stepSize);
   }
 
   /*
    * Compute the number of steps to reach the delta.
+   * The last step can go past the last value when the step does not divide the delta, so the division rounds up.
+   * This is computed as delta / step plus one if there is a remainder because (delta + step - 1) / step could overflow.
    */
-  auto tripCount = builder.CreateUDiv(delta, IV.getSingleComputedStepValue());
+  auto quotient = builder.CreateUDiv(delta, stepSize);
+  auto hasRemainder = builder.CreateICmpNE(builder.CreateURem(delta, stepSize), ConstantInt::get(delta->getType(), 0));
+  auto tripCount = builder.CreateAdd(quotient, builder.CreateZExt(hasRemainder, quotient->getType()));
+  tripCount = builder.CreateSelect(isPastTheLastValue, ConstantInt::get(tripCount->getType(), 0), tripCount);
 
   return tripCount;
 }
@@ -123,7 +123,23 @@ namespace llvm::noelle {
     std::unordered_map<int, Value *> envIndexToAccumulatedReducableVar;
     std::unordered_map<int, std::vector<Value *>> envIndexToReducableVar;
     std::unordered_map<int, AllocaInst *> envIndexToVectorOfReducableVar;
-    int numReducers;
+    uint32_t numReducers;
+
+    /*
+     * Number of private copies of reduced variables combined by a single vector operation.
+     */
+    static const uint32_t reductionLanes = 4;
+
+    /*
+     * Reduce live out variables by combining the private copies of "reductionLanes" threads at a time with vector operations.
+     * The partial results of the lanes are then combined as a tree.
+     */
+    BasicBlock * reduceLiveOutVariablesWithVectors (
+      BasicBlock *bb,
+      std::unordered_map<int, int> &reducableBinaryOps,
+      std::unordered_map<int, Value *> &initialValues,
+      Value *numberOfThreadsExecuted
+    );
 
     /*
      * Information on a specific user (a function, stage, chunk, etc...)
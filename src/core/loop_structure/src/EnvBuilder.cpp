@@ -103,7 +103,7 @@ void EnvUserBuilder::createReducableEnvPtr (
 EnvBuilder::EnvBuilder (LLVMContext &cxt)
   : CXT{cxt}, envTypes{}, envUsers{},
     envIndexToVar{}, envIndexToReducableVar{}, envIndexToVectorOfReducableVar{},
-    numReducers{-1}, envSize{-1} {
+    numReducers{0}, envSize{-1} {
   envIndexToVar.clear();
   envIndexToReducableVar.clear();
   envIndexToVectorOfReducableVar.clear();
@@ -294,9 +294,12 @@ void EnvBuilder::generateEnvVariables (IRBuilder<> builder) {
 
     /*
      * Define the type of the vectorized form of the reducable variable.
+     *
+     * The number of private copies is rounded up to a multiple of the vector lanes used to reduce them, so the reduction never loads outside the array.
      */
     auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
-    auto reduceArrType = ArrayType::get(int64, numReducers * valuesInCacheLine);
+    auto numberOfPrivateCopies = alignTo(numReducers, EnvBuilder::reductionLanes);
+    auto reduceArrType = ArrayType::get(int64, numberOfPrivateCopies * valuesInCacheLine);
 
     /*
      * Allocate the vectorized form of the reducable variable on the stack.
@@ -314,7 +317,7 @@ void EnvBuilder::generateEnvVariables (IRBuilder<> builder) {
     /*
      * Compute and cache the pointer of each element of the vectorized variable.
      */
-    for (auto i = 0; i < numReducers; ++i) {
+    for (auto i = 0u; i < numReducers; ++i) {
       auto reducePtr = fetchCastedEnvPtr(reduceArrAlloca, i, ptrType);
       envIndexToReducableVar[envIndex].push_back(reducePtr);
     }
@@ -323,6 +326,27 @@ void EnvBuilder::generateEnvVariables (IRBuilder<> builder) {
   return ;
 }
 
+/*
+ * Return the value that leaves the operand unchanged when combined with it using @binOp (nullptr if it is unknown).
+ */
+static Value * getIdentityOfReduction (Instruction::BinaryOps binOp, Type *type){
+  switch (binOp){
+    case Instruction::Add:
+    case Instruction::Or:
+      return ConstantInt::get(type, 0);
+    case Instruction::Mul:
+      return ConstantInt::get(type, 1);
+    case Instruction::And:
+      return Constant::getAllOnesValue(type);
+    case Instruction::FAdd:
+      return ConstantFP::getNegativeZero(type);
+    case Instruction::FMul:
+      return ConstantFP::get(type, 1.0);
+    default:
+      return nullptr;
+  }
+}
+
 BasicBlock * EnvBuilder::reduceLiveOutVariables (
   BasicBlock *bb,
   IRBuilder<> builder,
@@ -338,6 +362,22 @@ BasicBlock * EnvBuilder::reduceLiveOutVariables (
     return bb;
   }
 
+  /*
+   * Check if there are enough private copies to benefit from combining them with vector operations.
+   * All reductions must have an identity value to fill the lanes of the threads that did not execute.
+   */
+  auto canUseVectors = (this->numReducers >= (2 * EnvBuilder::reductionLanes));
+  for (auto envIndexInitValue : initialValues) {
+    auto envIndex = envIndexInitValue.first;
+    auto binOp = (Instruction::BinaryOps)reducableBinaryOps[envIndex];
+    if (getIdentityOfReduction(binOp, envTypes[envIndex]) == nullptr){
+      canUseVectors = false;
+    }
+  }
+  if (canUseVectors){
+    return this->reduceLiveOutVariablesWithVectors(bb, reducableBinaryOps, initialValues, numberOfThreadsExecuted);
+  }
+
   /*
    * Fetch the function that "bb" belongs to.
    */
@@ -516,6 +556,151 @@ BasicBlock * EnvBuilder::reduceLiveOutVariables (
   return afterReductionBB;
 }
 
+BasicBlock * EnvBuilder::reduceLiveOutVariablesWithVectors (
+  BasicBlock *bb,
+  std::unordered_map<int, int> &reducableBinaryOps,
+  std::unordered_map<int, Value *> &initialValues,
+  Value *numberOfThreadsExecuted
+) {
+
+  /*
+   * Fetch the function that "bb" belongs to.
+   */
+  auto f = bb->getParent();
+
+  /*
+   * Create the basic blocks of the reduction loop and of the code after it.
+   */
+  auto loopBodyBB = BasicBlock::Create(this->CXT, "ReductionLoopBody", f);
+  auto afterReductionBB = BasicBlock::Create(this->CXT, "AfterReduction", f, loopBodyBB);
+
+  /*
+   * Change the successor of "bb" to be "loopBodyBB".
+   */
+  auto bbTerminator = bb->getTerminator();
+  if (bbTerminator != nullptr){
+    bbTerminator->eraseFromParent();
+  }
+  IRBuilder<> bbBuilder{bb};
+
+  /*
+   * Initialize the vector accumulators.
+   * The first lane starts from the initial value of the reduced variable, the others from the identity of the reduction.
+   */
+  auto lanes = EnvBuilder::reductionLanes;
+  std::unordered_map<int, Value *> identities;
+  std::unordered_map<int, Value *> initialAccumulators;
+  for (auto envIndexInitValue : initialValues) {
+    auto envIndex = envIndexInitValue.first;
+    auto initialValue = envIndexInitValue.second;
+    auto binOp = (Instruction::BinaryOps)reducableBinaryOps[envIndex];
+    auto identity = getIdentityOfReduction(binOp, envTypes[envIndex]);
+    identities[envIndex] = identity;
+
+    auto identityVector = bbBuilder.CreateVectorSplat(lanes, identity);
+    initialAccumulators[envIndex] = bbBuilder.CreateInsertElement(identityVector, initialValue, (uint64_t)0);
+  }
+  bbBuilder.CreateBr(loopBodyBB);
+
+  /*
+   * Add the PHI node about the induction variable of the reduction loop.
+   * Every iteration combines the private copies of "lanes" threads.
+   */
+  IRBuilder<> loopBodyBuilder{loopBodyBB};
+  auto int32Type = IntegerType::get(this->CXT, 32);
+  auto IVReductionLoop = loopBodyBuilder.CreatePHI(int32Type, 2);
+  IVReductionLoop->addIncoming(ConstantInt::get(int32Type, 0), bb);
+
+  /*
+   * Add the PHI nodes about the vector accumulators.
+   */
+  std::unordered_map<int, PHINode *> phiNodes;
+  for (auto envIndexInitValue : initialValues) {
+    auto envIndex = envIndexInitValue.first;
+    auto initialAccumulator = initialAccumulators[envIndex];
+    auto phiNode = loopBodyBuilder.CreatePHI(initialAccumulator->getType(), 2);
+    phiNode->addIncoming(initialAccumulator, bb);
+    phiNodes[envIndex] = phiNode;
+  }
+
+  /*
+   * Compute how many values can fit in a cache line.
+   */
+  auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
+
+  /*
+   * Accumulate the private copies of the threads of the current iteration.
+   */
+  std::unordered_map<int, Value *> accumulators;
+  for (auto envIndexInitValue : initialValues) {
+    auto envIndex = envIndexInitValue.first;
+    auto binOp = (Instruction::BinaryOps)reducableBinaryOps[envIndex];
+    auto identity = identities[envIndex];
+    auto ptrType = PointerType::getUnqual(envTypes[envIndex]);
+    auto baseAddressOfReducedVar = envIndexToVectorOfReducableVar[envIndex];
+    auto zeroV = cast<Value>(ConstantInt::get(int32Type, 0));
+
+    /*
+     * Pack the private copies in a vector.
+     * Lanes of threads that did not execute take the identity of the reduction.
+     * Their private copies are still loaded because the array of private copies is padded to a multiple of the lanes.
+     */
+    Value *privateCopies = loopBodyBuilder.CreateVectorSplat(lanes, identity);
+    for (auto lane = 0u; lane < lanes; lane++){
+      auto threadID = loopBodyBuilder.CreateAdd(IVReductionLoop, ConstantInt::get(int32Type, lane));
+      auto offsetValue = loopBodyBuilder.CreateMul(threadID, ConstantInt::get(int32Type, valuesInCacheLine));
+      auto effectiveAddress = loopBodyBuilder.CreateInBoundsGEP(baseAddressOfReducedVar, ArrayRef<Value*>({ zeroV, offsetValue }));
+      auto effectiveAddressProperlyCasted = loopBodyBuilder.CreateBitCast(effectiveAddress, ptrType);
+      auto privateCopy = loopBodyBuilder.CreateLoad(effectiveAddressProperlyCasted);
+      auto threadExecuted = loopBodyBuilder.CreateICmpSLT(threadID, numberOfThreadsExecuted);
+      auto laneValue = loopBodyBuilder.CreateSelect(threadExecuted, privateCopy, identity);
+      privateCopies = loopBodyBuilder.CreateInsertElement(privateCopies, laneValue, (uint64_t)lane);
+    }
+
+    /*
+     * Accumulate.
+     */
+    auto phiNode = phiNodes[envIndex];
+    auto newAccumulator = loopBodyBuilder.CreateBinOp(binOp, phiNode, privateCopies);
+    phiNode->addIncoming(newAccumulator, loopBodyBB);
+    accumulators[envIndex] = newAccumulator;
+  }
+
+  /*
+   * Update the induction variable and jump back to the reduction loop body if there are threads left.
+   */
+  auto updatedIVReductionLoop = loopBodyBuilder.CreateAdd(IVReductionLoop, ConstantInt::get(int32Type, lanes));
+  IVReductionLoop->addIncoming(updatedIVReductionLoop, loopBodyBB);
+  auto continueToReduceVariables = loopBodyBuilder.CreateICmpSLT(updatedIVReductionLoop, numberOfThreadsExecuted);
+  loopBodyBuilder.CreateCondBr(continueToReduceVariables, loopBodyBB, afterReductionBB);
+
+  /*
+   * Combine the lanes of the accumulators as a tree: every step folds the upper half of the lanes into the lower half.
+   */
+  IRBuilder<> afterReductionBuilder{afterReductionBB};
+  for (auto envIndexInitValue : initialValues) {
+    auto envIndex = envIndexInitValue.first;
+    auto binOp = (Instruction::BinaryOps)reducableBinaryOps[envIndex];
+    auto accumulator = accumulators[envIndex];
+    for (auto width = lanes / 2; width > 0; width /= 2){
+      std::vector<Constant *> mask;
+      for (auto lane = 0u; lane < lanes; lane++){
+        auto sourceLane = (lane < width) ? (lane + width) : lane;
+        mask.push_back(ConstantInt::get(int32Type, sourceLane));
+      }
+      auto upperHalf = afterReductionBuilder.CreateShuffleVector(accumulator, UndefValue::get(accumulator->getType()), ConstantVector::get(mask));
+      accumulator = afterReductionBuilder.CreateBinOp(binOp, accumulator, upperHalf);
+    }
+
+    /*
+     * Keep track of the reduced value.
+     */
+    envIndexToAccumulatedReducableVar[envIndex] = afterReductionBuilder.CreateExtractElement(accumulator, (uint64_t)0);
+  }
+
+  return afterReductionBB;
+}
+
 Value *EnvBuilder::getEnvArrayInt8Ptr () {
   assert(envArrayInt8Ptr);
   return envArrayInt8Ptr;
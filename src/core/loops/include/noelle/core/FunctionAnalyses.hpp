@@ -0,0 +1,84 @@
+/*
+ * Copyright 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/DominatorSummary.hpp"
+
+#include "llvm/ADT/Hashing.h"
+#include "llvm/Analysis/TargetLibraryInfo.h"
+
+#include <memory>
+
+namespace llvm::noelle {
+
+  /*
+   * Analyses of a function that the analyses of its loops depend on (e.g., scalar evolution for induction variables).
+   * They are computed the first time they are requested, and they are shared by all loops of the function that have been given "this".
+   */
+  class FunctionAnalyses {
+    public:
+
+      /*
+       * Use the target library information and the assumption cache of the pass that analyzes the loops of @F.
+       */
+      FunctionAnalyses (
+        Function &F,
+        TargetLibraryInfo &TLI,
+        AssumptionCache &AC
+        );
+
+      /*
+       * Use the target library information of the target triple of the module of @F.
+       * This is for loops that are not analyzed through a pass (e.g., the loop of a task).
+       */
+      FunctionAnalyses (Function &F);
+
+      FunctionAnalyses () = delete ;
+
+      Function & getFunction (void) const ;
+
+      /*
+       * Check whether instructions or basic blocks have been added to, removed from, or moved within the function since "this" has been created.
+       * Computing the analyses after such a change aborts the compilation.
+       */
+      bool hasFunctionChanged (void) const ;
+
+      /*
+       * Check whether the analyses have been computed.
+       */
+      bool areAnalysesComputed (void) const ;
+
+      DominatorSummary & getDominators (void) ;
+
+      ScalarEvolution & getScalarEvolution (void) ;
+
+      ~FunctionAnalyses ();
+
+    private:
+      Function &F;
+      hash_code fingerprint;                    /* Code of @F when "this" has been created. */
+      TargetLibraryInfoImpl *TLII;              /* Owned by "this" only if the pass did not provide TLI and AC. */
+      TargetLibraryInfo *TLI;
+      AssumptionCache *AC;
+      bool ownsTLIAndAC;
+      DominatorTree *DT;
+      PostDominatorTree *PDT;
+      LoopInfo *LI;
+      ScalarEvolution *SE;
+      DominatorSummary *DS;
+
+      void computeAnalyses (void);
+
+      static hash_code computeFingerprint (Function &F);
+  };
+
+}
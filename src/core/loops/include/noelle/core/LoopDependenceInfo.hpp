@@ -22,6 +22,7 @@
 #include "noelle/core/Transformations.hpp"
 #include "noelle/core/SCCDAGAttrs.hpp"
 #include "noelle/core/LoopIterationDomainSpaceAnalysis.hpp"
+#include "noelle/core/FunctionAnalyses.hpp"
 
 namespace llvm::noelle {
 
@@ -37,6 +38,7 @@ namespace llvm::noelle {
        * Parallelization options
        */
       uint32_t DOALLChunkSize;
+      DOALLSchedule DOALLIterationSchedule;
 
       /*
        * Constructors.
@@ -88,6 +90,21 @@ namespace llvm::noelle {
         bool enableLoopAwareDependenceAnalyses
       );
 
+      /*
+       * The analyses of the function of @l are shared with the other loops of that function given the same @functionAnalyses.
+       */
+      LoopDependenceInfo (
+        PDG *fG,
+        Loop *l,
+        DominatorSummary &DS,
+        ScalarEvolution &SE,
+        uint32_t maxCores,
+        bool enableFloatAsReal,
+        std::unordered_set<LoopDependenceInfoOptimization> optimizations,
+        bool enableLoopAwareDependenceAnalyses,
+        std::shared_ptr<FunctionAnalyses> functionAnalyses
+      );
+
       LoopDependenceInfo () = delete ;
 
       /*
@@ -174,6 +191,19 @@ namespace llvm::noelle {
 
       uint32_t getMaximumNumberOfCores (void) const ;
 
+      /*
+       * Time spent computing an analysis of the loop.
+       */
+      struct AnalysisTime {
+        uint64_t invocations;
+        double seconds;
+      };
+
+      /*
+       * Return, for every analysis of the loop computed so far, how many times it has been computed and the time spent computing it.
+       */
+      const std::map<std::string, AnalysisTime> & getTimeSpentInAnalyses (void) const ;
+
       /*
        * Deconstructor.
        */
@@ -187,6 +217,7 @@ namespace llvm::noelle {
       std::set<Transformation> enabledTransformations;  /* Transformations enabled. */
       std::unordered_set<LoopDependenceInfoOptimization> enabledOptimizations;  /* Optimizations enabled. */
       bool areLoopAwareAnalysesEnabled;
+      bool enableFloatAsReal;
 
       PDG *loopDG;                            /* Dependence graph of the loop.
                                                * This graph does not include instructions outside the loop (i.e., no external dependences are included).
@@ -216,9 +247,41 @@ namespace llvm::noelle {
 
       SCCDAGAttrs *sccdagAttrs;
 
+      SCCDAG *loopSCCDAG;
+
+      bool isLoopGoverningIVAttributionComputed;
+
+      /*
+       * The analyses below the dependence graph are computed the first time they are requested.
+       * The dominators and the scalar evolution given to the constructor do not outlive it, so these analyses use the analyses of the function of the loop that are shared with its other loops.
+       *
+       * The dependence graph describes the loop as it was when "this" has been created, while the function analyses describe the code at the time of the request.
+       * Hence, the lazy analyses must be requested before the loop is transformed; requesting them afterwards aborts the compilation.
+       */
+      std::shared_ptr<FunctionAnalyses> functionAnalyses;
+
+      std::map<std::string, AnalysisTime> timeOfAnalyses;
+
       /*
        * Methods
        */
+      FunctionAnalyses & getFunctionAnalyses (void);
+
+      bool hasLoopChanged (void) const ;
+
+      template <class Analysis>
+      Analysis measureAnalysis (const std::string &name, std::function<Analysis (void)> computeAnalysis);
+
+      void computeInvariantManager (void);
+
+      void computeInductionVariableManager (void);
+
+      void computeSCCManager (void);
+
+      void computeLoopIterationDomainSpaceAnalysis (void);
+
+      void computeLoopGoverningIVAttribution (void);
+
       void fetchLoopAndBBInfo (
         Loop *l,
         ScalarEvolution &SE
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/FunctionAnalyses.hpp"
+
+namespace llvm::noelle {
+
+FunctionAnalyses::FunctionAnalyses (
+  Function &F,
+  TargetLibraryInfo &TLI,
+  AssumptionCache &AC
+  ) : F{F}
+    , fingerprint{computeFingerprint(F)}
+    , TLII{nullptr}
+    , TLI{&TLI}
+    , AC{&AC}
+    , ownsTLIAndAC{false}
+    , DT{nullptr}
+    , PDT{nullptr}
+    , LI{nullptr}
+    , SE{nullptr}
+    , DS{nullptr}
+  {
+  return ;
+}
+
+FunctionAnalyses::FunctionAnalyses (
+  Function &F
+  ) : F{F}
+    , fingerprint{computeFingerprint(F)}
+    , TLII{new TargetLibraryInfoImpl(Triple(F.getParent()->getTargetTriple()))}
+    , TLI{new TargetLibraryInfo(*TLII)}
+    , AC{new AssumptionCache(F)}
+    , ownsTLIAndAC{true}
+    , DT{nullptr}
+    , PDT{nullptr}
+    , LI{nullptr}
+    , SE{nullptr}
+    , DS{nullptr}
+  {
+  return ;
+}
+
+Function & FunctionAnalyses::getFunction (void) const {
+  return this->F;
+}
+
+bool FunctionAnalyses::hasFunctionChanged (void) const {
+  return computeFingerprint(this->F) != this->fingerprint;
+}
+
+bool FunctionAnalyses::areAnalysesComputed (void) const {
+  return this->SE != nullptr;
+}
+
+DominatorSummary & FunctionAnalyses::getDominators (void) {
+  if (!this->areAnalysesComputed()){
+    this->computeAnalyses();
+  }
+
+  return *this->DS;
+}
+
+ScalarEvolution & FunctionAnalyses::getScalarEvolution (void) {
+  if (!this->areAnalysesComputed()){
+    this->computeAnalyses();
+  }
+
+  return *this->SE;
+}
+
+void FunctionAnalyses::computeAnalyses (void){
+
+  /*
+   * The analyses are computed from the current code of the function.
+   * Hence, the function must not have been transformed since "this" has been created; otherwise, the analyses would not describe the code the loops of "this" have been analyzed on.
+   */
+  if (this->hasFunctionChanged()){
+    errs() << "FunctionAnalyses: Error = the analyses of the function " << this->F.getName() << " have been requested after the function has been transformed\n";
+    abort();
+  }
+
+  /*
+   * Compute the analyses.
+   */
+  this->DT = new DominatorTree(this->F);
+  this->PDT = new PostDominatorTree(this->F);
+  this->LI = new LoopInfo(*this->DT);
+  this->SE = new ScalarEvolution(this->F, *this->TLI, *this->AC, *this->DT, *this->LI);
+  this->DS = new DominatorSummary(*this->DT, *this->PDT);
+
+  return ;
+}
+
+hash_code FunctionAnalyses::computeFingerprint (Function &F){
+
+  /*
+   * Combine the basic blocks and the instructions of @F in their order.
+   * Adding, removing, or moving an instruction or a basic block changes the fingerprint.
+   */
+  hash_code fingerprint = hash_value(F.size());
+  for (auto &bb : F){
+    fingerprint = hash_combine(fingerprint, &bb);
+    for (auto &inst : bb){
+      fingerprint = hash_combine(fingerprint, &inst, inst.getNumOperands());
+    }
+  }
+
+  return fingerprint;
+}
+
+FunctionAnalyses::~FunctionAnalyses (){
+
+  /*
+   * Free the analyses in the reverse order of their dependences.
+   */
+  delete this->DS;
+  delete this->SE;
+  delete this->LI;
+  delete this->PDT;
+  delete this->DT;
+
+  if (this->ownsTLIAndAC){
+    delete this->AC;
+    delete this->TLI;
+    delete this->TLII;
+  }
+
+  return ;
+}
+
+}
@@ -15,8 +15,23 @@
 #include "noelle/core/LoopDependenceInfo.hpp"
 #include "LoopAwareMemDepAnalysis.hpp"
 
+#include <chrono>
+
 namespace llvm::noelle {
 
+template <class Analysis>
+Analysis LoopDependenceInfo::measureAnalysis (const std::string &name, std::function<Analysis (void)> computeAnalysis){
+  auto start = std::chrono::steady_clock::now();
+  auto analysis = computeAnalysis();
+  auto end = std::chrono::steady_clock::now();
+
+  auto &time = this->timeOfAnalyses[name];
+  time.invocations++;
+  time.seconds += std::chrono::duration<double>(end - start).count();
+
+  return analysis;
+}
+
 LoopDependenceInfo::LoopDependenceInfo (
   PDG *fG,
   Loop *l,
@@ -74,11 +89,37 @@ LoopDependenceInfo::LoopDependenceInfo(
   bool enableFloatAsReal,
   std::unordered_set<LoopDependenceInfoOptimization> optimizations,
   bool enableLoopAwareDependenceAnalyses
+) : LoopDependenceInfo{fG, l, DS, SE, maxCores, enableFloatAsReal, optimizations, enableLoopAwareDependenceAnalyses, nullptr} {
+
+  return ;
+}
+
+LoopDependenceInfo::LoopDependenceInfo(
+  PDG *fG,
+  Loop *l,
+  DominatorSummary &DS,
+  ScalarEvolution &SE,
+  uint32_t maxCores,
+  bool enableFloatAsReal,
+  std::unordered_set<LoopDependenceInfoOptimization> optimizations,
+  bool enableLoopAwareDependenceAnalyses,
+  std::shared_ptr<FunctionAnalyses> functionAnalyses
 ) : DOALLChunkSize{8},
+    DOALLIterationSchedule{DOALL_AUTO_SCHEDULE_ID},
     maximumNumberOfCoresForTheParallelization{maxCores},
     liSummary{l},
     enabledOptimizations{optimizations},
-    areLoopAwareAnalysesEnabled{enableLoopAwareDependenceAnalyses}
+    areLoopAwareAnalysesEnabled{enableLoopAwareDependenceAnalyses},
+    enableFloatAsReal{enableFloatAsReal},
+    inductionVariables{nullptr},
+    invariantManager{nullptr},
+    loopGoverningIVAttribution{nullptr},
+    domainSpaceAnalysis{nullptr},
+    memoryCloningAnalysis{nullptr},
+    sccdagAttrs{nullptr},
+    loopSCCDAG{nullptr},
+    isLoopGoverningIVAttributionComputed{false},
+    functionAnalyses{functionAnalyses}
   {
 
   /*
@@ -93,15 +134,24 @@ LoopDependenceInfo::LoopDependenceInfo(
    */
   this->enableAllTransformations();
 
+  /*
+   * Use analyses of the function of the loop that are not shared with other loops if none have been given.
+   */
+  if (this->functionAnalyses == nullptr){
+    this->functionAnalyses = std::make_shared<FunctionAnalyses>(*l->getHeader()->getParent());
+  }
+
   /*
    * Fetch the loop dependence graph (i.e., the subset of the PDG that relates to the loop @l) and its SCCDAG.
    */
   this->fetchLoopAndBBInfo(l, SE);
   auto ls = this->getLoopStructure();
   auto loopExitBlocks = ls->getLoopExitBasicBlocks();
-  auto DGs = this->createDGsForLoop(l, fG, DS, SE);
+  auto DGs = measureAnalysis<std::pair<PDG *, SCCDAG *>>("Loop dependence graph", [&]() {
+    return this->createDGsForLoop(l, fG, DS, SE);
+  });
   this->loopDG = DGs.first;
-  auto loopSCCDAG = DGs.second;
+  this->loopSCCDAG = DGs.second;
 
   /*
    * Create the environment for the loop.
@@ -109,44 +159,136 @@ LoopDependenceInfo::LoopDependenceInfo(
   this->environment = new LoopEnvironment(loopDG, loopExitBlocks);
 
   /*
-   * Create the invariant manager.
-   *
-   * This step identifies instructions that are loop invariants.
+   * The invariants, the induction variables, and the attributes of the SCCs are computed when they are requested.
+   */
+
+  return ;
+}
+
+FunctionAnalyses & LoopDependenceInfo::getFunctionAnalyses (void){
+
+  /*
+   * The loop must not have been transformed since "this" has been created (see functionAnalyses).
+   * Analyzing the transformed code would silently produce results that do not match the dependence graph of the loop.
+   */
+  if (this->hasLoopChanged()){
+    auto ls = this->getLoopStructure();
+    errs() << "LoopDependenceInfo: Error = the analyses of the loop " << this->getID() << " of the function " << ls->getFunction()->getName() << " have been requested after the loop has been transformed\n";
+    abort();
+  }
+
+  /*
+   * Compute the analyses of the function if no other loop of the function has requested them yet.
+   */
+  auto &analyses = *this->functionAnalyses;
+  if (!analyses.areAnalysesComputed()){
+    measureAnalysis<ScalarEvolution *>("Function analyses", [&analyses]() {
+      return &analyses.getScalarEvolution();
+    });
+  }
+
+  return analyses;
+}
+
+bool LoopDependenceInfo::hasLoopChanged (void) const {
+
+  /*
+   * Every instruction of the loop must be an internal node of the dependence graph of the loop, and vice versa.
+   */
+  auto ls = this->getLoopStructure();
+  uint64_t numberOfInstructions = 0;
+  for (auto bb : ls->getBasicBlocks()){
+    for (auto &inst : *bb){
+      if (!this->loopDG->isInternal(&inst)){
+        return true;
+      }
+      numberOfInstructions++;
+    }
+  }
+  if (numberOfInstructions != this->loopDG->numInternalNodes()){
+    return true;
+  }
+
+  return false;
+}
+
+void LoopDependenceInfo::computeInvariantManager (void){
+
+  /*
+   * Identify the instructions that are loop invariants.
    */
   auto topLoop = this->liSummary.getLoopNestingTreeRoot();
-  this->invariantManager = new InvariantManager(topLoop, this->loopDG);
+  this->invariantManager = measureAnalysis<InvariantManager *>("Invariants", [this, topLoop]() {
+    return new InvariantManager(topLoop, this->loopDG);
+  });
+
+  return ;
+}
+
+void LoopDependenceInfo::computeInductionVariableManager (void){
+  auto invManager = this->getInvariantManager();
+  auto &SE = this->getFunctionAnalyses().getScalarEvolution();
 
   /*
-   * Create the induction variable manager.
-   *
-   * This step identifies IVs.
+   * Identify the IVs.
    *
    * First, we need to compute the LDG that doesn't include memory dependences.
    * Memory dependences don't matter for the IV detection.
    * Then, we compute the SCCDAG of this sub-LDG.
    * And then, we can identify IVs from this new SCCDAG.
    */
-  auto loopSCCDAGWithoutMemoryDeps = this->computeSCCDAGWithOnlyVariableAndControlDependences(loopDG);
-  this->inductionVariables = new InductionVariableManager(liSummary, *invariantManager, SE, *loopSCCDAGWithoutMemoryDeps, *environment);
+  this->inductionVariables = measureAnalysis<InductionVariableManager *>("Induction variables", [&]() {
+    auto loopSCCDAGWithoutMemoryDeps = this->computeSCCDAGWithOnlyVariableAndControlDependences(this->loopDG);
+    return new InductionVariableManager(this->liSummary, *invManager, SE, *loopSCCDAGWithoutMemoryDeps, *this->environment);
+  });
+
+  return ;
+}
+
+void LoopDependenceInfo::computeSCCManager (void){
+  auto ivManager = this->getInductionVariableManager();
+  auto &analyses = this->getFunctionAnalyses();
 
   /*
    * Calculate various attributes on SCCs
    */
-  this->sccdagAttrs = new SCCDAGAttrs(enableFloatAsReal, loopDG, loopSCCDAG, this->liSummary, SE, *inductionVariables, DS);
-  this->domainSpaceAnalysis = new LoopIterationDomainSpaceAnalysis(liSummary, *this->inductionVariables, SE);
+  this->sccdagAttrs = measureAnalysis<SCCDAGAttrs *>("SCC attributes", [&]() {
+    return new SCCDAGAttrs(this->enableFloatAsReal, this->loopDG, this->loopSCCDAG, this->liSummary, analyses.getScalarEvolution(), *ivManager, analyses.getDominators());
+  });
+
+  return ;
+}
+
+void LoopDependenceInfo::computeLoopIterationDomainSpaceAnalysis (void){
+  auto ivManager = this->getInductionVariableManager();
+  auto &SE = this->getFunctionAnalyses().getScalarEvolution();
+
+  this->domainSpaceAnalysis = measureAnalysis<LoopIterationDomainSpaceAnalysis *>("Loop iteration domain space", [&]() {
+    return new LoopIterationDomainSpaceAnalysis(this->liSummary, *ivManager, SE);
+  });
+
+  return ;
+}
+
+void LoopDependenceInfo::computeLoopGoverningIVAttribution (void){
+  auto ivManager = this->getInductionVariableManager();
 
   /*
    * Collect induction variable information
    */
-  auto iv = this->inductionVariables->getLoopGoverningInductionVariable(*liSummary.getLoop(*l->getHeader()));
-  loopGoverningIVAttribution = iv == nullptr ? nullptr
-    : new LoopGoverningIVAttribution(*iv, *loopSCCDAG->sccOfValue(iv->getLoopEntryPHI()), loopExitBlocks);
+  auto ls = this->getLoopStructure();
+  auto loopExitBlocks = ls->getLoopExitBasicBlocks();
+  auto iv = ivManager->getLoopGoverningInductionVariable(*ls);
+  this->loopGoverningIVAttribution = iv == nullptr ? nullptr
+    : new LoopGoverningIVAttribution(*iv, *this->loopSCCDAG->sccOfValue(iv->getLoopEntryPHI()), loopExitBlocks);
+  this->isLoopGoverningIVAttributionComputed = true;
 
   return ;
 }
 
 void LoopDependenceInfo::copyParallelizationOptionsFrom (LoopDependenceInfo *otherLDI) {
   this->DOALLChunkSize = otherLDI->DOALLChunkSize;
+  this->DOALLIterationSchedule = otherLDI->DOALLIterationSchedule;
   this->enabledTransformations = otherLDI->enabledTransformations;
   this->maximumNumberOfCoresForTheParallelization = otherLDI->maximumNumberOfCoresForTheParallelization;
   this->areLoopAwareAnalysesEnabled = otherLDI->areLoopAwareAnalysesEnabled;
@@ -516,14 +658,20 @@ LoopStructure * LoopDependenceInfo::getNestedMostLoopStructure (Instruction *I)
 }
 
 bool LoopDependenceInfo::isSCCContainedInSubloop (SCC *scc) const {
-  return this->sccdagAttrs->isSCCContainedInSubloop(this->liSummary, scc);
+  return this->getSCCManager()->isSCCContainedInSubloop(this->liSummary, scc);
 }
 
 InductionVariableManager * LoopDependenceInfo::getInductionVariableManager (void) const {
+  if (this->inductionVariables == nullptr){
+    const_cast<LoopDependenceInfo *>(this)->computeInductionVariableManager();
+  }
   return inductionVariables;
 }
 
 LoopGoverningIVAttribution * LoopDependenceInfo::getLoopGoverningIVAttribution (void) const {
+  if (!this->isLoopGoverningIVAttributionComputed){
+    const_cast<LoopDependenceInfo *>(this)->computeLoopGoverningIVAttribution();
+  }
   return loopGoverningIVAttribution;
 }
 
@@ -546,10 +694,16 @@ uint32_t LoopDependenceInfo::getMaximumNumberOfCores (void) const {
 }
 
 InvariantManager * LoopDependenceInfo::getInvariantManager (void) const {
+  if (this->invariantManager == nullptr){
+    const_cast<LoopDependenceInfo *>(this)->computeInvariantManager();
+  }
   return this->invariantManager;
 }
 
 LoopIterationDomainSpaceAnalysis * LoopDependenceInfo::getLoopIterationDomainSpaceAnalysis (void) const {
+  if (this->domainSpaceAnalysis == nullptr){
+    const_cast<LoopDependenceInfo *>(this)->computeLoopIterationDomainSpaceAnalysis();
+  }
   return this->domainSpaceAnalysis;
 }
 
@@ -558,6 +712,9 @@ const LoopsSummary & LoopDependenceInfo::getLoopHierarchyStructures (void) const
 }
 
 SCCDAGAttrs * LoopDependenceInfo::getSCCManager (void) const {
+  if (this->sccdagAttrs == nullptr){
+    const_cast<LoopDependenceInfo *>(this)->computeSCCManager();
+  }
   return this->sccdagAttrs;
 }
       
@@ -610,13 +767,30 @@ LoopDependenceInfo::~LoopDependenceInfo() {
   if (this->loopGoverningIVAttribution){
     delete this->loopGoverningIVAttribution;
   }
+  if (this->invariantManager){
+    delete this->invariantManager;
+  }
+  if (this->domainSpaceAnalysis){
+    delete this->domainSpaceAnalysis;
+  }
 
-  assert(this->invariantManager);
-  delete this->invariantManager;
+  /*
+   * The SCCDAG of the loop is referenced by the attributes of its SCCs, if they have been computed.
+   */
+  if (this->sccdagAttrs == nullptr){
+    delete this->loopSCCDAG;
+  }
 
-  delete this->domainSpaceAnalysis;
+  /*
+   * The SCEVs of the analyses above belong to the scalar evolution of the function.
+   * This is released after them, when "this" drops its share of the analyses of the function.
+   */
 
   return ;
 }
 
+const std::map<std::string, LoopDependenceInfo::AnalysisTime> & LoopDependenceInfo::getTimeSpentInAnalyses (void) const {
+  return this->timeOfAnalyses;
+}
+
 }
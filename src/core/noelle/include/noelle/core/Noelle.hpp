@@ -23,6 +23,7 @@
 #include "noelle/core/FunctionsManager.hpp"
 #include "noelle/core/TypesManager.hpp"
 #include "noelle/core/CompilationOptionsManager.hpp"
+#include "noelle/core/MachineCostModel.hpp"
 
 namespace llvm::noelle {
 
@@ -52,6 +53,11 @@ namespace llvm::noelle {
       FunctionsManager * getFunctionsManager (void) ;
 
       CompilationOptionsManager * getCompilationOptionsManager (void) ;
+
+      /*
+       * Return the latencies of the current machine (see -noelle-cost-table).
+       */
+      MachineCostModel * getMachineCostModel (void) ;
       
       TypesManager * getTypesManager (void) ;
 
@@ -184,8 +190,29 @@ namespace llvm::noelle {
         std::vector<BasicBlock *> &loopExitBlocks
         );
 
+      /*
+       * Link several transformed versions of the same loop.
+       * @startOfParLoopInOriginalFunc selects the version to run and jumps to its entry point.
+       * The i-th version exits through @endsOfParLoopInOriginalFunc[i] with the exit block taken stored in @envArrays[i].
+       */
+      void linkTransformedLoopToOriginalFunction (
+        Module *module,
+        BasicBlock *originalPreHeader,
+        BasicBlock *startOfParLoopInOriginalFunc,
+        std::vector<BasicBlock *> &endsOfParLoopInOriginalFunc,
+        std::vector<Value *> &envArrays,
+        Value *envIndexForExitVariable,
+        std::vector<BasicBlock *> &loopExitBlocks
+        );
+
       bool verifyCode (void) const ;
 
+      /*
+       * Drop the analyses of @f shared by its loops.
+       * This must be invoked after transforming @f: loops created from now on will use analyses of the new code of @f.
+       */
+      void invalidateFunctionAnalyses (Function *f) ;
+
       ~Noelle();
 
     private:
@@ -204,11 +231,14 @@ namespace llvm::noelle {
       std::vector<uint32_t> loopThreads;
       std::vector<uint32_t> techniquesToDisable;
       std::vector<uint32_t> DOALLChunkSize;
+      std::vector<uint32_t> DOALLSchedules;
       std::unordered_map<BasicBlock *, uint32_t> loopHeaderToLoopIndexMap;
       FunctionsManager *fm;
       TypesManager *tm;
       CompilationOptionsManager *om;
       MetadataManager *mm;
+      MachineCostModel *costModel;
+      std::unordered_map<Function *, std::shared_ptr<FunctionAnalyses>> functionAnalyses;
 
       uint32_t fetchTheNextValue (
         std::stringstream &stream
@@ -216,6 +246,8 @@ namespace llvm::noelle {
 
       bool checkToGetLoopFilteringInfo (void) ;
 
+      std::shared_ptr<FunctionAnalyses> getFunctionAnalyses (Function *f) ;
+
       LoopDependenceInfo * getLoopDependenceInfoForLoop (
         Loop *loop,
         PDG *functionPDG,
@@ -223,6 +255,7 @@ namespace llvm::noelle {
         ScalarEvolution *SE,
         uint32_t techniquesToDisable,
         uint32_t DOALLChunkSize,
+        uint32_t DOALLScheduleForLoop,
         uint32_t maxCores,
         std::unordered_set<LoopDependenceInfoOptimization> optimizations
       );
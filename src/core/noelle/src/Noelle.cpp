@@ -28,6 +28,7 @@ Noelle::Noelle()
   , tm{nullptr}
   , om{nullptr}
   , mm{nullptr}
+  , costModel{nullptr}
 {
   return ;
 }
@@ -109,6 +110,31 @@ void Noelle::linkTransformedLoopToOriginalFunction (
     Value *envIndexForExitVariable,
     std::vector<BasicBlock *> &loopExitBlocks
     ){
+  std::vector<BasicBlock *> endsOfParLoopInOriginalFunc{ endOfParLoopInOriginalFunc };
+  std::vector<Value *> envArrays{ envArray };
+  this->linkTransformedLoopToOriginalFunction(
+      module,
+      originalPreHeader,
+      startOfParLoopInOriginalFunc,
+      endsOfParLoopInOriginalFunc,
+      envArrays,
+      envIndexForExitVariable,
+      loopExitBlocks
+      );
+
+  return ;
+}
+
+void Noelle::linkTransformedLoopToOriginalFunction (
+    Module *module,
+    BasicBlock *originalPreHeader,
+    BasicBlock *startOfParLoopInOriginalFunc,
+    std::vector<BasicBlock *> &endsOfParLoopInOriginalFunc,
+    std::vector<Value *> &envArrays,
+    Value *envIndexForExitVariable,
+    std::vector<BasicBlock *> &loopExitBlocks
+    ){
+  assert(endsOfParLoopInOriginalFunc.size() == envArrays.size());
 
   /*
    * Create the global variable for the parallelized loop.
@@ -140,66 +166,70 @@ void Noelle::linkTransformedLoopToOriginalFunction (
       );
   originalTerminator->eraseFromParent();
 
-  IRBuilder<> endBuilder(endOfParLoopInOriginalFunc);
-
-  /*
-   * Load exit block environment variable and branch to the correct loop exit block
-   */
-  if (loopExitBlocks.size() == 1) {
-    endBuilder.CreateBr(loopExitBlocks[0]);
-  } else {
+  for (auto versionIndex = 0u; versionIndex < endsOfParLoopInOriginalFunc.size(); ++versionIndex) {
+    auto endOfParLoopInOriginalFunc = endsOfParLoopInOriginalFunc[versionIndex];
+    auto envArray = envArrays[versionIndex];
+    IRBuilder<> endBuilder(endOfParLoopInOriginalFunc);
 
     /*
-     * Compute how many values can fit in a cache line.
+     * Load exit block environment variable and branch to the correct loop exit block
      */
-    auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
-
-    auto exitEnvPtr = endBuilder.CreateInBoundsGEP(
-        envArray,
-        ArrayRef<Value*>({
-          cast<Value>(ConstantInt::get(int64, 0)),
-          endBuilder.CreateMul(envIndexForExitVariable, ConstantInt::get(int64, valuesInCacheLine))
-          })
-        );
-    auto exitEnvCast = endBuilder.CreateIntCast(endBuilder.CreateLoad(exitEnvPtr), int32, /*isSigned=*/false);
-    auto exitSwitch = endBuilder.CreateSwitch(exitEnvCast, loopExitBlocks[0]);
-    for (int i = 1; i < loopExitBlocks.size(); ++i) {
-      exitSwitch->addCase(ConstantInt::get(int32, i), loopExitBlocks[i]);
+    if (loopExitBlocks.size() == 1) {
+      endBuilder.CreateBr(loopExitBlocks[0]);
+    } else {
+
+      /*
+       * Compute how many values can fit in a cache line.
+       */
+      auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
+
+      auto exitEnvPtr = endBuilder.CreateInBoundsGEP(
+          envArray,
+          ArrayRef<Value*>({
+            cast<Value>(ConstantInt::get(int64, 0)),
+            endBuilder.CreateMul(envIndexForExitVariable, ConstantInt::get(int64, valuesInCacheLine))
+            })
+          );
+      auto exitEnvCast = endBuilder.CreateIntCast(endBuilder.CreateLoad(exitEnvPtr), int32, /*isSigned=*/false);
+      auto exitSwitch = endBuilder.CreateSwitch(exitEnvCast, loopExitBlocks[0]);
+      for (int i = 1; i < loopExitBlocks.size(); ++i) {
+        exitSwitch->addCase(ConstantInt::get(int32, i), loopExitBlocks[i]);
+      }
     }
-  }
 
-  /*
-   * NOTE(angelo): LCSSA constants need to be replicated for parallelized code path
-   */
-  for (auto bb : loopExitBlocks) {
-    for (auto &I : *bb) {
-      if (auto phi = dyn_cast<PHINode>(&I)) {
-        auto bbIndex = phi->getBasicBlockIndex(originalHeader);
-        if (bbIndex == -1) {
+    /*
+     * NOTE(angelo): LCSSA constants need to be replicated for parallelized code path
+     */
+    for (auto bb : loopExitBlocks) {
+      for (auto &I : *bb) {
+        if (auto phi = dyn_cast<PHINode>(&I)) {
+          auto bbIndex = phi->getBasicBlockIndex(originalHeader);
+          if (bbIndex == -1) {
+            continue;
+          }
+          auto val = phi->getIncomingValue(bbIndex);
+          if (isa<Constant>(val)) {
+            phi->addIncoming(val, endOfParLoopInOriginalFunc);
+          }
           continue;
         }
-        auto val = phi->getIncomingValue(bbIndex);
-        if (isa<Constant>(val)) {
-          phi->addIncoming(val, endOfParLoopInOriginalFunc);
-        }
-        continue;
+        break;
       }
-      break;
     }
-  }
 
-  /*
-   * Set/Reset global variable so only one invocation of the loop is run in parallel at a time.
-   */
-  if (startOfParLoopInOriginalFunc == endOfParLoopInOriginalFunc) {
-    endBuilder.SetInsertPoint(&*endOfParLoopInOriginalFunc->begin());
-    endBuilder.CreateStore(const1, globalBool);
-  } else {
-    IRBuilder<> startBuilder(&*startOfParLoopInOriginalFunc->begin());
-    startBuilder.CreateStore(const1, globalBool);
+    /*
+     * Set/Reset global variable so only one invocation of the loop is run in parallel at a time.
+     */
+    if (startOfParLoopInOriginalFunc == endOfParLoopInOriginalFunc) {
+      endBuilder.SetInsertPoint(&*endOfParLoopInOriginalFunc->begin());
+      endBuilder.CreateStore(const1, globalBool);
+    } else if (versionIndex == 0) {
+      IRBuilder<> startBuilder(&*startOfParLoopInOriginalFunc->begin());
+      startBuilder.CreateStore(const1, globalBool);
+    }
+    endBuilder.SetInsertPoint(endOfParLoopInOriginalFunc->getTerminator());
+    endBuilder.CreateStore(const0, globalBool);
   }
-  endBuilder.SetInsertPoint(endOfParLoopInOriginalFunc->getTerminator());
-  endBuilder.CreateStore(const0, globalBool);
 
   return ;
 }
@@ -303,6 +333,11 @@ CompilationOptionsManager * Noelle::getCompilationOptionsManager (void) {
   return this->om;
 }
 
+MachineCostModel * Noelle::getMachineCostModel (void) {
+  assert(this->costModel != nullptr);
+  return this->costModel;
+}
+
 MetadataManager * Noelle::getMetadataManager (void) {
   if (!this->mm){
     this->mm = new MetadataManager(*this->getProgram());
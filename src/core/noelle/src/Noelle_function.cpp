@@ -28,6 +28,38 @@ DominatorSummary * Noelle::getDominators (Function *f) {
 
   return ds;
 }
+
+std::shared_ptr<FunctionAnalyses> Noelle::getFunctionAnalyses (Function *f) {
+
+  /*
+   * Share the analyses of @f between its loops until @f is transformed (see invalidateFunctionAnalyses).
+   * Loops created before the transformation keep their analyses.
+   * Code transformed without invalidating the analyses (e.g., by LLVM utilities invoked by a custom pass) is caught when its number of instructions changes.
+   */
+  auto analysesIt = this->functionAnalyses.find(f);
+  if (  true
+        && (analysesIt != this->functionAnalyses.end())
+        && (!analysesIt->second->hasFunctionChanged())
+     ){
+    return analysesIt->second;
+  }
+
+  /*
+   * Create the analyses of @f with the target library information and the assumptions of the pass.
+   */
+  auto& TLI = getAnalysis<TargetLibraryInfoWrapperPass>().getTLI();
+  auto& AC = getAnalysis<AssumptionCacheTracker>().getAssumptionCache(*f);
+  auto analyses = std::make_shared<FunctionAnalyses>(*f, TLI, AC);
+  this->functionAnalyses[f] = analyses;
+
+  return analyses;
+}
+
+void Noelle::invalidateFunctionAnalyses (Function *f) {
+  this->functionAnalyses.erase(f);
+
+  return ;
+}
       
 FunctionsManager * Noelle::getFunctionsManager (void) {
   if (!this->fm){
@@ -238,7 +238,7 @@ LoopDependenceInfo * Noelle::getLoop (
    * Check of loopIndex provided is within bounds
    */
   if (this->loopHeaderToLoopIndexMap.find(header) == this->loopHeaderToLoopIndexMap.end()){
-    auto ldi = new LoopDependenceInfo(funcPDG, llvmLoop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, optimizations, this->loopAwareDependenceAnalysis);
+    auto ldi = new LoopDependenceInfo(funcPDG, llvmLoop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, optimizations, this->loopAwareDependenceAnalysis, this->getFunctionAnalyses(function));
 
     delete DS;
     return ldi;
@@ -253,7 +253,7 @@ LoopDependenceInfo * Noelle::getLoop (
    * No filter file was provided. Construct LDI without profiler configurables
    */
   if (!this->hasReadFilterFile) {
-    auto ldi = new LoopDependenceInfo(funcPDG, llvmLoop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, optimizations, this->loopAwareDependenceAnalysis);
+    auto ldi = new LoopDependenceInfo(funcPDG, llvmLoop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, optimizations, this->loopAwareDependenceAnalysis, this->getFunctionAnalyses(function));
 
     delete DS;
     return ldi;
@@ -279,6 +279,7 @@ LoopDependenceInfo * Noelle::getLoop (
       &SE,
       this->techniquesToDisable[loopIndex],
       this->DOALLChunkSize[loopIndex],
+      this->DOALLSchedules[loopIndex],
       maximumNumberOfCoresForTheParallelization,
       optimizations
       );
@@ -367,7 +368,7 @@ std::vector<LoopDependenceInfo *> * Noelle::getLoops (
     for(auto edge : funcPDG->getEdges()) {
       assert(!edge->isLoopCarriedDependence() && "Flag set");
     }
-    auto ldi = new LoopDependenceInfo(funcPDG, loop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, this->loopAwareDependenceAnalysis);
+    auto ldi = new LoopDependenceInfo(funcPDG, loop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, {}, this->loopAwareDependenceAnalysis, this->getFunctionAnalyses(function));
     allLoops->push_back(ldi);
   }
 
@@ -490,7 +491,7 @@ std::vector<LoopDependenceInfo *> * Noelle::getLoops (
         /*
          * Allocate the loop wrapper.
          */
-        auto ldi = new LoopDependenceInfo(funcPDG, loop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, this->loopAwareDependenceAnalysis);
+        auto ldi = new LoopDependenceInfo(funcPDG, loop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, {}, this->loopAwareDependenceAnalysis, this->getFunctionAnalyses(function));
 
         allLoops->push_back(ldi);
         continue ;
@@ -529,6 +530,7 @@ std::vector<LoopDependenceInfo *> * Noelle::getLoops (
           &SE,
           this->techniquesToDisable[currentLoopIndex],
           this->DOALLChunkSize[currentLoopIndex],
+          this->DOALLSchedules[currentLoopIndex],
           maximumNumberOfCoresForTheParallelization,
           {}
           );
@@ -699,6 +701,24 @@ bool Noelle::checkToGetLoopFilteringInfo (void) {
   auto fileAsString = indexBuf.get()->getBuffer().str();
   std::stringstream indexString{fileAsString};
 
+  /*
+   * Check the version of the file.
+   *
+   * Files that start with "v2" have a tenth field per loop: the schedule of the iterations of DOALL.
+   * Files without a version have nine fields per loop and they let DOALL choose the schedule.
+   */
+  auto hasDOALLSchedules = false;
+  indexString >> std::ws;
+  if (indexString.peek() == 'v'){
+    std::string version;
+    indexString >> version;
+    if (version != "v2"){
+      errs() << "ERROR: the 'INDEX_FILE' file isn't correct. Its version \"" << version << "\" is not supported\n";
+      abort();
+    }
+    hasDOALLSchedules = true;
+  }
+
   /*
    * Parse the file
    */
@@ -751,6 +771,22 @@ bool Noelle::checkToGetLoopFilteringInfo (void) {
     this->fetchTheNextValue(indexString);
     this->fetchTheNextValue(indexString);
 
+    /*
+     * DOALL: schedule of the iterations
+     * 0: Chosen by DOALL
+     * 1: Static
+     * 2: Dynamic
+     * 3: Guided
+     */
+    uint32_t DOALLSchedule = DOALL_AUTO_SCHEDULE_ID;
+    if (hasDOALLSchedules){
+      DOALLSchedule = this->fetchTheNextValue(indexString);
+      if (DOALLSchedule > DOALL_GUIDED_SCHEDULE_ID){
+        errs() << "ERROR: the 'INDEX_FILE' file isn't correct. The DOALL schedule " << DOALLSchedule << " does not exist\n";
+        abort();
+      }
+    }
+
     /*
      * If the loop needs to be parallelized, then we enable it.
      */
@@ -759,11 +795,13 @@ bool Noelle::checkToGetLoopFilteringInfo (void) {
       this->loopThreads.push_back(cores);
       this->techniquesToDisable.push_back(technique);
       this->DOALLChunkSize.push_back(DOALLChunkFactor);
+      this->DOALLSchedules.push_back(DOALLSchedule);
 
     } else{
       this->loopThreads.push_back(1);
       this->techniquesToDisable.push_back(0);
       this->DOALLChunkSize.push_back(0);
+      this->DOALLSchedules.push_back(DOALL_AUTO_SCHEDULE_ID);
     }
   }
 
@@ -909,6 +947,7 @@ LoopDependenceInfo * Noelle::getLoopDependenceInfoForLoop (
     ScalarEvolution *SE,
     uint32_t techniquesToDisableForLoop,
     uint32_t DOALLChunkSizeForLoop,
+    uint32_t DOALLScheduleForLoop,
     uint32_t maxCores,
     std::unordered_set<LoopDependenceInfoOptimization> optimizations
     ) {
@@ -924,7 +963,8 @@ LoopDependenceInfo * Noelle::getLoopDependenceInfoForLoop (
       maxCores,
       this->enableFloatAsReal, 
       optimizations, 
-      this->loopAwareDependenceAnalysis);
+      this->loopAwareDependenceAnalysis,
+      this->getFunctionAnalyses(loop->getHeader()->getParent()));
 
   /*
    * Set the loop constraints specified by INDEX_FILE.
@@ -932,6 +972,7 @@ LoopDependenceInfo * Noelle::getLoopDependenceInfoForLoop (
    * DOALL chunk size is the one defined by INDEX_FILE + 1. This is because chunk size must start from 1.
    */
   ldi->DOALLChunkSize = DOALLChunkSizeForLoop + 1;
+  ldi->DOALLIterationSchedule = static_cast<DOALLSchedule>(DOALLScheduleForLoop);
 
   /*
    * Set the techniques that are enabled.
@@ -28,6 +28,7 @@ static cl::opt<bool> DisableWhilifier("noelle-disable-whilifier", cl::ZeroOrMore
 static cl::opt<bool> DisableSCEVSimplification("noelle-disable-scev-simplification", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable IV related SCEV simplification"));
 static cl::opt<bool> DisableLoopAwareDependenceAnalyses("noelle-disable-loop-aware-dependence-analyses", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable loop aware dependence analyses"));
 static cl::opt<bool> DisableInliner("noelle-disable-inliner", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable the function inliner"));
+static cl::opt<std::string> CostTable("noelle-cost-table", cl::ZeroOrMore, cl::Hidden, cl::desc("Cost table of the machine generated by noelle-calibrate"));
 static cl::opt<bool> InlinerDisableHoistToMain("noelle-inliner-avoid-hoist-to-main", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable the function inliner"));
 
 bool Noelle::doInitialization (Module &M) {
@@ -89,6 +90,13 @@ bool Noelle::doInitialization (Module &M) {
    * Allocate the managers.
    */
   this->om = new CompilationOptionsManager(M, optMaxCores);
+  this->costModel = new MachineCostModel();
+  if (CostTable.getNumOccurrences() > 0){
+    if (!this->costModel->loadCostTable(CostTable.getValue())){
+      errs() << "Noelle: ERROR = cannot read the cost table " << CostTable.getValue() << "\n";
+      abort();
+    }
+  }
 
   /*
    * Store the module.
@@ -107,6 +115,7 @@ bool Noelle::doInitialization (Module &M) {
 void Noelle::getAnalysisUsage(AnalysisUsage &AU) const {
   AU.addRequired<LoopInfoWrapperPass>();
   AU.addRequired<AssumptionCacheTracker>();
+  AU.addRequired<TargetLibraryInfoWrapperPass>();
   AU.addRequired<DominatorTreeWrapperPass>();
   AU.addRequired<PostDominatorTreeWrapperPass>();
   AU.addRequired<ScalarEvolutionWrapperPass>();
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2016 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "noelle/core/SystemHeaders.hpp"
+
+namespace llvm::noelle {
+
+/*
+ * Memoization of the queries sent to an alias analysis while computing the dependences of a function.
+ *
+ * Many pairs of memory instructions access the same locations, and the same pair is queried once per direction by the data-flow walk.
+ * Alias queries are symmetric, so their two locations are stored in a canonical order.
+ * Mod/ref queries are not symmetric, so they are stored as they are asked.
+ */
+class AliasQueryCache {
+  public:
+    AliasQueryCache ();
+
+    AliasResult alias (const MemoryLocation &loc1, const MemoryLocation &loc2, function_ref<AliasResult (void)> query);
+
+    ModRefInfo getModRefInfo (const CallBase *call, const MemoryLocation &loc, function_ref<ModRefInfo (void)> query);
+
+    ModRefInfo getModRefInfo (const CallBase *call1, const CallBase *call2, function_ref<ModRefInfo (void)> query);
+
+    /*
+     * Forget the results of the queries.
+     * The counters of hits and misses are preserved.
+     */
+    void clear (void);
+
+    uint64_t getNumberOfHits (void) const ;
+
+    uint64_t getNumberOfMisses (void) const ;
+
+  private:
+    DenseMap<std::pair<MemoryLocation, MemoryLocation>, AliasResult> aliasResults;
+    DenseMap<std::pair<const CallBase *, MemoryLocation>, ModRefInfo> callLocationResults;
+    DenseMap<std::pair<const CallBase *, const CallBase *>, ModRefInfo> callCallResults;
+    uint64_t hits;
+    uint64_t misses;
+
+    template <class Key, class Result>
+    Result lookup (DenseMap<Key, Result> &results, const Key &key, function_ref<Result (void)> query);
+};
+
+}
@@ -12,6 +12,9 @@
 
 #include "llvm/IR/Instructions.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/STLExtras.h"
 #include <climits>
 #include <unordered_map>
 #include <queue>
@@ -34,39 +37,52 @@ namespace llvm::noelle {
 
   enum DataDependenceType { DG_DATA_NONE, DG_DATA_RAW, DG_DATA_WAR, DG_DATA_WAW };
 
+  /*
+   * Predicate that skips the slots of removed nodes and edges while iterating over the dense storage of a graph.
+   */
+  struct DGLiveSlot {
+    template <class E>
+    bool operator() (E *element) const { return element != nullptr; }
+  };
+
   template <class T>
   class DG {
     public:
-      DG () : nodeIdCounter{0} {}
+      DG () : nodeIdCounter{0}, edgeIdCounter{0}, numberOfLiveNodes{0}, numberOfLiveEdges{0} {}
 
-      typedef typename std::set<DGNode<T> *>::iterator nodes_iterator;
-      typedef typename std::set<DGNode<T> *>::const_iterator nodes_const_iterator;
+      /*
+       * Nodes and edges are stored in arrays indexed by their ID.
+       * The slot of a removed node (or edge) is set to nullptr and it is skipped by the iterators.
+       * Hence, nodes and edges can be removed while iterating over the graph, but they cannot be added.
+       */
+      typedef llvm::filter_iterator<typename std::vector<DGNode<T> *>::iterator, DGLiveSlot> nodes_iterator;
+      typedef llvm::filter_iterator<typename std::vector<DGNode<T> *>::const_iterator, DGLiveSlot> nodes_const_iterator;
 
-      typedef typename std::set<DGEdge<T> *>::iterator edges_iterator;
-      typedef typename std::set<DGEdge<T> *>::const_iterator edges_const_iterator;
+      typedef llvm::filter_iterator<typename std::vector<DGEdge<T> *>::iterator, DGLiveSlot> edges_iterator;
+      typedef llvm::filter_iterator<typename std::vector<DGEdge<T> *>::const_iterator, DGLiveSlot> edges_const_iterator;
 
-      typedef typename std::map<T *, DGNode<T> *>::iterator node_map_iterator;
+      typedef typename DenseMap<T *, DGNode<T> *>::iterator node_map_iterator;
 
       /*
        * Node and Edge Iterators
        */
       nodes_iterator begin_nodes() {
-        auto n = allNodes.begin();
+        auto n = nodes_iterator(allNodes.begin(), allNodes.end(), DGLiveSlot());
         return n;
       }
 
       nodes_iterator end_nodes() {
-        auto n = allNodes.end();
+        auto n = nodes_iterator(allNodes.end(), allNodes.end(), DGLiveSlot());
         return n;
       }
 
       nodes_const_iterator begin_nodes() const {
-        auto n = allNodes.begin();
+        auto n = nodes_const_iterator(allNodes.begin(), allNodes.end(), DGLiveSlot());
         return n;
       }
 
       nodes_const_iterator end_nodes() const {
-        auto n = allNodes.end();
+        auto n = nodes_const_iterator(allNodes.end(), allNodes.end(), DGLiveSlot());
         return n;
       }
 
@@ -91,22 +107,22 @@ namespace llvm::noelle {
       }
 
       edges_iterator begin_edges() {
-        auto e = allEdges.begin();
+        auto e = edges_iterator(allEdges.begin(), allEdges.end(), DGLiveSlot());
         return e;
       }
 
       edges_iterator end_edges() {
-        auto e = allEdges.end();
+        auto e = edges_iterator(allEdges.end(), allEdges.end(), DGLiveSlot());
         return e;
       }
 
       edges_const_iterator begin_edges() const {
-        auto e = allEdges.begin();
+        auto e = edges_const_iterator(allEdges.begin(), allEdges.end(), DGLiveSlot());
         return e;
       }
 
       edges_const_iterator end_edges() const {
-        auto e = allEdges.end();
+        auto e = edges_const_iterator(allEdges.end(), allEdges.end(), DGLiveSlot());
         return e;
       }
 
@@ -120,18 +136,18 @@ namespace llvm::noelle {
       bool isExternal(T *theT) const { return externalNodeMap.find(theT) != externalNodeMap.end(); }
       bool isInGraph(T *theT) const { return isInternal(theT) || isExternal(theT); }
 
-      unsigned numNodes() const { return allNodes.size(); }
+      unsigned numNodes() const { return numberOfLiveNodes; }
       unsigned numInternalNodes() const { return internalNodeMap.size(); }
       unsigned numExternalNodes() const { return externalNodeMap.size(); }
-      unsigned numEdges() const { return allEdges.size(); }
+      unsigned numEdges() const { return numberOfLiveEdges; }
 
       /*
        * Iterator ranges
        */
       iterator_range<nodes_iterator>
-      getNodes() { return make_range(allNodes.begin(), allNodes.end()); }
+      getNodes() { return make_range(begin_nodes(), end_nodes()); }
       iterator_range<edges_iterator>
-      getEdges() { return make_range(allEdges.begin(), allEdges.end()); }
+      getEdges() { return make_range(begin_edges(), end_edges()); }
 
       iterator_range<node_map_iterator>
       internalNodePairs() { return make_range(internalNodeMap.begin(), internalNodeMap.end()); }
@@ -167,11 +183,19 @@ namespace llvm::noelle {
 
     protected:
       int32_t nodeIdCounter;
-      std::set<DGNode<T> *> allNodes;
-      std::set<DGEdge<T> *> allEdges;
+      int32_t edgeIdCounter;
+      uint32_t numberOfLiveNodes;
+      uint32_t numberOfLiveEdges;
+      std::vector<DGNode<T> *> allNodes;
+      std::vector<DGEdge<T> *> allEdges;
       DGNode<T> *entryNode;
-      std::map<T *, DGNode<T> *> internalNodeMap;
-      std::map<T *, DGNode<T> *> externalNodeMap;
+      DenseMap<T *, DGNode<T> *> internalNodeMap;
+      DenseMap<T *, DGNode<T> *> externalNodeMap;
+
+    private:
+      void addEdgeToStorage(DGEdge<T> *edge);
+      void compactNodes();
+      void compactEdges();
   };
 
   template <class T>
@@ -179,8 +203,8 @@ namespace llvm::noelle {
   {
     public:
       typedef typename std::vector<DGNode<T> *>::iterator nodes_iterator;
-      typedef typename std::unordered_set<DGEdge<T> *>::iterator edges_iterator;
-      typedef typename std::unordered_set<DGEdge<T> *>::const_iterator edges_const_iterator;
+      typedef typename SmallVector<DGEdge<T> *, 4>::iterator edges_iterator;
+      typedef typename SmallVector<DGEdge<T> *, 4>::const_iterator edges_const_iterator;
 
       edges_iterator begin_outgoing_edges() { return outgoingEdges.begin(); }
       edges_iterator end_outgoing_edges() { return outgoingEdges.end(); }
@@ -223,8 +247,8 @@ namespace llvm::noelle {
 
       int32_t ID;
       T *theT;
-      std::unordered_set<DGEdge<T> *> outgoingEdges;
-      std::unordered_set<DGEdge<T> *> incomingEdges;
+      SmallVector<DGEdge<T> *, 4> outgoingEdges;
+      SmallVector<DGEdge<T> *, 4> incomingEdges;
 
     friend class DG<T>;
   };
@@ -242,7 +266,7 @@ namespace llvm::noelle {
   {
    public:
      DGEdgeBase(DGNode<T> *src, DGNode<T> *dst)
-         : from(src), to(dst), memory(false), must(false),
+         : ID(-1), from(src), to(dst), memory(false), must(false),
            dataDepType(DG_DATA_NONE), isControl(false), isLoopCarried(false),
            isRemovable(false), remeds(nullptr) {}
      DGEdgeBase(const DGEdgeBase<T, SubT> &oldEdge);
@@ -343,6 +367,7 @@ namespace llvm::noelle {
     }
 
    protected:
+    int32_t ID;
     DGNode<T> *from;
     DGNode<T> *to;
     std::unordered_set<DGEdge<SubT> *> subEdges;
@@ -357,6 +382,8 @@ namespace llvm::noelle {
     DataDependenceType dataDepType;
 
     SetOfRemedies_ptr remeds;
+
+    friend class DG<T>;
   };
 
   /*
@@ -364,8 +391,16 @@ namespace llvm::noelle {
    */
   template <class T>
   DGNode<T> *DG<T>::addNode(T *theT, bool inclusion) {
+
+    /*
+     * Reclaim the slots of the removed nodes once they dominate the storage.
+     * This is done here rather than when removing nodes so that removals never move the other nodes while a user iterates over the graph.
+     */
+    this->compactNodes();
+
     auto node = new DGNode<T>(nodeIdCounter++, theT);
-    allNodes.insert(node);
+    allNodes.push_back(node);
+    numberOfLiveNodes++;
     auto &map = inclusion ? internalNodeMap : externalNodeMap;
     map[theT] = node;
     return node;
@@ -382,7 +417,10 @@ namespace llvm::noelle {
   DGNode<T> *DG<T>::fetchNode(T *theT)
   {
     auto nodeI = internalNodeMap.find(theT);
-    return (nodeI != internalNodeMap.end()) ? nodeI->second : externalNodeMap[theT];
+    if (nodeI != internalNodeMap.end()) {
+      return nodeI->second;
+    }
+    return externalNodeMap.lookup(theT);
   }
 
   template <class T> const DGNode<T> *DG<T>::fetchConstNode(T *theT) const {
@@ -398,7 +436,7 @@ namespace llvm::noelle {
     auto fromNode = fetchNode(from);
     auto toNode = fetchNode(to);
     auto edge = new DGEdge<T>(fromNode, toNode);
-    allEdges.insert(edge);
+    this->addEdgeToStorage(edge);
     fromNode->addOutgoingEdge(edge);
     toNode->addIncomingEdge(edge);
     return edge;
@@ -421,7 +459,7 @@ namespace llvm::noelle {
   DGEdge<T> *DG<T>::copyAddEdge(DGEdge<T> &edgeToCopy)
   {
     auto edge = new DGEdge<T>(edgeToCopy);
-    allEdges.insert(edge);
+    this->addEdgeToStorage(edge);
 
     /*
      * Point copy of edge to equivalent nodes in this graph
@@ -436,6 +474,16 @@ namespace llvm::noelle {
     return edge;
   }
 
+  template <class T>
+  void DG<T>::addEdgeToStorage(DGEdge<T> *edge)
+  {
+    this->compactEdges();
+
+    edge->ID = edgeIdCounter++;
+    allEdges.push_back(edge);
+    numberOfLiveEdges++;
+  }
+
   template <class T>
   std::unordered_set<DGNode<T> *> DG<T>::getTopLevelNodes(bool onlyInternal)
   {
@@ -445,7 +493,7 @@ namespace llvm::noelle {
      * Add all nodes that have no incoming nodes
      * Exclude self, and external nodes if onlyInternal = true
      */
-    for (auto node : allNodes)
+    for (auto node : getNodes())
     {
       if (onlyInternal && isExternal(node->getT())) continue;
 
@@ -467,7 +515,7 @@ namespace llvm::noelle {
   {
     std::unordered_set<DGNode<T> *> leafNodes;
     if (onlyInternal) {
-      for (auto selfNode : allNodes) {
+      for (auto selfNode : getNodes()) {
         bool noChildNode = true;
         for (auto edge : selfNode->getOutgoingEdges()) {
           noChildNode &= (edge->getIncomingNode() == selfNode);
@@ -494,7 +542,7 @@ namespace llvm::noelle {
     std::vector<std::unordered_set<DGNode<T> *> *> connectedComponents;
     std::unordered_set<DGNode<T> *> visitedNodes;
 
-    for (auto node : allNodes)
+    for (auto node : getNodes())
     {
       if (visitedNodes.find(node) != visitedNodes.end()) continue;
 
@@ -584,7 +632,9 @@ namespace llvm::noelle {
     auto theT = node->getT();
     auto &map = isInternal(theT) ? internalNodeMap : externalNodeMap;
     map.erase(theT);
-    allNodes.erase(node);
+    assert(allNodes[node->ID] == node);
+    allNodes[node->ID] = nullptr;
+    numberOfLiveNodes--;
 
     /*
      * Collect edges to operate on before doing deletes
@@ -603,7 +653,9 @@ namespace llvm::noelle {
     for (auto edge : outgoingFromNode) edge->getIncomingNode()->removeConnectedNode(node);
     for (auto edge : allToAndFromNode)
     {
-      allEdges.erase(edge);
+      assert(allEdges[edge->ID] == edge);
+      allEdges[edge->ID] = nullptr;
+      numberOfLiveEdges--;
       delete edge;
     }
 
@@ -615,10 +667,62 @@ namespace llvm::noelle {
   {
     edge->getOutgoingNode()->removeConnectedEdge(edge);
     edge->getIncomingNode()->removeConnectedEdge(edge);
-    allEdges.erase(edge);
+    assert(allEdges[edge->ID] == edge);
+    allEdges[edge->ID] = nullptr;
+    numberOfLiveEdges--;
     delete edge;
   }
 
+  template <class T>
+  void DG<T>::compactNodes()
+  {
+    auto numberOfRemovedNodes = allNodes.size() - numberOfLiveNodes;
+    if (  false
+          || (numberOfRemovedNodes < 64)
+          || (numberOfRemovedNodes < numberOfLiveNodes)
+       ){
+      return ;
+    }
+
+    /*
+     * Move the live nodes to the front while preserving their order, and renumber them.
+     */
+    int32_t nextID = 0;
+    for (auto node : allNodes) {
+      if (node == nullptr) continue;
+      node->ID = nextID;
+      allNodes[nextID] = node;
+      nextID++;
+    }
+    allNodes.resize(nextID);
+    nodeIdCounter = nextID;
+  }
+
+  template <class T>
+  void DG<T>::compactEdges()
+  {
+    auto numberOfRemovedEdges = allEdges.size() - numberOfLiveEdges;
+    if (  false
+          || (numberOfRemovedEdges < 64)
+          || (numberOfRemovedEdges < numberOfLiveEdges)
+       ){
+      return ;
+    }
+
+    /*
+     * Move the live edges to the front while preserving their order, and renumber them.
+     */
+    int32_t nextID = 0;
+    for (auto edge : allEdges) {
+      if (edge == nullptr) continue;
+      edge->ID = nextID;
+      allEdges[nextID] = edge;
+      nextID++;
+    }
+    allEdges.resize(nextID);
+    edgeIdCounter = nextID;
+  }
+
   template <class T>
   void DG<T>::copyNodesIntoNewGraph (
       DG<T> &newGraph, 
@@ -651,6 +755,10 @@ namespace llvm::noelle {
   {
     allNodes.clear();
     allEdges.clear();
+    nodeIdCounter = 0;
+    edgeIdCounter = 0;
+    numberOfLiveNodes = 0;
+    numberOfLiveEdges = 0;
     entryNode = nullptr;
     internalNodeMap.clear();
     externalNodeMap.clear();
@@ -659,13 +767,13 @@ namespace llvm::noelle {
   template <class T>
   raw_ostream & DG<T>::print(raw_ostream &stream)
   {
-    stream << "Total node count: " << allNodes.size() << "\n";
+    stream << "Total node count: " << numNodes() << "\n";
     stream << "Internal node count: " << internalNodeMap.size() << "\n";
     for (auto pair : internalNodePairs()) pair.second->print(stream) << "\n";
     stream << "External node count: " << externalNodeMap.size() << "\n";
     for (auto pair : externalNodePairs()) pair.second->print(stream) << "\n";
-    stream << "Edge count: " << allEdges.size() << "\n";
-    for (auto edge : allEdges) edge->print(stream) << "\n";
+    stream << "Edge count: " << numEdges() << "\n";
+    for (auto edge : getEdges()) edge->print(stream) << "\n";
     return stream;
   }
 
@@ -675,55 +783,42 @@ namespace llvm::noelle {
   template <class T>
   void DGNode<T>::addIncomingEdge(DGEdge<T> *edge)
   {
-    incomingEdges.insert(edge);
+    incomingEdges.push_back(edge);
     auto node = edge->getOutgoingNode();
   }
 
   template <class T>
   void DGNode<T>::addOutgoingEdge(DGEdge<T> *edge)
   {
-    outgoingEdges.insert(edge);
+    outgoingEdges.push_back(edge);
     auto node = edge->getIncomingNode();
   }
 
   template <class T>
   void DGNode<T>::removeConnectedEdge(DGEdge<T> *edge)
   {
-    DGNode<T> *node;
-    if (outgoingEdges.find(edge) != outgoingEdges.end())
-    {
-      outgoingEdges.erase(edge);
-      node = edge->getIncomingNode();
-    }
-    else
-    {
-      incomingEdges.erase(edge);
-      node = edge->getOutgoingNode();
+    /*
+     * The order of the adjacent edges is not meaningful, so the removed edge is replaced by the last one.
+     */
+    auto removeFrom = [edge](SmallVector<DGEdge<T> *, 4> &edges) -> bool {
+      auto edgeI = std::find(edges.begin(), edges.end(), edge);
+      if (edgeI == edges.end()) {
+        return false;
+      }
+      *edgeI = edges.back();
+      edges.pop_back();
+      return true;
+    };
+    if (!removeFrom(outgoingEdges)) {
+      removeFrom(incomingEdges);
     }
   }
 
   template <class T>
   void DGNode<T>::removeConnectedNode(DGNode<T> *node)
   {
-    std::unordered_set<DGEdge<T> *> outgoingEdgesToRemove{};
-    for (auto edge : outgoingEdges) {
-      if (edge->getIncomingNode() == node) {
-        outgoingEdgesToRemove.insert(edge);
-      }
-    }
-    for (auto edge : outgoingEdgesToRemove) {
-      outgoingEdges.erase(edge);
-    }
-
-    std::unordered_set<DGEdge<T> *> incomingEdgesToRemove{};
-    for (auto edge : incomingEdges) {
-      if (edge->getOutgoingNode() == node) {
-        incomingEdgesToRemove.insert(edge);
-      }
-    }
-    for (auto edge : incomingEdgesToRemove) {
-      incomingEdges.erase(edge);
-    }
+    llvm::erase_if(outgoingEdges, [node](DGEdge<T> *edge) { return edge->getIncomingNode() == node; });
+    llvm::erase_if(incomingEdges, [node](DGEdge<T> *edge) { return edge->getOutgoingNode() == node; });
   }
 
   template <class T>
@@ -759,6 +854,7 @@ namespace llvm::noelle {
   template <class T, class SubT>
   DGEdgeBase<T, SubT>::DGEdgeBase(const DGEdgeBase<T, SubT> &oldEdge)
   {
+    ID = -1;
     auto nodePair = oldEdge.getNodePair();
     from = nodePair.first;
     to = nodePair.second;
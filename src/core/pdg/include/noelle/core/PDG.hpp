@@ -108,6 +108,18 @@ namespace llvm::noelle {
         Value *to
         );
 
+      /*
+       * Remove the nodes of @param values together with their dependences.
+       * The values are never dereferenced, so they can already be erased from the IR.
+       */
+      void removeValues (std::unordered_set<Value *> const &values) ;
+
+      /*
+       * Remove all dependences that have one of @param values as source or destination.
+       * The nodes of the values are kept.
+       */
+      void removeDependencesOf (std::vector<Value *> const &values) ;
+
       /*
        * Creating Program Dependence Subgraphs
        */
@@ -10,6 +10,8 @@
  */
 #pragma once
 
+#include "llvm/IR/ModuleSlotTracker.h"
+
 #include "noelle/core/SystemHeaders.hpp"
 #include "noelle/core/TalkDown.hpp"
 #include "noelle/core/AllocAA.hpp"
@@ -19,6 +21,9 @@
 #include "noelle/core/CallGraph.hpp"
 
 namespace llvm::noelle {
+  class PDGCache;
+  class AliasQueryCache;
+
   enum class PDGVerbosity { Disabled, Minimal, Maximal, MaximalAndPDG };
 
   class PDGAnalysis : public ModulePass {
@@ -43,14 +48,77 @@ namespace llvm::noelle {
 
       noelle::CallGraph * getProgramCallGraph (void);
 
+      /*
+       * Incremental update of the dependences.
+       *
+       * A transformation notifies the functions (or the instructions) it is about to modify before changing the IR, the functions it has created after creating them, and the functions it is about to erase before erasing them.
+       * updatePDG then replaces the nodes and the dependences of the notified functions only, leaving the rest of the PDG untouched.
+       * A function notified as modified that the transformation ends up not changing can be dropped with notifyFunctionUnmodified.
+       * Function DGs returned before the update remain valid but describe the old code.
+       *
+       * Precision: SVF analyzes the code only once, before any transformation.
+       * Hence, the first update stops querying SVF and computes again the dependences of all functions, not only the notified ones.
+       * From then on, the PDG (either updated or built from scratch) has the dependences the LLVM alias analyses cannot disprove, which can be more than the ones found with SVF.
+       */
+      void notifyFunctionModified (Function &F);
+
+      void notifyFunctionUnmodified (Function &F);
+
+      void notifyFunctionCreated (Function &F);
+
+      void notifyFunctionErased (Function &F);
+
+      void notifyInstructionCreated (Instruction *inst);
+
+      void notifyInstructionDeleted (Instruction *inst);
+
+      void notifyInstructionMoved (Instruction *inst);
+
+      void updatePDG (void);
+
       static bool isTheLibraryFunctionPure (Function *libraryFunction);
 
       static bool isTheLibraryFunctionThreadSafe (Function *libraryFunction);
 
+      /*
+       * Return true if the dependences of @F have been loaded from the cache of dependences (see -noelle-pdg-cache).
+       */
+      bool areDependencesOfFunctionFromCache (Function &F) const ;
+
+      /*
+       * Return the number of queries to the LLVM alias analyses that have been answered by their memoization while computing the memory dependences.
+       */
+      uint64_t getNumberOfMemoizedAliasQueries (void) const ;
+
+      /*
+       * Set the number of threads used to build the PDGs from now on (see -noelle-pdg-threads).
+       * The dependences computed do not depend on the number of threads.
+       */
+      void setNumberOfThreads (uint32_t numberOfThreads) ;
+
     private:
       Module *M;
       PDG *programDependenceGraph;
       std::unordered_map<Function *, PDG *> functionToFDGMap;
+      std::vector<PDG *> retiredFunctionDGs;
+      std::unordered_map<Function *, std::unordered_set<Value *>> valuesOfModifiedFunctions;
+      std::unordered_set<Instruction *> movedInstructions;
+      std::string cacheFileName;
+      PDGCache *dependenceCache;
+      std::unordered_map<Function *, uint64_t> structuralHashes;
+      std::unordered_map<Function *, std::set<Function *>> calleesOfFunctions;
+      std::unordered_map<Function *, std::set<GlobalVariable *>> globalsOfFunctions;
+      std::unordered_map<GlobalVariable *, uint64_t> hashesOfGlobals;
+      std::unordered_map<Function *, uint32_t> calleeClosureOfFunctions;
+      std::vector<uint64_t> calleeClosureHashes;
+      std::vector<std::set<GlobalVariable *>> calleeClosureGlobals;
+      std::vector<Function *> addressTakenFunctions;
+      bool areAddressTakenFunctionsCollected;
+      uint64_t moduleContextHash;
+      std::unordered_set<Function *> functionsLoadedFromCache;
+      std::unordered_set<Function *> functionsWithDependencesFromCache;
+      AliasQueryCache *aliasQueriesOfLLVM;
+      AliasQueryCache *aliasQueriesOfSVF;
       AllocAA *allocAA;
       std::set<Function *> CGUnderMain;
       TalkDown *talkdown;
@@ -62,6 +130,7 @@ namespace llvm::noelle {
       bool disableSVF;
       bool disableAllocAA;
       bool disableRA;
+      uint32_t numberOfThreads;
       PDGPrinter printer;
       noelle::CallGraph *noelleCG;
 
@@ -99,6 +168,27 @@ namespace llvm::noelle {
 
       void trimDGUsingCustomAliasAnalysis (PDG *pdg);
 
+      /*
+       * Keys of the cache of dependences.
+       *
+       * The IR is printed with the slot tracker of the PDG under construction, which numbers the module once for all the keys.
+       */
+      void invalidateStructuralHashes (void);
+      uint64_t getStructuralHash (Function &F, ModuleSlotTracker &slotTracker);
+      uint64_t getHashOfGlobal (GlobalVariable &global, ModuleSlotTracker &slotTracker);
+      const std::set<Function *> & getCalleesOfFunction (Function &F);
+      const std::set<GlobalVariable *> & getGlobalsOfFunction (Function &F);
+      const std::vector<Function *> & getAddressTakenFunctions (void);
+      uint32_t getCalleeClosure (Function &F, ModuleSlotTracker &slotTracker);
+      void addCalleeClosure (std::vector<Function *> &sccOfCallGraph, ModuleSlotTracker &slotTracker);
+      uint64_t getModuleContextHash (void);
+      bool dependencesRelyOnTheUsesOfGlobals (void);
+      uint64_t computeCacheKey (Function &F, bool isPartOfProgramPDG, ModuleSlotTracker &slotTracker);
+      bool fetchDependencesFromCache (PDG *pdg, Function &F, bool isPartOfProgramPDG, ModuleSlotTracker &slotTracker);
+      void storeDependencesInCache (PDG *pdg, Function &F, bool isPartOfProgramPDG, ModuleSlotTracker &slotTracker);
+      void fetchDependencesOfModuleFromCache (PDG *pdg, Module &M, ModuleSlotTracker &slotTracker);
+      void storeDependencesOfModuleInCache (PDG *pdg, Module &M, ModuleSlotTracker &slotTracker);
+
       // TODO: Find a way to extract this into a helper module for all passes in the PDG project
       void collectCGUnderFunctionMain (Module &M);
 
@@ -109,6 +199,15 @@ namespace llvm::noelle {
       void constructEdgesFromControl (PDG *pdg, Module &M);
       void constructEdgesFromAliasesForFunction (PDG *pdg, Function &F);
       void constructEdgesFromControlForFunction (PDG *pdg, Function &F);
+      void constructEdgesFromAliasesForFunction (PDG *pdg, Function &F, DataFlowResult *dfr);
+      void constructEdgesFromAliasesAndControlInParallel (PDG *pdg, Module &M);
+      DataFlowResult * computeReachableMemoryInstructions (Function &F);
+      void printAliasQueryStatistics (void);
+      void computeControlDependencesForFunction (
+        Function &F,
+        PostDominatorTree &postDomTree,
+        std::vector<std::pair<Value *, Value *>> &controlDependences
+      );
 
       void iterateInstForStore(PDG *, Function &, AAResults &, DataFlowResult *, StoreInst *);
       void iterateInstForLoad(PDG *, Function &, AAResults &, DataFlowResult *, LoadInst *);
@@ -121,6 +220,8 @@ namespace llvm::noelle {
       void addEdgeFromFunctionModRef(PDG *, Function &, AAResults &, CallBase *, CallBase *);
 
       void removeEdgesNotUsedByParSchemes (PDG *pdg);
+      bool isEdgeNotUsedByParSchemes (DGEdge<Value> *edge);
+      void updateDependencesOfFunctions (PDG *pdg);
 
       AliasResult doTheyAlias (PDG *pdg, Function &F, AAResults &AA, Value *instI, Value *instJ);
 
@@ -124,6 +124,11 @@ namespace llvm::noelle {
       // SCC nodes to Ids map.
       std::unordered_map<const SCC *, uint32_t> sccIndexes;
 
+      /*
+       * Add a node to the SCCDAG for each strongly connected component of @pdg.
+       */
+      void addSCCsOfDependenceGraph (PDG *pdg);
+
       /*
        * Compute transitive dependences between nodes of the SCCDAG.
        */
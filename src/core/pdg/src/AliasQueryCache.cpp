@@ -0,0 +1,85 @@
+/*
+ * Copyright 2016 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/AliasQueryCache.hpp"
+
+namespace llvm::noelle {
+
+AliasQueryCache::AliasQueryCache ()
+  : hits{0}
+  , misses{0}
+  {
+
+  return ;
+}
+
+template <class Key, class Result>
+Result AliasQueryCache::lookup (DenseMap<Key, Result> &results, const Key &key, function_ref<Result (void)> query){
+
+  /*
+   * Check if the query has already been answered.
+   */
+  auto resultIt = results.find(key);
+  if (resultIt != results.end()){
+    this->hits++;
+    return resultIt->second;
+  }
+
+  /*
+   * Ask the alias analysis.
+   */
+  this->misses++;
+  auto result = query();
+  results.insert(std::make_pair(key, result));
+
+  return result;
+}
+
+AliasResult AliasQueryCache::alias (const MemoryLocation &loc1, const MemoryLocation &loc2, function_ref<AliasResult (void)> query){
+
+  /*
+   * Sort the locations.
+   */
+  auto key = std::make_pair(loc1, loc2);
+  if (  false
+        || (loc2.Ptr < loc1.Ptr)
+        || ((loc2.Ptr == loc1.Ptr) && (loc2.Size.toRaw() < loc1.Size.toRaw()))
+     ){
+    std::swap(key.first, key.second);
+  }
+
+  return this->lookup(this->aliasResults, key, query);
+}
+
+ModRefInfo AliasQueryCache::getModRefInfo (const CallBase *call, const MemoryLocation &loc, function_ref<ModRefInfo (void)> query){
+  return this->lookup(this->callLocationResults, std::make_pair(call, loc), query);
+}
+
+ModRefInfo AliasQueryCache::getModRefInfo (const CallBase *call1, const CallBase *call2, function_ref<ModRefInfo (void)> query){
+  return this->lookup(this->callCallResults, std::make_pair(call1, call2), query);
+}
+
+void AliasQueryCache::clear (void){
+  this->aliasResults.clear();
+  this->callLocationResults.clear();
+  this->callCallResults.clear();
+
+  return ;
+}
+
+uint64_t AliasQueryCache::getNumberOfHits (void) const {
+  return this->hits;
+}
+
+uint64_t AliasQueryCache::getNumberOfMisses (void) const {
+  return this->misses;
+}
+
+}
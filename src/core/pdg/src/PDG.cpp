@@ -113,6 +113,58 @@ DGEdge<Value> * PDG::addEdge (Value *from, Value *to) {
   return this->DG<Value>::addEdge(from, to); 
 }
 
+void PDG::removeValues (std::unordered_set<Value *> const &values) {
+  for (auto value : values) {
+
+    /*
+     * Fetch the node of the value.
+     */
+    auto node = this->fetchNode(value);
+    if (node == nullptr) {
+      continue ;
+    }
+
+    /*
+     * Remove the node and its dependences.
+     */
+    if (node == this->getEntryNode()) {
+      this->setEntryNode(nullptr);
+    }
+    this->removeNode(node);
+  }
+
+  return ;
+}
+
+void PDG::removeDependencesOf (std::vector<Value *> const &values) {
+
+  /*
+   * Collect the dependences first as removing them modifies the adjacency of the nodes.
+   */
+  std::unordered_set<DGEdge<Value> *> dependences;
+  for (auto value : values) {
+    auto node = this->fetchNode(value);
+    if (node == nullptr) {
+      continue ;
+    }
+    for (auto edge : node->getOutgoingEdges()) {
+      dependences.insert(edge);
+    }
+    for (auto edge : node->getIncomingEdges()) {
+      dependences.insert(edge);
+    }
+  }
+
+  /*
+   * Remove the dependences.
+   */
+  for (auto edge : dependences) {
+    this->removeEdge(edge);
+  }
+
+  return ;
+}
+
 PDG * PDG::createFunctionSubgraph(Function &F) {
 
   /*
@@ -174,7 +226,7 @@ void PDG::copyEdgesInto (PDG *newPDG, bool linkToExternal) {
 }
 
 void PDG::copyEdgesInto (PDG *newPDG, bool linkToExternal, std::unordered_set<DGEdge<Value> *> const & edgesToIgnore) {
-  for (auto *oldEdge : allEdges) {
+  for (auto *oldEdge : this->getEdges()) {
     if (edgesToIgnore.find(oldEdge) != edgesToIgnore.end()) {
       continue;
     }
@@ -13,6 +13,8 @@
 #include "noelle/core/PDGPrinter.hpp"
 #include "noelle/core/PDGAnalysis.hpp"
 #include "noelle/core/Utils.hpp"
+#include "PDGCache.hpp"
+#include "noelle/core/AliasQueryCache.hpp"
 
 namespace llvm::noelle {
 
@@ -20,6 +22,11 @@ PDGAnalysis::PDGAnalysis()
   : ModulePass{ID}
     , M{nullptr}
     , programDependenceGraph{nullptr}
+    , dependenceCache{nullptr}
+    , areAddressTakenFunctionsCollected{false}
+    , moduleContextHash{0}
+    , aliasQueriesOfLLVM{new AliasQueryCache()}
+    , aliasQueriesOfSVF{new AliasQueryCache()}
     , CGUnderMain{}
     , dfa{}
     , embedPDG{false}
@@ -28,6 +35,7 @@ PDGAnalysis::PDGAnalysis()
     , disableSVF{false}
     , disableAllocAA{false}
     , disableRA{false}
+    , numberOfThreads{1}
     , printer{}
     , noelleCG{nullptr}
   {
@@ -49,6 +57,19 @@ void PDGAnalysis::releaseMemory () {
   }
   this->functionToFDGMap.clear();
 
+  for (auto fdg : this->retiredFunctionDGs) {
+    delete fdg;
+  }
+  this->retiredFunctionDGs.clear();
+  this->valuesOfModifiedFunctions.clear();
+  this->movedInstructions.clear();
+
+  if (this->dependenceCache) delete this->dependenceCache;
+  this->dependenceCache = nullptr;
+
+  this->invalidateStructuralHashes();
+  this->functionsWithDependencesFromCache.clear();
+
   return ;
 }
 
@@ -226,12 +247,37 @@ PDG * PDGAnalysis::constructPDGFromAnalysis(Module &M) {
 
   auto pdg = new PDG(M);
 
+  /*
+   * The code might have changed since the last time dependences have been computed.
+   */
+  this->invalidateStructuralHashes();
+
+  /*
+   * The keys of the cache of dependences print the IR.
+   * The slot tracker numbers the values of the module once for all of them.
+   */
+  ModuleSlotTracker slotTracker(&M);
+
+  /*
+   * Load the dependences of the functions that did not change since they have been cached.
+   * The analyses below skip these functions.
+   */
+  fetchDependencesOfModuleFromCache(pdg, M, slotTracker);
+
   constructEdgesFromUseDefs(pdg);
-  constructEdgesFromAliases(pdg, M);
-  constructEdgesFromControl(pdg, M);
+  if (this->numberOfThreads > 1){
+    constructEdgesFromAliasesAndControlInParallel(pdg, M);
+  } else {
+    constructEdgesFromAliases(pdg, M);
+    constructEdgesFromControl(pdg, M);
+  }
 
   trimDGUsingCustomAliasAnalysis(pdg);
 
+  storeDependencesOfModuleInCache(pdg, M, slotTracker);
+
+  printAliasQueryStatistics();
+
   return pdg; 
 }
 
@@ -241,9 +287,17 @@ PDG * PDGAnalysis::constructFunctionDGFromAnalysis(Function &F) {
   }
 
   auto pdg = new PDG(F);
+  this->invalidateStructuralHashes();
+  ModuleSlotTracker slotTracker(F.getParent());
+  if (fetchDependencesFromCache(pdg, F, false, slotTracker)) {
+    return pdg;
+  }
   constructEdgesFromUseDefs(pdg);
   constructEdgesFromAliasesForFunction(pdg, F);
   constructEdgesFromControlForFunction(pdg, F);
+  storeDependencesInCache(pdg, F, false, slotTracker);
+
+  printAliasQueryStatistics();
 
   return pdg;
 }
@@ -475,6 +529,17 @@ void PDGAnalysis::constructEdgesFromUseDefs (PDG *pdg){
       continue;
     }
 
+    /*
+     * Skip the values of functions whose dependences have been loaded from the cache.
+     */
+    if (!this->functionsLoadedFromCache.empty()){
+      auto arg = dyn_cast<Argument>(pdgValue);
+      auto F = (arg != nullptr) ? arg->getParent() : cast<Instruction>(pdgValue)->getFunction();
+      if (this->functionsLoadedFromCache.find(F) != this->functionsLoadedFromCache.end()){
+        continue;
+      }
+    }
+
     /*
      * The current definition has uses.
      * Add the uses.
@@ -503,6 +568,7 @@ void PDGAnalysis::constructEdgesFromAliases (PDG *pdg, Module &M){
      * Check if the function has a body.
      */
     if (F.empty()) continue ;
+    if (this->functionsLoadedFromCache.find(&F) != this->functionsLoadedFromCache.end()) continue ;
 
     /*
      * Add the edges to the PDG.
@@ -516,12 +582,27 @@ void PDGAnalysis::constructEdgesFromAliases (PDG *pdg, Module &M){
 void PDGAnalysis::constructEdgesFromAliasesForFunction (PDG *pdg, Function &F){
 
   /*
-   * Fetch the alias analysis.
+   * Run the reachable analysis.
    */
-  auto &AA = getAnalysis<AAResultsWrapperPass>(F).getAAResults();
+  auto dfr = this->computeReachableMemoryInstructions(F);
+
+  /*
+   * Add the memory dependences.
+   */
+  this->constructEdgesFromAliasesForFunction(pdg, F, dfr);
+
+  /*
+   * Free the memory.
+   */
+  delete dfr;
+}
+
+DataFlowResult * PDGAnalysis::computeReachableMemoryInstructions (Function &F){
 
   /*
    * Run the reachable analysis.
+   *
+   * This code must not rely on the pass manager as it can be invoked by worker threads (see PDGAnalysis_parallel.cpp).
    */
   auto onlyMemoryInstructionFilter = [](Instruction *i) -> bool {
     if (isa<LoadInst>(i)){
@@ -537,6 +618,23 @@ void PDGAnalysis::constructEdgesFromAliasesForFunction (PDG *pdg, Function &F){
   };
   auto dfr = this->disableRA ? this->dfa.getFullSets(&F) : this->dfa.runReachableAnalysis(&F, onlyMemoryInstructionFilter);
 
+  return dfr;
+}
+
+void PDGAnalysis::constructEdgesFromAliasesForFunction (PDG *pdg, Function &F, DataFlowResult *dfr){
+  assert(dfr != nullptr);
+
+  /*
+   * Fetch the alias analysis.
+   */
+  auto &AA = getAnalysis<AAResultsWrapperPass>(F).getAAResults();
+
+  /*
+   * Queries are memoized only within a function, which bounds the memory used by their results.
+   */
+  this->aliasQueriesOfLLVM->clear();
+  this->aliasQueriesOfSVF->clear();
+
   for (auto &B : F) {
     for (auto &I : B) {
       if (auto store = dyn_cast<StoreInst>(&I)) {
@@ -549,10 +647,7 @@ void PDGAnalysis::constructEdgesFromAliasesForFunction (PDG *pdg, Function &F){
     }
   }
 
-  /*
-   * Free the memory.
-   */
-  delete dfr;
+  return ;
 }
 
 void PDGAnalysis::iterateInstForCall (PDG *pdg, Function &F, AAResults &AA, DataFlowResult *dfr, CallBase *call) {
@@ -567,7 +662,8 @@ void PDGAnalysis::iterateInstForCall (PDG *pdg, Function &F, AAResults &AA, Data
   /*
    * Identify all dependences with @call.
    */
-  for (auto I : dfr->OUT(call)) {
+  for (auto index : dfr->OUTBits(call).set_bits()) {
+    auto I = dfr->getValueOfIndex(index);
 
     /*
      * Check stores.
@@ -614,23 +710,7 @@ void PDGAnalysis::removeEdgesNotUsedByParSchemes (PDG *pdg) {
    * Collect the edges in the PDG that can be safely removed.
    */
   for (auto edge : pdg->getEdges()) {
-
-    /*
-     * Fetch the source of the dependence.
-     */
-    auto source = edge->getOutgoingT();
-    if (!isa<Instruction>(source)) continue;
-
-    /*
-     * Check if the function of the dependence destiation cannot be reached from main.
-     */
-    auto F = cast<Instruction>(source)->getFunction();
-    if (CGUnderMain.find(F) == CGUnderMain.end()) continue;
-
-    if (  false
-        || edgeIsNotLoopCarriedMemoryDependency(edge)
-        || edgeIsAlongNonMemoryWritingFunctions(edge)
-      ) {
+    if (this->isEdgeNotUsedByParSchemes(edge)) {
       removeEdges.insert(edge);
     }
   }
@@ -645,6 +725,35 @@ void PDGAnalysis::removeEdgesNotUsedByParSchemes (PDG *pdg) {
   return ;
 }
 
+bool PDGAnalysis::isEdgeNotUsedByParSchemes (DGEdge<Value> *edge) {
+
+  /*
+   * Fetch the source of the dependence.
+   */
+  auto source = edge->getOutgoingT();
+  if (!isa<Instruction>(source)) return false;
+
+  /*
+   * Check if the function of the dependence destiation cannot be reached from main.
+   */
+  auto F = cast<Instruction>(source)->getFunction();
+  if (CGUnderMain.find(F) == CGUnderMain.end()) return false;
+
+  /*
+   * Dependences loaded from the cache have already been trimmed.
+   */
+  if (this->functionsLoadedFromCache.find(F) != this->functionsLoadedFromCache.end()) return false;
+
+  if (  false
+      || edgeIsNotLoopCarriedMemoryDependency(edge)
+      || edgeIsAlongNonMemoryWritingFunctions(edge)
+    ) {
+    return true;
+  }
+
+  return false;
+}
+
 // NOTE: Loads between random parts of separate GVs and both edges between GVs should be removed
 bool PDGAnalysis::edgeIsNotLoopCarriedMemoryDependency (DGEdge<Value> *edge) {
 
@@ -936,6 +1045,16 @@ PDGAnalysis::~PDGAnalysis() {
     delete fdg;
   }
   this->functionToFDGMap.clear();
+
+  for (auto fdg : this->retiredFunctionDGs) {
+    delete fdg;
+  }
+
+  if (this->dependenceCache)
+    delete this->dependenceCache;
+
+  delete this->aliasQueriesOfLLVM;
+  delete this->aliasQueriesOfSVF;
 }
 
 // http://www.cplusplus.com/reference/clibrary/ and https://github.com/SVF-tools/SVF/blob/master/lib/Util/ExtAPI.cpp
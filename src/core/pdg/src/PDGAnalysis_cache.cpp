@@ -0,0 +1,547 @@
+/*
+ * Copyright 2016 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "llvm/IR/ModuleSlotTracker.h"
+#include "llvm/Analysis/GlobalsModRef.h"
+#include "llvm/Support/xxhash.h"
+
+#include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/PDGAnalysis.hpp"
+#include "PDGCache.hpp"
+
+namespace llvm::noelle {
+
+/*
+ * Hash the textual IR.
+ * Metadata IDs are numbered module-wide, so they are dropped to keep the hash of a function independent from changes elsewhere in the module.
+ */
+static uint64_t hashIR (const std::string &text){
+  std::string normalizedText;
+  normalizedText.reserve(text.size());
+  for (auto i = 0u; i < text.size(); i++){
+    normalizedText.push_back(text[i]);
+    if (text[i] != '!'){
+      continue ;
+    }
+    while (  true
+             && ((i + 1) < text.size())
+             && isdigit(text[i + 1])
+          ){
+      i++;
+    }
+  }
+
+  return xxHash64(normalizedText);
+}
+
+/*
+ * Collect the global variables referenced by a constant, including those within constant expressions.
+ */
+static void collectGlobalsOfConstant (Constant *c, std::set<GlobalVariable *> &globals){
+  if (auto global = dyn_cast<GlobalVariable>(c)){
+    globals.insert(global);
+    return ;
+  }
+  if (isa<GlobalValue>(c)){
+    return ;
+  }
+  for (auto &op : c->operands()){
+    if (auto opConstant = dyn_cast<Constant>(op)){
+      collectGlobalsOfConstant(opConstant, globals);
+    }
+  }
+
+  return ;
+}
+
+/*
+ * Collect the functions and the global variables whose code refers to a value (e.g., a global).
+ */
+static void collectUsersOf (Value *v, std::set<Function *> &functions, std::set<GlobalVariable *> &globals){
+  for (auto user : v->users()){
+    if (auto inst = dyn_cast<Instruction>(user)){
+      functions.insert(inst->getFunction());
+      continue ;
+    }
+    if (auto global = dyn_cast<GlobalVariable>(user)){
+      if (globals.insert(global).second){
+        collectUsersOf(global, functions, globals);
+      }
+      continue ;
+    }
+    if (  true
+          && isa<Constant>(user)
+          && !isa<GlobalValue>(user)
+       ){
+      collectUsersOf(user, functions, globals);
+    }
+  }
+
+  return ;
+}
+
+static uint64_t hashWords (const std::vector<uint64_t> &words){
+  return xxHash64(ArrayRef<uint8_t>(reinterpret_cast<const uint8_t *>(words.data()), words.size() * sizeof(uint64_t)));
+}
+
+void PDGAnalysis::invalidateStructuralHashes (void){
+  this->structuralHashes.clear();
+  this->calleesOfFunctions.clear();
+  this->globalsOfFunctions.clear();
+  this->hashesOfGlobals.clear();
+  this->calleeClosureOfFunctions.clear();
+  this->calleeClosureHashes.clear();
+  this->calleeClosureGlobals.clear();
+  this->addressTakenFunctions.clear();
+  this->areAddressTakenFunctionsCollected = false;
+  this->moduleContextHash = 0;
+
+  return ;
+}
+
+uint64_t PDGAnalysis::getStructuralHash (Function &F, ModuleSlotTracker &slotTracker){
+  auto hashIt = this->structuralHashes.find(&F);
+  if (hashIt != this->structuralHashes.end()){
+    return hashIt->second;
+  }
+
+  /*
+   * Hash the code of the function, including the attributes of the declarations.
+   */
+  std::string text;
+  raw_string_ostream stream(text);
+  static_cast<Value &>(F).print(stream, slotTracker);
+
+  /*
+   * The alias analyses rely on metadata attached to instructions (e.g., TBAA), whose content is not printed with the function.
+   */
+  for (auto &inst : instructions(F)){
+    SmallVector<std::pair<unsigned, MDNode *>, 4> attachments;
+    inst.getAllMetadataOtherThanDebugLoc(attachments);
+    for (auto &attachment : attachments){
+      attachment.second->printTree(stream, slotTracker, F.getParent());
+    }
+  }
+  stream.flush();
+
+  auto hash = hashIR(text);
+  this->structuralHashes[&F] = hash;
+
+  return hash;
+}
+
+uint64_t PDGAnalysis::getHashOfGlobal (GlobalVariable &global, ModuleSlotTracker &slotTracker){
+  auto hashIt = this->hashesOfGlobals.find(&global);
+  if (hashIt != this->hashesOfGlobals.end()){
+    return hashIt->second;
+  }
+
+  std::string text;
+  raw_string_ostream stream(text);
+  static_cast<Value &>(global).print(stream, slotTracker);
+  stream.flush();
+
+  auto hash = hashIR(text);
+  this->hashesOfGlobals[&global] = hash;
+
+  return hash;
+}
+
+const std::set<Function *> & PDGAnalysis::getCalleesOfFunction (Function &F){
+  auto calleesIt = this->calleesOfFunctions.find(&F);
+  if (calleesIt != this->calleesOfFunctions.end()){
+    return calleesIt->second;
+  }
+
+  /*
+   * Indirect calls are represented by nullptr.
+   */
+  auto &callees = this->calleesOfFunctions[&F];
+  for (auto &inst : instructions(F)){
+    auto call = dyn_cast<CallBase>(&inst);
+    if (call == nullptr){
+      continue ;
+    }
+    callees.insert(call->getCalledFunction());
+  }
+
+  return callees;
+}
+
+const std::set<GlobalVariable *> & PDGAnalysis::getGlobalsOfFunction (Function &F){
+  auto globalsIt = this->globalsOfFunctions.find(&F);
+  if (globalsIt != this->globalsOfFunctions.end()){
+    return globalsIt->second;
+  }
+
+  auto &globals = this->globalsOfFunctions[&F];
+  for (auto &inst : instructions(F)){
+    for (auto &op : inst.operands()){
+      if (auto c = dyn_cast<Constant>(op)){
+        collectGlobalsOfConstant(c, globals);
+      }
+    }
+  }
+
+  return globals;
+}
+
+const std::vector<Function *> & PDGAnalysis::getAddressTakenFunctions (void){
+  if (this->areAddressTakenFunctionsCollected){
+    return this->addressTakenFunctions;
+  }
+
+  /*
+   * An indirect call can reach any function whose address is taken.
+   */
+  for (auto &F : *this->M){
+    if (F.hasAddressTaken()){
+      this->addressTakenFunctions.push_back(&F);
+    }
+  }
+  this->areAddressTakenFunctionsCollected = true;
+
+  return this->addressTakenFunctions;
+}
+
+uint32_t PDGAnalysis::getCalleeClosure (Function &F, ModuleSlotTracker &slotTracker){
+  auto closureIt = this->calleeClosureOfFunctions.find(&F);
+  if (closureIt != this->calleeClosureOfFunctions.end()){
+    return closureIt->second;
+  }
+
+  /*
+   * Identify the SCCs of the call graph reachable from F that have not been identified yet (Tarjan's algorithm).
+   * The call graph is visited without recursion because call chains can be long.
+   * Tarjan's algorithm identifies an SCC only after all SCCs it can reach, so the closures of the callees of an SCC are always available when the SCC is added.
+   */
+  std::unordered_map<Function *, uint32_t> indexes;
+  std::unordered_map<Function *, uint32_t> lowLinks;
+  std::vector<Function *> stack;
+  std::unordered_set<Function *> onStack;
+  std::vector<std::pair<Function *, std::vector<Function *>>> callersToVisit;
+  std::vector<uint32_t> nextCallees;
+  auto visit = [&](Function *function){
+    auto index = static_cast<uint32_t>(indexes.size());
+    indexes[function] = index;
+    lowLinks[function] = index;
+    stack.push_back(function);
+    onStack.insert(function);
+
+    std::vector<Function *> callees;
+    for (auto callee : this->getCalleesOfFunction(*function)){
+      if (callee != nullptr){
+        callees.push_back(callee);
+        continue ;
+      }
+      auto &addressTakenFunctions = this->getAddressTakenFunctions();
+      callees.insert(callees.end(), addressTakenFunctions.begin(), addressTakenFunctions.end());
+    }
+    callersToVisit.push_back(std::make_pair(function, std::move(callees)));
+    nextCallees.push_back(0);
+  };
+  visit(&F);
+  while (!callersToVisit.empty()){
+    auto caller = callersToVisit.back().first;
+    auto &nextCallee = nextCallees.back();
+
+    /*
+     * Visit the next callee of the current function.
+     */
+    if (nextCallee < callersToVisit.back().second.size()){
+      auto callee = callersToVisit.back().second[nextCallee++];
+      if (this->calleeClosureOfFunctions.find(callee) != this->calleeClosureOfFunctions.end()){
+        continue ;
+      }
+      if (indexes.find(callee) == indexes.end()){
+        visit(callee);
+        continue ;
+      }
+      if (onStack.find(callee) != onStack.end()){
+        lowLinks[caller] = std::min(lowLinks[caller], indexes[callee]);
+      }
+      continue ;
+    }
+
+    /*
+     * All the callees of the current function have been visited.
+     */
+    callersToVisit.pop_back();
+    nextCallees.pop_back();
+    if (!callersToVisit.empty()){
+      auto parent = callersToVisit.back().first;
+      lowLinks[parent] = std::min(lowLinks[parent], lowLinks[caller]);
+    }
+    if (lowLinks[caller] != indexes[caller]){
+      continue ;
+    }
+
+    /*
+     * The current function is the root of an SCC.
+     */
+    std::vector<Function *> scc;
+    Function *member = nullptr;
+    do {
+      member = stack.back();
+      stack.pop_back();
+      onStack.erase(member);
+      scc.push_back(member);
+    } while (member != caller);
+    this->addCalleeClosure(scc, slotTracker);
+  }
+
+  return this->calleeClosureOfFunctions.at(&F);
+}
+
+void PDGAnalysis::addCalleeClosure (std::vector<Function *> &sccOfCallGraph, ModuleSlotTracker &slotTracker){
+  auto closureID = static_cast<uint32_t>(this->calleeClosureHashes.size());
+  for (auto function : sccOfCallGraph){
+    this->calleeClosureOfFunctions[function] = closureID;
+  }
+
+  /*
+   * Collect the closures of the callees of the SCC and the global variables accessed by the functions of the SCC.
+   */
+  std::set<uint32_t> calleeClosures;
+  std::set<GlobalVariable *> globals;
+  for (auto function : sccOfCallGraph){
+    for (auto callee : this->getCalleesOfFunction(*function)){
+      if (callee != nullptr){
+        calleeClosures.insert(this->calleeClosureOfFunctions.at(callee));
+        continue ;
+      }
+      for (auto addressTakenFunction : this->getAddressTakenFunctions()){
+        calleeClosures.insert(this->calleeClosureOfFunctions.at(addressTakenFunction));
+      }
+    }
+    auto &globalsOfFunction = this->getGlobalsOfFunction(*function);
+    globals.insert(globalsOfFunction.begin(), globalsOfFunction.end());
+  }
+  calleeClosures.erase(closureID);
+
+  /*
+   * Combine the hashes of the functions of the SCC, of their global variables, and of the closures of their callees.
+   * The hashes of a set are sorted to make the closure independent from the order of the set (pointers).
+   */
+  std::vector<uint64_t> words;
+  auto appendHashes = [&words](std::vector<uint64_t> &hashes){
+    std::sort(hashes.begin(), hashes.end());
+    words.push_back(hashes.size());
+    words.insert(words.end(), hashes.begin(), hashes.end());
+  };
+  std::vector<uint64_t> functionHashes;
+  for (auto function : sccOfCallGraph){
+    functionHashes.push_back(this->getStructuralHash(*function, slotTracker));
+  }
+  appendHashes(functionHashes);
+  std::vector<uint64_t> globalHashes;
+  for (auto global : globals){
+    globalHashes.push_back(this->getHashOfGlobal(*global, slotTracker));
+  }
+  appendHashes(globalHashes);
+  std::vector<uint64_t> calleeHashes;
+  for (auto calleeClosure : calleeClosures){
+    calleeHashes.push_back(this->calleeClosureHashes[calleeClosure]);
+  }
+  appendHashes(calleeHashes);
+  this->calleeClosureHashes.push_back(hashWords(words));
+
+  /*
+   * GlobalsAA needs the global variables accessed by the whole closure (see computeCacheKey).
+   */
+  if (this->dependencesRelyOnTheUsesOfGlobals()){
+    for (auto calleeClosure : calleeClosures){
+      auto &globalsOfCallee = this->calleeClosureGlobals[calleeClosure];
+      globals.insert(globalsOfCallee.begin(), globalsOfCallee.end());
+    }
+  } else {
+    globals.clear();
+  }
+  this->calleeClosureGlobals.push_back(std::move(globals));
+
+  return ;
+}
+
+uint64_t PDGAnalysis::getModuleContextHash (void){
+  if (this->moduleContextHash != 0){
+    return this->moduleContextHash;
+  }
+
+  /*
+   * Hash what the dependences of every function can rely on: the target and the layout of the named types.
+   */
+  std::string text;
+  raw_string_ostream stream(text);
+  stream << this->M->getDataLayoutStr() << "\n" << this->M->getTargetTriple() << "\n";
+  for (auto structType : this->M->getIdentifiedStructTypes()){
+    structType->print(stream, false, false);
+    stream << "\n";
+  }
+  stream.flush();
+  this->moduleContextHash = hashIR(text);
+
+  return this->moduleContextHash;
+}
+
+bool PDGAnalysis::dependencesRelyOnTheUsesOfGlobals (void){
+
+  /*
+   * GlobalsAA decides whether a global variable can be pointed to by the pointers of F by looking at every use of that global in the module.
+   */
+  return this->getAnalysisIfAvailable<GlobalsAAWrapperPass>() != nullptr;
+}
+
+uint64_t PDGAnalysis::computeCacheKey (Function &F, bool isPartOfProgramPDG, ModuleSlotTracker &slotTracker){
+  assert(this->M != nullptr);
+
+  /*
+   * The dependences of F depend on what its callees do, directly or not, and on the global variables they access.
+   * These are summarized by the closure of the SCC of the call graph that includes F, which is shared by the functions of the SCC and reused by their callers.
+   */
+  auto calleeClosure = this->getCalleeClosure(F, slotTracker);
+
+  /*
+   * Collect the other code the dependences of F rely on when the alias analyses are interprocedural.
+   * GlobalsAA looks at every use of the globals accessed by F and its callees to decide whether they escape.
+   * We are also conservative on the pointers F receives: the direct callers of F are included.
+   */
+  std::set<Function *> otherFunctions;
+  std::set<GlobalVariable *> otherGlobals;
+  if (this->dependencesRelyOnTheUsesOfGlobals()){
+    auto &globals = this->calleeClosureGlobals[calleeClosure];
+    auto globalsAndTheirUsers = globals;
+    for (auto global : globals){
+      collectUsersOf(global, otherFunctions, globalsAndTheirUsers);
+    }
+    for (auto global : globalsAndTheirUsers){
+      if (globals.find(global) == globals.end()){
+        otherGlobals.insert(global);
+      }
+    }
+    for (auto user : F.users()){
+      if (auto call = dyn_cast<CallBase>(user)){
+        otherFunctions.insert(call->getFunction());
+      }
+    }
+  }
+
+  /*
+   * Combine the hashes of F, of its callee closure, of the other functions and globals collected above, of the module context, and of the configuration of the dependence analyses.
+   * The hashes of a set are sorted to make the key independent from the order of the set (pointers).
+   */
+  std::vector<uint64_t> words;
+  words.push_back(this->getStructuralHash(F, slotTracker));
+  words.push_back(this->calleeClosureHashes[calleeClosure]);
+  auto appendHashes = [&words](std::vector<uint64_t> &hashes){
+    std::sort(hashes.begin(), hashes.end());
+    words.push_back(hashes.size());
+    words.insert(words.end(), hashes.begin(), hashes.end());
+  };
+  std::vector<uint64_t> otherHashes;
+  for (auto function : otherFunctions){
+    otherHashes.push_back(this->getStructuralHash(*function, slotTracker));
+  }
+  appendHashes(otherHashes);
+  std::vector<uint64_t> globalHashes;
+  for (auto global : otherGlobals){
+    globalHashes.push_back(this->getHashOfGlobal(*global, slotTracker));
+  }
+  appendHashes(globalHashes);
+  words.push_back(this->getModuleContextHash());
+  uint64_t configuration = 0;
+  configuration |= this->disableSVF ? 1 : 0;
+  configuration |= this->disableAllocAA ? 2 : 0;
+  configuration |= this->disableRA ? 4 : 0;
+  configuration |= isPartOfProgramPDG ? 8 : 0;
+  configuration |= (isPartOfProgramPDG && (this->CGUnderMain.find(&F) != this->CGUnderMain.end())) ? 16 : 0;
+  words.push_back(configuration);
+
+  return hashWords(words);
+}
+
+bool PDGAnalysis::areDependencesOfFunctionFromCache (Function &F) const {
+  return this->functionsWithDependencesFromCache.find(&F) != this->functionsWithDependencesFromCache.end();
+}
+
+bool PDGAnalysis::fetchDependencesFromCache (PDG *pdg, Function &F, bool isPartOfProgramPDG, ModuleSlotTracker &slotTracker){
+  if (this->dependenceCache == nullptr){
+    return false;
+  }
+
+  auto key = this->computeCacheKey(F, isPartOfProgramPDG, slotTracker);
+  if (!this->dependenceCache->fetchDependences(key, F, pdg)){
+    return false;
+  }
+  this->functionsWithDependencesFromCache.insert(&F);
+
+  return true;
+}
+
+void PDGAnalysis::storeDependencesInCache (PDG *pdg, Function &F, bool isPartOfProgramPDG, ModuleSlotTracker &slotTracker){
+  if (this->dependenceCache == nullptr){
+    return ;
+  }
+
+  auto key = this->computeCacheKey(F, isPartOfProgramPDG, slotTracker);
+  this->dependenceCache->storeDependences(key, F, pdg);
+
+  return ;
+}
+
+void PDGAnalysis::fetchDependencesOfModuleFromCache (PDG *pdg, Module &M, ModuleSlotTracker &slotTracker){
+  if (this->dependenceCache == nullptr){
+    return ;
+  }
+
+  /*
+   * Whether a function can be reached from main affects how its dependences are trimmed.
+   */
+  this->collectCGUnderFunctionMain(M);
+
+  for (auto &F : M){
+    if (F.empty()){
+      continue ;
+    }
+    if (this->fetchDependencesFromCache(pdg, F, true, slotTracker)){
+      this->functionsLoadedFromCache.insert(&F);
+    }
+  }
+  if (verbose >= PDGVerbosity::Minimal) {
+    errs() << "PDGAnalysis: Dependences of " << this->functionsLoadedFromCache.size() << " functions loaded from the cache\n";
+  }
+
+  return ;
+}
+
+void PDGAnalysis::storeDependencesOfModuleInCache (PDG *pdg, Module &M, ModuleSlotTracker &slotTracker){
+  if (this->dependenceCache == nullptr){
+    return ;
+  }
+
+  for (auto &F : M){
+    if (  false
+          || F.empty()
+          || (this->functionsLoadedFromCache.find(&F) != this->functionsLoadedFromCache.end())
+       ){
+      continue ;
+    }
+    this->storeDependencesInCache(pdg, F, true, slotTracker);
+  }
+  this->functionsLoadedFromCache.clear();
+
+  /*
+   * Write the new dependences right away: the pass manager might never release this pass.
+   */
+  this->dependenceCache->writeToFile();
+
+  return ;
+}
+
+}
@@ -27,6 +27,9 @@ void PDGAnalysis::constructEdgesFromControl (PDG *pdg, Module &M){
     if (F.empty()) {
       continue ;
     }
+    if (this->functionsLoadedFromCache.find(&F) != this->functionsLoadedFromCache.end()) {
+      continue ;
+    }
 
     /*
      * Compute the control dependences of the function based on its post-dominator tree.
@@ -40,17 +43,48 @@ void PDGAnalysis::constructEdgesFromControl (PDG *pdg, Module &M){
 void PDGAnalysis::constructEdgesFromControlForFunction (PDG *pdg, Function &F) {
   assert(pdg != nullptr);
 
+  /*
+   * Fetch the post-dominator tree of the function.
+   */
+  auto &postDomTree = getAnalysis<PostDominatorTreeWrapperPass>(F).getPostDomTree();
+
+  /*
+   * Compute the control dependences.
+   */
+  std::vector<std::pair<Value *, Value *>> controlDependences;
+  this->computeControlDependencesForFunction(F, postDomTree, controlDependences);
+
+  /*
+   * Add the control dependences.
+   */
+  for (auto &dependence : controlDependences) {
+    auto edge = pdg->addEdge(dependence.first, dependence.second);
+    edge->setControl(true);
+  }
+
+  return ;
+}
+
+void PDGAnalysis::computeControlDependencesForFunction (
+  Function &F,
+  PostDominatorTree &postDomTree,
+  std::vector<std::pair<Value *, Value *>> &controlDependences
+  ) {
+
   /*
    * There is a control dependence from a basic block A to a basic block B iff
    * 1) there is E such that E is a successor of A, and 
    * 2) B post-dominates E, and
    * 3) B doesn't strictly post-dominate A
+   *
+   * Dependences are appended to @controlDependences in the order they have to be added to a PDG.
+   * This code must not rely on the pass manager as it can be invoked by worker threads (see PDGAnalysis_parallel.cpp).
    */
-
-  /*
-   * Fetch the post-dominator tree of the function.
-   */
-  auto &postDomTree = getAnalysis<PostDominatorTreeWrapperPass>(F).getPostDomTree();
+  std::unordered_map<Value *, std::unordered_set<Value *>> controlProducersOf;
+  auto addControlDependence = [&controlDependences, &controlProducersOf](Value *from, Value *to) {
+    controlDependences.push_back(std::make_pair(from, to));
+    controlProducersOf[to].insert(from);
+  };
 
   for (auto &B : F) {
 
@@ -108,22 +142,18 @@ void PDGAnalysis::constructEdgesFromControlForFunction (PDG *pdg, Function &F) {
          * Add the control dependences.
          */
         for (auto &I : B) {
-          auto edge = pdg->addEdge((Value*)controlTerminator, (Value*)&I);
-          edge->setControl(true);
+          addControlDependence(controlTerminator, &I);
         }
       }
     }
   }
 
   auto getControlProducers = [&](Value *V) -> std::unordered_set<Value *> {
-    std::unordered_set<Value *> controlProducers;
-    auto node = pdg->fetchNode(V);
-    for (auto edge : node->getIncomingEdges()) {
-      if (!edge->isControlDependence()) continue;
-      auto controlProducer = edge->getOutgoingT();
-      controlProducers.insert(controlProducer);
+    auto producersIt = controlProducersOf.find(V);
+    if (producersIt == controlProducersOf.end()){
+      return {};
     }
-    return controlProducers;
+    return producersIt->second;
   };
 
   /*
@@ -160,8 +190,7 @@ void PDGAnalysis::constructEdgesFromControlForFunction (PDG *pdg, Function &F) {
       for (auto producer : controlProducers) {
         if (currentControlProducersOnPHI.find(producer) != currentControlProducersOnPHI.end()) continue;
 
-        auto edge = pdg->addEdge(producer, &phi);
-        edge->setControl(true);
+        addControlDependence(producer, &phi);
       }
     }
   }
@@ -0,0 +1,347 @@
+/*
+ * Copyright 2016 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/PDGAnalysis.hpp"
+
+namespace llvm::noelle {
+
+void PDGAnalysis::notifyFunctionModified (Function &F){
+
+  /*
+   * Check if the function has already been notified.
+   * If it has, then we already know which values its nodes belong to.
+   */
+  if (this->valuesOfModifiedFunctions.find(&F) != this->valuesOfModifiedFunctions.end()){
+    return ;
+  }
+
+  /*
+   * Remember the values of the function as they are before the transformation.
+   * These are the only values that can have a node in the PDG for this function.
+   */
+  auto &values = this->valuesOfModifiedFunctions[&F];
+  for (auto &arg : F.args()){
+    values.insert(&arg);
+  }
+  for (auto &inst : instructions(F)){
+    values.insert(&inst);
+  }
+
+  return ;
+}
+
+void PDGAnalysis::notifyFunctionUnmodified (Function &F){
+
+  /*
+   * The transformation has not changed @F after all, so its dependences are still correct.
+   */
+  this->valuesOfModifiedFunctions.erase(&F);
+
+  return ;
+}
+
+void PDGAnalysis::notifyFunctionCreated (Function &F){
+
+  /*
+   * A new function has no node in the PDG.
+   * Its values are all the ones it has now, and updatePDG will add their nodes.
+   */
+  this->notifyFunctionModified(F);
+
+  return ;
+}
+
+void PDGAnalysis::notifyFunctionErased (Function &F){
+
+  /*
+   * Collect the values that can have a node in the PDG for @F.
+   * These are the values @F had when it was notified as modified (if it was) and the ones it has now, which are still alive.
+   */
+  std::unordered_set<Value *> values;
+  auto valuesIt = this->valuesOfModifiedFunctions.find(&F);
+  if (valuesIt != this->valuesOfModifiedFunctions.end()){
+    values = std::move(valuesIt->second);
+    this->valuesOfModifiedFunctions.erase(valuesIt);
+  }
+  for (auto &arg : F.args()){
+    values.insert(&arg);
+  }
+  for (auto &inst : instructions(F)){
+    values.insert(&inst);
+  }
+
+  /*
+   * The instructions of @F notified as moved will not exist after @F is erased.
+   */
+  for (auto &inst : instructions(F)){
+    this->movedInstructions.erase(&inst);
+  }
+
+  /*
+   * Retire the function DG of @F.
+   */
+  auto fdgIt = this->functionToFDGMap.find(&F);
+  if (fdgIt != this->functionToFDGMap.end()){
+    this->retiredFunctionDGs.push_back(fdgIt->second);
+    this->functionToFDGMap.erase(fdgIt);
+  }
+
+  /*
+   * Forget what we know about @F.
+   */
+  this->CGUnderMain.erase(&F);
+  this->functionsWithDependencesFromCache.erase(&F);
+  this->invalidateStructuralHashes();
+
+  /*
+   * Remove the nodes of @F, and therefore all its dependences, from the PDG of the module.
+   */
+  if (this->programDependenceGraph != nullptr){
+    this->programDependenceGraph->removeValues(values);
+  }
+
+  return ;
+}
+
+void PDGAnalysis::notifyInstructionCreated (Instruction *inst){
+  assert(inst != nullptr);
+  auto F = inst->getFunction();
+  assert(F != nullptr);
+
+  this->notifyFunctionModified(*F);
+
+  return ;
+}
+
+void PDGAnalysis::notifyInstructionDeleted (Instruction *inst){
+  assert(inst != nullptr);
+  auto F = inst->getFunction();
+  assert(F != nullptr);
+
+  this->notifyFunctionModified(*F);
+
+  return ;
+}
+
+void PDGAnalysis::notifyInstructionMoved (Instruction *inst){
+  assert(inst != nullptr);
+  auto F = inst->getFunction();
+  assert(F != nullptr);
+
+  /*
+   * The function the instruction is moved to is known only after the transformation.
+   */
+  this->notifyFunctionModified(*F);
+  this->movedInstructions.insert(inst);
+
+  return ;
+}
+
+void PDGAnalysis::updatePDG (void){
+
+  /*
+   * Add the functions that received the moved instructions.
+   */
+  for (auto inst : this->movedInstructions){
+    auto F = inst->getFunction();
+    assert(F != nullptr);
+    this->notifyFunctionModified(*F);
+  }
+  this->movedInstructions.clear();
+  if (this->valuesOfModifiedFunctions.empty()){
+    return ;
+  }
+
+  /*
+   * The points-to analysis of SVF has been computed on the code before the transformation, so it no longer describes the program.
+   * From now on, the dependences computed by this pass rely only on the LLVM alias analyses (as with -noelle-disable-pdg-svf).
+   * The dependences of the functions that have not been notified have been computed with SVF, so they are computed again as well.
+   * This keeps the updated PDG identical to the one this pass builds from scratch after the update.
+   */
+  if (!this->disableSVF){
+    if (verbose >= PDGVerbosity::Minimal) {
+      errs() << "PDGAnalysis: The code has changed since SVF analyzed it, so SVF is no longer used\n";
+    }
+    this->disableSVF = true;
+    for (auto &F : *this->M){
+      if (F.empty()){
+        continue ;
+      }
+      this->notifyFunctionModified(F);
+    }
+  }
+  if (verbose >= PDGVerbosity::Minimal) {
+    errs() << "PDGAnalysis: Update the dependences of " << this->valuesOfModifiedFunctions.size() << " functions\n";
+  }
+
+  /*
+   * Retire the function DGs of the modified functions.
+   * They will be computed again when requested.
+   * Users might still hold them, so they are freed only when the memory of this pass is released.
+   */
+  for (auto &pair : this->valuesOfModifiedFunctions){
+    auto fdgIt = this->functionToFDGMap.find(pair.first);
+    if (fdgIt == this->functionToFDGMap.end()){
+      continue ;
+    }
+    this->retiredFunctionDGs.push_back(fdgIt->second);
+    this->functionToFDGMap.erase(fdgIt);
+  }
+
+  /*
+   * The dependences of the modified functions are no longer the ones loaded from the cache.
+   */
+  for (auto &pair : this->valuesOfModifiedFunctions){
+    this->functionsWithDependencesFromCache.erase(pair.first);
+  }
+  this->invalidateStructuralHashes();
+
+  /*
+   * Update the PDG of the module if it has been computed already.
+   */
+  if (this->programDependenceGraph != nullptr){
+    this->updateDependencesOfFunctions(this->programDependenceGraph);
+  }
+  this->valuesOfModifiedFunctions.clear();
+
+  return ;
+}
+
+void PDGAnalysis::updateDependencesOfFunctions (PDG *pdg){
+  assert(pdg != nullptr);
+
+  /*
+   * Remove the nodes of the values that no longer belong to the function they were part of.
+   * These values could have been erased from the IR, so they must not be dereferenced.
+   */
+  std::unordered_set<Value *> staleValues;
+  std::unordered_map<Function *, std::vector<Value *>> currentValuesOfFunctions;
+  for (auto &pair : this->valuesOfModifiedFunctions){
+    auto F = pair.first;
+    auto &currentValues = currentValuesOfFunctions[F];
+    if (!F->isDeclaration()){
+
+      /*
+       * The PDG of the module has no node for the arguments of a declaration (see PDG::PDG).
+       */
+      for (auto &arg : F->args()){
+        currentValues.push_back(&arg);
+      }
+      for (auto &inst : instructions(*F)){
+        currentValues.push_back(&inst);
+      }
+    }
+
+    std::unordered_set<Value *> currentValuesSet(currentValues.begin(), currentValues.end());
+    for (auto oldValue : pair.second){
+      if (currentValuesSet.find(oldValue) == currentValuesSet.end()){
+        staleValues.insert(oldValue);
+      }
+    }
+  }
+  pdg->removeValues(staleValues);
+
+  /*
+   * Remove the dependences of the values that are still alive and add nodes for the new ones.
+   */
+  std::vector<Value *> valuesToUpdate;
+  for (auto &pair : currentValuesOfFunctions){
+    valuesToUpdate.insert(valuesToUpdate.end(), pair.second.begin(), pair.second.end());
+  }
+  pdg->removeDependencesOf(valuesToUpdate);
+  for (auto value : valuesToUpdate){
+    if (!pdg->isInGraph(value)){
+      pdg->addNode(value, true);
+    }
+  }
+
+  /*
+   * Compute the variable dependences.
+   * Dependences never cross the boundary of a function, so the ones of the values of the modified functions are all we need.
+   */
+  for (auto value : valuesToUpdate){
+    for (auto &U : value->uses()){
+      auto user = U.getUser();
+      if (isa<Instruction>(user) || isa<Argument>(user)) {
+        auto edge = pdg->addEdge(value, user);
+        edge->setMemMustType(false, true, DG_DATA_RAW);
+      }
+    }
+  }
+
+  /*
+   * Compute the memory and control dependences.
+   *
+   * The post-dominator tree of the pass manager is not updated by the transformation, so we compute it from the current IR.
+   * SVF is no longer queried at this point (see updatePDG).
+   */
+  assert(this->disableSVF);
+  for (auto &pair : currentValuesOfFunctions){
+    auto F = pair.first;
+    if (F->empty()){
+      continue ;
+    }
+    this->constructEdgesFromAliasesForFunction(pdg, *F);
+
+    PostDominatorTree postDomTree;
+    postDomTree.recalculate(*F);
+    std::vector<std::pair<Value *, Value *>> controlDependences;
+    this->computeControlDependencesForFunction(*F, postDomTree, controlDependences);
+    for (auto &dependence : controlDependences) {
+      auto edge = pdg->addEdge(dependence.first, dependence.second);
+      edge->setControl(true);
+    }
+  }
+
+  /*
+   * Trim the new dependences the same way the whole PDG is trimmed at construction time.
+   * The call graph under main is not recomputed: a function that becomes reachable from main only because of the notified changes keeps all its dependences, which is conservative.
+   */
+  if (!this->disableAllocAA){
+    if (this->CGUnderMain.empty()){
+      this->collectCGUnderFunctionMain(*this->M);
+    }
+    this->allocAA = &getAnalysis<AllocAA>();
+
+    std::unordered_set<DGEdge<Value> *> edgesToRemove;
+    for (auto value : valuesToUpdate){
+      auto node = pdg->fetchNode(value);
+      for (auto edge : node->getOutgoingEdges()){
+        if (this->isEdgeNotUsedByParSchemes(edge)){
+          edgesToRemove.insert(edge);
+        }
+      }
+    }
+    for (auto edge : edgesToRemove){
+      pdg->removeEdge(edge);
+    }
+  }
+
+  /*
+   * Restore the entry node if it has been removed.
+   * The PDG has no entry node if the transformation has erased the body of "main".
+   */
+  if (pdg->getEntryNode() == nullptr){
+    auto mainF = this->M->getFunction("main");
+    if (  false
+          || (mainF == nullptr)
+          || mainF->empty()
+       ){
+      return ;
+    }
+    auto entryInst = &*mainF->getEntryBlock().begin();
+    pdg->setEntryNode(pdg->fetchNode(entryInst));
+  }
+
+  return ;
+}
+
+}
@@ -13,13 +13,18 @@
 #include "noelle/core/PDGPrinter.hpp"
 #include "noelle/core/PDGAnalysis.hpp"
 #include "IntegrationWithSVF.hpp"
+#include "noelle/core/AliasQueryCache.hpp"
 #include "noelle/core/Utils.hpp"
 
 namespace llvm::noelle {
 
 void PDGAnalysis::iterateInstForStore (PDG *pdg, Function &F, AAResults &AA, DataFlowResult *dfr, StoreInst *store) {
 
-  for (auto I : dfr->OUT(store)) {
+  /*
+   * Use the dense representation of the data-flow result to avoid materializing a set per instruction.
+   */
+  for (auto index : dfr->OUTBits(store).set_bits()) {
+    auto I = dfr->getValueOfIndex(index);
 
     /*
      * Check stores.
@@ -56,7 +61,8 @@ void PDGAnalysis::iterateInstForStore (PDG *pdg, Function &F, AAResults &AA, Dat
 
 void PDGAnalysis::iterateInstForLoad (PDG *pdg, Function &F, AAResults &AA, DataFlowResult *dfr, LoadInst *load) {
 
-  for (auto I : dfr->OUT(load)) {
+  for (auto index : dfr->OUTBits(load).set_bits()) {
+    auto I = dfr->getValueOfIndex(index);
 
     /*
      * Check stores.
@@ -128,7 +134,11 @@ void PDGAnalysis::addEdgeFromFunctionModRef (PDG *pdg, Function &F, AAResults &A
   /*
    * Query the LLVM alias analyses.
    */
-  switch (AA.getModRefInfo(call, MemoryLocation::get(store))) {
+  auto storeLocation = MemoryLocation::get(store);
+  auto modRefOfLLVM = this->aliasQueriesOfLLVM->getModRefInfo(call, storeLocation, [&]() {
+    return AA.getModRefInfo(call, storeLocation);
+  });
+  switch (modRefOfLLVM) {
     case ModRefInfo::NoModRef:
       return;
     case ModRefInfo::Ref:
@@ -171,8 +181,10 @@ void PDGAnalysis::addEdgeFromFunctionModRef (PDG *pdg, Function &F, AAResults &A
      * This is due to a bug in SVF that doesn't model I/O library calls correctly.
      */
     if (this->isSafeToQueryModRefOfSVF(call, bv)) {
-      auto const &loc = MemoryLocation::get(store);
-      switch (NoelleSVFIntegration::getModRefInfo(call, loc)) {
+      auto modRefOfSVF = this->aliasQueriesOfSVF->getModRefInfo(call, storeLocation, [&]() {
+        return NoelleSVFIntegration::getModRefInfo(call, storeLocation);
+      });
+      switch (modRefOfSVF) {
         case ModRefInfo::NoModRef:
           return;
         case ModRefInfo::Ref:
@@ -250,7 +262,11 @@ void PDGAnalysis::addEdgeFromFunctionModRef (PDG *pdg, Function &F, AAResults &A
   /*
    * Query the LLVM alias analyses.
    */
-  switch (AA.getModRefInfo(call, MemoryLocation::get(load))) {
+  auto loadLocation = MemoryLocation::get(load);
+  auto modRefOfLLVM = this->aliasQueriesOfLLVM->getModRefInfo(call, loadLocation, [&]() {
+    return AA.getModRefInfo(call, loadLocation);
+  });
+  switch (modRefOfLLVM) {
     case ModRefInfo::NoModRef:
     case ModRefInfo::Ref:
       return;
@@ -288,7 +304,10 @@ void PDGAnalysis::addEdgeFromFunctionModRef (PDG *pdg, Function &F, AAResults &A
      * This is due to a bug in SVF that doesn't model I/O library calls correctly.
      */
     if (isSafeToQueryModRefOfSVF(call, bv)) {
-      switch (NoelleSVFIntegration::getModRefInfo(call, MemoryLocation::get(load))) {
+      auto modRefOfSVF = this->aliasQueriesOfSVF->getModRefInfo(call, loadLocation, [&]() {
+        return NoelleSVFIntegration::getModRefInfo(call, loadLocation);
+      });
+      switch (modRefOfSVF) {
         case ModRefInfo::NoModRef:
         case ModRefInfo::Ref:
           return;
@@ -376,7 +395,10 @@ void PDGAnalysis::addEdgeFromFunctionModRef (PDG *pdg, Function &F, AAResults &A
   /*
    * Query the LLVM alias analyses.
    */
-  switch (AA.getModRefInfo(call, otherCall)) {
+  auto modRefOfLLVM = this->aliasQueriesOfLLVM->getModRefInfo(call, otherCall, [&]() {
+    return AA.getModRefInfo(call, otherCall);
+  });
+  switch (modRefOfLLVM) {
     case ModRefInfo::NoModRef:
       return;
 
@@ -388,14 +410,17 @@ void PDGAnalysis::addEdgeFromFunctionModRef (PDG *pdg, Function &F, AAResults &A
       bv[0] = true;
       break;
 
-    case ModRefInfo::Mod:
+    case ModRefInfo::Mod: {
 
       /*
        * @call may write a memory location that can be read or written by @otherCall
        */
       bv[1] = true;
 
-      switch (AA.getModRefInfo(otherCall, call)) {
+      auto reverseModRefOfLLVM = this->aliasQueriesOfLLVM->getModRefInfo(otherCall, call, [&]() {
+        return AA.getModRefInfo(otherCall, call);
+      });
+      switch (reverseModRefOfLLVM) {
         case ModRefInfo::NoModRef:
           return;
         case ModRefInfo::Ref:
@@ -409,6 +434,7 @@ void PDGAnalysis::addEdgeFromFunctionModRef (PDG *pdg, Function &F, AAResults &A
           break;
       }
       break;
+    }
 
     case ModRefInfo::ModRef:
 
@@ -458,7 +484,10 @@ void PDGAnalysis::addEdgeFromFunctionModRef (PDG *pdg, Function &F, AAResults &A
           && isSafeToQueryModRefOfSVF(call, bv) 
           && isSafeToQueryModRefOfSVF(otherCall, bv)
       ) {
-      switch (NoelleSVFIntegration::getModRefInfo(call, otherCall)) {
+      auto modRefOfSVF = this->aliasQueriesOfSVF->getModRefInfo(call, otherCall, [&]() {
+        return NoelleSVFIntegration::getModRefInfo(call, otherCall);
+      });
+      switch (modRefOfSVF) {
         case ModRefInfo::NoModRef:
           return;
 
@@ -466,10 +495,13 @@ void PDGAnalysis::addEdgeFromFunctionModRef (PDG *pdg, Function &F, AAResults &A
           bv[0] = true;
           break;
 
-        case ModRefInfo::Mod:
+        case ModRefInfo::Mod: {
           bv[1] = true;
 
-          switch (NoelleSVFIntegration::getModRefInfo(otherCall, call)) {
+          auto reverseModRefOfSVF = this->aliasQueriesOfSVF->getModRefInfo(otherCall, call, [&]() {
+            return NoelleSVFIntegration::getModRefInfo(otherCall, call);
+          });
+          switch (reverseModRefOfSVF) {
             case ModRefInfo::NoModRef:
               return;
             case ModRefInfo::Ref:
@@ -483,6 +515,7 @@ void PDGAnalysis::addEdgeFromFunctionModRef (PDG *pdg, Function &F, AAResults &A
               break;
           }
           break;
+        }
 
         case ModRefInfo::ModRef:
           bv[2] = true;
@@ -626,7 +659,12 @@ void PDGAnalysis::addEdgeFromMemoryAlias (PDG *pdg, Function &F, AAResults &AA,
   /*
    * Query the LLVM alias analyses.
    */
-  switch (AA.alias(MemoryLocation::get(instI), MemoryLocation::get(instJ))) {
+  auto locationI = MemoryLocation::get(instI);
+  auto locationJ = MemoryLocation::get(instJ);
+  auto aliasOfLLVM = this->aliasQueriesOfLLVM->alias(locationI, locationJ, [&]() {
+    return AA.alias(locationI, locationJ);
+  });
+  switch (aliasOfLLVM) {
     case NoAlias:
       return ;
     case PartialAlias:
@@ -653,7 +691,10 @@ void PDGAnalysis::addEdgeFromMemoryAlias (PDG *pdg, Function &F, AAResults &AA,
     /*
      * SVF is enabled, so let's use it.
      */
-    switch (NoelleSVFIntegration::alias(MemoryLocation::get(instI), MemoryLocation::get(instJ))) {
+    auto aliasOfSVF = this->aliasQueriesOfSVF->alias(locationI, locationJ, [&]() {
+      return NoelleSVFIntegration::alias(locationI, locationJ);
+    });
+    switch (aliasOfSVF) {
       case NoAlias:
         return;
       case PartialAlias:
@@ -719,4 +760,21 @@ AliasResult PDGAnalysis::doTheyAlias (PDG *pdg, Function &F, AAResults &AA, Valu
   return MayAlias;
 }
 
+uint64_t PDGAnalysis::getNumberOfMemoizedAliasQueries (void) const {
+  return this->aliasQueriesOfLLVM->getNumberOfHits();
+}
+
+void PDGAnalysis::printAliasQueryStatistics (void){
+  if (verbose < PDGVerbosity::Minimal) {
+    return ;
+  }
+
+  errs() << "PDGAnalysis: Queries to the LLVM alias analyses: " << this->aliasQueriesOfLLVM->getNumberOfHits() << " hits, " << this->aliasQueriesOfLLVM->getNumberOfMisses() << " misses\n";
+  if (!this->disableSVF){
+    errs() << "PDGAnalysis: Queries to SVF: " << this->aliasQueriesOfSVF->getNumberOfHits() << " hits, " << this->aliasQueriesOfSVF->getNumberOfMisses() << " misses\n";
+  }
+
+  return ;
+}
+
 }
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2016 - 2021  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <atomic>
+
+#include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/PDGAnalysis.hpp"
+
+namespace llvm::noelle {
+
+/*
+ * Per-function state computed by the worker threads.
+ */
+struct FunctionEdgesBuffer {
+  DataFlowResult *reachableMemoryInstructions;
+  std::vector<std::pair<Value *, Value *>> controlDependences;
+};
+
+void PDGAnalysis::setNumberOfThreads (uint32_t numberOfThreads){
+  this->numberOfThreads = std::max(numberOfThreads, 1u);
+
+  return ;
+}
+
+void PDGAnalysis::constructEdgesFromAliasesAndControlInParallel (PDG *pdg, Module &M){
+  assert(pdg != nullptr);
+  assert(this->numberOfThreads > 1);
+  if (verbose >= PDGVerbosity::Maximal) {
+    errs() << "PDGAnalysis: Construct memory and control dependences using " << this->numberOfThreads << " threads\n";
+  }
+
+  /*
+   * Collect the functions with a body.
+   */
+  std::vector<Function *> functions;
+  for (auto &F : M) {
+    if (F.empty()) continue ;
+    if (this->functionsLoadedFromCache.find(&F) != this->functionsLoadedFromCache.end()) continue ;
+    functions.push_back(&F);
+  }
+
+  /*
+   * Define the work done per function by a worker thread.
+   *
+   * The worker only reads the IR.
+   * The reachability analysis and the control dependences are computed into the buffer of the function without touching the PDG or the pass manager.
+   * Alias analyses (LLVM AA, SVF) are not thread-safe, so memory dependences are resolved by the main thread when the buffers get merged.
+   */
+  auto computeBuffer = [this](Function *F, FunctionEdgesBuffer &buffer) {
+    buffer.reachableMemoryInstructions = this->computeReachableMemoryInstructions(*F);
+
+    PostDominatorTree postDomTree;
+    postDomTree.recalculate(*F);
+    this->computeControlDependencesForFunction(*F, postDomTree, buffer.controlDependences);
+
+    return ;
+  };
+
+  /*
+   * Process the functions in windows to bound the memory used by the reachability results that are alive at the same time.
+   */
+  auto windowSize = this->numberOfThreads * 16;
+  std::vector<std::vector<std::pair<Value *, Value *>>> controlDependencesOfFunctions(functions.size());
+  for (uint64_t windowStart = 0; windowStart < functions.size(); windowStart += windowSize) {
+    auto windowEnd = std::min<uint64_t>(windowStart + windowSize, functions.size());
+
+    /*
+     * Compute the buffers of the functions of the current window in parallel.
+     */
+    std::vector<FunctionEdgesBuffer> buffers(windowEnd - windowStart);
+    std::atomic<uint64_t> nextFunction{windowStart};
+    auto worker = [&]() {
+      while (true) {
+        auto functionIndex = nextFunction.fetch_add(1);
+        if (functionIndex >= windowEnd) {
+          break ;
+        }
+        computeBuffer(functions[functionIndex], buffers[functionIndex - windowStart]);
+      }
+    };
+    std::vector<std::thread> threads;
+    for (auto i = 1u; i < this->numberOfThreads; i++) {
+      threads.push_back(std::thread(worker));
+    }
+    worker();
+    for (auto &thread : threads) {
+      thread.join();
+    }
+
+    /*
+     * Merge the memory dependences in the order of the functions within the module.
+     * The alias analyses of the pass manager and SVF are queried by this thread only, after the workers have finished, through the code of the serial construction (see constructEdgesFromAliases).
+     * This keeps the PDG identical to the one computed serially (see tests/unit/pdg_threads).
+     */
+    for (auto functionIndex = windowStart; functionIndex < windowEnd; functionIndex++) {
+      auto &buffer = buffers[functionIndex - windowStart];
+      this->constructEdgesFromAliasesForFunction(pdg, *functions[functionIndex], buffer.reachableMemoryInstructions);
+      delete buffer.reachableMemoryInstructions;
+
+      controlDependencesOfFunctions[functionIndex] = std::move(buffer.controlDependences);
+    }
+  }
+
+  /*
+   * Merge the control dependences.
+   *
+   * The serial construction adds them after all memory dependences of the module, so we do the same.
+   */
+  for (auto &controlDependences : controlDependencesOfFunctions) {
+    for (auto &dependence : controlDependences) {
+      auto edge = pdg->addEdge(dependence.first, dependence.second);
+      edge->setControl(true);
+    }
+  }
+
+  return ;
+}
+
+}
@@ -0,0 +1,324 @@
+/*
+ * Copyright 2016 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/xxhash.h"
+
+#include "PDGCache.hpp"
+
+namespace llvm::noelle {
+
+static const uint64_t cacheMagic = 0x3147445045494f4eULL; // "NOEIPDG1"
+static const uint32_t cacheVersion = 2;
+static const uint64_t headerSize = 2 * sizeof(uint64_t) + 2 * sizeof(uint32_t);
+static const uint64_t indexEntrySize = 3 * sizeof(uint64_t) + 2 * sizeof(uint32_t);
+
+/*
+ * Attributes of a cached dependence.
+ */
+static const uint32_t memoryAttribute = 1;
+static const uint32_t mustAttribute = 2;
+static const uint32_t controlAttribute = 4;
+static const uint32_t dataTypeShift = 3;
+
+PDGCache::PDGCache (const std::string &fileName)
+  : fileName{fileName}
+  , hits{0}
+  , misses{0}
+  {
+  this->loadFile();
+
+  return ;
+}
+
+void PDGCache::loadFile (void){
+
+  /*
+   * Map the file into memory.
+   * A missing file is an empty cache.
+   */
+  auto fileOrError = MemoryBuffer::getFile(this->fileName, -1, false);
+  if (!fileOrError){
+    return ;
+  }
+  auto &buffer = *fileOrError;
+  auto start = buffer->getBufferStart();
+  auto size = buffer->getBufferSize();
+
+  /*
+   * Check the header.
+   * A file written by a different version of NOELLE, or one that has been truncated, is ignored and overwritten.
+   */
+  if (size < headerSize){
+    return ;
+  }
+  uint64_t magic, fileSize;
+  uint32_t version, numberOfSections;
+  std::memcpy(&magic, start, sizeof(magic));
+  std::memcpy(&version, start + sizeof(uint64_t), sizeof(version));
+  std::memcpy(&numberOfSections, start + sizeof(uint64_t) + sizeof(uint32_t), sizeof(numberOfSections));
+  std::memcpy(&fileSize, start + sizeof(uint64_t) + 2 * sizeof(uint32_t), sizeof(fileSize));
+  if (  false
+        || (magic != cacheMagic)
+        || (version != cacheVersion)
+        || (fileSize != size)
+        || (size < headerSize + numberOfSections * indexEntrySize)
+     ){
+    return ;
+  }
+
+  /*
+   * Parse the index.
+   */
+  auto entry = start + headerSize;
+  for (auto i = 0u; i < numberOfSections; i++, entry += indexEntrySize){
+    uint64_t key, offset;
+    Section section;
+    std::memcpy(&key, entry, sizeof(key));
+    std::memcpy(&offset, entry + sizeof(uint64_t), sizeof(offset));
+    std::memcpy(&section.checksum, entry + 2 * sizeof(uint64_t), sizeof(uint64_t));
+    std::memcpy(&section.numberOfValues, entry + 3 * sizeof(uint64_t), sizeof(uint32_t));
+    std::memcpy(&section.numberOfDependences, entry + 3 * sizeof(uint64_t) + sizeof(uint32_t), sizeof(uint32_t));
+    if (  false
+          || (offset % sizeof(uint32_t) != 0)
+          || (offset + 3 * sizeof(uint32_t) * (uint64_t)section.numberOfDependences > size)
+       ){
+      this->sectionsInFile.clear();
+      return ;
+    }
+    section.dependences = reinterpret_cast<const uint32_t *>(start + offset);
+    this->sectionsInFile[key] = section;
+  }
+
+  this->file = std::move(buffer);
+
+  return ;
+}
+
+bool PDGCache::fetchDependences (uint64_t key, Function &F, PDG *pdg){
+  assert(pdg != nullptr);
+
+  /*
+   * Fetch the section of the function.
+   */
+  auto sectionIt = this->sectionsInFile.find(key);
+  if (sectionIt == this->sectionsInFile.end()){
+    this->misses++;
+    return false;
+  }
+  auto &section = sectionIt->second;
+  std::vector<Value *> values;
+  this->collectValuesOf(F, values);
+  if (values.size() != section.numberOfValues){
+    this->misses++;
+    return false;
+  }
+
+  /*
+   * Check the section before adding any of its dependences.
+   * A corrupted section is dropped, so it is neither used again nor written back to the file.
+   */
+  ArrayRef<uint32_t> dependences(section.dependences, 3 * section.numberOfDependences);
+  auto isCorrupted = (this->computeChecksum(dependences) != section.checksum);
+  for (auto i = 0u; (i < dependences.size()) && !isCorrupted; i += 3){
+    if (  false
+          || (dependences[i] >= values.size())
+          || (dependences[i + 1] >= values.size())
+          || ((dependences[i + 2] >> dataTypeShift) > DG_DATA_WAW)
+       ){
+      isCorrupted = true;
+    }
+  }
+  if (isCorrupted){
+    errs() << "PDGCache: Warning = the dependences of " << F.getName() << " in the cache file " << this->fileName << " are corrupted, so they are computed again\n";
+    this->sectionsInFile.erase(sectionIt);
+    this->misses++;
+    return false;
+  }
+
+  /*
+   * Add the dependences.
+   */
+  auto dependence = section.dependences;
+  for (auto i = 0u; i < section.numberOfDependences; i++, dependence += 3){
+    auto fromID = dependence[0];
+    auto toID = dependence[1];
+    auto attributes = dependence[2];
+    auto edge = pdg->addEdge(values[fromID], values[toID]);
+    edge->setMemMustType(
+      (attributes & memoryAttribute) != 0,
+      (attributes & mustAttribute) != 0,
+      static_cast<DataDependenceType>(attributes >> dataTypeShift)
+      );
+    edge->setControl((attributes & controlAttribute) != 0);
+  }
+  this->usedSections.insert(key);
+  this->hits++;
+
+  return true;
+}
+
+void PDGCache::storeDependences (uint64_t key, Function &F, PDG *pdg){
+  assert(pdg != nullptr);
+
+  /*
+   * Number the values of the function.
+   */
+  std::vector<Value *> values;
+  this->collectValuesOf(F, values);
+  std::unordered_map<Value *, uint32_t> valueIDs;
+  for (auto i = 0u; i < values.size(); i++){
+    valueIDs[values[i]] = i;
+  }
+
+  /*
+   * Serialize the dependences.
+   * Dependences that leave the function or that summarize other dependences cannot be expressed by the cache, so such a function is not cached.
+   */
+  std::vector<uint32_t> dependences;
+  for (auto value : values){
+    auto node = pdg->fetchNode(value);
+    if (node == nullptr){
+      continue ;
+    }
+    for (auto edge : node->getOutgoingEdges()){
+      auto toIt = valueIDs.find(edge->getIncomingT());
+      if (  false
+            || (toIt == valueIDs.end())
+            || (edge->begin_sub_edges() != edge->end_sub_edges())
+         ){
+        errs() << "PDGCache: Warning = the dependences of " << F.getName() << " are not cached because they cannot be expressed by the cache\n";
+        return ;
+      }
+      uint32_t attributes = static_cast<uint32_t>(edge->dataDependenceType()) << dataTypeShift;
+      if (edge->isMemoryDependence()) attributes |= memoryAttribute;
+      if (edge->isMustDependence()) attributes |= mustAttribute;
+      if (edge->isControlDependence()) attributes |= controlAttribute;
+      dependences.push_back(valueIDs[value]);
+      dependences.push_back(toIt->second);
+      dependences.push_back(attributes);
+    }
+  }
+
+  this->newSections[key] = std::make_pair(values.size(), std::move(dependences));
+
+  return ;
+}
+
+void PDGCache::writeToFile (void){
+
+  /*
+   * Check if there is anything new to write.
+   */
+  if (this->newSections.empty()){
+    return ;
+  }
+
+  /*
+   * Collect the sections to write.
+   */
+  std::map<uint64_t, std::pair<uint32_t, ArrayRef<uint32_t>>> sections;
+  for (auto key : this->usedSections){
+    auto &section = this->sectionsInFile.at(key);
+    sections[key] = std::make_pair(section.numberOfValues, ArrayRef<uint32_t>(section.dependences, 3 * section.numberOfDependences));
+  }
+  for (auto &pair : this->newSections){
+    sections[pair.first] = std::make_pair(pair.second.first, ArrayRef<uint32_t>(pair.second.second));
+  }
+
+  /*
+   * Write a temporary file and then move it over the old one.
+   * The old file stays mapped until the new one is complete, and concurrent readers never see a partial file.
+   * The name of the temporary file is unique, so concurrent invocations that share the cache do not write the same file.
+   */
+  int temporaryFD;
+  SmallString<128> temporaryFileName;
+  auto EC = sys::fs::createUniqueFile(this->fileName + ".tmp-%%%%%%%%", temporaryFD, temporaryFileName);
+  if (EC){
+    errs() << "PDGCache: Warning = cannot write the cache file " << this->fileName << ": " << EC.message() << "\n";
+    return ;
+  }
+  {
+    raw_fd_ostream output(temporaryFD, true);
+    auto writeWord = [&output](auto word) {
+      output.write(reinterpret_cast<const char *>(&word), sizeof(word));
+    };
+
+    uint64_t fileSize = headerSize + sections.size() * indexEntrySize;
+    for (auto &pair : sections){
+      fileSize += pair.second.second.size() * sizeof(uint32_t);
+    }
+    writeWord(cacheMagic);
+    writeWord(cacheVersion);
+    writeWord(static_cast<uint32_t>(sections.size()));
+    writeWord(fileSize);
+    uint64_t offset = headerSize + sections.size() * indexEntrySize;
+    for (auto &pair : sections){
+      auto &dependences = pair.second.second;
+      writeWord(pair.first);
+      writeWord(offset);
+      writeWord(computeChecksum(dependences));
+      writeWord(pair.second.first);
+      writeWord(static_cast<uint32_t>(dependences.size() / 3));
+      offset += dependences.size() * sizeof(uint32_t);
+    }
+    for (auto &pair : sections){
+      auto &dependences = pair.second.second;
+      output.write(reinterpret_cast<const char *>(dependences.data()), dependences.size() * sizeof(uint32_t));
+    }
+    output.close();
+    if (output.has_error()){
+      errs() << "PDGCache: Warning = cannot write the cache file " << temporaryFileName << "\n";
+      output.clear_error();
+      sys::fs::remove(temporaryFileName);
+      return ;
+    }
+  }
+  EC = sys::fs::rename(temporaryFileName, this->fileName);
+  if (EC){
+    errs() << "PDGCache: Warning = cannot write the cache file " << this->fileName << ": " << EC.message() << "\n";
+    sys::fs::remove(temporaryFileName);
+    return ;
+  }
+  this->newSections.clear();
+
+  return ;
+}
+
+uint64_t PDGCache::getNumberOfHits (void) const {
+  return this->hits;
+}
+
+uint64_t PDGCache::getNumberOfMisses (void) const {
+  return this->misses;
+}
+
+void PDGCache::collectValuesOf (Function &F, std::vector<Value *> &values){
+  for (auto &arg : F.args()){
+    values.push_back(&arg);
+  }
+  for (auto &inst : instructions(F)){
+    values.push_back(&inst);
+  }
+
+  return ;
+}
+
+uint64_t PDGCache::computeChecksum (ArrayRef<uint32_t> dependences){
+  return xxHash64(StringRef(reinterpret_cast<const char *>(dependences.data()), dependences.size() * sizeof(uint32_t)));
+}
+
+PDGCache::~PDGCache (){
+  this->writeToFile();
+
+  return ;
+}
+
+}
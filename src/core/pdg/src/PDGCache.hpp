@@ -0,0 +1,84 @@
+/*
+ * Copyright 2016 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "llvm/Support/MemoryBuffer.h"
+
+#include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/PDG.hpp"
+
+namespace llvm::noelle {
+
+/*
+ * Binary file that caches the dependences of functions across invocations.
+ *
+ * The file has one section per function, identified by a key that the user computes from the code of the function and from everything its dependences rely on.
+ * Layout (native endianness):
+ *   header:  magic (uint64), version (uint32), number of sections (uint32), size of the file (uint64)
+ *   index:   per section, key (uint64), offset of the section from the beginning of the file (uint64), checksum of the section (uint64), number of values (uint32), number of dependences (uint32)
+ *   section: per dependence, source (uint32), destination (uint32), attributes (uint32)
+ * Values are numbered as the arguments of the function followed by its instructions in program order.
+ *
+ * The file is memory mapped, so only the index is parsed when the cache is loaded.
+ * A file that is truncated or has a different version is ignored, and a section that does not match its checksum is a miss: the cache is never trusted over the analyses.
+ */
+class PDGCache {
+  public:
+    PDGCache (const std::string &fileName);
+
+    /*
+     * Add to @param pdg the dependences of @param F cached with @param key.
+     * Return false if they are not in the cache or if their section is corrupted, which is then dropped from the cache.
+     */
+    bool fetchDependences (uint64_t key, Function &F, PDG *pdg);
+
+    /*
+     * Cache the dependences of @param pdg that start from the values of @param F.
+     * A function with a dependence that the cache cannot express (e.g., one that leaves @param F) is not cached.
+     */
+    void storeDependences (uint64_t key, Function &F, PDG *pdg);
+
+    uint64_t getNumberOfHits (void) const ;
+
+    uint64_t getNumberOfMisses (void) const ;
+
+    /*
+     * Write the file if new dependences have been cached.
+     * Only the sections used or added by the current invocation are kept.
+     */
+    void writeToFile (void);
+
+    ~PDGCache ();
+
+  private:
+    struct Section {
+      const uint32_t *dependences;
+      uint64_t checksum;
+      uint32_t numberOfValues;
+      uint32_t numberOfDependences;
+    };
+
+    std::string fileName;
+    std::unique_ptr<MemoryBuffer> file;
+    std::unordered_map<uint64_t, Section> sectionsInFile;
+    std::unordered_set<uint64_t> usedSections;
+    std::map<uint64_t, std::pair<uint32_t, std::vector<uint32_t>>> newSections;
+    uint64_t hits;
+    uint64_t misses;
+
+    void loadFile (void);
+
+    static void collectValuesOf (Function &F, std::vector<Value *> &values);
+
+    static uint64_t computeChecksum (ArrayRef<uint32_t> dependences);
+};
+
+}
@@ -11,6 +11,7 @@
 #include "noelle/core/SystemHeaders.hpp"
 #include "noelle/core/PDGAnalysis.hpp"
 #include "noelle/core/PDGPrinter.hpp"
+#include "PDGCache.hpp"
 
 namespace llvm::noelle{ 
 
@@ -24,6 +25,8 @@ static cl::opt<bool> PDGCheck("noelle-pdg-check", cl::ZeroOrMore, cl::Hidden, cl
 static cl::opt<bool> PDGSVFDisable("noelle-disable-pdg-svf", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable SVF"));
 static cl::opt<bool> PDGAllocAADisable("noelle-disable-pdg-allocaa", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable our custom alias analysis"));
 static cl::opt<bool> PDGRADisable("noelle-disable-pdg-reaching-analysis", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable the use of reaching analysis to compute the PDG"));
+static cl::opt<std::string> PDGCacheFile("noelle-pdg-cache", cl::ZeroOrMore, cl::Hidden, cl::init(""), cl::desc("File used to cache the dependences of the functions across invocations; it requires -noelle-disable-pdg-svf because the dependences found with SVF rely on the code of the whole program"));
+static cl::opt<unsigned> PDGThreads("noelle-pdg-threads", cl::ZeroOrMore, cl::Hidden, cl::init(1), cl::desc("Number of threads used to compute the reachability of memory instructions and the control dependences of the functions of the module"));
 
 bool PDGAnalysis::doInitialization (Module &M){
   this->verbose = static_cast<PDGVerbosity>(PDGVerbose.getValue());
@@ -33,6 +36,8 @@ bool PDGAnalysis::doInitialization (Module &M){
   this->disableSVF = (PDGSVFDisable.getNumOccurrences() > 0) ? true : false;
   this->disableAllocAA = (PDGAllocAADisable.getNumOccurrences() > 0) ? true : false;
   this->disableRA = (PDGRADisable.getNumOccurrences() > 0) ? true : false;
+  this->numberOfThreads = std::max(PDGThreads.getValue(), 1u);
+  this->cacheFileName = PDGCacheFile.getValue();
 
   return false;
 }
@@ -68,6 +73,22 @@ bool PDGAnalysis::runOnModule (Module &M){
    */
   this->M = &M;
 
+  /*
+   * Load the cache of dependences.
+   */
+  if (this->cacheFileName != ""){
+
+    /*
+     * SVF computes the points-to sets of the pointers of a function from the code of the whole program (e.g., its callers).
+     * Hence, the dependences of a function found with SVF can change when any other function changes, and they cannot be cached per function.
+     */
+    if (this->disableSVF){
+      this->dependenceCache = new PDGCache(this->cacheFileName);
+    } else {
+      errs() << "PDGAnalysis: Warning = the cache of dependences " << this->cacheFileName << " is not used because SVF is enabled (see -noelle-disable-pdg-svf)\n";
+    }
+  }
+
   /*
    * Initialize SVF.
    */
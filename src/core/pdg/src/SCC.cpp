@@ -61,7 +61,7 @@ void SCC::copyNodesAndEdges(std::set<DGNode<Value> *> internalNodes, std::set<DG
   for (auto node : externalNodes) {
     addNode(node->getT(), /*internal=*/ false);
   }
-	entryNode = (*allNodes.begin());
+	entryNode = (*this->begin_nodes());
 
 	/*
 	 * Add internal edges on this SCC's instructions 
@@ -123,9 +123,9 @@ raw_ostream &SCC::print (raw_ostream &stream, std::string prefixToUse, int maxEd
   /*
    * Print the dependences that cross the SCC.
    */
-  stream << prefixToUse << "Edges: " << allEdges.size() << "\n";
+  stream << prefixToUse << "Edges: " << this->numEdges() << "\n";
   int edgesPrinted = 0;
-  for (auto edge : allEdges) {
+  for (auto edge : this->getEdges()) {
     if (edgesPrinted++ >= maxEdges) {
       stream << prefixToUse << "\t....\n";
       break;
@@ -141,7 +141,7 @@ raw_ostream &SCC::printMinimal (raw_ostream &stream, std::string prefixToUse) {
   for (auto nodePair : internalNodePairs()) nodePair.second->print(stream << prefixToUse << "\t") << "\n";
   stream << prefixToUse << "External nodes: " << externalNodeMap.size() << "\n";
   for (auto nodePair : externalNodePairs()) nodePair.second->print(stream << prefixToUse << "\t") << "\n";
-  stream << prefixToUse << "Edges: " << allEdges.size() << "\n";
+  stream << prefixToUse << "Edges: " << this->numEdges() << "\n";
   return stream;
 }
 
@@ -20,68 +20,121 @@ SCCDAG::SCCDAG(PDG *pdg) {
 
   /*
    * Create nodes of the SCCDAG.
-   *
-   * Iterate over all nodes in the PDG to calculate strongly connected components (see Tarjan's DFS algo).
    */
-  std::set<DGNode<Value> *> visited;
-  DGNode<Value> *originalEntryNode = pdg->getEntryNode();
+  this->addSCCsOfDependenceGraph(pdg);
 
-  for (auto nodeToVisit : pdg->getNodes()) {
-    if (visited.find(nodeToVisit) != visited.end()) continue;
+  /*
+   * Create the map from a Value to an SCC included in the SCCDAG.
+   */
+  this->markValuesInSCC();
 
-    pdg->setEntryNode(nodeToVisit);
+  /*
+   * Create dependences between nodes of the SCCDAG.
+   */
+  this->markEdgesAndSubEdges();
 
-    DGGraphWrapper<PDG, Value> pdgWrapper(pdg);
+  /*
+   * Compute transitive dependences between nodes of the SCCDAG.
+   */
+  orderedDirty = true;
+  this->computeReachabilityAmongSCCs();
 
-    for (auto pdgI = scc_begin(&pdgWrapper); pdgI != scc_end(&pdgWrapper); ++pdgI) {
+  return ;
+}
+
+void SCCDAG::addSCCsOfDependenceGraph (PDG *pdg) {
+
+  /*
+   * Compute the strongly connected components of the PDG with Tarjan's algorithm.
+   *
+   * A single traversal that follows the adjacency of the PDG nodes covers all roots, so the cost is linear in the number of nodes and edges of the PDG.
+   * The DFS is iterative to avoid overflowing the stack on large loops.
+   */
+  struct NodeState {
+    uint32_t index;
+    uint32_t lowLink;
+    bool onStack;
+  };
+  struct Frame {
+    DGNode<Value> *node;
+    DGNode<Value>::edges_iterator nextEdge;
+  };
+  DenseMap<DGNode<Value> *, NodeState> states;
+  std::vector<DGNode<Value> *> sccStack;
+  std::vector<Frame> dfsStack;
+  uint32_t nextIndex = 0;
+
+  auto startVisit = [&](DGNode<Value> *node) {
+    states[node] = { nextIndex, nextIndex, true };
+    nextIndex++;
+    sccStack.push_back(node);
+    dfsStack.push_back({ node, node->begin_outgoing_edges() });
+  };
+
+  for (auto root : pdg->getNodes()) {
+    if (states.find(root) != states.end()) {
+      continue ;
+    }
+
+    startVisit(root);
+    while (!dfsStack.empty()) {
+      auto &frame = dfsStack.back();
+      auto node = frame.node;
 
       /*
-       * Identify a new SCC.
+       * Visit the next successor of the current node.
        */
-      const std::vector<DGNodeWrapper<Value> *> &sccNodes = *pdgI;
-      auto firstNodeWrapper = *sccNodes.begin();
-      auto firstNode = firstNodeWrapper->wrappedNode;
-      if (visited.find(firstNode) != visited.end()) {
-        continue;
+      if (frame.nextEdge != node->end_outgoing_edges()) {
+        auto successor = (*frame.nextEdge)->getIncomingNode();
+        frame.nextEdge++;
+        auto successorStateI = states.find(successor);
+        if (successorStateI == states.end()) {
+          startVisit(successor);
+          continue ;
+        }
+        if (successorStateI->second.onStack) {
+          auto &state = states[node];
+          state.lowLink = std::min(state.lowLink, successorStateI->second.index);
+        }
+        continue ;
       }
 
-      std::set<DGNode<Value> *> unwrappedNodes{};
-      for (auto sccNode : sccNodes) {
-        unwrappedNodes.insert(sccNode->wrappedNode);
+      /*
+       * All successors of the current node have been visited.
+       * Pop the node and propagate its low link to its DFS parent.
+       */
+      dfsStack.pop_back();
+      auto state = states[node];
+      if (!dfsStack.empty()) {
+        auto &parentState = states[dfsStack.back().node];
+        parentState.lowLink = std::min(parentState.lowLink, state.lowLink);
+      }
+      if (state.lowLink != state.index) {
+        continue ;
       }
 
       /*
-       * Add a new SCC to the SCCDAG.
+       * The current node is the root of an SCC: collect its nodes.
        */
-      visited.insert(unwrappedNodes.begin(), unwrappedNodes.end());
-      auto scc = new SCC(unwrappedNodes);
+      std::set<DGNode<Value> *> sccNodes;
       auto isInternal = false;
-      for (auto node : unwrappedNodes) {
-        isInternal |= pdg->isInternal(node->getT());
-      }
+      DGNode<Value> *sccNode;
+      do {
+        sccNode = sccStack.back();
+        sccStack.pop_back();
+        states[sccNode].onStack = false;
+        sccNodes.insert(sccNode);
+        isInternal |= pdg->isInternal(sccNode->getT());
+      } while (sccNode != node);
 
+      /*
+       * Add a new SCC to the SCCDAG.
+       */
+      auto scc = new SCC(sccNodes);
       this->addNode(scc, /*inclusion=*/ isInternal);
     }
   }
 
-  pdg->setEntryNode(originalEntryNode);
-
-  /*
-   * Create the map from a Value to an SCC included in the SCCDAG.
-   */
-  this->markValuesInSCC();
-
-  /*
-   * Create dependences between nodes of the SCCDAG.
-   */
-  this->markEdgesAndSubEdges();
-
-  /*
-   * Compute transitive dependences between nodes of the SCCDAG.
-   */
-  orderedDirty = true;
-  this->computeReachabilityAmongSCCs();
-
   return ;
 }
 
@@ -124,6 +177,18 @@ void SCCDAG::markEdgesAndSubEdges (void) {
      */
     auto outgoingSCC = outgoingSCCNode->getT();
 
+    /*
+     * Index the edges that already connect the current SCC to other SCCs.
+     * This avoids scanning the adjacency of the current SCC for every dependence that leaves it.
+     */
+    std::unordered_map<DGNode<SCC> *, DGEdge<SCC> *> edgeToAdjacentSCC;
+    for (auto edge : outgoingSCCNode->getOutgoingEdges()) {
+      edgeToAdjacentSCC.insert(std::make_pair(edge->getIncomingNode(), edge));
+    }
+    for (auto edge : outgoingSCCNode->getIncomingEdges()) {
+      edgeToAdjacentSCC.insert(std::make_pair(edge->getOutgoingNode(), edge));
+    }
+
     /*
      * Check dependences that go outside the current SCC.
      */
@@ -137,16 +202,10 @@ void SCCDAG::markEdgesAndSubEdges (void) {
       /*
        * Find or create unique edge between the two connected SCC
        */
-      std::unordered_set<DGEdge<SCC> *> edgeSet;
-      for (auto edge : outgoingSCCNode->getOutgoingEdges()) {
-        if (edge->getIncomingNode() != incomingSCCNode) continue;
-        edgeSet.insert(edge);
-      }
-      for (auto edge : outgoingSCCNode->getIncomingEdges()) {
-        if (edge->getOutgoingNode() != incomingSCCNode) continue;
-        edgeSet.insert(edge);
+      auto &sccEdge = edgeToAdjacentSCC[incomingSCCNode];
+      if (sccEdge == nullptr) {
+        sccEdge = this->addEdge(outgoingSCC, incomingSCC);
       }
-      auto sccEdge = edgeSet.empty() ? this->addEdge(outgoingSCC, incomingSCC) : (*edgeSet.begin());
 
       /*
        * Clear out subedges if not already done once; add all currently existing subedges
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+
+/*
+ * Topology of the machine described by /sys/devices/system.
+ *
+ * It is read both by the runtime (to pin tasks) and by the compiler (see Architecture), so it only depends on the C++ standard library.
+ * Physical cores and caches are identified by the lowest logical core that shares them.
+ */
+typedef struct {
+  uint32_t ID;
+  uint32_t physicalCoreID;
+  uint32_t SMTIndex;            /* Position of the logical core within its physical core. */
+  uint32_t lastLevelCacheID;
+  uint64_t lastLevelCacheBytes; /* 0 if unknown. */
+  uint32_t NUMANodeID;
+} NOELLE_logicalCore_t ;
+
+/*
+ * Parse a list of IDs in the format used by sysfs (e.g., "0-3,8,10-11").
+ */
+static inline std::vector<uint32_t> NOELLE_parseListOfIDs (const std::string &list){
+  std::vector<uint32_t> IDs;
+
+  std::stringstream stream(list);
+  std::string range;
+  while (std::getline(stream, range, ',')){
+    if (range.empty()){
+      continue ;
+    }
+    auto dash = range.find('-');
+    auto first = strtoul(range.c_str(), nullptr, 10);
+    auto last = (dash == std::string::npos) ? first : strtoul(range.c_str() + dash + 1, nullptr, 10);
+    for (auto ID = first; ID <= last; ID++){
+      IDs.push_back(ID);
+    }
+  }
+
+  return IDs;
+}
+
+/*
+ * Read the first line of a sysfs file (empty if the file cannot be read).
+ */
+static inline std::string NOELLE_readSysFile (const std::string &path){
+  std::ifstream file(path);
+  std::string line;
+  if (file.good()){
+    std::getline(file, line);
+  }
+
+  return line;
+}
+
+/*
+ * Parse the size of a cache in the format used by sysfs (e.g., "32K").
+ */
+static inline uint64_t NOELLE_parseCacheSize (const std::string &size){
+  if (size.empty()){
+    return 0;
+  }
+  uint64_t bytes = strtoull(size.c_str(), nullptr, 10);
+  switch (size.back()){
+    case 'K':
+      return bytes << 10;
+    case 'M':
+      return bytes << 20;
+    case 'G':
+      return bytes << 30;
+  }
+
+  return bytes;
+}
+
+/*
+ * Describe the online logical cores of the machine (empty if the topology is not available).
+ */
+static inline std::vector<NOELLE_logicalCore_t> NOELLE_readTopology (void){
+  std::vector<NOELLE_logicalCore_t> cores;
+
+  /*
+   * Map logical cores to NUMA nodes.
+   */
+  std::string nodeDir = "/sys/devices/system/node/";
+  std::vector<uint32_t> NUMANodeOfCore;
+  for (auto nodeID : NOELLE_parseListOfIDs(NOELLE_readSysFile(nodeDir + "online"))){
+    auto coresOfNode = NOELLE_parseListOfIDs(NOELLE_readSysFile(nodeDir + "node" + std::to_string(nodeID) + "/cpulist"));
+    for (auto coreID : coresOfNode){
+      if (coreID >= NUMANodeOfCore.size()){
+        NUMANodeOfCore.resize(coreID + 1, 0);
+      }
+      NUMANodeOfCore[coreID] = nodeID;
+    }
+  }
+
+  /*
+   * Describe the online logical cores.
+   */
+  std::string cpuDir = "/sys/devices/system/cpu/";
+  for (auto coreID : NOELLE_parseListOfIDs(NOELLE_readSysFile(cpuDir + "online"))){
+    auto coreDir = cpuDir + "cpu" + std::to_string(coreID) + "/";
+    NOELLE_logicalCore_t core;
+    core.ID = coreID;
+
+    /*
+     * Physical core.
+     */
+    auto siblings = NOELLE_parseListOfIDs(NOELLE_readSysFile(coreDir + "topology/thread_siblings_list"));
+    core.physicalCoreID = siblings.empty() ? coreID : siblings.front();
+    core.SMTIndex = std::find(siblings.begin(), siblings.end(), coreID) - siblings.begin();
+
+    /*
+     * Last-level cache: the cache with the highest level.
+     */
+    core.lastLevelCacheID = core.physicalCoreID;
+    core.lastLevelCacheBytes = 0;
+    auto lastLevel = 0;
+    for (auto index = 0; ; index++){
+      auto cacheDir = coreDir + "cache/index" + std::to_string(index) + "/";
+      auto level = NOELLE_readSysFile(cacheDir + "level");
+      if (level.empty()){
+        break ;
+      }
+      if (atoi(level.c_str()) < lastLevel){
+        continue ;
+      }
+      lastLevel = atoi(level.c_str());
+      auto sharingCores = NOELLE_parseListOfIDs(NOELLE_readSysFile(cacheDir + "shared_cpu_list"));
+      if (!sharingCores.empty()){
+        core.lastLevelCacheID = sharingCores.front();
+      }
+      core.lastLevelCacheBytes = NOELLE_parseCacheSize(NOELLE_readSysFile(cacheDir + "size"));
+    }
+
+    /*
+     * NUMA node.
+     */
+    core.NUMANodeID = (coreID < NUMANodeOfCore.size()) ? NUMANodeOfCore[coreID] : 0;
+
+    cores.push_back(core);
+  }
+
+  return cores;
+}
@@ -1,20 +1,32 @@
 #include <future>
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <pthread.h>
+#include <sched.h>
 #include <functional>
 #include <memory>
+#include <new>
 #include <thread>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 
-#include <ThreadSafeQueue.hpp>
-#include <ThreadSafeLockFreeQueue.hpp>
 #include <ThreadPools.hpp>
 
+#include "NoelleTopology.hpp"
+
 #include <condition_variable>
 #include <mutex>
 #include <queue>
@@ -39,872 +51,3144 @@ static int64_t numberOfPushes32 = 0;
 static int64_t numberOfPushes64 = 0;
 #endif
     
-typedef struct {
-  void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t) ;
-  void *env ;
-  int64_t coreID ;
-  int64_t numCores;
-  int64_t chunkSize ;
-  pthread_spinlock_t endLock;
-} DOALL_args_t ;
+/*
+ * Pause the current core while spinning.
+ */
+static inline void NOELLE_cpuRelax (void){
+  #if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+  #elif defined(__aarch64__)
+  asm volatile("yield");
+  #endif
+}
 
-class NoelleRuntime {
+/*
+ * Single-producer single-consumer queue used by DSWP stages.
+ *
+ * Values are published in batches that fill a cache line, so the producer and the consumer synchronize once per cache line rather than once per value.
+ * The producer must call flush when it stops producing (e.g., at the end of a pipeline stage) to publish the values of the last partial batch.
+ *
+ * A stage can produce values for several stages (e.g., A->B and A->C), and a stage that waits for another one could wait for values that stage holds unpublished in a queue other than the one it waits on.
+ * Hence, a stage publishes the pending values of every queue it produces into before waiting on any queue (see flushQueuesOfCurrentStage).
+ *
+ * This part of the queue does not depend on the type of its values.
+ */
+class alignas(CACHE_LINE_SIZE) BatchedSPSCQueueBase {
   public:
-    NoelleRuntime ();
-
-    uint32_t reserveCores (uint32_t coresRequested);
 
-    void releaseCores (uint32_t coresReleased);
-
-    DOALL_args_t * getDOALLArgs (uint32_t cores, uint32_t *index);
-
-    void releaseDOALLArgs (uint32_t index);
+    void flush (void){
+      this->published.store(this->producerIndex, std::memory_order_release);
 
-    ThreadPoolForCSingleQueue *virgil;
+      return ;
+    }
 
-    ~NoelleRuntime(void);
+    /*
+     * Publish the pending values of every queue the current stage produces into.
+     */
+    static void flushQueuesOfCurrentStage (void);
 
-  private:
-    mutable pthread_spinlock_t doallMemoryLock;
-    std::vector<uint32_t> doallMemorySizes;
-    std::vector<bool> doallMemoryAvailability;
-    std::vector<DOALL_args_t *> doallMemory;
+    /*
+     * Forget the queues produced by the current stage, which has ended (queues do not outlive the invocation of the pipeline).
+     */
+    static void currentStageEnds (void);
+
+  protected:
+    BatchedSPSCQueueBase ()
+      : published{0}
+      , consumed{0}
+      , producerIndex{0}
+      , cachedConsumed{0}
+      , isRegisteredByProducer{false}
+      , consumerIndex{0}
+      , cachedPublished{0}
+      {
+      return ;
+    }
 
-    uint32_t getMaximumNumberOfCores (void);
+    /*
+     * Remember that the current stage produces into "this".
+     */
+    __attribute__((noinline, cold)) void registerProducer (void);
 
     /*
-     * Current number of idle cores.
+     * Number of values published by the producer and released by the consumer.
      */
-    int32_t NOELLE_idleCores;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> published;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> consumed;
 
     /*
-     * Maximum number of cores.
+     * State private to the producer.
      */
-    uint32_t maxCores;
+    alignas(CACHE_LINE_SIZE) uint64_t producerIndex;
+    uint64_t cachedConsumed;
+    bool isRegisteredByProducer;
 
-    mutable pthread_spinlock_t spinLock;
+    /*
+     * State private to the consumer.
+     */
+    alignas(CACHE_LINE_SIZE) uint64_t consumerIndex;
+    uint64_t cachedPublished;
 };
 
-#ifdef RUNTIME_PROFILE
-pthread_spinlock_t printLock;
-uint64_t clocks_starts[64];
-uint64_t clocks_ends[64];
-uint64_t clocks_dispatch_starts[64];
-uint64_t clocks_dispatch_ends[64];
-#endif
+/*
+ * Queues the stage running in the current thread produces into.
+ */
+static thread_local std::vector<BatchedSPSCQueueBase *> NOELLE_queuesProducedByCurrentStage;
 
-static NoelleRuntime runtime{};
+void BatchedSPSCQueueBase::registerProducer (void){
+  NOELLE_queuesProducedByCurrentStage.push_back(this);
+  this->isRegisteredByProducer = true;
 
-extern "C" {
+  return ;
+}
 
-  /******************************************** NOELLE APIs ***********************************************/
+void BatchedSPSCQueueBase::flushQueuesOfCurrentStage (void){
+  for (auto queue : NOELLE_queuesProducedByCurrentStage){
+    queue->flush();
+  }
 
-  class DispatcherInfo {
-    public:
-      int32_t numberOfThreadsUsed;
-      int64_t unusedVariableToPreventOptIfStructHasOnlyOneVariable;
-  };
+  return ;
+}
 
-  /*
-   * Dispatch threads to run a DOALL loop.
-   */
-  DispatcherInfo NOELLE_DOALLDispatcher (
-    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t), 
-    void *env, 
-    int64_t maxNumberOfCores, 
-    int64_t chunkSize
-    );
+void BatchedSPSCQueueBase::currentStageEnds (void){
+  NOELLE_queuesProducedByCurrentStage.clear();
 
+  return ;
+}
 
-    #ifdef RUNTIME_PROFILE
-    static __inline__ int64_t rdtsc_s(void) {
-      unsigned a, d; 
-      asm volatile("cpuid" ::: "%rax", "%rbx", "%rcx", "%rdx");
-      asm volatile("rdtsc" : "=a" (a), "=d" (d)); 
-      return ((unsigned long)a) | (((unsigned long)d) << 32); 
-    }
-    static __inline__ int64_t rdtsc_e(void) {
-      unsigned a, d; 
-      asm volatile("rdtscp" : "=a" (a), "=d" (d)); 
-      asm volatile("cpuid" ::: "%rax", "%rbx", "%rcx", "%rdx");
-      return ((unsigned long)a) | (((unsigned long)d) << 32); 
+/*
+ * push and pop are inlined in the pipeline stages by the DSWP code generator.
+ * They only include the fast path, which touches memory private to the caller and the queue slot; waiting on a full or empty queue is kept out of line (noinline), so it does not bloat the stages.
+ */
+template <class T>
+class alignas(CACHE_LINE_SIZE) BatchedSPSCQueue : public BatchedSPSCQueueBase {
+  public:
+    BatchedSPSCQueue ()
+      : BatchedSPSCQueueBase()
+      {
+      return ;
     }
-    #endif
 
+    void push (T value){
 
-  /******************************************** NOELLE API implementations ***********************************************/
+      /*
+       * Remember that the current stage produces into this queue the first time it does.
+       */
+      if (__builtin_expect(!this->isRegisteredByProducer, 0)){
+        this->registerProducer();
+      }
 
-  typedef void (*stageFunctionPtr_t)(void *, void*);
+      /*
+       * Wait for space.
+       */
+      if (__builtin_expect((this->producerIndex - this->cachedConsumed) == BatchedSPSCQueue::capacity, 0)){
+        this->waitForSpace();
+      }
 
-  void printReachedS(std::string s)
-  {
-    auto outS = "Reached: " + s;
-    printf("%s\n",outS.c_str());
-  }
+      /*
+       * Append the value and publish the batch when it fills a cache line.
+       */
+      this->values[this->producerIndex & (BatchedSPSCQueue::capacity - 1)] = value;
+      this->producerIndex++;
+      if ((this->producerIndex % BatchedSPSCQueue::batchSize) == 0){
+        this->published.store(this->producerIndex, std::memory_order_release);
+      }
 
-  void printReachedI(int i){
-    printf("Reached: %d\n",i);
-  }
+      return ;
+    }
 
-  void printPushedP(int32_t *p){
-    printf("Pushed: %p\n", p);
-  }
+    void pop (T &value){
 
-  void printPulledP(int32_t *p){
-    printf("Pulled: %p\n", p);
-  }
+      /*
+       * Wait for a value.
+       */
+      if (__builtin_expect(this->consumerIndex == this->cachedPublished, 0)){
+        this->waitForValues();
+      }
 
-  void queuePush8(ThreadSafeQueue<int8_t> *queue, int8_t *val) { 
-    queue->push(*val); 
+      /*
+       * Take the value and release the batch when we are done with its cache line.
+       */
+      value = this->values[this->consumerIndex & (BatchedSPSCQueue::capacity - 1)];
+      this->consumerIndex++;
+      if ((this->consumerIndex % BatchedSPSCQueue::batchSize) == 0){
+        this->consumed.store(this->consumerIndex, std::memory_order_release);
+      }
 
-    #ifdef DSWP_STATS
-    numberOfPushes8++;
-    #endif
+      return ;
+    }
 
-    return ;
-  }
+    static void * operator new (size_t size){
+      void *memory = nullptr;
+      if (posix_memalign(&memory, CACHE_LINE_SIZE, size) != 0){
+        throw std::bad_alloc();
+      }
+      return memory;
+    }
 
-  void queuePop8(ThreadSafeQueue<int8_t> *queue, int8_t *val) { 
-    queue->waitPop(*val); 
-    return ;
-  }
+    static void operator delete (void *memory){
+      free(memory);
+    }
 
-  void queuePush16(ThreadSafeQueue<int16_t> *queue, int16_t *val) { 
-    queue->push(*val); 
+  private:
 
-    #ifdef DSWP_STATS
-    numberOfPushes16++;
-    #endif
+    /*
+     * Slow path of push.
+     * Publish the values of the current stage first: the consumer could be waiting for them (in this queue or in another one) to free space.
+     */
+    __attribute__((noinline, cold)) void waitForSpace (void){
+      BatchedSPSCQueueBase::flushQueuesOfCurrentStage();
+      while (true){
+        this->cachedConsumed = this->consumed.load(std::memory_order_acquire);
+        if ((this->producerIndex - this->cachedConsumed) < BatchedSPSCQueue::capacity){
+          break ;
+        }
+        NOELLE_cpuRelax();
+      }
 
-    return ;
-  }
+      return ;
+    }
 
-  void queuePop16(ThreadSafeQueue<int16_t> *queue, int16_t *val) { 
-    queue->waitPop(*val);
-  }
+    /*
+     * Slow path of pop.
+     * Release the values consumed so far first: the producer could be waiting for them to free space.
+     * Also publish the values of the current stage: the producer could be waiting for them, directly or through other stages.
+     */
+    __attribute__((noinline, cold)) void waitForValues (void){
+      this->consumed.store(this->consumerIndex, std::memory_order_release);
+      BatchedSPSCQueueBase::flushQueuesOfCurrentStage();
+      while (true){
+        this->cachedPublished = this->published.load(std::memory_order_acquire);
+        if (this->consumerIndex != this->cachedPublished){
+          break ;
+        }
+        NOELLE_cpuRelax();
+      }
 
-  void queuePush32(ThreadSafeQueue<int32_t> *queue, int32_t *val) { 
-    queue->push(*val); 
+      return ;
+    }
 
-    #ifdef DSWP_STATS
-    numberOfPushes32++;
-    #endif
+    static const uint64_t batchSize = CACHE_LINE_SIZE / sizeof(T);
+    static const uint64_t capacity = 256 * batchSize;
 
-    return ;
-  }
+    alignas(CACHE_LINE_SIZE) T values[capacity];
+};
 
-  void queuePop32(ThreadSafeQueue<int32_t> *queue, int32_t *val) { 
-    queue->waitPop(*val);
-  }
+/*
+ * Task of the work-stealing pool.
+ */
+typedef struct {
+  void (*function)(void *) ;
+  void *args ;
+} WorkStealingTask ;
 
-  void queuePush64(ThreadSafeQueue<int64_t> *queue, int64_t *val) { 
-    queue->push(*val); 
+/*
+ * Chase-Lev deque of tasks.
+ * Only the owner pushes and pops tasks at the bottom, while other threads steal them from the top.
+ */
+class WorkStealingDeque {
+  public:
+    WorkStealingDeque ();
 
-    #ifdef DSWP_STATS
-    numberOfPushes64++;
-    #endif
+    void push (WorkStealingTask *task);
 
-    return ;
-  }
+    WorkStealingTask * pop (void);
 
-  void queuePop64(ThreadSafeQueue<int64_t> *queue, int64_t *val) { 
-    queue->waitPop(*val); 
+    WorkStealingTask * steal (void);
 
-    return ;
-  }
+    bool isEmpty (void) const ;
 
+    ~WorkStealingDeque ();
 
-  /**********************************************************************
-   *                DOALL
-   **********************************************************************/
-  static void NOELLE_DOALLTrampoline (void *args){
-    #ifdef RUNTIME_PROFILE
-    auto clocks_start = rdtsc_s();
-    #endif
+  private:
+    class Buffer {
+      public:
+        Buffer (int64_t capacity);
 
-    /*
-     * Fetch the arguments.
-     */
-    auto DOALLArgs = (DOALL_args_t *) args;
+        int64_t capacity;
+        std::atomic<WorkStealingTask *> *tasks;
 
-    /*
-     * Invoke
-     */
-    DOALLArgs->parallelizedLoop(DOALLArgs->env, DOALLArgs->coreID, DOALLArgs->numCores, DOALLArgs->chunkSize);
-    #ifdef RUNTIME_PROFILE
-    auto clocks_end = rdtsc_e();
-    clocks_starts[DOALLArgs->coreID] = clocks_start;
-    clocks_ends[DOALLArgs->coreID] = clocks_end;
-    #endif
+        WorkStealingTask * get (int64_t index) const ;
 
-    pthread_spin_unlock(&(DOALLArgs->endLock));
-    return ;
-  }
+        void put (int64_t index, WorkStealingTask *task);
 
-  DispatcherInfo NOELLE_DOALLDispatcher (
-    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t), 
-    void *env, 
-    int64_t maxNumberOfCores, 
-    int64_t chunkSize
-    ){
-    #ifdef RUNTIME_PROFILE
-    auto clocks_start = rdtsc_s();
-    #endif
+        ~Buffer ();
+    };
 
     /*
-     * Fetch VIRGIL
+     * Thieves update the top while the owner updates the bottom: keep them in different cache lines.
      */
-    auto virgil = runtime.virgil;
+    std::atomic<int64_t> top;
+    char topPadding[CACHE_LINE_SIZE - sizeof(std::atomic<int64_t>)];
+    std::atomic<int64_t> bottom;
+    std::atomic<Buffer *> buffer;
 
     /*
-     * Set the number of cores to use.
+     * Buffers replaced by bigger ones.
+     * They are freed only when the deque is destroyed because thieves could still be reading them.
      */
-    auto numCores = runtime.reserveCores(maxNumberOfCores);
-    #ifdef RUNTIME_PRINT
-    std::cerr << "Starting dispatcher: num cores " << numCores << ", chunk size: " << chunkSize << std::endl;
-    #endif
+    std::vector<Buffer *> retiredBuffers;
+};
+
+/*
+ * Pool of threads that execute tasks taken from their own deque or stolen from the deques of the other threads.
+ * Tasks submitted by a thread of the pool are pushed to its own deque, so nested parallel regions do not contend on a shared queue.
+ * Tasks submitted by other threads go to a shared injection queue.
+ */
+class WorkStealingPool {
+  public:
 
     /*
-     * Allocate the memory to store the arguments.
+     * @logicalCoresOfWorkers lists the logical core each worker is pinned to (empty to let them float).
      */
-    uint32_t doallMemoryIndex;
-    auto argsForAllCores = runtime.getDOALLArgs(numCores - 1, &doallMemoryIndex);
+    WorkStealingPool (uint32_t numberOfWorkers, const std::vector<int32_t> &logicalCoresOfWorkers);
+
+    void submit (WorkStealingTask *task);
 
     /*
-     * Submit DOALL tasks.
+     * Execute tasks of the pool until @isDone returns true.
+     * Threads waiting for their tasks must help: the tasks they wait for could be queued behind them.
      */
-    for (auto i = 0; i < (numCores - 1); ++i) {
+    template <class Predicate>
+    void helpUntil (Predicate isDone){
+      auto workerID = (WorkStealingPool::currentPool == this) ? WorkStealingPool::currentWorkerID : -1;
+      auto victimSeed = (uint32_t)(uintptr_t)&workerID;
+      while (!isDone()){
+        auto task = this->fetchTask(workerID, &victimSeed);
+        if (task == nullptr){
+          std::this_thread::yield();
+          continue ;
+        }
+        task->function(task->args);
+      }
 
-      /*
-       * Prepare the arguments.
-       */
-      auto argsPerCore = &argsForAllCores[i];
-      argsPerCore->parallelizedLoop = parallelizedLoop;
-      argsPerCore->env = env;
-      argsPerCore->numCores = numCores;
-      argsPerCore->chunkSize = chunkSize;
+      return ;
+    }
 
-      #ifdef RUNTIME_PROFILE
-      clocks_dispatch_starts[i] = rdtsc_s();
-      #endif
+    /*
+     * Check if there are tasks that no thread has started yet.
+     */
+    bool hasTasks (void) const ;
 
-      /*
-       * Submit
-       */
-      virgil->submitAndDetach(NOELLE_DOALLTrampoline, argsPerCore);
+    ~WorkStealingPool ();
 
-      #ifdef RUNTIME_PROFILE
-      clocks_dispatch_ends[i] = rdtsc_s();
-      #endif
-      #ifdef RUNTIME_PRINT
-      std::cerr << "Submitted DOALL task on core " << i << std::endl;
-      #endif
-    }
-    #ifdef RUNTIME_PRINT
-    std::cerr << "Submitted pool" << std::endl;
-    #endif
-    #ifdef RUNTIME_PROFILE
-    auto clocks_after_fork = rdtsc_e();
-    #endif
+  private:
+    std::vector<WorkStealingDeque *> deques;
+    std::vector<std::thread> workers;
+    std::atomic<bool> isAlive;
 
     /*
-     * Run a task.
+     * Tasks submitted by threads outside the pool.
      */
-    parallelizedLoop(env, numCores - 1, numCores, chunkSize);
+    std::mutex injectionLock;
+    std::queue<WorkStealingTask *> injectionQueue;
+    std::atomic<int64_t> injectedTasks;
 
     /*
-     * Wait for the remaining DOALL tasks.
+     * Idle workers sleep here after spinning for a while.
      */
-    #ifdef RUNTIME_PROFILE
-    auto clocks_before_join = rdtsc_s();
-    #endif
-    for (auto i = 0; i < (numCores - 1); ++i) {
-      pthread_spin_lock(&(argsForAllCores[i].endLock));
-    }
-    #ifdef RUNTIME_PRINT
-    std::cerr << "All tasks completed" << std::endl;
-    #endif
-    #ifdef RUNTIME_PROFILE
-    auto clocks_after_join = rdtsc_e();
-    auto clocks_before_cleanup = rdtsc_s();
-    #endif
+    std::mutex sleepLock;
+    std::condition_variable sleepCondition;
+    std::atomic<uint32_t> sleepingWorkers;
+
+    std::vector<int32_t> logicalCoresOfWorkers;
+
+    void runWorker (uint32_t workerID);
+
+    WorkStealingTask * fetchTask (int32_t workerID, uint32_t *victimSeed);
 
     /*
-     * Free the cores and memory.
+     * ID of the worker of the pool executed by the current thread (-1 if the thread does not belong to the pool).
      */
-    runtime.releaseCores(numCores);
-    runtime.releaseDOALLArgs(doallMemoryIndex);
+    static thread_local int32_t currentWorkerID;
+    static thread_local WorkStealingPool *currentPool;
+};
+
+/*
+ * Barrier used by a dispatcher to wait for the tasks it submitted.
+ * Tasks decrement a single counter when they complete.
+ * The dispatcher spins on the counter for a while and then sleeps on a futex, so long joins do not keep its core busy.
+ *
+ * There is one barrier per dispatch.
+ */
+class alignas(CACHE_LINE_SIZE) CompletionBarrier {
+  public:
+    CompletionBarrier (uint32_t numberOfTasks);
 
     /*
-     * Prepare the return value.
+     * Declare the completion of a task.
      */
-    DispatcherInfo dispatcherInfo;
-    dispatcherInfo.numberOfThreadsUsed = numCores;
-    #ifdef RUNTIME_PROFILE
-    auto clocks_after_cleanup = rdtsc_s();
-    pthread_spin_lock(&printLock);
-    std::cerr << "XAN: Start         = " << clocks_start << "\n";
-    std::cerr << "XAN: Setup overhead         = " << clocks_after_fork - clocks_start << " clocks\n";
-    uint64_t totalDispatch = 0;
-    for (auto i=0; i < (numCores - 1); i++){
-      totalDispatch += (clocks_dispatch_ends[i] - clocks_dispatch_starts[i]);
-    }
-    std::cerr << "XAN:    Dispatch overhead         = " << totalDispatch << " clocks\n";
-    std::cerr << "XAN: Start joining = " << clocks_after_fork << "\n";
-    for (auto i=0; i < (numCores - 1); i++){
-      std::cerr << "Thread " << i << ": Start = " << clocks_starts[i] << "\n";
-      std::cerr << "Thread " << i << ": End   = " << clocks_ends[i] << "\n";
-      std::cerr << "Thread " << i << ": Delta = " << clocks_ends[i] - clocks_starts[i] << "\n";
-    }
-    std::cerr << "XAN: Joined        = " << clocks_after_join << "\n";
-    std::cerr << "XAN: Joining delta = " << clocks_after_join - clocks_before_join << "\n";
+    void arrive (void);
 
-    uint64_t start_min = 0;
-    uint64_t start_max = 0;
-    for (auto i=0; i < (numCores - 1); i++){
-      if (  false
-            || (start_min == 0)
-            || (clocks_starts[i] < start_min)
-        ){
-        start_min = clocks_starts[i];
-      }
-      if (clocks_starts[i] > start_max){
-        start_max = clocks_starts[i];
-      }
-    }
-    std::cerr << "XAN: Thread starts min = " << start_min << "\n";
-    std::cerr << "XAN: Thread starts max = " << start_max << "\n";
-    std::cerr << "XAN: Task starting overhead = " << start_max - start_min << "\n";
+    bool isCompleted (void) const ;
 
-    uint64_t end_max = 0;
-    uint64_t lastThreadID = 0;
-    for (auto i=0; i < (numCores - 1); i++){
-      if (clocks_ends[i] > end_max){
-        lastThreadID = i;
-        end_max = clocks_ends[i];
-      }
-    }
-    std::cerr << "XAN: Last thread ended = " << end_max << " (thread " << lastThreadID << ")\n";
-    std::cerr << "XAN: Joining overhead       = " << clocks_after_join - end_max << "\n";
+    /*
+     * Wait for all tasks to complete: spin for @spinBudget rounds and then sleep.
+     *
+     * @return true if the caller had to sleep.
+     */
+    bool wait (uint64_t spinBudget);
 
-    pthread_spin_unlock(&printLock);
-    #endif
+  private:
 
-    return dispatcherInfo;
-  }
+    /*
+     * Number of tasks that did not complete yet.
+     * The highest bit is set when the dispatcher sleeps, so only the last task of a sleeping dispatcher pays for the system call that wakes it up.
+     */
+    std::atomic<uint32_t> pending;
 
-  #ifdef RUNTIME_PRINT
-  void *mySSGlobal = nullptr;
-  #endif
+    static const uint32_t sleepingBit = 0x80000000u;
+};
 
+/*
+ * Schedules of the iterations of a DOALL loop.
+ * They must match the DOALLSchedule IDs used by the compiler.
+ */
+enum {
+  NOELLE_DOALL_STATIC_SCHEDULE = 1,
+  NOELLE_DOALL_DYNAMIC_SCHEDULE = 2,
+  NOELLE_DOALL_GUIDED_SCHEDULE = 3
+};
 
-  /**********************************************************************
-   *                HELIX
-   **********************************************************************/
-  typedef struct {
-    void (*parallelizedLoop)(void *, void *, void *, void *, int64_t, int64_t, uint64_t *);
-    void *env ;
-    void *loopCarriedArray;
-    void *ssArrayPast;
-    void *ssArrayFuture;
-    uint64_t coreID;
-    uint64_t numCores;
-    uint64_t *loopIsOverFlag;
-    pthread_spinlock_t endLock;
-  } NOELLE_HELIX_args_t ;
+/*
+ * Parallelization techniques.
+ * They must match the Transformation IDs used by the compiler.
+ */
+enum {
+  NOELLE_DOALL_TECHNIQUE = 0,
+  NOELLE_DSWP_TECHNIQUE = 1,
+  NOELLE_HELIX_TECHNIQUE = 2
+};
 
-  static void NOELLE_HELIXTrampoline (void *args){
+/*
+ * Chunk-related state of a single core executing a DOALL loop with a dynamic or guided schedule.
+ */
+typedef struct alignas(CACHE_LINE_SIZE) {
+  int64_t lastChunkEnd;
+  int64_t nextChunkStart;
+  int64_t chunksLeft;
+} DOALL_chunk_state_t ;
+
+/*
+ * Iteration counter shared among the cores executing a DOALL loop with a dynamic or guided schedule.
+ */
+typedef struct {
+  alignas(CACHE_LINE_SIZE) std::atomic<int64_t> nextIteration;
+  alignas(CACHE_LINE_SIZE) int64_t schedule;
+  int64_t chunkSize;
+  int64_t numCores;
+  int64_t expectedIterations;
+  DOALL_chunk_state_t *chunkStates;
+} DOALL_scheduler_t ;
+
+typedef struct {
+  void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t, void *) ;
+  void *env ;
+  int64_t coreID ;
+  int64_t numCores;
+  int64_t chunkSize ;
+  void *scheduler ;
+  CompletionBarrier *barrier ;
+  int32_t logicalCore ;
+  WorkStealingTask workStealingTask ;
+} DOALL_args_t ;
+
+/*
+ * Team of threads that persists across the invocations of DOALL loops (environment variable NOELLE_DOALL_TEAM).
+ *
+ * Between invocations, each worker is parked on its own generation counter.
+ * The dispatcher starts a worker by writing the arguments of the worker and bumping its counter.
+ * This avoids allocating the arguments and going through a task queue at every invocation, which dominates short loops invoked many times.
+ *
+ * Only one loop at a time can use the team: loops dispatched while the team is busy go through the thread pools.
+ */
+class DOALLTeam {
+  public:
 
     /*
-     * Fetch the arguments.
+     * @logicalCoresOfWorkers lists the logical core each worker is pinned to (empty to let them float).
+     * Parked workers spin for @spinBudget rounds before sleeping.
      */
-    auto HELIX_args = (NOELLE_HELIX_args_t *) args;
+    DOALLTeam (uint32_t numberOfWorkers, const std::vector<int32_t> &logicalCoresOfWorkers, uint64_t spinBudget);
 
     /*
-     * Invoke
+     * Take the exclusive use of the team.
+     *
+     * @return false if another loop is using the team.
      */
-    HELIX_args->parallelizedLoop(
-      HELIX_args->env, 
-      HELIX_args->loopCarriedArray, 
-      HELIX_args->ssArrayPast, 
-      HELIX_args->ssArrayFuture, 
-      HELIX_args->coreID,
-      HELIX_args->numCores,
-      HELIX_args->loopIsOverFlag
-      );
+    bool tryAcquire (void);
 
-    pthread_spin_unlock(&(HELIX_args->endLock));
-    return ;
-  }
+    void release (void);
+
+    uint32_t getNumberOfWorkers (void) const ;
+
+    /*
+     * Return the arguments of the worker @workerID.
+     * They are set by the dispatcher before starting the worker.
+     */
+    DOALL_args_t * getArgs (uint32_t workerID);
+
+    /*
+     * Return the chunk states of the cores (one per worker plus one for the dispatcher).
+     */
+    DOALL_chunk_state_t * getChunkStates (void);
+
+    /*
+     * Start the worker @workerID on its arguments.
+     */
+    void start (uint32_t workerID);
 
-  static void HELIX_helperThread (void *ssArray, uint32_t numOfsequentialSegments, uint64_t *theLoopIsOver){
+    ~DOALLTeam ();
 
-    while ((*theLoopIsOver) == 0){
+  private:
+    typedef struct alignas(CACHE_LINE_SIZE) {
+      DOALL_args_t args;
 
       /*
-       * Prefetch all sequential segment cache lines of the current loop iteration.
+       * Number of times the worker has been started.
+       * The highest bit is set when the worker sleeps, so the dispatcher pays for the system call only if it has to wake the worker up.
        */
-      for (auto i = 0 ; ((*theLoopIsOver) == 0) && (i < numOfsequentialSegments); i++){
+      alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> generation;
+    } Worker ;
 
-        /*
-         * Fetch the pointer.
-         */
-        auto ptr = (uint64_t *)(((uint64_t)ssArray) + (i * CACHE_LINE_SIZE));
+    uint32_t numberOfWorkers;
+    Worker *teamWorkers;
+    DOALL_chunk_state_t *chunkStates;
+    std::vector<std::thread> threads;
+    std::atomic<bool> isAlive;
+    std::atomic<bool> isBusy;
+    uint64_t spinBudget;
 
-        /*
-         * Prefetch the cache line for the current sequential segment.
-         */
-        while (((*theLoopIsOver) == 0) && ((*ptr) == 0)) ;
-      }
-    }
+    static const uint32_t sleepingBit = 0x80000000u;
 
-    return ;
-  }
+    void runWorker (uint32_t workerID, int32_t logicalCore);
+};
 
-  static DispatcherInfo NOELLE_HELIX_dispatcher (
-    void (*parallelizedLoop)(void *, void *, void *, void *, int64_t, int64_t, uint64_t *), 
-    void *env,
-    void *loopCarriedArray,
-    int64_t maxNumberOfCores, 
-    int64_t numOfsequentialSegments,
-    bool LIO
-    ){
-    #ifdef RUNTIME_PRINT
-    std::cerr << "HELIX: dispatcher: Start" << std::endl;
-    std::cerr << "HELIX: dispatcher:  Number of sequential segments = " << numOfsequentialSegments << std::endl;
-    std::cerr << "HELIX: dispatcher:  Number of cores = " << numCores << std::endl;
-    #endif
+/*
+ * Policies to pin the threads that execute parallel tasks (environment variable NOELLE_AFFINITY).
+ */
+enum NoelleAffinity {
+  NOELLE_AFFINITY_NONE,   /* Threads are not pinned ("none", default). */
+  NOELLE_AFFINITY_SMT,    /* Consecutive tasks share a physical core first, then the last-level cache ("smt"). */
+  NOELLE_AFFINITY_LLC     /* Consecutive tasks run on different physical cores that share the last-level cache; SMT siblings are used last ("llc"). */
+};
 
-    /*
-     * Assumptions.
-     */
-    assert(parallelizedLoop != NULL);
-    assert(env != NULL);
-    assert(maxNumberOfCores > 1);
+/*
+ * How HELIX cores wait for a sequential segment (environment variable NOELLE_HELIX_WAIT).
+ */
+enum NoelleHELIXWait {
+  NOELLE_HELIX_WAIT_BACKOFF,  /* Pause for exponentially longer between checks and then yield the core ("backoff", default). */
+  NOELLE_HELIX_WAIT_POLL      /* Check continuously without pausing ("poll"). */
+};
+
+/*
+ * Configuration of a tunable loop chosen by the autotuner (environment variable NOELLE_TUNING_CONFIG).
+ * A value of 0 keeps the one chosen by the compiler (-1 for the technique).
+ */
+typedef struct {
+  bool parallel;
+  int64_t technique;
+  int64_t cores;
+  int64_t chunkSize;
+  int64_t schedule;
+} NOELLE_tuningConfiguration_t ;
+
+/*
+ * Maximum number of pauses between two checks of a sequential segment before yielding the core.
+ */
+static const uint32_t HELIX_maximumPauses = 16;
+
+class NoelleRuntime {
+  public:
+    NoelleRuntime ();
 
     /*
-     * Fetch VIRGIL
+     * Reserve up to @coresRequested cores.
+     * If @firstCoreSlot is given, it is set to the slot of the first reserved core (see getLogicalCoreOfSlot).
      */
-    auto virgil = runtime.virgil;
+    uint32_t reserveCores (uint32_t coresRequested, uint32_t *firstCoreSlot = nullptr);
+
+    void releaseCores (uint32_t coresReleased);
+
+    DOALL_args_t * getDOALLArgs (uint32_t cores, uint32_t *index);
+
+    void releaseDOALLArgs (uint32_t index);
 
     /*
-     * Reserve the cores.
+     * Return the logical core a task that runs in the core slot @slot has to be pinned to (-1 if threads are not pinned).
+     * Consecutive slots are placed close to each other according to the affinity policy, so tasks that communicate with their neighbours (DSWP stages, HELIX cores) share a cache.
      */
-    auto numCores = runtime.reserveCores(maxNumberOfCores);
-    assert(numCores >= 1);
+    int32_t getLogicalCoreOfSlot (uint32_t slot) const ;
+
+    ThreadPoolForCSingleQueue *virgil;
 
     /*
-     * Allocate the sequential segment arrays.
-     * We need numCores - 1 arrays.
+     * Number of rounds a dispatcher spins before sleeping while waiting for its tasks (environment variable NOELLE_SPIN_BUDGET).
      */
-    auto numOfSSArrays = numCores;
-    if (!LIO){
-      numOfSSArrays = 1;
-    }
-    void *ssArrays = NULL;
-    auto ssSize = CACHE_LINE_SIZE;
-    auto ssArraySize = ssSize * numOfsequentialSegments;
-    if (numOfsequentialSegments > 0){
+    uint64_t spinBudget;
 
-      /*
-       * Allocate the sequential segment arrays.
-       */
-      posix_memalign(&ssArrays, CACHE_LINE_SIZE, ssArraySize * numOfSSArrays);
-      if (ssArrays == NULL){
-        fprintf(stderr, "HELIX: dispatcher: ERROR = not enough memory to allocate %lld sequential segment arrays\n", (long long)numCores);
-        abort();
-      }
+    NoelleHELIXWait helixWait;
 
-      /*
-       * Initialize the sequential segment arrays.
-       */
-      for (auto i = 0; i < numOfSSArrays; i++){
+    /*
+     * Run small invocations of parallelized loops sequentially (environment variable NOELLE_SEQUENTIAL_FALLBACK).
+     */
+    bool sequentialFallback;
 
-        /*
-         * Fetch the current sequential segment array.
-         */
-        auto ssArray = (void *)(((uint64_t)ssArrays) + (i * ssArraySize));
+    uint32_t getNumberOfCores (void) const ;
 
-        /*
-         * Initialize the locks.
-         */
-        for (auto lockID = 0; lockID < numOfsequentialSegments; lockID++){
+    /*
+     * Return the configuration of the tunable loop @loopID (nullptr if the loop has not been configured).
+     */
+    const NOELLE_tuningConfiguration_t * getTuningConfiguration (int64_t loopID) const ;
 
-          /*
-           * Fetch the pointer to the current lock.
-           */
-          auto lock = (pthread_spinlock_t *)(((uint64_t)ssArray) + (lockID * ssSize));
+    /*
+     * Return the pool used to run DOALL tasks (nullptr unless NOELLE_THREAD_POOL=work_stealing).
+     * The pool is created by the first DOALL loop that needs it, so programs without DOALL loops only pay for the threads of VIRGIL.
+     * HELIX and DSWP tasks communicate among each other while running, so they need the dedicated threads of VIRGIL.
+     */
+    WorkStealingPool * getWorkStealingPool (void);
 
-          /*
-           * Initialize the lock.
-           */
-          pthread_spin_init(lock, PTHREAD_PROCESS_PRIVATE);
+    /*
+     * Persistent team used by DOALL loops that are not nested (nullptr unless NOELLE_DOALL_TEAM=on).
+     */
+    DOALLTeam *doallTeam;
 
-          /*
-           * If the sequential segment is not for core 0, then we need to lock it.
-           */
-          if (i > 0){
-            pthread_spin_lock(lock);
-          }
-        }
-      }
-    }
+    ~NoelleRuntime(void);
 
-    #ifdef RUNTIME_PRINT
-    mySSGlobal = ssArrays;
-    #endif
+  private:
+    NoelleAffinity affinity;
 
     /*
-     * Allocate the arguments for the cores.
+     * Logical cores ordered according to the affinity policy.
      */
-    NOELLE_HELIX_args_t *argsForAllCores;
-    posix_memalign((void **)&argsForAllCores, CACHE_LINE_SIZE, sizeof(NOELLE_HELIX_args_t) * (numCores - 1));
+    std::vector<uint32_t> logicalCoresOrder;
 
     /*
-     * Launch threads
+     * Number of physical cores of the machine (0 if unknown).
      */
-    uint64_t loopIsOverFlag = 0;
+    uint32_t numberOfPhysicalCores;
+
+    bool useWorkStealingPool;
+    std::once_flag workStealingPoolCreation;
+    WorkStealingPool *workStealingPool;
+
+    mutable pthread_spinlock_t doallMemoryLock;
+    std::vector<uint32_t> doallMemorySizes;
+    std::vector<bool> doallMemoryAvailability;
+    std::vector<DOALL_args_t *> doallMemory;
+
+    /*
+     * Configurations of the tunable loops indexed by loop ID.
+     * They are only written while the runtime is constructed.
+     */
+    std::unordered_map<int64_t, NOELLE_tuningConfiguration_t> tuningConfigurations;
+
+    void loadTuningConfigurations (const char *fileName);
+
+    uint32_t getMaximumNumberOfCores (void);
+
+    /*
+     * Current number of idle cores.
+     */
+    int32_t NOELLE_idleCores;
+
+    /*
+     * Maximum number of cores.
+     */
+    uint32_t maxCores;
+
+    mutable pthread_spinlock_t spinLock;
+};
+
+#ifdef RUNTIME_PROFILE
+pthread_spinlock_t printLock;
+uint64_t clocks_starts[64];
+uint64_t clocks_ends[64];
+uint64_t clocks_dispatch_starts[64];
+uint64_t clocks_dispatch_ends[64];
+#endif
+
+/*
+ * Return the logical cores the program was allowed to run on when the runtime started.
+ */
+static const cpu_set_t & NOELLE_getOriginalCores (void){
+  static cpu_set_t originalCores = [](){
     cpu_set_t cores;
-    for (auto i = 0; i < (numCores - 1); ++i) {
-      #ifdef RUNTIME_PRINT
-      fprintf(stderr, "HelixDispatcher: Creating future for core %d\n", i);
-      #endif
+    CPU_ZERO(&cores);
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &cores) != 0){
+      for (auto core = 0; core < CPU_SETSIZE; core++){
+        CPU_SET(core, &cores);
+      }
+    }
+    return cores;
+  }();
+
+  return originalCores;
+}
+
+/*
+ * Whether the current thread is pinned to a single logical core.
+ */
+static thread_local bool NOELLE_isCurrentThreadPinned = false;
+
+/*
+ * Pin the current thread to @logicalCore.
+ * If @logicalCore is negative, let the current thread run on the cores the program started with again (e.g., a thread of VIRGIL that ran a pinned task before).
+ */
+static void NOELLE_pinCurrentThread (int32_t logicalCore){
+  if (logicalCore < 0){
+    if (NOELLE_isCurrentThreadPinned){
+      pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &NOELLE_getOriginalCores());
+      NOELLE_isCurrentThreadPinned = false;
+    }
+    return ;
+  }
+
+  cpu_set_t cores;
+  CPU_ZERO(&cores);
+  CPU_SET(logicalCore, &cores);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cores);
+  NOELLE_isCurrentThreadPinned = true;
+
+  return ;
+}
+
+static NoelleRuntime runtime{};
+
+/*
+ * Number of DOALL tasks the current thread is executing (they nest when a parallelized loop invokes another one).
+ */
+static thread_local uint32_t DOALLNestingLevel = 0;
+
+/*
+ * Costs measured for the invocations of a parallelized loop.
+ * They are used to run sequentially the invocations that are too small to pay off the dispatch of the parallelized loop.
+ */
+typedef struct alignas(CACHE_LINE_SIZE) {
+
+  /*
+   * ID of the loop plus one (0 if the entry is free).
+   */
+  std::atomic<int64_t> key;
+
+  std::atomic<uint64_t> invocations;
+
+  /*
+   * Average time (in nanoseconds) of an iteration of the original sequential loop.
+   */
+  std::atomic<uint64_t> sequentialInvocations;
+  std::atomic<double> sequentialIterationTime;
+
+  /*
+   * Average time (in nanoseconds) and number of iterations of an invocation of the parallelized loop.
+   */
+  std::atomic<uint64_t> parallelInvocations;
+  std::atomic<double> parallelTime;
+  std::atomic<double> parallelIterations;
+} NOELLE_loopCosts_t ;
+
+/*
+ * Number of loops whose costs can be tracked.
+ */
+static const uint32_t NOELLE_loopCostsTableSize = 4096;
+
+/*
+ * Number of entries probed to find the costs of a loop before giving up.
+ */
+static const uint32_t NOELLE_loopCostsProbes = 8;
+
+/*
+ * Number of invocations the running averages of the costs are computed over.
+ */
+static const double NOELLE_loopCostsWindow = 8.0;
+
+/*
+ * Period (in invocations) after which a loop tries the choice the costs do not suggest.
+ */
+static const uint64_t NOELLE_loopCostsExplorationPeriod = 256;
+
+static NOELLE_loopCosts_t NOELLE_loopCosts[NOELLE_loopCostsTableSize];
+
+/*
+ * Histograms of a loop profiled by the program.
+ * Bucket 0 counts the value 0 and bucket k counts the values in [2^(k-1), 2^k).
+ */
+typedef struct {
+  std::atomic<uint64_t> invocations;
+  std::atomic<uint64_t> iterations[65];
+  std::atomic<uint64_t> cyclesPerIteration[65];
+} NOELLE_loopProfile_t ;
+
+/*
+ * Period (in invocations of a loop) of the invocations whose cost is measured.
+ */
+static const uint64_t NOELLE_loopProfilerSamplingPeriod = 16;
+
+static NOELLE_loopProfile_t *NOELLE_loopProfiles = nullptr;
+static int64_t NOELLE_loopProfilesCount = 0;
+
+/*
+ * Iterations of the current invocation of a loop whose dependences are profiled.
+ */
+typedef struct {
+  uint64_t invocation;
+  uint64_t iteration;
+} NOELLE_dependenceProfilerLoop_t ;
+
+/*
+ * Last two iterations of the current invocation that accessed a word through the source of a dependence.
+ */
+typedef struct {
+  uint64_t lastIteration;
+  uint64_t previousIteration;
+} NOELLE_dependenceProfilerShadow_t ;
+
+/*
+ * The shadow of the memory accessed by the source of a dependence is kept per word (2^NOELLE_dependenceProfilerWordBits bytes).
+ * Hence, accesses to different bytes of the same word are considered to access the same location: this can only report manifestations that did not happen.
+ *
+ * Words are grouped in pages of 2^NOELLE_dependenceProfilerPageBits words that are allocated the first time the source accesses one of their words.
+ * A page is reset the first time it is accessed by a new invocation of the loop.
+ */
+static const uint64_t NOELLE_dependenceProfilerWordBits = 3;
+static const uint64_t NOELLE_dependenceProfilerPageBits = 12;
+
+typedef struct {
+  uint64_t invocation;
+  NOELLE_dependenceProfilerShadow_t words[1 << NOELLE_dependenceProfilerPageBits];
+} NOELLE_dependenceProfilerPage_t ;
+
+/*
+ * A profiled loop-carried memory dependence.
+ * A check is an execution of its destination, and the dependence manifests when the destination accesses a word the source accessed in an earlier iteration of the same invocation.
+ */
+typedef struct {
+  const char *description;
+  uint64_t checks;
+  uint64_t manifestations;
+  std::unordered_map<uintptr_t, NOELLE_dependenceProfilerPage_t *> pages;
+  uintptr_t lastPageNumber;                     /* Last page accessed, which is likely to be accessed next. */
+  NOELLE_dependenceProfilerPage_t *lastPage;
+} NOELLE_dependenceProfile_t ;
+
+static NOELLE_dependenceProfilerLoop_t *NOELLE_dependenceProfilerLoops = nullptr;
+static NOELLE_dependenceProfile_t *NOELLE_dependenceProfiles = nullptr;
+static int64_t NOELLE_dependenceProfilesCount = 0;
+
+/*
+ * Fetch the costs of the loop @loopID, allocating them if this is the first invocation of the loop.
+ *
+ * @return nullptr if the table is full.
+ */
+static NOELLE_loopCosts_t * NOELLE_fetchLoopCosts (int64_t loopID){
+  auto key = loopID + 1;
+  for (auto i = 0u; i < NOELLE_loopCostsProbes; i++){
+    auto costs = &NOELLE_loopCosts[(((uint64_t)loopID) + i) % NOELLE_loopCostsTableSize];
+    auto currentKey = costs->key.load(std::memory_order_acquire);
+    if (  true
+          && (currentKey == 0)
+          && costs->key.compare_exchange_strong(currentKey, key, std::memory_order_acq_rel)
+       ){
+      return costs;
+    }
+
+    /*
+     * The entry could have been taken by another invocation of the same loop after we read it.
+     */
+    if (currentKey == key){
+      return costs;
+    }
+  }
+
+  return nullptr;
+}
+
+extern "C" {
+
+  /******************************************** NOELLE APIs ***********************************************/
+
+  class DispatcherInfo {
+    public:
+      int32_t numberOfThreadsUsed;
+      int64_t unusedVariableToPreventOptIfStructHasOnlyOneVariable;
+  };
+
+  /*
+   * Dispatch threads to run a DOALL loop.
+   *
+   * @schedule is one of the NOELLE_DOALL_*_SCHEDULE values.
+   * @expectedIterations is the number of iterations the compiler expects the loop to execute (0 if unknown); it is only used by the guided schedule.
+   */
+  DispatcherInfo NOELLE_DOALLDispatcher (
+    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t, void *), 
+    void *env, 
+    int64_t maxNumberOfCores, 
+    int64_t chunkSize,
+    int64_t schedule,
+    int64_t expectedIterations
+    );
+
+  /*
+   * Assign the next chunk of iterations to the core @coreID of a DOALL loop with a dynamic or guided schedule.
+   *
+   * @return The number of iterations to skip from the end of the chunk previously executed by @coreID to reach the new one.
+   */
+  int64_t NOELLE_DOALLFetchChunk (
+    void *scheduler,
+    int64_t coreID
+    );
+
+  /*
+   * Declare the start of an invocation of the parallelized loop @loopID that will execute @tripCount iterations.
+   * The runtime chooses whether the invocation runs in parallel, on up to @numCores cores, or with the original sequential loop.
+   *
+   * @return A ticket to pass to NOELLE_loopInvocationEnds; its lowest bit is set if the invocation has to run in parallel.
+   */
+  int64_t NOELLE_loopInvocationBegins (
+    int64_t loopID,
+    int64_t tripCount,
+    int64_t numCores
+    );
+
+  /*
+   * Declare the end of an invocation of the parallelized loop @loopID.
+   */
+  void NOELLE_loopInvocationEnds (
+    int64_t loopID,
+    int64_t tripCount,
+    int64_t ticket
+    );
+
+  /*
+   * Return the parallelization technique the autotuner chose for the tunable loop @loopID (see NOELLE_TUNING_CONFIG).
+   * The compiler generated a version of the loop for @technique and possibly for other techniques; the version of @technique runs if the one returned does not exist.
+   */
+  int64_t NOELLE_tunedTechnique (
+    int64_t loopID,
+    int64_t technique
+    );
+
+  /*
+   * Return the number of cores the autotuner chose for the tunable loop @loopID (see NOELLE_TUNING_CONFIG).
+   * The compiler allocated the environment of the loop for @numCores cores, so the number returned is never higher than that.
+   */
+  int64_t NOELLE_tunedNumberOfCores (
+    int64_t loopID,
+    int64_t numCores
+    );
+
+  /*
+   * Return the chunk size the autotuner chose for the tunable DOALL loop @loopID.
+   */
+  int64_t NOELLE_tunedDOALLChunkSize (
+    int64_t loopID,
+    int64_t chunkSize
+    );
+
+  /*
+   * Return the schedule the autotuner chose for the tunable DOALL loop @loopID.
+   * The code of a task differs between the static schedule and the ones that assign chunks on demand, so only the latter can be swapped.
+   */
+  int64_t NOELLE_tunedDOALLSchedule (
+    int64_t loopID,
+    int64_t schedule
+    );
+
+  /*
+   * Allocate the histograms of the @numberOfLoops loops profiled by the program (see noelle-prof-coverage --loops).
+   * The histograms are written to the file NOELLE_LOOP_PROFILE (default "default.loopprof") when the program exits.
+   */
+  void NOELLE_loopProfilerInitialize (
+    int64_t numberOfLoops
+    );
+
+  /*
+   * Declare the start of an invocation of the profiled loop @loopID.
+   *
+   * @return The cycle counter if the invocation is sampled to measure its cost, 0 otherwise.
+   */
+  int64_t NOELLE_loopProfilerInvocationBegins (
+    int64_t loopID
+    );
+
+  /*
+   * Declare the end of an invocation of the profiled loop @loopID that executed @iterations iterations.
+   * @startCycles is the value returned by NOELLE_loopProfilerInvocationBegins.
+   */
+  void NOELLE_loopProfilerInvocationEnds (
+    int64_t loopID,
+    int64_t iterations,
+    int64_t startCycles
+    );
+
+  /*
+   * Allocate the state to profile @numberOfDependences loop-carried memory dependences of @numberOfLoops loops (see noelle-prof-dependences).
+   * @descriptions[i] identifies the dependence i within the profile, which is written to the file NOELLE_DEPENDENCE_PROFILE (default "default.depprof") when the program exits.
+   *
+   * The profiler assumes the program is sequential.
+   */
+  void NOELLE_dependenceProfilerInitialize (
+    int64_t numberOfLoops,
+    int64_t numberOfDependences,
+    const char **descriptions
+    );
+
+  void NOELLE_dependenceProfilerInvocationBegins (
+    int64_t loopID
+    );
+
+  void NOELLE_dependenceProfilerIterationBegins (
+    int64_t loopID
+    );
+
+  /*
+   * Declare that the source of the dependence @dependenceID, which is carried by the loop @loopID, accessed @size bytes starting from @address.
+   */
+  void NOELLE_dependenceProfilerSource (
+    int64_t dependenceID,
+    int64_t loopID,
+    void *address,
+    int64_t size
+    );
+
+  /*
+   * Declare that the destination of the dependence @dependenceID, which is carried by the loop @loopID, accessed @size bytes starting from @address.
+   */
+  void NOELLE_dependenceProfilerDestination (
+    int64_t dependenceID,
+    int64_t loopID,
+    void *address,
+    int64_t size
+    );
+
+
+    #ifdef RUNTIME_PROFILE
+    static __inline__ int64_t rdtsc_s(void) {
+      unsigned a, d; 
+      asm volatile("cpuid" ::: "%rax", "%rbx", "%rcx", "%rdx");
+      asm volatile("rdtsc" : "=a" (a), "=d" (d)); 
+      return ((unsigned long)a) | (((unsigned long)d) << 32); 
+    }
+    static __inline__ int64_t rdtsc_e(void) {
+      unsigned a, d; 
+      asm volatile("rdtscp" : "=a" (a), "=d" (d)); 
+      asm volatile("cpuid" ::: "%rax", "%rbx", "%rcx", "%rdx");
+      return ((unsigned long)a) | (((unsigned long)d) << 32); 
+    }
+    #endif
+
+
+  /******************************************** NOELLE API implementations ***********************************************/
+
+  typedef void (*stageFunctionPtr_t)(void *, void*);
+
+  void printReachedS(std::string s)
+  {
+    auto outS = "Reached: " + s;
+    printf("%s\n",outS.c_str());
+  }
+
+  void printReachedI(int i){
+    printf("Reached: %d\n",i);
+  }
+
+  void printPushedP(int32_t *p){
+    printf("Pushed: %p\n", p);
+  }
+
+  void printPulledP(int32_t *p){
+    printf("Pulled: %p\n", p);
+  }
+
+  void queuePush8(BatchedSPSCQueue<int8_t> *queue, int8_t *val) { 
+    queue->push(*val); 
+
+    #ifdef DSWP_STATS
+    numberOfPushes8++;
+    #endif
+
+    return ;
+  }
+
+  void queuePop8(BatchedSPSCQueue<int8_t> *queue, int8_t *val) { 
+    queue->pop(*val); 
+    return ;
+  }
+
+  void queueFlush8(BatchedSPSCQueue<int8_t> *queue) { 
+    queue->flush(); 
+    return ;
+  }
+
+  void queuePush16(BatchedSPSCQueue<int16_t> *queue, int16_t *val) { 
+    queue->push(*val); 
+
+    #ifdef DSWP_STATS
+    numberOfPushes16++;
+    #endif
+
+    return ;
+  }
+
+  void queuePop16(BatchedSPSCQueue<int16_t> *queue, int16_t *val) { 
+    queue->pop(*val);
+  }
+
+  void queueFlush16(BatchedSPSCQueue<int16_t> *queue) { 
+    queue->flush(); 
+    return ;
+  }
+
+  void queuePush32(BatchedSPSCQueue<int32_t> *queue, int32_t *val) { 
+    queue->push(*val); 
+
+    #ifdef DSWP_STATS
+    numberOfPushes32++;
+    #endif
+
+    return ;
+  }
+
+  void queuePop32(BatchedSPSCQueue<int32_t> *queue, int32_t *val) { 
+    queue->pop(*val);
+  }
+
+  void queueFlush32(BatchedSPSCQueue<int32_t> *queue) { 
+    queue->flush(); 
+    return ;
+  }
+
+  void queuePush64(BatchedSPSCQueue<int64_t> *queue, int64_t *val) { 
+    queue->push(*val); 
+
+    #ifdef DSWP_STATS
+    numberOfPushes64++;
+    #endif
+
+    return ;
+  }
+
+  void queuePop64(BatchedSPSCQueue<int64_t> *queue, int64_t *val) { 
+    queue->pop(*val); 
+
+    return ;
+  }
+
+  void queueFlush64(BatchedSPSCQueue<int64_t> *queue) { 
+    queue->flush(); 
+    return ;
+  }
+
+
+  /**********************************************************************
+   *                DOALL
+   **********************************************************************/
+  static void NOELLE_DOALLTrampoline (void *args){
+    #ifdef RUNTIME_PROFILE
+    auto clocks_start = rdtsc_s();
+    #endif
+
+    /*
+     * Fetch the arguments.
+     */
+    auto DOALLArgs = (DOALL_args_t *) args;
+    NOELLE_pinCurrentThread(DOALLArgs->logicalCore);
+
+    /*
+     * Invoke
+     */
+    DOALLNestingLevel++;
+    DOALLArgs->parallelizedLoop(DOALLArgs->env, DOALLArgs->coreID, DOALLArgs->numCores, DOALLArgs->chunkSize, DOALLArgs->scheduler);
+    DOALLNestingLevel--;
+    #ifdef RUNTIME_PROFILE
+    auto clocks_end = rdtsc_e();
+    clocks_starts[DOALLArgs->coreID] = clocks_start;
+    clocks_ends[DOALLArgs->coreID] = clocks_end;
+    #endif
+
+    DOALLArgs->barrier->arrive();
+    return ;
+  }
+
+  int64_t NOELLE_DOALLFetchChunk (
+    void *scheduler,
+    int64_t coreID
+    ){
+
+    /*
+     * Fetch the state of the core.
+     */
+    auto DOALLScheduler = (DOALL_scheduler_t *) scheduler;
+    auto chunkSize = DOALLScheduler->chunkSize;
+    auto state = &(DOALLScheduler->chunkStates[coreID]);
+
+    /*
+     * Check if the core still owns chunks it grabbed before.
+     * This only happens with the guided schedule, which grabs several consecutive chunks at once.
+     */
+    int64_t chunkStart;
+    if (state->chunksLeft > 0){
+      chunkStart = state->nextChunkStart;
+      state->chunksLeft--;
+
+    } else {
+
+      /*
+       * Compute how many chunks to grab.
+       * The guided schedule grabs a share of the iterations left, which shrinks as the loop approaches its end.
+       */
+      int64_t chunks = 1;
+      if (  true
+            && (DOALLScheduler->schedule == NOELLE_DOALL_GUIDED_SCHEDULE)
+            && (DOALLScheduler->expectedIterations > 0)
+         ){
+        auto iterationsLeft = DOALLScheduler->expectedIterations - DOALLScheduler->nextIteration.load(std::memory_order_relaxed);
+        chunks = iterationsLeft / (2 * DOALLScheduler->numCores * chunkSize);
+        if (chunks < 1){
+          chunks = 1;
+        }
+      }
+
+      /*
+       * Grab the chunks from the shared iteration counter.
+       */
+      chunkStart = DOALLScheduler->nextIteration.fetch_add(chunks * chunkSize, std::memory_order_relaxed);
+      state->chunksLeft = chunks - 1;
+    }
+
+    /*
+     * Compute the distance from the chunk previously executed by the core.
+     */
+    auto iterationsToSkip = chunkStart - state->lastChunkEnd;
+    state->nextChunkStart = chunkStart + chunkSize;
+    state->lastChunkEnd = chunkStart + chunkSize;
+
+    return iterationsToSkip;
+  }
+
+  DispatcherInfo NOELLE_DOALLDispatcher (
+    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t, void *), 
+    void *env, 
+    int64_t maxNumberOfCores, 
+    int64_t chunkSize,
+    int64_t schedule,
+    int64_t expectedIterations
+    ){
+    #ifdef RUNTIME_PROFILE
+    auto clocks_start = rdtsc_s();
+    #endif
+
+    auto virgil = runtime.virgil;
+
+    /*
+     * Use the persistent team if there is one and no other loop is using it.
+     * Nested loops never use it: the team is busy running the loop that invokes them.
+     */
+    DOALLTeam *team = nullptr;
+    if (  true
+          && (runtime.doallTeam != nullptr)
+          && (DOALLNestingLevel == 0)
+          && runtime.doallTeam->tryAcquire()
+       ){
+      team = runtime.doallTeam;
+      maxNumberOfCores = std::min<int64_t>(maxNumberOfCores, team->getNumberOfWorkers() + 1);
+    }
+
+    /*
+     * Fetch the work-stealing pool if the team is not going to run the tasks.
+     */
+    auto workStealingPool = (team != nullptr) ? nullptr : runtime.getWorkStealingPool();
+
+    /*
+     * Set the number of cores to use.
+     *
+     * A DOALL loop invoked by another one (nested) does not reserve cores when tasks are executed by the work-stealing pool.
+     * Its tasks are pushed to the deque of the current thread and they are executed by the threads that become idle.
+     */
+    uint32_t firstCoreSlot = 0;
+    auto isNested = (workStealingPool != nullptr) && (DOALLNestingLevel > 0);
+    auto numCores = isNested ? maxNumberOfCores : runtime.reserveCores(maxNumberOfCores, &firstCoreSlot);
+    #ifdef RUNTIME_PRINT
+    std::cerr << "Starting dispatcher: num cores " << numCores << ", chunk size: " << chunkSize << ", schedule: " << schedule << ", nested: " << isNested << ", team: " << (team != nullptr) << std::endl;
+    #endif
+
+    /*
+     * Allocate the memory to store the arguments.
+     * The team owns the arguments of its workers, so it reuses them across invocations.
+     */
+    uint32_t doallMemoryIndex;
+    auto argsForAllCores = (team != nullptr) ? nullptr : runtime.getDOALLArgs(numCores - 1, &doallMemoryIndex);
+
+    /*
+     * Set up the shared iteration counter for the schedules that assign chunks on demand.
+     */
+    DOALL_scheduler_t DOALLScheduler;
+    void *scheduler = nullptr;
+    if (schedule != NOELLE_DOALL_STATIC_SCHEDULE){
+      DOALLScheduler.nextIteration.store(0, std::memory_order_relaxed);
+      DOALLScheduler.schedule = schedule;
+      DOALLScheduler.chunkSize = chunkSize;
+      DOALLScheduler.numCores = numCores;
+      DOALLScheduler.expectedIterations = expectedIterations;
+      if (team != nullptr){
+        DOALLScheduler.chunkStates = team->getChunkStates();
+      } else {
+        posix_memalign((void **)&DOALLScheduler.chunkStates, CACHE_LINE_SIZE, sizeof(DOALL_chunk_state_t) * numCores);
+      }
+      for (auto i = 0; i < numCores; ++i) {
+        DOALLScheduler.chunkStates[i].lastChunkEnd = 0;
+        DOALLScheduler.chunkStates[i].nextChunkStart = 0;
+        DOALLScheduler.chunkStates[i].chunksLeft = 0;
+      }
+      scheduler = &DOALLScheduler;
+    }
+
+    /*
+     * Set up the barrier to wait for the tasks.
+     */
+    CompletionBarrier barrier(numCores - 1);
+
+    /*
+     * Submit DOALL tasks.
+     */
+    for (auto i = 0; i < (numCores - 1); ++i) {
+
+      /*
+       * Prepare the arguments.
+       */
+      auto argsPerCore = (team != nullptr) ? team->getArgs(i) : &argsForAllCores[i];
+      argsPerCore->parallelizedLoop = parallelizedLoop;
+      argsPerCore->env = env;
+      argsPerCore->numCores = numCores;
+      argsPerCore->chunkSize = chunkSize;
+      argsPerCore->scheduler = scheduler;
+      argsPerCore->barrier = &barrier;
+
+      /*
+       * Threads of the work-stealing pool and of the team are pinned when they start, so only tasks executed by VIRGIL need to be pinned.
+       */
+      argsPerCore->logicalCore = ((team != nullptr) || (workStealingPool != nullptr)) ? -1 : runtime.getLogicalCoreOfSlot(firstCoreSlot + i);
+
+      #ifdef RUNTIME_PROFILE
+      clocks_dispatch_starts[i] = rdtsc_s();
+      #endif
+
+      /*
+       * Submit
+       */
+      if (team != nullptr){
+        team->start(i);
+      } else if (workStealingPool != nullptr){
+        argsPerCore->workStealingTask.function = NOELLE_DOALLTrampoline;
+        argsPerCore->workStealingTask.args = argsPerCore;
+        workStealingPool->submit(&argsPerCore->workStealingTask);
+      } else {
+        virgil->submitAndDetach(NOELLE_DOALLTrampoline, argsPerCore);
+      }
+
+      #ifdef RUNTIME_PROFILE
+      clocks_dispatch_ends[i] = rdtsc_s();
+      #endif
+      #ifdef RUNTIME_PRINT
+      std::cerr << "Submitted DOALL task on core " << i << std::endl;
+      #endif
+    }
+    #ifdef RUNTIME_PRINT
+    std::cerr << "Submitted pool" << std::endl;
+    #endif
+    #ifdef RUNTIME_PROFILE
+    auto clocks_after_fork = rdtsc_e();
+    #endif
+
+    /*
+     * Run a task.
+     */
+    DOALLNestingLevel++;
+    parallelizedLoop(env, numCores - 1, numCores, chunkSize, scheduler);
+    DOALLNestingLevel--;
+
+    /*
+     * Wait for the remaining DOALL tasks.
+     */
+    #ifdef RUNTIME_PROFILE
+    auto clocks_before_join = rdtsc_s();
+    #endif
+    if (  true
+          && (team == nullptr)
+          && (workStealingPool != nullptr)
+       ){
+
+      /*
+       * Execute other tasks while waiting: our tasks could still be in the deque of this thread.
+       * Once every task of the pool has been started by some thread, there is nothing left to help with and we can go to sleep.
+       */
+      uint64_t rounds = 0;
+      auto spinBudget = runtime.spinBudget;
+      workStealingPool->helpUntil([&]() -> bool {
+        if (barrier.isCompleted()){
+          return true;
+        }
+        rounds++;
+        return (rounds > spinBudget) && (!workStealingPool->hasTasks());
+      });
+    }
+    #ifdef RUNTIME_PROFILE
+    auto joinedBySleeping = barrier.wait(runtime.spinBudget);
+    #else
+    barrier.wait(runtime.spinBudget);
+    #endif
+    #ifdef RUNTIME_PRINT
+    std::cerr << "All tasks completed" << std::endl;
+    #endif
+    #ifdef RUNTIME_PROFILE
+    auto clocks_after_join = rdtsc_e();
+    auto clocks_before_cleanup = rdtsc_s();
+    #endif
+
+    /*
+     * Free the cores and memory.
+     */
+    if (!isNested){
+      runtime.releaseCores(numCores);
+    }
+    if (team != nullptr){
+      team->release();
+    } else {
+      runtime.releaseDOALLArgs(doallMemoryIndex);
+      if (scheduler != nullptr){
+        free(DOALLScheduler.chunkStates);
+      }
+    }
+
+    /*
+     * Prepare the return value.
+     */
+    DispatcherInfo dispatcherInfo;
+    dispatcherInfo.numberOfThreadsUsed = numCores;
+    #ifdef RUNTIME_PROFILE
+    auto clocks_after_cleanup = rdtsc_s();
+    pthread_spin_lock(&printLock);
+    std::cerr << "XAN: Start         = " << clocks_start << "\n";
+    std::cerr << "XAN: Setup overhead         = " << clocks_after_fork - clocks_start << " clocks\n";
+    uint64_t totalDispatch = 0;
+    for (auto i=0; i < (numCores - 1); i++){
+      totalDispatch += (clocks_dispatch_ends[i] - clocks_dispatch_starts[i]);
+    }
+    std::cerr << "XAN:    Dispatch overhead         = " << totalDispatch << " clocks\n";
+    std::cerr << "XAN: Start joining = " << clocks_after_fork << "\n";
+    for (auto i=0; i < (numCores - 1); i++){
+      std::cerr << "Thread " << i << ": Start = " << clocks_starts[i] << "\n";
+      std::cerr << "Thread " << i << ": End   = " << clocks_ends[i] << "\n";
+      std::cerr << "Thread " << i << ": Delta = " << clocks_ends[i] - clocks_starts[i] << "\n";
+    }
+    std::cerr << "XAN: Joined        = " << clocks_after_join << "\n";
+    std::cerr << "XAN: Joining delta = " << clocks_after_join - clocks_before_join << "\n";
+    std::cerr << "XAN: Joined by sleeping = " << joinedBySleeping << "\n";
+
+    uint64_t start_min = 0;
+    uint64_t start_max = 0;
+    for (auto i=0; i < (numCores - 1); i++){
+      if (  false
+            || (start_min == 0)
+            || (clocks_starts[i] < start_min)
+        ){
+        start_min = clocks_starts[i];
+      }
+      if (clocks_starts[i] > start_max){
+        start_max = clocks_starts[i];
+      }
+    }
+    std::cerr << "XAN: Thread starts min = " << start_min << "\n";
+    std::cerr << "XAN: Thread starts max = " << start_max << "\n";
+    std::cerr << "XAN: Task starting overhead = " << start_max - start_min << "\n";
+
+    uint64_t end_max = 0;
+    uint64_t lastThreadID = 0;
+    for (auto i=0; i < (numCores - 1); i++){
+      if (clocks_ends[i] > end_max){
+        lastThreadID = i;
+        end_max = clocks_ends[i];
+      }
+    }
+    std::cerr << "XAN: Last thread ended = " << end_max << " (thread " << lastThreadID << ")\n";
+    std::cerr << "XAN: Joining overhead       = " << clocks_after_join - end_max << "\n";
+
+    pthread_spin_unlock(&printLock);
+    #endif
+
+    return dispatcherInfo;
+  }
+
+  #ifdef RUNTIME_PRINT
+  void *mySSGlobal = nullptr;
+  #endif
+
+
+  /**********************************************************************
+   *                HELIX
+   **********************************************************************/
+
+  /*
+   * State of a sequential segment.
+   *
+   * A core can enter the segment once the segment has been signaled more times than the core has waited on it.
+   * The counters only grow, so a waiter compares its own iteration against the completed ones and never competes with other cores for a lock word.
+   */
+  typedef struct {
+
+    /*
+     * Number of signals received by the segment.
+     * It is only written by the single core allowed to be in the segment.
+     */
+    std::atomic<uint64_t> completedIterations;
+
+    /*
+     * Number of waits issued on the segment, which is the iteration assigned to the next waiter.
+     */
+    std::atomic<uint64_t> nextIteration;
+  } HELIX_segment_t ;
+  static_assert(sizeof(HELIX_segment_t) <= CACHE_LINE_SIZE, "HELIX: a sequential segment must fit in the cache line the compiler reserves for it");
+
+  static void __attribute__((noinline, cold)) HELIX_waitForIteration (HELIX_segment_t *segment, uint64_t iteration){
+
+    /*
+     * Poll the segment without pausing if the user asked for the lowest signal-to-wake latency.
+     */
+    if (runtime.helixWait == NOELLE_HELIX_WAIT_POLL){
+      while (segment->completedIterations.load(std::memory_order_acquire) <= iteration){
+      }
+      return ;
+    }
+
+    /*
+     * Back off exponentially: pause for twice as long after every failed check, up to a limit.
+     * Once at the limit, give the core away as the signal is not coming soon.
+     */
+    uint32_t pauses = 1;
+    while (segment->completedIterations.load(std::memory_order_acquire) <= iteration){
+      if (pauses > HELIX_maximumPauses){
+        sched_yield();
+        continue ;
+      }
+      for (auto i = 0u; i < pauses; i++){
+        NOELLE_cpuRelax();
+      }
+      pauses <<= 1;
+    }
+
+    return ;
+  }
+
+  typedef struct {
+    void (*parallelizedLoop)(void *, void *, void *, void *, int64_t, int64_t, uint64_t *);
+    void *env ;
+    void *loopCarriedArray;
+    void *ssArrayPast;
+    void *ssArrayFuture;
+    uint64_t coreID;
+    uint64_t numCores;
+    uint64_t *loopIsOverFlag;
+    CompletionBarrier *barrier;
+    int32_t logicalCore;
+  } NOELLE_HELIX_args_t ;
+
+  static void NOELLE_HELIXTrampoline (void *args){
+
+    /*
+     * Fetch the arguments.
+     */
+    auto HELIX_args = (NOELLE_HELIX_args_t *) args;
+    NOELLE_pinCurrentThread(HELIX_args->logicalCore);
+
+    /*
+     * Invoke
+     */
+    HELIX_args->parallelizedLoop(
+      HELIX_args->env, 
+      HELIX_args->loopCarriedArray, 
+      HELIX_args->ssArrayPast, 
+      HELIX_args->ssArrayFuture, 
+      HELIX_args->coreID,
+      HELIX_args->numCores,
+      HELIX_args->loopIsOverFlag
+      );
+
+    HELIX_args->barrier->arrive();
+    return ;
+  }
+
+  static DispatcherInfo NOELLE_HELIX_dispatcher (
+    void (*parallelizedLoop)(void *, void *, void *, void *, int64_t, int64_t, uint64_t *), 
+    void *env,
+    void *loopCarriedArray,
+    int64_t maxNumberOfCores, 
+    int64_t numOfsequentialSegments,
+    bool LIO
+    ){
+    #ifdef RUNTIME_PRINT
+    std::cerr << "HELIX: dispatcher: Start" << std::endl;
+    std::cerr << "HELIX: dispatcher:  Number of sequential segments = " << numOfsequentialSegments << std::endl;
+    std::cerr << "HELIX: dispatcher:  Number of cores = " << numCores << std::endl;
+    #endif
+
+    /*
+     * Assumptions.
+     */
+    assert(parallelizedLoop != NULL);
+    assert(env != NULL);
+    assert(maxNumberOfCores > 1);
+
+    /*
+     * Fetch VIRGIL
+     */
+    auto virgil = runtime.virgil;
+
+    /*
+     * Reserve the cores.
+     */
+    uint32_t firstCoreSlot;
+    auto numCores = runtime.reserveCores(maxNumberOfCores, &firstCoreSlot);
+    assert(numCores >= 1);
+
+    /*
+     * Allocate the sequential segment arrays.
+     * We need numCores - 1 arrays.
+     */
+    auto numOfSSArrays = numCores;
+    if (!LIO){
+      numOfSSArrays = 1;
+    }
+    void *ssArrays = NULL;
+    auto ssSize = CACHE_LINE_SIZE;
+    auto ssArraySize = ssSize * numOfsequentialSegments;
+    if (numOfsequentialSegments > 0){
+
+      /*
+       * Allocate the sequential segment arrays.
+       */
+      posix_memalign(&ssArrays, CACHE_LINE_SIZE, ssArraySize * numOfSSArrays);
+      if (ssArrays == NULL){
+        fprintf(stderr, "HELIX: dispatcher: ERROR = not enough memory to allocate %lld sequential segment arrays\n", (long long)numCores);
+        abort();
+      }
+
+      /*
+       * Initialize the sequential segment arrays.
+       */
+      for (auto i = 0; i < numOfSSArrays; i++){
+
+        /*
+         * Fetch the current sequential segment array.
+         */
+        auto ssArray = (void *)(((uint64_t)ssArrays) + (i * ssArraySize));
+
+        /*
+         * Initialize the sequential segments.
+         */
+        for (auto ssID = 0; ssID < numOfsequentialSegments; ssID++){
+
+          /*
+           * Fetch the pointer to the current sequential segment.
+           */
+          auto segment = (HELIX_segment_t *)(((uint64_t)ssArray) + (ssID * ssSize));
+
+          /*
+           * Only core 0 can enter the sequential segment without being signaled first.
+           */
+          segment->nextIteration.store(0, std::memory_order_relaxed);
+          segment->completedIterations.store((i == 0) ? 1 : 0, std::memory_order_relaxed);
+        }
+      }
+    }
+
+    #ifdef RUNTIME_PRINT
+    mySSGlobal = ssArrays;
+    #endif
+
+    /*
+     * Allocate the arguments for the cores.
+     */
+    NOELLE_HELIX_args_t *argsForAllCores;
+    posix_memalign((void **)&argsForAllCores, CACHE_LINE_SIZE, sizeof(NOELLE_HELIX_args_t) * (numCores - 1));
+
+    /*
+     * Set up the barrier to wait for the tasks.
+     */
+    CompletionBarrier barrier(numCores - 1);
+
+    /*
+     * Launch threads
+     */
+    #ifdef RUNTIME_PROFILE
+    auto clocks_before_dispatch = rdtsc_s();
+    #endif
+    uint64_t loopIsOverFlag = 0;
+    for (auto i = 0; i < (numCores - 1); ++i) {
+      #ifdef RUNTIME_PRINT
+      fprintf(stderr, "HelixDispatcher: Creating future for core %d\n", i);
+      #endif
+
+      /*
+       * Identify the past and future sequential segment arrays.
+       */
+      auto pastID = i % numOfSSArrays;
+      auto futureID = (i + 1) % numOfSSArrays;
+
+      /*
+       * Fetch the sequential segment array for the current thread.
+       */
+      auto ssArrayPast = (void *)(((uint64_t)ssArrays) + (pastID * ssArraySize));
+      auto ssArrayFuture = (void *)(((uint64_t)ssArrays) + (futureID * ssArraySize));
+      #ifdef RUNTIME_PRINT
+      fprintf(stderr, "HelixDispatcher: defined ss past and future arrays: %ld %ld\n", (int *)ssArrayPast - (int *)mySSGlobal, (int *)ssArrayFuture - (int *)mySSGlobal);
+      #endif
+
+      /*
+       * Prepare the arguments.
+       */
+      auto argsPerCore = &argsForAllCores[i];
+      argsPerCore->parallelizedLoop = parallelizedLoop;
+      argsPerCore->env = env;
+      argsPerCore->loopCarriedArray = loopCarriedArray;
+      argsPerCore->ssArrayPast = ssArrayPast;
+      argsPerCore->ssArrayFuture = ssArrayFuture;
+      argsPerCore->coreID = i;
+      argsPerCore->numCores = numCores;
+      argsPerCore->loopIsOverFlag = &loopIsOverFlag;
+      argsPerCore->barrier = &barrier;
+
+      /*
+       * Set the affinity: consecutive cores exchange the sequential segments, so they should share a cache.
+       */
+      argsPerCore->logicalCore = runtime.getLogicalCoreOfSlot(firstCoreSlot + i);
+
+      /*
+       * Launch the thread.
+       */
+      virgil->submitAndDetach(NOELLE_HELIXTrampoline, argsPerCore);
+    }
+    #ifdef RUNTIME_PRINT
+    std::cerr << "Submitted pool\n";
+    int futureGotten = 0;
+    #endif
+    #ifdef RUNTIME_PROFILE
+    auto clocks_after_dispatch = rdtsc_e();
+    #endif
+
+    /*
+     * Run a task.
+     */
+    auto pastID = (numCores - 1) % numOfSSArrays;
+    auto futureID = 0;
+    auto ssArrayPast = (void *)(((uint64_t)ssArrays) + (pastID * ssArraySize));
+    auto ssArrayFuture = ssArrays;
+    parallelizedLoop(env, loopCarriedArray, ssArrayPast, ssArrayFuture, numCores - 1, numCores, &loopIsOverFlag);
+
+    /*
+     * Wait for the remaining HELIX tasks.
+     */
+    #ifdef RUNTIME_PROFILE
+    auto clocks_before_join = rdtsc_s();
+    auto joinedBySleeping = barrier.wait(runtime.spinBudget);
+    auto clocks_after_join = rdtsc_e();
+    pthread_spin_lock(&printLock);
+    std::cerr << "HELIX: Dispatch overhead = " << clocks_after_dispatch - clocks_before_dispatch << " clocks\n";
+    std::cerr << "HELIX: Joining delta = " << clocks_after_join - clocks_before_join << " clocks\n";
+    std::cerr << "HELIX: Joined by sleeping = " << joinedBySleeping << "\n";
+    pthread_spin_unlock(&printLock);
+    #else
+    barrier.wait(runtime.spinBudget);
+    #endif
+    #ifdef RUNTIME_PRINT
+    std::cerr << "Got all futures\n";
+    #endif
+
+    /*
+     * Free the cores and memory.
+     */
+    runtime.releaseCores(numCores);
+
+    /*
+     * Free the memory.
+     */
+    free(argsForAllCores);
+    free(ssArrays);
+
+    DispatcherInfo dispatcherInfo;
+    dispatcherInfo.numberOfThreadsUsed = numCores;
+    return dispatcherInfo;
+  }
+
+  DispatcherInfo NOELLE_HELIX_dispatcher_sequentialSegments (
+    void (*parallelizedLoop)(void *, void *, void *, void *, int64_t, int64_t, uint64_t *), 
+    void *env,
+    void *loopCarriedArray,
+    int64_t numCores, 
+    int64_t numOfsequentialSegments
+    ){
+    return NOELLE_HELIX_dispatcher(parallelizedLoop, env, loopCarriedArray, numCores, numOfsequentialSegments, true);
+  }
+
+  DispatcherInfo NOELLE_HELIX_dispatcher_criticalSections (
+    void (*parallelizedLoop)(void *, void *, void *, void *, int64_t, int64_t, uint64_t *), 
+    void *env,
+    void *loopCarriedArray,
+    int64_t numCores, 
+    int64_t numOfsequentialSegments
+    ){
+    return NOELLE_HELIX_dispatcher(parallelizedLoop, env, loopCarriedArray, numCores, numOfsequentialSegments, false);
+  }
+
+  void HELIX_wait (
+    void *sequentialSegment
+    ){
+
+    /*
+     * Fetch the sequential segment.
+     */
+    auto ss = (HELIX_segment_t *) sequentialSegment;
+
+    #ifdef RUNTIME_PRINT
+    assert(ss != NULL);
+    fprintf(stderr, "HelixDispatcher: Waiting on sequential segment: %ld\n", (int *)sequentialSegment - (int *)mySSGlobal);
+    #endif
+
+    /*
+     * Take the next iteration of the segment and wait for the previous one to complete.
+     */
+    auto iteration = ss->nextIteration.fetch_add(1, std::memory_order_relaxed);
+    if (__builtin_expect(ss->completedIterations.load(std::memory_order_acquire) <= iteration, 0)){
+      HELIX_waitForIteration(ss, iteration);
+    }
+
+    #ifdef RUNTIME_PRINT
+    fprintf(stderr, "HelixDispatcher: Waited on sequential segment: %ld\n", (int *)sequentialSegment - (int *)mySSGlobal);
+    #endif
+
+    return ;
+  }
+
+  void HELIX_signal (
+    void *sequentialSegment
+    ){
+
+    /*
+     * Fetch the sequential segment.
+     */
+    auto ss = (HELIX_segment_t *) sequentialSegment;
+
+    #ifdef RUNTIME_PRINT
+    assert(ss != NULL);
+    fprintf(stderr, "HelixDispatcher: Signaling on sequential segment: %ld\n", (int *)sequentialSegment - (int *)mySSGlobal);
+    #endif
+
+    /*
+     * Complete the current iteration.
+     * Only the core in the segment can signal it, so there is no need for an atomic increment.
+     */
+    auto completed = ss->completedIterations.load(std::memory_order_relaxed);
+    ss->completedIterations.store(completed + 1, std::memory_order_release);
+
+    #ifdef RUNTIME_PRINT
+    fprintf(stderr, "HelixDispatcher: Signaled on sequential segment: %ld\n", (int *)sequentialSegment - (int *)mySSGlobal);
+    #endif
+
+    return ;
+  }
+
+
+  /**********************************************************************
+   *                DSWP
+   **********************************************************************/
+  typedef struct {
+    stageFunctionPtr_t funcToInvoke;
+    void *env;
+    void *localQueues;
+    CompletionBarrier *barrier;
+    int32_t logicalCore;
+  } NOELLE_DSWP_args_t ;
+
+  void stageExecuter(void (*stage)(void *, void *), void *env, void *queues){ 
+    stage(env, queues);
+    BatchedSPSCQueueBase::currentStageEnds();
+
+    return ;
+  }
+
+  static void NOELLE_DSWPTrampoline (void *args){
+
+    /*
+     * Fetch the arguments.
+     */
+    auto DSWPArgs = (NOELLE_DSWP_args_t *) args;
+    NOELLE_pinCurrentThread(DSWPArgs->logicalCore);
+
+    /*
+     * Invoke
+     */
+    DSWPArgs->funcToInvoke(DSWPArgs->env, DSWPArgs->localQueues);
+    BatchedSPSCQueueBase::currentStageEnds();
+
+    DSWPArgs->barrier->arrive();
+    return ;
+  }
+
+  DispatcherInfo NOELLE_DSWPDispatcher (
+    void *env, 
+    int64_t *queueSizes, 
+    void *stages, 
+    int64_t numberOfStages, 
+    int64_t numberOfQueues
+    ){
+    #ifdef RUNTIME_PRINT
+    std::cerr << "Starting dispatcher: num stages " << numberOfStages << ", num queues: " << numberOfQueues << std::endl;
+    #endif
+
+    /*
+     * Fetch VIRGIL
+     */
+    auto virgil = runtime.virgil;
+
+    /*
+     * Reserve the cores.
+     */
+    uint32_t firstCoreSlot;
+    auto numCores = runtime.reserveCores(numberOfStages, &firstCoreSlot);
+    assert(numCores >= 1);
+
+    /*
+     * Allocate the communication queues.
+     */
+    void *localQueues[numberOfQueues];
+    for (auto i = 0; i < numberOfQueues; ++i) {
+      switch (queueSizes[i]) {
+        case 1:
+          localQueues[i] = new BatchedSPSCQueue<int8_t>();
+          break;
+        case 8:
+          localQueues[i] = new BatchedSPSCQueue<int8_t>();
+          break;
+        case 16:
+          localQueues[i] = new BatchedSPSCQueue<int16_t>();
+          break;
+        case 32:
+          localQueues[i] = new BatchedSPSCQueue<int32_t>();
+          break;
+        case 64:
+          localQueues[i] = new BatchedSPSCQueue<int64_t>();
+          break;
+        default:
+          std::cerr << "NOELLE: Runtime: QUEUE SIZE INCORRECT" << std::endl;
+          abort();
+          break;
+      }
+    }
+    #ifdef RUNTIME_PRINT
+    std::cerr << "Made queues" << std::endl;
+    #endif
+
+    /*
+     * Allocate the memory to store the arguments.
+     */
+    auto argsForAllCores = (NOELLE_DSWP_args_t *) malloc(sizeof(NOELLE_DSWP_args_t) * numberOfStages);
+
+    /*
+     * Set up the barrier to wait for the tasks.
+     */
+    CompletionBarrier barrier(numberOfStages);
+
+    /*
+     * Submit DSWP tasks
+     */
+    #ifdef RUNTIME_PROFILE
+    auto clocks_before_dispatch = rdtsc_s();
+    #endif
+    auto allStages = (void **)stages;
+    for (auto i = 0; i < numberOfStages; ++i) {
+
+      /*
+       * Prepare the arguments.
+       */
+      auto argsPerCore = &argsForAllCores[i];
+      argsPerCore->funcToInvoke = reinterpret_cast<stageFunctionPtr_t>(reinterpret_cast<long long>(allStages[i]));
+      argsPerCore->env = env;
+      argsPerCore->localQueues = (void *) localQueues;
+      argsPerCore->barrier = &barrier;
+
+      /*
+       * Set the affinity: consecutive stages are the ones most likely to communicate through queues, so they should share a cache.
+       */
+      argsPerCore->logicalCore = runtime.getLogicalCoreOfSlot(firstCoreSlot + i);
+
+      /*
+       * Submit
+       */
+      virgil->submitAndDetach(NOELLE_DSWPTrampoline, argsPerCore);
+      #ifdef RUNTIME_PRINT
+      std::cerr << "Submitted stage" << std::endl;
+      #endif
+    }
+    #ifdef RUNTIME_PRINT
+    std::cerr << "Submitted pool" << std::endl;
+    #endif
+
+    /*
+     * Wait for the tasks to complete.
+     */
+    #ifdef RUNTIME_PROFILE
+    auto clocks_before_join = rdtsc_s();
+    auto joinedBySleeping = barrier.wait(runtime.spinBudget);
+    auto clocks_after_join = rdtsc_e();
+    pthread_spin_lock(&printLock);
+    std::cerr << "DSWP: Dispatch overhead = " << clocks_before_join - clocks_before_dispatch << " clocks\n";
+    std::cerr << "DSWP: Joining delta = " << clocks_after_join - clocks_before_join << " clocks\n";
+    std::cerr << "DSWP: Joined by sleeping = " << joinedBySleeping << "\n";
+    pthread_spin_unlock(&printLock);
+    #else
+    barrier.wait(runtime.spinBudget);
+    #endif
+    #ifdef RUNTIME_PRINT
+    std::cerr << "Got all futures" << std::endl;
+    #endif
+
+    /*
+     * Free the cores and memory.
+     */
+    runtime.releaseCores(numCores);
+    for (int i = 0; i < numberOfQueues; ++i) {
+      switch (queueSizes[i]) {
+        case 1:
+          delete (BatchedSPSCQueue<int8_t> *)(localQueues[i]);
+          break;
+        case 8:
+          delete (BatchedSPSCQueue<int8_t> *)(localQueues[i]);
+          break;
+        case 16:
+          delete (BatchedSPSCQueue<int16_t> *)(localQueues[i]);
+          break;
+        case 32:
+          delete (BatchedSPSCQueue<int32_t> *)(localQueues[i]);
+          break;
+        case 64:
+          delete (BatchedSPSCQueue<int64_t> *)(localQueues[i]);
+          break;
+      }
+    }
+    free(argsForAllCores);
+
+    #ifdef DSWP_STATS
+    std::cout << "DSWP: 1 Byte pushes = " << numberOfPushes8 << std::endl;
+    std::cout << "DSWP: 2 Bytes pushes = " << numberOfPushes16 << std::endl;
+    std::cout << "DSWP: 4 Bytes pushes = " << numberOfPushes32 << std::endl;
+    std::cout << "DSWP: 8 Bytes pushes = " << numberOfPushes64 << std::endl;
+    #endif
+
+    DispatcherInfo dispatcherInfo;
+    dispatcherInfo.numberOfThreadsUsed = numberOfStages;
+    return dispatcherInfo;
+  }
+
+
+  /**********************************************************************
+   *                Sequential fallback
+   **********************************************************************/
+  static int64_t NOELLE_currentTime (void){
+    auto time = std::chrono::steady_clock::now().time_since_epoch();
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+  }
+
+  static double NOELLE_updateAverage (double average, double sample, uint64_t samples){
+    if (samples == 0){
+      return sample;
+    }
+
+    /*
+     * Preemptions and page faults make some invocations much slower than the others.
+     * Limit how much a single one can move the average, so it does not flip the choices of the invocations that follow.
+     */
+    sample = std::min(sample, 2 * average);
+
+    return average + ((sample - average) / NOELLE_loopCostsWindow);
+  }
+
+  int64_t NOELLE_loopInvocationBegins (
+    int64_t loopID,
+    int64_t tripCount,
+    int64_t numCores
+    ){
+    int64_t runInParallel = 1;
+
+    /*
+     * The autotuner has the last word on the loops it configured.
+     */
+    auto configuration = runtime.getTuningConfiguration(loopID);
+    if (configuration != nullptr){
+      runInParallel = configuration->parallel;
+      return (NOELLE_currentTime() << 1) | runInParallel;
+    }
+
+    /*
+     * Fetch the costs of the loop.
+     * Loops without an entry in the table always run in parallel.
+     */
+    auto costs = runtime.sequentialFallback ? NOELLE_fetchLoopCosts(loopID) : nullptr;
+    if (costs != nullptr){
+
+      /*
+       * Run in parallel until the cost of the parallelized loop has been measured.
+       */
+      auto invocation = costs->invocations.fetch_add(1, std::memory_order_relaxed);
+      auto parallelInvocations = costs->parallelInvocations.load(std::memory_order_relaxed);
+      auto sequentialInvocations = costs->sequentialInvocations.load(std::memory_order_relaxed);
+      auto parallelIterations = costs->parallelIterations.load(std::memory_order_relaxed);
+      if (parallelInvocations > 0){
+        if (sequentialInvocations == 0){
+
+          /*
+           * Measure the cost of an iteration of the sequential loop.
+           * This is done only with an invocation no bigger than the ones measured in parallel, to bound the time spent to learn.
+           */
+          runInParallel = (tripCount > parallelIterations);
+
+        } else {
+
+          /*
+           * Estimate the time of the invocation in parallel as the time spent to dispatch it plus the time of the iterations spread among the cores.
+           * The dispatch time is what the parallel invocations measured on top of their iterations.
+           */
+          auto cores = std::max<int64_t>(1, std::min<int64_t>(numCores, runtime.getNumberOfCores()));
+          auto iterationTime = costs->sequentialIterationTime.load(std::memory_order_relaxed);
+          auto parallelTime = costs->parallelTime.load(std::memory_order_relaxed);
+          auto dispatchTime = std::max(0.0, parallelTime - ((parallelIterations * iterationTime) / cores));
+          auto sequentialEstimate = tripCount * iterationTime;
+          auto parallelEstimate = dispatchTime + (sequentialEstimate / cores);
+          runInParallel = (parallelEstimate < sequentialEstimate);
+
+          /*
+           * Invocations close to the break-even point periodically try the other choice to keep the costs of both of them up to date.
+           */
+          if (  true
+                && ((invocation % NOELLE_loopCostsExplorationPeriod) == 0)
+                && (sequentialEstimate < (2 * dispatchTime))
+             ){
+            runInParallel = !runInParallel;
+          }
+        }
+      }
+    }
+
+    /*
+     * Stamp the ticket with the time the invocation starts.
+     */
+    return (NOELLE_currentTime() << 1) | runInParallel;
+  }
+
+  void NOELLE_loopInvocationEnds (
+    int64_t loopID,
+    int64_t tripCount,
+    int64_t ticket
+    ){
+    if (!runtime.sequentialFallback){
+      return ;
+    }
+
+    /*
+     * Measure the time of the invocation.
+     */
+    auto time = (double)(NOELLE_currentTime() - (ticket >> 1));
+    auto costs = NOELLE_fetchLoopCosts(loopID);
+    if (costs == nullptr){
+      return ;
+    }
+
+    /*
+     * Update the costs of the loop.
+     * Concurrent invocations of the same loop could lose an update, which only delays the learning.
+     */
+    if ((ticket & 1) != 0){
+      auto samples = costs->parallelInvocations.load(std::memory_order_relaxed);
+      costs->parallelTime.store(NOELLE_updateAverage(costs->parallelTime.load(std::memory_order_relaxed), time, samples), std::memory_order_relaxed);
+      costs->parallelIterations.store(NOELLE_updateAverage(costs->parallelIterations.load(std::memory_order_relaxed), tripCount, samples), std::memory_order_relaxed);
+      costs->parallelInvocations.store(samples + 1, std::memory_order_relaxed);
+
+    } else {
+      auto samples = costs->sequentialInvocations.load(std::memory_order_relaxed);
+      auto iterationTime = time / std::max<int64_t>(1, tripCount);
+      costs->sequentialIterationTime.store(NOELLE_updateAverage(costs->sequentialIterationTime.load(std::memory_order_relaxed), iterationTime, samples), std::memory_order_relaxed);
+      costs->sequentialInvocations.store(samples + 1, std::memory_order_relaxed);
+    }
+
+    return ;
+  }
+
+  int64_t NOELLE_tunedTechnique (
+    int64_t loopID,
+    int64_t technique
+    ){
+    auto configuration = runtime.getTuningConfiguration(loopID);
+    if (  false
+          || (configuration == nullptr)
+          || (configuration->technique < 0)
+       ){
+      return technique;
+    }
+
+    return configuration->technique;
+  }
+
+  int64_t NOELLE_tunedNumberOfCores (
+    int64_t loopID,
+    int64_t numCores
+    ){
+    auto configuration = runtime.getTuningConfiguration(loopID);
+    if (  false
+          || (configuration == nullptr)
+          || (configuration->cores <= 0)
+       ){
+      return numCores;
+    }
+
+    /*
+     * HELIX needs at least two cores.
+     */
+    return std::max<int64_t>(std::min<int64_t>(configuration->cores, numCores), std::min<int64_t>(numCores, 2));
+  }
+
+  int64_t NOELLE_tunedDOALLChunkSize (
+    int64_t loopID,
+    int64_t chunkSize
+    ){
+    auto configuration = runtime.getTuningConfiguration(loopID);
+    if (  false
+          || (configuration == nullptr)
+          || (configuration->chunkSize <= 0)
+       ){
+      return chunkSize;
+    }
+
+    return configuration->chunkSize;
+  }
+
+  int64_t NOELLE_tunedDOALLSchedule (
+    int64_t loopID,
+    int64_t schedule
+    ){
+    auto configuration = runtime.getTuningConfiguration(loopID);
+    if (  false
+          || (configuration == nullptr)
+          || (schedule == NOELLE_DOALL_STATIC_SCHEDULE)
+          || (  true
+                && (configuration->schedule != NOELLE_DOALL_DYNAMIC_SCHEDULE)
+                && (configuration->schedule != NOELLE_DOALL_GUIDED_SCHEDULE)
+             )
+       ){
+      return schedule;
+    }
+
+    return configuration->schedule;
+  }
+
+
+  /**********************************************************************
+   *                Loop profiler
+   **********************************************************************/
+  static int64_t NOELLE_readCycles (void){
+    #if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+    #else
+    return NOELLE_currentTime();
+    #endif
+  }
+
+  /*
+   * Return the bucket of the histograms @value belongs to: 0 for 0, and k for the values in [2^(k-1), 2^k).
+   */
+  static uint32_t NOELLE_loopProfilerBucket (int64_t value){
+    if (value <= 0){
+      return 0;
+    }
+
+    return 64 - __builtin_clzll((uint64_t)value);
+  }
+
+  static void NOELLE_loopProfilerDump (void){
+    auto fileName = getenv("NOELLE_LOOP_PROFILE");
+    if (fileName == nullptr){
+      fileName = (char *)"default.loopprof";
+    }
+    std::ofstream profile(fileName);
+    if (!profile.is_open()){
+      std::cerr << "NOELLE: Runtime: ERROR = cannot write the loop profile to " << fileName << std::endl;
+      return ;
+    }
+
+    /*
+     * Write a line per histogram of the loops that have been invoked.
+     */
+    for (auto loopID = 0; loopID < NOELLE_loopProfilesCount; loopID++){
+      auto loopProfile = &NOELLE_loopProfiles[loopID];
+      if (loopProfile->invocations.load() == 0){
+        continue ;
+      }
+      profile << loopID << " iterations";
+      for (auto &counter : loopProfile->iterations){
+        profile << " " << counter.load();
+      }
+      profile << "\n";
+      profile << loopID << " cycles";
+      for (auto &counter : loopProfile->cyclesPerIteration){
+        profile << " " << counter.load();
+      }
+      profile << "\n";
+    }
+
+    return ;
+  }
+
+  void NOELLE_loopProfilerInitialize (
+    int64_t numberOfLoops
+    ){
+    assert(NOELLE_loopProfiles == nullptr);
+
+    NOELLE_loopProfiles = new NOELLE_loopProfile_t[numberOfLoops]();
+    NOELLE_loopProfilesCount = numberOfLoops;
+    atexit(NOELLE_loopProfilerDump);
+
+    return ;
+  }
+
+  int64_t NOELLE_loopProfilerInvocationBegins (
+    int64_t loopID
+    ){
+    assert(loopID < NOELLE_loopProfilesCount);
+
+    /*
+     * Sample the cost of some invocations only: reading the cycle counter at every invocation would slow down small loops too much.
+     */
+    auto invocation = NOELLE_loopProfiles[loopID].invocations.fetch_add(1, std::memory_order_relaxed);
+    if ((invocation % NOELLE_loopProfilerSamplingPeriod) != 0){
+      return 0;
+    }
+
+    return NOELLE_readCycles();
+  }
+
+  void NOELLE_loopProfilerInvocationEnds (
+    int64_t loopID,
+    int64_t iterations,
+    int64_t startCycles
+    ){
+    auto loopProfile = &NOELLE_loopProfiles[loopID];
+
+    /*
+     * Count the iterations of the invocation.
+     */
+    loopProfile->iterations[NOELLE_loopProfilerBucket(iterations)].fetch_add(1, std::memory_order_relaxed);
+
+    /*
+     * Measure the cost of an iteration if the invocation has been sampled.
+     */
+    if (startCycles != 0){
+      auto cycles = (NOELLE_readCycles() - startCycles) / std::max<int64_t>(1, iterations);
+      loopProfile->cyclesPerIteration[NOELLE_loopProfilerBucket(cycles)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return ;
+  }
+
+
+  /**********************************************************************
+   *                Dependence profiler
+   **********************************************************************/
+  static void NOELLE_dependenceProfilerDump (void){
+    auto fileName = getenv("NOELLE_DEPENDENCE_PROFILE");
+    if (fileName == nullptr){
+      fileName = (char *)"default.depprof";
+    }
+    std::ofstream profile(fileName);
+    if (!profile.is_open()){
+      std::cerr << "NOELLE: Runtime: ERROR = cannot write the dependence profile to " << fileName << std::endl;
+      return ;
+    }
+
+    /*
+     * Write a line per dependence: its checks, its manifestations, and its description.
+     */
+    for (auto dependenceID = 0; dependenceID < NOELLE_dependenceProfilesCount; dependenceID++){
+      auto dependenceProfile = &NOELLE_dependenceProfiles[dependenceID];
+      profile << dependenceProfile->checks << " " << dependenceProfile->manifestations << " " << dependenceProfile->description << "\n";
+    }
+
+    return ;
+  }
+
+  /*
+   * Fetch the profile of the dependence @dependenceID.
+   */
+  static NOELLE_dependenceProfile_t * NOELLE_dependenceProfilerFetch (int64_t dependenceID){
+    assert(dependenceID < NOELLE_dependenceProfilesCount);
+
+    return &NOELLE_dependenceProfiles[dependenceID];
+  }
+
+  /*
+   * Fetch the shadow of @word for the current invocation of @loop, dropping the accesses of the previous invocations.
+   *
+   * @return nullptr if the source never accessed the page of @word and @allocate is false.
+   */
+  static NOELLE_dependenceProfilerShadow_t * NOELLE_dependenceProfilerFetchShadow (
+    NOELLE_dependenceProfile_t *dependenceProfile,
+    NOELLE_dependenceProfilerLoop_t *loop,
+    uintptr_t word,
+    bool allocate
+    ){
+
+    /*
+     * Fetch the page of the word.
+     */
+    auto pageNumber = word >> NOELLE_dependenceProfilerPageBits;
+    auto page = dependenceProfile->lastPage;
+    if (  false
+          || (page == nullptr)
+          || (dependenceProfile->lastPageNumber != pageNumber)
+       ){
+      auto pageIt = dependenceProfile->pages.find(pageNumber);
+      if (pageIt != dependenceProfile->pages.end()){
+        page = pageIt->second;
+
+      } else if (allocate){
+        page = new NOELLE_dependenceProfilerPage_t();
+        page->invocation = loop->invocation;
+        dependenceProfile->pages[pageNumber] = page;
+
+      } else {
+        return nullptr;
+      }
+      dependenceProfile->lastPageNumber = pageNumber;
+      dependenceProfile->lastPage = page;
+    }
+
+    /*
+     * Drop the accesses of the previous invocations.
+     */
+    if (page->invocation != loop->invocation){
+      memset(page->words, 0, sizeof(page->words));
+      page->invocation = loop->invocation;
+    }
+
+    return &page->words[word & ((1 << NOELLE_dependenceProfilerPageBits) - 1)];
+  }
+
+  void NOELLE_dependenceProfilerInitialize (
+    int64_t numberOfLoops,
+    int64_t numberOfDependences,
+    const char **descriptions
+    ){
+    assert(NOELLE_dependenceProfiles == nullptr);
+
+    NOELLE_dependenceProfilerLoops = new NOELLE_dependenceProfilerLoop_t[numberOfLoops]();
+    NOELLE_dependenceProfiles = new NOELLE_dependenceProfile_t[numberOfDependences]();
+    for (auto dependenceID = 0; dependenceID < numberOfDependences; dependenceID++){
+      NOELLE_dependenceProfiles[dependenceID].description = descriptions[dependenceID];
+    }
+    NOELLE_dependenceProfilesCount = numberOfDependences;
+    atexit(NOELLE_dependenceProfilerDump);
+
+    return ;
+  }
+
+  void NOELLE_dependenceProfilerInvocationBegins (
+    int64_t loopID
+    ){
+    auto loop = &NOELLE_dependenceProfilerLoops[loopID];
+    loop->invocation++;
+    loop->iteration = 0;
+
+    return ;
+  }
+
+  void NOELLE_dependenceProfilerIterationBegins (
+    int64_t loopID
+    ){
+    NOELLE_dependenceProfilerLoops[loopID].iteration++;
+
+    return ;
+  }
+
+  void NOELLE_dependenceProfilerSource (
+    int64_t dependenceID,
+    int64_t loopID,
+    void *address,
+    int64_t size
+    ){
+    auto loop = &NOELLE_dependenceProfilerLoops[loopID];
+    auto dependenceProfile = NOELLE_dependenceProfilerFetch(dependenceID);
+    if (size <= 0){
+      return ;
+    }
+
+    /*
+     * Remember the iteration that accessed each word.
+     */
+    auto firstWord = ((uintptr_t)address) >> NOELLE_dependenceProfilerWordBits;
+    auto lastWord = (((uintptr_t)address) + size - 1) >> NOELLE_dependenceProfilerWordBits;
+    for (auto word = firstWord; word <= lastWord; word++){
+      auto shadow = NOELLE_dependenceProfilerFetchShadow(dependenceProfile, loop, word, true);
+      if (shadow->lastIteration != loop->iteration){
+        shadow->previousIteration = shadow->lastIteration;
+        shadow->lastIteration = loop->iteration;
+      }
+    }
+
+    return ;
+  }
+
+  void NOELLE_dependenceProfilerDestination (
+    int64_t dependenceID,
+    int64_t loopID,
+    void *address,
+    int64_t size
+    ){
+    auto loop = &NOELLE_dependenceProfilerLoops[loopID];
+    auto dependenceProfile = NOELLE_dependenceProfilerFetch(dependenceID);
+    dependenceProfile->checks++;
+    if (size <= 0){
+      return ;
+    }
+
+    /*
+     * Check whether the source accessed any of the words in an earlier iteration.
+     * Iterations start from 1, so 0 means that the source did not access the word.
+     */
+    auto firstWord = ((uintptr_t)address) >> NOELLE_dependenceProfilerWordBits;
+    auto lastWord = (((uintptr_t)address) + size - 1) >> NOELLE_dependenceProfilerWordBits;
+    for (auto word = firstWord; word <= lastWord; word++){
+      auto shadow = NOELLE_dependenceProfilerFetchShadow(dependenceProfile, loop, word, false);
+      if (shadow == nullptr){
+        continue ;
+      }
+      if (  false
+            || ((shadow->lastIteration != 0) && (shadow->lastIteration < loop->iteration))
+            || (shadow->previousIteration != 0)
+         ){
+        dependenceProfile->manifestations++;
+        break ;
+      }
+    }
 
-      /*
-       * Identify the past and future sequential segment arrays.
-       */
-      auto pastID = i % numOfSSArrays;
-      auto futureID = (i + 1) % numOfSSArrays;
+    return ;
+  }
 
-      /*
-       * Fetch the sequential segment array for the current thread.
-       */
-      auto ssArrayPast = (void *)(((uint64_t)ssArrays) + (pastID * ssArraySize));
-      auto ssArrayFuture = (void *)(((uint64_t)ssArrays) + (futureID * ssArraySize));
-      #ifdef RUNTIME_PRINT
-      fprintf(stderr, "HelixDispatcher: defined ss past and future arrays: %ld %ld\n", (int *)ssArrayPast - (int *)mySSGlobal, (int *)ssArrayFuture - (int *)mySSGlobal);
-      #endif
+}
 
-      /*
-       * Prepare the arguments.
-       */
-      auto argsPerCore = &argsForAllCores[i];
-      argsPerCore->parallelizedLoop = parallelizedLoop;
-      argsPerCore->env = env;
-      argsPerCore->loopCarriedArray = loopCarriedArray;
-      argsPerCore->ssArrayPast = ssArrayPast;
-      argsPerCore->ssArrayFuture = ssArrayFuture;
-      argsPerCore->coreID = i;
-      argsPerCore->numCores = numCores;
-      argsPerCore->loopIsOverFlag = &loopIsOverFlag;
-      pthread_spin_init(&(argsPerCore->endLock), PTHREAD_PROCESS_PRIVATE);
-      pthread_spin_lock(&(argsPerCore->endLock));
+WorkStealingDeque::Buffer::Buffer (int64_t capacity)
+  : capacity{capacity}
+  {
+  this->tasks = new std::atomic<WorkStealingTask *>[capacity];
 
-      /*
-       * Set the affinity for both the thread and its helper.
-       */
-      /*CPU_ZERO(&cores);
-      auto physicalCore = i * 2;
-      CPU_SET(physicalCore, &cores);
-      CPU_SET(physicalCore + 1, &cores);
-      */
+  return ;
+}
 
-      /*
-       * Launch the thread.
-       */
-      virgil->submitAndDetach(NOELLE_HELIXTrampoline, argsPerCore);
+WorkStealingTask * WorkStealingDeque::Buffer::get (int64_t index) const {
+  return this->tasks[index & (this->capacity - 1)].load(std::memory_order_acquire);
+}
 
-      /*
-       * Launch the helper thread.
-       */
+void WorkStealingDeque::Buffer::put (int64_t index, WorkStealingTask *task){
+  this->tasks[index & (this->capacity - 1)].store(task, std::memory_order_release);
+
+  return ;
+}
+
+WorkStealingDeque::Buffer::~Buffer (){
+  delete[] this->tasks;
+}
+
+WorkStealingDeque::WorkStealingDeque ()
+  : top{0}
+  , bottom{0}
+  , buffer{new Buffer(64)}
+  {
+
+  return ;
+}
+
+void WorkStealingDeque::push (WorkStealingTask *task){
+  auto b = this->bottom.load(std::memory_order_relaxed);
+  auto t = this->top.load(std::memory_order_acquire);
+  auto currentBuffer = this->buffer.load(std::memory_order_relaxed);
+
+  /*
+   * Grow the buffer if it is full.
+   */
+  if ((b - t) > (currentBuffer->capacity - 1)){
+    auto newBuffer = new Buffer(currentBuffer->capacity * 2);
+    for (auto i = t; i < b; i++){
+      newBuffer->put(i, currentBuffer->get(i));
+    }
+    this->retiredBuffers.push_back(currentBuffer);
+    this->buffer.store(newBuffer, std::memory_order_release);
+    currentBuffer = newBuffer;
+  }
+
+  /*
+   * Publish the task.
+   */
+  currentBuffer->put(b, task);
+  std::atomic_thread_fence(std::memory_order_release);
+  this->bottom.store(b + 1, std::memory_order_relaxed);
+
+  return ;
+}
+
+WorkStealingTask * WorkStealingDeque::pop (void){
+  auto b = this->bottom.load(std::memory_order_relaxed) - 1;
+  auto currentBuffer = this->buffer.load(std::memory_order_relaxed);
+  this->bottom.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto t = this->top.load(std::memory_order_relaxed);
+
+  /*
+   * Check if the deque is empty.
+   */
+  if (t > b){
+    this->bottom.store(b + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  /*
+   * Fetch the task.
+   * If this is the last one, we race against the thieves for it.
+   */
+  auto task = currentBuffer->get(b);
+  if (t == b){
+    if (!this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)){
+      task = nullptr;
+    }
+    this->bottom.store(b + 1, std::memory_order_relaxed);
+  }
+
+  return task;
+}
+
+WorkStealingTask * WorkStealingDeque::steal (void){
+  auto t = this->top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto b = this->bottom.load(std::memory_order_acquire);
+  if (t >= b){
+    return nullptr;
+  }
+
+  /*
+   * Fetch the task and claim it.
+   * Another thread could have claimed it in the meantime.
+   */
+  auto currentBuffer = this->buffer.load(std::memory_order_acquire);
+  auto task = currentBuffer->get(t);
+  if (!this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)){
+    return nullptr;
+  }
+
+  return task;
+}
+
+bool WorkStealingDeque::isEmpty (void) const {
+  auto b = this->bottom.load(std::memory_order_relaxed);
+  auto t = this->top.load(std::memory_order_relaxed);
+
+  return (t >= b);
+}
+
+WorkStealingDeque::~WorkStealingDeque (){
+  delete this->buffer.load();
+  for (auto retiredBuffer : this->retiredBuffers){
+    delete retiredBuffer;
+  }
+}
+
+thread_local int32_t WorkStealingPool::currentWorkerID = -1;
+thread_local WorkStealingPool *WorkStealingPool::currentPool = nullptr;
+
+WorkStealingPool::WorkStealingPool (uint32_t numberOfWorkers, const std::vector<int32_t> &logicalCoresOfWorkers)
+  : isAlive{true}
+  , injectedTasks{0}
+  , sleepingWorkers{0}
+  , logicalCoresOfWorkers{logicalCoresOfWorkers}
+  {
+
+  /*
+   * Allocate the deques before starting any worker because workers steal from all of them.
+   */
+  for (auto i = 0u; i < numberOfWorkers; i++){
+    this->deques.push_back(new WorkStealingDeque());
+  }
+
+  /*
+   * Start the workers.
+   */
+  for (auto i = 0u; i < numberOfWorkers; i++){
+    this->workers.push_back(std::thread(&WorkStealingPool::runWorker, this, i));
+  }
+
+  return ;
+}
+
+void WorkStealingPool::submit (WorkStealingTask *task){
+
+  /*
+   * Push the task to the deque of the current thread if it belongs to the pool.
+   * Otherwise, push it to the injection queue.
+   */
+  if (WorkStealingPool::currentPool == this){
+    this->deques[WorkStealingPool::currentWorkerID]->push(task);
+
+  } else {
+    std::lock_guard<std::mutex> guard(this->injectionLock);
+    this->injectionQueue.push(task);
+    this->injectedTasks.fetch_add(1, std::memory_order_seq_cst);
+  }
+
+  /*
+   * Wake up a sleeping worker.
+   */
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (this->sleepingWorkers.load(std::memory_order_seq_cst) > 0){
+    std::lock_guard<std::mutex> guard(this->sleepLock);
+    this->sleepCondition.notify_one();
+  }
+
+  return ;
+}
+
+WorkStealingTask * WorkStealingPool::fetchTask (int32_t workerID, uint32_t *victimSeed){
+
+  /*
+   * Try the deque of the current worker.
+   */
+  if (workerID >= 0){
+    auto task = this->deques[workerID]->pop();
+    if (task != nullptr){
+      return task;
+    }
+  }
+
+  /*
+   * Try the tasks submitted from outside the pool.
+   */
+  if (this->injectedTasks.load(std::memory_order_relaxed) > 0){
+    std::lock_guard<std::mutex> guard(this->injectionLock);
+    if (!this->injectionQueue.empty()){
+      auto task = this->injectionQueue.front();
+      this->injectionQueue.pop();
+      this->injectedTasks.fetch_sub(1, std::memory_order_relaxed);
+      return task;
+    }
+  }
+
+  /*
+   * Try to steal from the other workers starting from a random victim.
+   */
+  auto numberOfDeques = this->deques.size();
+  *victimSeed = (*victimSeed * 1103515245) + 12345;
+  auto firstVictim = (*victimSeed >> 16) % numberOfDeques;
+  for (auto i = 0u; i < numberOfDeques; i++){
+    auto victim = (firstVictim + i) % numberOfDeques;
+    if (((int32_t)victim) == workerID){
       continue ;
-      /*localFutures.push_back(pool.submitToCores(
-        cores,
-        HELIX_helperThread, 
-        ssArrayPast,
-        numOfsequentialSegments,
-        &loopIsOverFlag
-      ));*/
     }
-    #ifdef RUNTIME_PRINT
-    std::cerr << "Submitted pool\n";
-    int futureGotten = 0;
-    #endif
+    auto task = this->deques[victim]->steal();
+    if (task != nullptr){
+      return task;
+    }
+  }
 
-    /*
-     * Run a task.
-     */
-    auto pastID = (numCores - 1) % numOfSSArrays;
-    auto futureID = 0;
-    auto ssArrayPast = (void *)(((uint64_t)ssArrays) + (pastID * ssArraySize));
-    auto ssArrayFuture = ssArrays;
-    parallelizedLoop(env, loopCarriedArray, ssArrayPast, ssArrayFuture, numCores - 1, numCores, &loopIsOverFlag);
+  return nullptr;
+}
+
+bool WorkStealingPool::hasTasks (void) const {
+  if (this->injectedTasks.load(std::memory_order_seq_cst) > 0){
+    return true;
+  }
+  for (auto deque : this->deques){
+    if (!deque->isEmpty()){
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void WorkStealingPool::runWorker (uint32_t workerID){
+  WorkStealingPool::currentWorkerID = workerID;
+  WorkStealingPool::currentPool = this;
+  auto victimSeed = workerID + 1;
+  if (workerID < this->logicalCoresOfWorkers.size()){
+    NOELLE_pinCurrentThread(this->logicalCoresOfWorkers[workerID]);
+  }
+
+  uint32_t idleRounds = 0;
+  while (this->isAlive.load(std::memory_order_relaxed)){
 
     /*
-     * Wait for the remaining HELIX tasks.
+     * Execute the next task if there is one.
      */
-    for (auto i = 0; i < (numCores - 1); ++i) {
-      pthread_spin_lock(&(argsForAllCores[i].endLock));
+    auto task = this->fetchTask(workerID, &victimSeed);
+    if (task != nullptr){
+      task->function(task->args);
+      idleRounds = 0;
+      continue ;
     }
-    #ifdef RUNTIME_PRINT
-    std::cerr << "Got all futures\n";
-    #endif
 
     /*
-     * Free the cores and memory.
+     * Spin for a while before going to sleep: tasks of frequently invoked parallel regions arrive soon.
      */
-    runtime.releaseCores(numCores);
+    idleRounds++;
+    if (idleRounds < 1024){
+      std::this_thread::yield();
+      continue ;
+    }
 
     /*
-     * Free the memory.
+     * Go to sleep.
+     * Tasks submitted while we were deciding to sleep are caught by checking the deques after having declared ourselves as sleeping.
      */
-    free(argsForAllCores);
-    free(ssArrays);
+    std::unique_lock<std::mutex> guard(this->sleepLock);
+    this->sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (  true
+          && this->isAlive.load(std::memory_order_relaxed)
+          && (!this->hasTasks())
+       ){
+      this->sleepCondition.wait(guard);
+    }
+    this->sleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+    idleRounds = 0;
+  }
 
-    DispatcherInfo dispatcherInfo;
-    dispatcherInfo.numberOfThreadsUsed = numCores;
-    return dispatcherInfo;
+  return ;
+}
+
+WorkStealingPool::~WorkStealingPool (){
+
+  /*
+   * Stop the workers.
+   */
+  {
+    std::lock_guard<std::mutex> guard(this->sleepLock);
+    this->isAlive.store(false);
+    this->sleepCondition.notify_all();
+  }
+  for (auto &worker : this->workers){
+    worker.join();
   }
 
-  DispatcherInfo NOELLE_HELIX_dispatcher_sequentialSegments (
-    void (*parallelizedLoop)(void *, void *, void *, void *, int64_t, int64_t, uint64_t *), 
-    void *env,
-    void *loopCarriedArray,
-    int64_t numCores, 
-    int64_t numOfsequentialSegments
-    ){
-    return NOELLE_HELIX_dispatcher(parallelizedLoop, env, loopCarriedArray, numCores, numOfsequentialSegments, true);
+  /*
+   * Free the memory.
+   */
+  for (auto deque : this->deques){
+    delete deque;
   }
+}
 
-  DispatcherInfo NOELLE_HELIX_dispatcher_criticalSections (
-    void (*parallelizedLoop)(void *, void *, void *, void *, int64_t, int64_t, uint64_t *), 
-    void *env,
-    void *loopCarriedArray,
-    int64_t numCores, 
-    int64_t numOfsequentialSegments
-    ){
-    return NOELLE_HELIX_dispatcher(parallelizedLoop, env, loopCarriedArray, numCores, numOfsequentialSegments, false);
+CompletionBarrier::CompletionBarrier (uint32_t numberOfTasks)
+  : pending{numberOfTasks}
+  {
+  static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "The futex word must be a plain 32-bit integer");
+  assert(numberOfTasks < CompletionBarrier::sleepingBit);
+
+  return ;
+}
+
+void CompletionBarrier::arrive (void){
+
+  /*
+   * Declare the completion.
+   */
+  auto previous = this->pending.fetch_sub(1, std::memory_order_acq_rel);
+
+  /*
+   * Wake up the dispatcher if this was the last task and the dispatcher is sleeping.
+   * The dispatcher could return and destroy the barrier as soon as the counter reaches zero, so we only use its address from now on.
+   */
+  if (previous == (CompletionBarrier::sleepingBit | 1)){
+    syscall(SYS_futex, (uint32_t *)&this->pending, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
   }
 
-  void HELIX_wait (
-    void *sequentialSegment
-    ){
+  return ;
+}
+
+bool CompletionBarrier::isCompleted (void) const {
+  auto current = this->pending.load(std::memory_order_acquire);
+
+  return (current & ~CompletionBarrier::sleepingBit) == 0;
+}
+
+bool CompletionBarrier::wait (uint64_t spinBudget){
+
+  /*
+   * Spin: short parallel regions complete before it is worth paying for the system calls.
+   */
+  for (uint64_t i = 0; i < spinBudget; i++){
+    if (this->isCompleted()){
+      return false;
+    }
+    NOELLE_cpuRelax();
+  }
+
+  /*
+   * Sleep until the last task wakes us up.
+   */
+  auto slept = false;
+  while (true){
+    auto current = this->pending.load(std::memory_order_acquire);
+    if ((current & ~CompletionBarrier::sleepingBit) == 0){
+      break ;
+    }
 
     /*
-     * Fetch the spinlock
+     * Tell the tasks we are going to sleep.
      */
-    auto ss = (pthread_spinlock_t *) sequentialSegment;
-
-    #ifdef RUNTIME_PRINT
-    assert(ss != NULL);
-    fprintf(stderr, "HelixDispatcher: Waiting on sequential segment: %ld\n", (int *)sequentialSegment - (int *)mySSGlobal);
-    #endif
+    if ((current & CompletionBarrier::sleepingBit) == 0){
+      if (!this->pending.compare_exchange_weak(current, current | CompletionBarrier::sleepingBit, std::memory_order_acq_rel)){
+        continue ;
+      }
+      current |= CompletionBarrier::sleepingBit;
+    }
 
     /*
-     * Wait
+     * Sleep.
+     * The kernel does not put us to sleep if a task completed after we read the counter.
      */
-    pthread_spin_lock(ss);
+    syscall(SYS_futex, (uint32_t *)&this->pending, FUTEX_WAIT_PRIVATE, current, nullptr, nullptr, 0);
+    slept = true;
+  }
 
-    #ifdef RUNTIME_PRINT
-    fprintf(stderr, "HelixDispatcher: Waited on sequential segment: %ld\n", (int *)sequentialSegment - (int *)mySSGlobal);
-    #endif
+  return slept;
+}
+
+DOALLTeam::DOALLTeam (uint32_t numberOfWorkers, const std::vector<int32_t> &logicalCoresOfWorkers, uint64_t spinBudget)
+  : numberOfWorkers{numberOfWorkers}
+  , isAlive{true}
+  , isBusy{false}
+  , spinBudget{spinBudget}
+  {
+
+  /*
+   * Allocate the state of the workers.
+   */
+  posix_memalign((void **)&this->teamWorkers, CACHE_LINE_SIZE, sizeof(Worker) * numberOfWorkers);
+  posix_memalign((void **)&this->chunkStates, CACHE_LINE_SIZE, sizeof(DOALL_chunk_state_t) * (numberOfWorkers + 1));
+  if (  false
+        || (this->teamWorkers == nullptr)
+        || (this->chunkStates == nullptr)
+     ){
+    std::cerr << "NOELLE: Runtime: ERROR = not enough memory to allocate the DOALL team" << std::endl;
+    abort();
+  }
+  for (auto i = 0u; i < numberOfWorkers; i++){
+    new (&this->teamWorkers[i]) Worker();
+    this->teamWorkers[i].args.coreID = i;
+    this->teamWorkers[i].generation.store(0, std::memory_order_relaxed);
+  }
+
+  /*
+   * Start the workers.
+   */
+  for (auto i = 0u; i < numberOfWorkers; i++){
+    auto logicalCore = (i < logicalCoresOfWorkers.size()) ? logicalCoresOfWorkers[i] : -1;
+    this->threads.push_back(std::thread(&DOALLTeam::runWorker, this, i, logicalCore));
+  }
+
+  return ;
+}
 
-    return ;
+bool DOALLTeam::tryAcquire (void){
+  if (this->isBusy.load(std::memory_order_relaxed)){
+    return false;
   }
 
-  void HELIX_signal (
-    void *sequentialSegment
-    ){
+  return !this->isBusy.exchange(true, std::memory_order_acquire);
+}
 
-    /*
-     * Fetch the spinlock
-     */
-    auto ss = (pthread_spinlock_t *) sequentialSegment;
+void DOALLTeam::release (void){
+  this->isBusy.store(false, std::memory_order_release);
 
-    #ifdef RUNTIME_PRINT
-    assert(ss != NULL);
-    fprintf(stderr, "HelixDispatcher: Signaling on sequential segment: %ld\n", (int *)sequentialSegment - (int *)mySSGlobal);
-    #endif
+  return ;
+}
 
-    /*
-     * Signal
-     */
-    pthread_spin_unlock(ss);
+uint32_t DOALLTeam::getNumberOfWorkers (void) const {
+  return this->numberOfWorkers;
+}
 
-    #ifdef RUNTIME_PRINT
-    fprintf(stderr, "HelixDispatcher: Signaled on sequential segment: %ld\n", (int *)sequentialSegment - (int *)mySSGlobal);
-    #endif
+DOALL_args_t * DOALLTeam::getArgs (uint32_t workerID){
+  assert(workerID < this->numberOfWorkers);
 
-    return ;
-  }
+  return &this->teamWorkers[workerID].args;
+}
 
+DOALL_chunk_state_t * DOALLTeam::getChunkStates (void){
+  return this->chunkStates;
+}
 
-  /**********************************************************************
-   *                DSWP
-   **********************************************************************/
-  typedef struct {
-    stageFunctionPtr_t funcToInvoke;
-    void *env;
-    void *localQueues;
-    pthread_mutex_t endLock;
-  } NOELLE_DSWP_args_t ;
+void DOALLTeam::start (uint32_t workerID){
+  assert(workerID < this->numberOfWorkers);
+  auto &generation = this->teamWorkers[workerID].generation;
 
-  void stageExecuter(void (*stage)(void *, void *), void *env, void *queues){ 
-    return stage(env, queues);
+  /*
+   * Bump the generation of the worker.
+   * The release publishes the arguments of the worker, and it clears the sleeping bit.
+   */
+  auto current = generation.load(std::memory_order_relaxed);
+  while (!generation.compare_exchange_weak(current, ((current & ~DOALLTeam::sleepingBit) + 1) & ~DOALLTeam::sleepingBit, std::memory_order_release, std::memory_order_relaxed)){
   }
 
-  static void NOELLE_DSWPTrampoline (void *args){
-
-    /*
-     * Fetch the arguments.
-     */
-    auto DSWPArgs = (NOELLE_DSWP_args_t *) args;
-
-    /*
-     * Invoke
-     */
-    DSWPArgs->funcToInvoke(DSWPArgs->env, DSWPArgs->localQueues);
-
-    pthread_mutex_unlock(&(DSWPArgs->endLock));
-    return ;
+  /*
+   * Wake up the worker if it is sleeping.
+   */
+  if ((current & DOALLTeam::sleepingBit) != 0){
+    syscall(SYS_futex, (uint32_t *)&generation, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
   }
 
-  DispatcherInfo NOELLE_DSWPDispatcher (
-    void *env, 
-    int64_t *queueSizes, 
-    void *stages, 
-    int64_t numberOfStages, 
-    int64_t numberOfQueues
-    ){
-    #ifdef RUNTIME_PRINT
-    std::cerr << "Starting dispatcher: num stages " << numberOfStages << ", num queues: " << numberOfQueues << std::endl;
-    #endif
+  return ;
+}
 
-    /*
-     * Fetch VIRGIL
-     */
-    auto virgil = runtime.virgil;
+void DOALLTeam::runWorker (uint32_t workerID, int32_t logicalCore){
+  NOELLE_pinCurrentThread(logicalCore);
+  auto &generation = this->teamWorkers[workerID].generation;
+
+  uint32_t lastGeneration = 0;
+  while (true){
 
     /*
-     * Reserve the cores.
+     * Spin for a while: frequently invoked loops start the worker again soon.
      */
-    auto numCores = runtime.reserveCores(numberOfStages);
-    assert(numCores >= 1);
+    auto current = generation.load(std::memory_order_acquire);
+    for (uint64_t i = 0; (i < this->spinBudget) && ((current & ~DOALLTeam::sleepingBit) == lastGeneration); i++){
+      NOELLE_cpuRelax();
+      current = generation.load(std::memory_order_acquire);
+    }
 
     /*
-     * Allocate the communication queues.
+     * Sleep until the dispatcher bumps our generation.
      */
-    void *localQueues[numberOfQueues];
-    for (auto i = 0; i < numberOfQueues; ++i) {
-      switch (queueSizes[i]) {
-        case 1:
-          localQueues[i] = new ThreadSafeLockFreeQueue<int8_t>();
-          break;
-        case 8:
-          localQueues[i] = new ThreadSafeLockFreeQueue<int8_t>();
-          break;
-        case 16:
-          localQueues[i] = new ThreadSafeLockFreeQueue<int16_t>();
-          break;
-        case 32:
-          localQueues[i] = new ThreadSafeLockFreeQueue<int32_t>();
-          break;
-        case 64:
-          localQueues[i] = new ThreadSafeLockFreeQueue<int64_t>();
-          break;
-        default:
-          std::cerr << "NOELLE: Runtime: QUEUE SIZE INCORRECT" << std::endl;
-          abort();
-          break;
+    while ((current & ~DOALLTeam::sleepingBit) == lastGeneration){
+      if ((current & DOALLTeam::sleepingBit) == 0){
+        if (!generation.compare_exchange_weak(current, current | DOALLTeam::sleepingBit, std::memory_order_acquire)){
+          continue ;
+        }
+        current |= DOALLTeam::sleepingBit;
       }
+      syscall(SYS_futex, (uint32_t *)&generation, FUTEX_WAIT_PRIVATE, current, nullptr, nullptr, 0);
+      current = generation.load(std::memory_order_acquire);
     }
-    #ifdef RUNTIME_PRINT
-    std::cerr << "Made queues" << std::endl;
-    #endif
+    lastGeneration = current & ~DOALLTeam::sleepingBit;
 
     /*
-     * Allocate the memory to store the arguments.
+     * Check if the team is being destroyed.
      */
-    auto argsForAllCores = (NOELLE_DSWP_args_t *) malloc(sizeof(NOELLE_DSWP_args_t) * numberOfStages);
+    if (!this->isAlive.load(std::memory_order_acquire)){
+      break ;
+    }
 
     /*
-     * Submit DSWP tasks
+     * Execute the task.
      */
-    auto allStages = (void **)stages;
-    for (auto i = 0; i < numberOfStages; ++i) {
+    NOELLE_DOALLTrampoline(&this->teamWorkers[workerID].args);
+  }
 
-      /*
-       * Prepare the arguments.
-       */
-      auto argsPerCore = &argsForAllCores[i];
-      argsPerCore->funcToInvoke = reinterpret_cast<stageFunctionPtr_t>(reinterpret_cast<long long>(allStages[i]));
-      argsPerCore->env = env;
-      argsPerCore->localQueues = (void *) localQueues;
-      pthread_mutex_init(&(argsPerCore->endLock), NULL);
-      pthread_mutex_lock(&(argsPerCore->endLock));
+  return ;
+}
 
-      /*
-       * Submit
-       */
-      virgil->submitAndDetach(NOELLE_DSWPTrampoline, argsPerCore);
-      #ifdef RUNTIME_PRINT
-      std::cerr << "Submitted stage" << std::endl;
-      #endif
-    }
-    #ifdef RUNTIME_PRINT
-    std::cerr << "Submitted pool" << std::endl;
-    #endif
+DOALLTeam::~DOALLTeam (){
 
-    /*
-     * Wait for the tasks to complete.
-     */
-    for (auto i = 0; i < numberOfStages; ++i) {
-      pthread_mutex_lock(&(argsForAllCores[i].endLock));
-    }
-    #ifdef RUNTIME_PRINT
-    std::cerr << "Got all futures" << std::endl;
-    #endif
+  /*
+   * Stop the workers.
+   */
+  this->isAlive.store(false, std::memory_order_release);
+  for (auto i = 0u; i < this->numberOfWorkers; i++){
+    this->start(i);
+  }
+  for (auto &thread : this->threads){
+    thread.join();
+  }
 
-    /*
-     * Free the cores and memory.
-     */
-    runtime.releaseCores(numCores);
-    for (int i = 0; i < numberOfQueues; ++i) {
-      switch (queueSizes[i]) {
-        case 1:
-          delete (ThreadSafeLockFreeQueue<int8_t> *)(localQueues[i]);
-          break;
-        case 8:
-          delete (ThreadSafeLockFreeQueue<int8_t> *)(localQueues[i]);
-          break;
-        case 16:
-          delete (ThreadSafeLockFreeQueue<int16_t> *)(localQueues[i]);
-          break;
-        case 32:
-          delete (ThreadSafeLockFreeQueue<int32_t> *)(localQueues[i]);
-          break;
-        case 64:
-          delete (ThreadSafeLockFreeQueue<int64_t> *)(localQueues[i]);
-          break;
-      }
-    }
-    free(argsForAllCores);
+  /*
+   * Free the memory.
+   */
+  free(this->teamWorkers);
+  free(this->chunkStates);
+}
 
-    #ifdef DSWP_STATS
-    std::cout << "DSWP: 1 Byte pushes = " << numberOfPushes8 << std::endl;
-    std::cout << "DSWP: 2 Bytes pushes = " << numberOfPushes16 << std::endl;
-    std::cout << "DSWP: 4 Bytes pushes = " << numberOfPushes32 << std::endl;
-    std::cout << "DSWP: 8 Bytes pushes = " << numberOfPushes64 << std::endl;
-    #endif
+/*
+ * Order the online logical cores of the machine according to @affinity (see NOELLE_readTopology).
+ * It also computes the number of physical cores.
+ */
+static std::vector<uint32_t> NOELLE_orderLogicalCores (NoelleAffinity affinity, uint32_t *numberOfPhysicalCores){
+  auto cores = NOELLE_readTopology();
+  (*numberOfPhysicalCores) = 0;
+  for (auto &core : cores){
+    if (core.physicalCoreID == core.ID){
+      (*numberOfPhysicalCores)++;
+    }
+  }
 
-    DispatcherInfo dispatcherInfo;
-    dispatcherInfo.numberOfThreadsUsed = numberOfStages;
-    return dispatcherInfo;
+  /*
+   * Order the logical cores.
+   */
+  std::sort(cores.begin(), cores.end(), [affinity](const NOELLE_logicalCore_t &a, const NOELLE_logicalCore_t &b) -> bool {
+    if (  true
+          && (affinity == NOELLE_AFFINITY_LLC)
+          && (a.SMTIndex != b.SMTIndex)
+       ){
+      return a.SMTIndex < b.SMTIndex;
+    }
+    if (a.NUMANodeID != b.NUMANodeID){
+      return a.NUMANodeID < b.NUMANodeID;
+    }
+    if (a.lastLevelCacheID != b.lastLevelCacheID){
+      return a.lastLevelCacheID < b.lastLevelCacheID;
+    }
+    if (a.physicalCoreID != b.physicalCoreID){
+      return a.physicalCoreID < b.physicalCoreID;
+    }
+    return a.ID < b.ID;
+  });
+  std::vector<uint32_t> order;
+  for (auto &core : cores){
+    order.push_back(core.ID);
   }
 
+  return order;
 }
 
 NoelleRuntime::NoelleRuntime() {
+
+  /*
+   * Discover the topology of the machine and set the affinity policy.
+   */
+  this->affinity = NOELLE_AFFINITY_NONE;
+  auto affinityEnvVar = getenv("NOELLE_AFFINITY");
+  if (affinityEnvVar != nullptr){
+    auto affinityName = std::string(affinityEnvVar);
+    if (affinityName == "smt"){
+      this->affinity = NOELLE_AFFINITY_SMT;
+    } else if (affinityName == "llc"){
+      this->affinity = NOELLE_AFFINITY_LLC;
+    } else if (affinityName != "none"){
+      std::cerr << "NOELLE: Runtime: NOELLE_AFFINITY must be none, smt, or llc" << std::endl;
+      abort();
+    }
+  }
+
+  /*
+   * Remember the cores the program started with before any thread gets pinned.
+   */
+  NOELLE_getOriginalCores();
+  this->logicalCoresOrder = NOELLE_orderLogicalCores(this->affinity, &this->numberOfPhysicalCores);
+  if (this->logicalCoresOrder.empty()){
+    this->affinity = NOELLE_AFFINITY_NONE;
+  }
+
   this->maxCores = this->getMaximumNumberOfCores();
   this->NOELLE_idleCores = maxCores;
 
@@ -919,9 +3203,153 @@ NoelleRuntime::NoelleRuntime() {
    */
   this->virgil = new ThreadPoolForCSingleQueue(false, maxCores);
 
+  /*
+   * Check whether DOALL tasks should run on the work-stealing pool or on VIRGIL (the default).
+   * The threads of VIRGIL are always created because HELIX and DSWP need them, so the pool is opt-in: its threads would otherwise compete with the ones of VIRGIL for the same cores.
+   * The pool itself is created by the first DOALL loop (see getWorkStealingPool).
+   */
+  this->workStealingPool = nullptr;
+  this->useWorkStealingPool = false;
+  auto poolEnvVar = getenv("NOELLE_THREAD_POOL");
+  if (poolEnvVar != nullptr){
+    auto poolName = std::string(poolEnvVar);
+    if (poolName == "work_stealing"){
+      this->useWorkStealingPool = true;
+    } else if (poolName != "single_queue"){
+      std::cerr << "NOELLE: Runtime: NOELLE_THREAD_POOL must be single_queue or work_stealing" << std::endl;
+      abort();
+    }
+  }
+
+  /*
+   * Set the number of rounds dispatchers spin before sleeping while waiting for their tasks.
+   */
+  this->spinBudget = 20000;
+  auto spinBudgetEnvVar = getenv("NOELLE_SPIN_BUDGET");
+  if (spinBudgetEnvVar != nullptr){
+    this->spinBudget = strtoull(spinBudgetEnvVar, nullptr, 10);
+  }
+
+  /*
+   * Allocate the persistent team of DOALL loops if the user asked for it.
+   * The dispatching thread runs one of the tasks, so the team needs one thread less than the number of cores.
+   */
+  this->doallTeam = nullptr;
+  auto teamEnvVar = getenv("NOELLE_DOALL_TEAM");
+  if (teamEnvVar != nullptr){
+    auto teamName = std::string(teamEnvVar);
+    if (teamName == "on"){
+      auto workers = (maxCores > 1) ? (maxCores - 1) : 1;
+      std::vector<int32_t> logicalCoresOfWorkers;
+      if (this->affinity != NOELLE_AFFINITY_NONE){
+        for (auto i = 0u; i < workers; i++){
+          logicalCoresOfWorkers.push_back(this->getLogicalCoreOfSlot(i + 1));
+        }
+      }
+      this->doallTeam = new DOALLTeam(workers, logicalCoresOfWorkers, this->spinBudget);
+
+    } else if (teamName != "off"){
+      std::cerr << "NOELLE: Runtime: NOELLE_DOALL_TEAM must be on or off" << std::endl;
+      abort();
+    }
+  }
+
+  /*
+   * Check if small invocations of parallelized loops can run sequentially.
+   */
+  this->sequentialFallback = true;
+  auto fallbackEnvVar = getenv("NOELLE_SEQUENTIAL_FALLBACK");
+  if (fallbackEnvVar != nullptr){
+    auto fallbackName = std::string(fallbackEnvVar);
+    if (fallbackName == "off"){
+      this->sequentialFallback = false;
+    } else if (fallbackName != "on"){
+      std::cerr << "NOELLE: Runtime: NOELLE_SEQUENTIAL_FALLBACK must be on or off" << std::endl;
+      abort();
+    }
+  }
+
+  /*
+   * Set how HELIX cores wait for sequential segments.
+   */
+  this->helixWait = NOELLE_HELIX_WAIT_BACKOFF;
+  auto helixWaitEnvVar = getenv("NOELLE_HELIX_WAIT");
+  if (helixWaitEnvVar != nullptr){
+    auto helixWaitName = std::string(helixWaitEnvVar);
+    if (helixWaitName == "poll"){
+      this->helixWait = NOELLE_HELIX_WAIT_POLL;
+    } else if (helixWaitName != "backoff"){
+      std::cerr << "NOELLE: Runtime: NOELLE_HELIX_WAIT must be backoff or poll" << std::endl;
+      abort();
+    }
+  }
+
+  /*
+   * Load the configurations of the tunable loops chosen by the autotuner.
+   */
+  auto tuningEnvVar = getenv("NOELLE_TUNING_CONFIG");
+  if (tuningEnvVar != nullptr){
+    this->loadTuningConfigurations(tuningEnvVar);
+  }
+
+  return ;
+}
+
+void NoelleRuntime::loadTuningConfigurations (const char *fileName){
+  std::ifstream configurations(fileName);
+  if (!configurations.is_open()){
+    std::cerr << "NOELLE: Runtime: ERROR = cannot read the tuning configurations from " << fileName << std::endl;
+    abort();
+  }
+
+  /*
+   * Every line is "loopID parallel technique cores chunkSize schedule", where the technique is DOALL, HELIX, DSWP, or - to keep the one chosen by the compiler.
+   * Lines that start with # are comments.
+   */
+  std::string line;
+  while (std::getline(configurations, line)){
+    if (  false
+          || line.empty()
+          || (line[0] == '#')
+       ){
+      continue ;
+    }
+    std::istringstream lineStream(line);
+    int64_t loopID, parallel;
+    std::string technique;
+    NOELLE_tuningConfiguration_t configuration;
+    if (!(lineStream >> loopID >> parallel >> technique >> configuration.cores >> configuration.chunkSize >> configuration.schedule)){
+      std::cerr << "NOELLE: Runtime: ERROR = the tuning configuration \"" << line << "\" is malformed" << std::endl;
+      abort();
+    }
+    configuration.parallel = (parallel != 0);
+    if (technique == "DOALL"){
+      configuration.technique = NOELLE_DOALL_TECHNIQUE;
+    } else if (technique == "HELIX"){
+      configuration.technique = NOELLE_HELIX_TECHNIQUE;
+    } else if (technique == "DSWP"){
+      configuration.technique = NOELLE_DSWP_TECHNIQUE;
+    } else if (technique == "-"){
+      configuration.technique = -1;
+    } else {
+      std::cerr << "NOELLE: Runtime: ERROR = the technique of the tuning configuration \"" << line << "\" is unknown" << std::endl;
+      abort();
+    }
+    this->tuningConfigurations[loopID] = configuration;
+  }
+
   return ;
 }
 
+const NOELLE_tuningConfiguration_t * NoelleRuntime::getTuningConfiguration (int64_t loopID) const {
+  auto configurationIt = this->tuningConfigurations.find(loopID);
+  if (configurationIt == this->tuningConfigurations.end()){
+    return nullptr;
+  }
+
+  return &configurationIt->second;
+}
+
 DOALL_args_t * NoelleRuntime::getDOALLArgs (uint32_t cores, uint32_t *index){
   DOALL_args_t *argsForAllCores = nullptr;
 
@@ -975,8 +3403,6 @@ DOALL_args_t * NoelleRuntime::getDOALLArgs (uint32_t cores, uint32_t *index){
   for (auto i = 0; i < cores; ++i) {
     auto argsPerCore = &argsForAllCores[i];
     argsPerCore->coreID = i;
-    pthread_spin_init(&(argsPerCore->endLock), 0);
-    pthread_spin_lock(&(argsPerCore->endLock));
   }
 
   return argsForAllCores;
@@ -989,7 +3415,7 @@ void NoelleRuntime::releaseDOALLArgs (uint32_t index){
   return ;
 }
 
-uint32_t NoelleRuntime::reserveCores (uint32_t coresRequested){
+uint32_t NoelleRuntime::reserveCores (uint32_t coresRequested, uint32_t *firstCoreSlot){
  
   /*
    * Reserve the number of cores available.
@@ -999,11 +3425,28 @@ uint32_t NoelleRuntime::reserveCores (uint32_t coresRequested){
   if (numCores < 1){
     numCores = 1;
   }
+
+  /*
+   * Reserved cores take the slots that follow the ones already in use.
+   * Dispatches that overlap release their cores in reverse order in the common case (nested parallel regions), so their slots do not overlap.
+   */
+  if (firstCoreSlot != nullptr){
+    auto coresInUse = ((int32_t)this->maxCores) - this->NOELLE_idleCores;
+    (*firstCoreSlot) = (coresInUse > 0) ? coresInUse : 0;
+  }
   this->NOELLE_idleCores -= numCores;
   pthread_spin_unlock(&this->spinLock);
 
   return numCores;
 }
+
+int32_t NoelleRuntime::getLogicalCoreOfSlot (uint32_t slot) const {
+  if (this->affinity == NOELLE_AFFINITY_NONE){
+    return -1;
+  }
+
+  return this->logicalCoresOrder[slot % this->logicalCoresOrder.size()];
+}
     
 void NoelleRuntime::releaseCores (uint32_t coresReleased){
   assert(coresReleased > 0);
@@ -1020,6 +3463,37 @@ void NoelleRuntime::releaseCores (uint32_t coresReleased){
   return ;
 }
 
+WorkStealingPool * NoelleRuntime::getWorkStealingPool (void){
+  if (!this->useWorkStealingPool){
+    return nullptr;
+  }
+
+  /*
+   * Allocate the pool the first time it is needed.
+   * The thread that dispatches a DOALL loop runs one of its tasks, so the pool needs one thread less than the number of cores.
+   */
+  std::call_once(this->workStealingPoolCreation, [this](){
+    auto workers = (this->maxCores > 1) ? (this->maxCores - 1) : 1;
+
+    /*
+     * The dispatching thread takes the first core slot, so workers are pinned starting from the second one.
+     */
+    std::vector<int32_t> logicalCoresOfWorkers;
+    if (this->affinity != NOELLE_AFFINITY_NONE){
+      for (auto i = 0u; i < workers; i++){
+        logicalCoresOfWorkers.push_back(this->getLogicalCoreOfSlot(i + 1));
+      }
+    }
+    this->workStealingPool = new WorkStealingPool(workers, logicalCoresOfWorkers);
+  });
+
+  return this->workStealingPool;
+}
+
+uint32_t NoelleRuntime::getNumberOfCores (void) const {
+  return this->maxCores;
+}
+
 uint32_t NoelleRuntime::getMaximumNumberOfCores (void){
   static int cores = 0;
 
@@ -1033,7 +3507,8 @@ uint32_t NoelleRuntime::getMaximumNumberOfCores (void){
      */
     auto envVar = getenv("NOELLE_CORES");
     if (envVar == nullptr){
-      cores = (std::thread::hardware_concurrency() / 2) - 1;
+      auto physicalCores = (this->numberOfPhysicalCores > 0) ? this->numberOfPhysicalCores : (std::thread::hardware_concurrency() / 2);
+      cores = (physicalCores > 1) ? (physicalCores - 1) : 1;
     } else {
       cores = atoi(envVar);
     }
@@ -1043,5 +3518,7 @@ uint32_t NoelleRuntime::getMaximumNumberOfCores (void){
 }
     
 NoelleRuntime::~NoelleRuntime(void){
+  delete this->doallTeam;
   delete this->virgil;
+  delete this->workStealingPool;
 }
@@ -36,4 +36,15 @@ namespace llvm::noelle {
     THREAD_SAFE_LIBRARY_ID
   };
 
+  /*
+   * Schedules of the iterations of a DOALL loop.
+   * DOALL_AUTO_SCHEDULE_ID lets DOALL choose one of the others.
+   */
+  enum DOALLSchedule {
+    DOALL_AUTO_SCHEDULE_ID,
+    DOALL_STATIC_SCHEDULE_ID,
+    DOALL_DYNAMIC_SCHEDULE_ID,
+    DOALL_GUIDED_SCHEDULE_ID
+  };
+
 }
@@ -48,7 +48,7 @@ class autotuneProgram(MeasurementInterface):
 
     # Read the range of each dimension of the design space
     inputFile = os.environ['RANGE_FILE']
-    ranges = utils.readFile(inputFile)
+    ranges = self.addDOALLScheduleDimensions(utils.readFile(inputFile))
 
     # Describe the design space to opentuner
     param = 0
@@ -63,7 +63,7 @@ class autotuneProgram(MeasurementInterface):
       if elem > 1:
 
         # Check the type of the parameter
-        paramType = param % 9
+        paramType = param % 10
 
         # Create the parameter
         if paramType == 0:
@@ -111,6 +111,11 @@ class autotuneProgram(MeasurementInterface):
           # DSWP parameter: should we use queue packing?
           openTuner_param = SwitchParameter(str(param), elem)
 
+        elif paramType == 9:
+
+          # DOALL parameter: schedule of the iterations (0: chosen by DOALL, 1: static, 2: dynamic, 3: guided)
+          openTuner_param = IntegerParameter(str(param), 0, str(elem - 1))
+
 
         # Share the parameter to OpenTuner
         manipulator.add_parameter(openTuner_param)
@@ -131,6 +136,22 @@ class autotuneProgram(MeasurementInterface):
     return manipulator
 
 
+  def addDOALLScheduleDimensions(self, ranges):
+
+    # RANGE_FILE has 9 dimensions per loop.
+    # Append the schedule of the DOALL iterations to the loops that can be parallelized.
+    extendedRanges = []
+    for loopStart in range(0, len(ranges), 9):
+      loopRanges = list(ranges[loopStart:loopStart + 9])
+      extendedRanges += loopRanges
+      if loopRanges[0] > 1:
+        extendedRanges.append(4)
+      else:
+        extendedRanges.append(1)
+
+    return extendedRanges
+
+
   def run(self, desired_result, input, limit):
     result = None
     """
@@ -379,7 +400,7 @@ class autotuneProgram(MeasurementInterface):
     # Write the configuration to the INDEX_FILE file
     inputName = os.environ['INPUT_NAME']
     outputFile = os.environ['INDEX_FILE']
-    utils.writeFile(outputFile, indexes)
+    self.writeIndexFile(outputFile, indexes)
 
     repoPath = os.environ['REPO_PATH']
     if (self.finalConfFlag):
@@ -406,12 +427,23 @@ class autotuneProgram(MeasurementInterface):
     return os.system(repoPath + '/src/scripts/backEnd') # generate the binary of the best configuration found
 
 
+  def writeIndexFile(self, outputFile, indexes):
+
+    # Version 2 of INDEX_FILE has 10 fields per loop: the last one is the DOALL schedule
+    with open(outputFile, 'w') as f:
+      f.write('v2\n')
+      for loopStart in range(0, len(indexes), 10):
+        f.write(' '.join(str(index) for index in indexes[loopStart:loopStart + 10]) + '\n')
+
+    return
+
+
   def eraseUselessParameters(self, indexes):
 
     # Erase parallelization parameters related to loops chosen to stay sequential
     param = 0
     for index in indexes:
-      paramID = param % 9
+      paramID = param % 10
       if paramID == 0:
         reset = 0
 
@@ -427,7 +459,7 @@ class autotuneProgram(MeasurementInterface):
     # Erase parameters currently not used
     param = 0
     for index in indexes:
-      paramID = param % 9
+      paramID = param % 10
       reset = 0
 
       # Is loop Parallelized?
@@ -466,6 +498,10 @@ class autotuneProgram(MeasurementInterface):
       if paramID == 8:
         reset = 1
 
+      # DOALL: schedule of the iterations
+      if paramID == 9 and doallIsDisabled == 1:
+        reset = 1
+
       # Reset
       if reset == 1:
         indexes[int(param)] = 0
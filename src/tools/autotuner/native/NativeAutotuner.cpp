@@ -0,0 +1,515 @@
+/*
+ * Copyright 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ * Loop made tunable by the parallelizer (see -noelle-parallelizer-tunable).
+ */
+typedef struct {
+  int64_t ID;
+  std::vector<std::string> techniques;
+  int64_t maxCores;
+  int64_t chunkSize;
+  int64_t schedule;
+  bool sequentialFallback;
+} TunableLoop ;
+
+/*
+ * Configuration of a loop as read by the NOELLE runtime (see NOELLE_TUNING_CONFIG).
+ */
+typedef struct {
+  int64_t parallel;
+  int64_t technique;
+  int64_t cores;
+  int64_t chunkSize;
+  int64_t schedule;
+} LoopConfiguration ;
+
+typedef std::vector<LoopConfiguration> Configuration;
+
+/*
+ * Schedules of DOALL loops that assign chunks on demand; they are the only ones the runtime can swap.
+ */
+static const int64_t dynamicSchedule = 2;
+static const int64_t guidedSchedule = 3;
+
+static const int64_t maximumChunkSize = 1024;
+
+static double infiniteTime = std::numeric_limits<double>::infinity();
+
+class NativeAutotuner {
+  public:
+    NativeAutotuner (
+      const std::vector<TunableLoop> &loops,
+      const std::vector<char *> &command,
+      uint32_t runs,
+      bool checkOutput
+      );
+
+    /*
+     * Search the best configuration by tuning one parameter of one loop at a time, for up to @rounds rounds over all parameters.
+     */
+    Configuration search (uint32_t rounds, double *bestTime);
+
+    void writeConfiguration (const Configuration &configuration, const std::string &fileName) const ;
+
+    ~NativeAutotuner ();
+
+  private:
+    std::vector<TunableLoop> loops;
+    std::vector<char *> command;
+    uint32_t runs;
+    bool checkOutput;
+    std::string configurationFileName;
+    std::string outputFileName;
+    std::string referenceOutput;
+    std::map<std::string, double> evaluatedConfigurations;
+    uint32_t binaryRuns;
+
+    Configuration getCompilerConfiguration (void) const ;
+
+    std::vector<int64_t> getCandidates (const TunableLoop &loop, const LoopConfiguration &loopConfiguration, uint32_t parameter) const ;
+
+    std::string toString (const Configuration &configuration) const ;
+
+    double evaluate (const Configuration &configuration);
+
+    double run (void);
+
+    std::string readOutput (void) const ;
+};
+
+NativeAutotuner::NativeAutotuner (
+  const std::vector<TunableLoop> &loops,
+  const std::vector<char *> &command,
+  uint32_t runs,
+  bool checkOutput
+  ) : loops{loops}
+    , command{command}
+    , runs{runs}
+    , checkOutput{checkOutput}
+    , binaryRuns{0}
+  {
+
+  /*
+   * Allocate the files used to pass the configuration to the binary and to collect its output.
+   */
+  char configurationTemplate[] = "/tmp/noelle_tuning_config_XXXXXX";
+  char outputTemplate[] = "/tmp/noelle_tuning_output_XXXXXX";
+  auto configurationFD = mkstemp(configurationTemplate);
+  auto outputFD = mkstemp(outputTemplate);
+  if (  false
+        || (configurationFD < 0)
+        || (outputFD < 0)
+     ){
+    std::cerr << "AUTOTUNER: ERROR = cannot create the temporary files" << std::endl;
+    exit(1);
+  }
+  close(configurationFD);
+  close(outputFD);
+  this->configurationFileName = configurationTemplate;
+  this->outputFileName = outputTemplate;
+
+  return ;
+}
+
+Configuration NativeAutotuner::getCompilerConfiguration (void) const {
+  Configuration configuration;
+  for (auto &loop : this->loops){
+    configuration.push_back({ 1, 0, loop.maxCores, loop.chunkSize, loop.schedule });
+  }
+
+  return configuration;
+}
+
+/*
+ * Parameters of a loop: 0 is the technique, 1 the number of cores, 2 the DOALL chunk size, 3 the DOALL schedule, and 4 whether it runs in parallel.
+ * The technique is tuned first because the other parameters depend on it.
+ * Whether to run in parallel is tuned last so it is compared against the best parallel configuration found for the loop.
+ */
+static const uint32_t numberOfParameters = 5;
+
+std::vector<int64_t> NativeAutotuner::getCandidates (const TunableLoop &loop, const LoopConfiguration &loopConfiguration, uint32_t parameter) const {
+  std::vector<int64_t> candidates;
+  auto &technique = loop.techniques[loopConfiguration.technique];
+  switch (parameter){
+    case 0:
+
+      /*
+       * The candidates are the indices of the techniques that generated a version of the loop.
+       */
+      if (loop.techniques.size() > 1){
+        for (auto i = 0u; i < loop.techniques.size(); i++){
+          candidates.push_back(i);
+        }
+      }
+      break ;
+
+    case 1:
+      if (loop.maxCores >= 2){
+        for (int64_t cores = 2; cores < loop.maxCores; cores *= 2){
+          candidates.push_back(cores);
+        }
+        candidates.push_back(loop.maxCores);
+      }
+      break ;
+
+    case 2:
+      if (technique == "DOALL"){
+        for (int64_t chunkSize = 1; chunkSize <= maximumChunkSize; chunkSize *= 2){
+          candidates.push_back(chunkSize);
+        }
+      }
+      break ;
+
+    case 3:
+      if (  true
+            && (technique == "DOALL")
+            && (  false
+                  || (loop.schedule == dynamicSchedule)
+                  || (loop.schedule == guidedSchedule)
+               )
+         ){
+        candidates = { dynamicSchedule, guidedSchedule };
+      }
+      break ;
+
+    case 4:
+
+      /*
+       * Invocations can run sequentially only if the loop has the sequential fallback.
+       */
+      if (loop.sequentialFallback){
+        candidates = { 0, 1 };
+      }
+      break ;
+  }
+
+  return candidates;
+}
+
+std::string NativeAutotuner::toString (const Configuration &configuration) const {
+  std::stringstream str;
+  str << "# loopID parallel technique cores chunkSize schedule\n";
+  for (auto i = 0u; i < this->loops.size(); i++){
+    auto &loopConfiguration = configuration[i];
+    str << this->loops[i].ID << " " << loopConfiguration.parallel << " " << this->loops[i].techniques[loopConfiguration.technique] << " " << loopConfiguration.cores << " " << loopConfiguration.chunkSize << " " << loopConfiguration.schedule << "\n";
+  }
+
+  return str.str();
+}
+
+std::string NativeAutotuner::readOutput (void) const {
+  std::ifstream output(this->outputFileName);
+  std::stringstream content;
+  content << output.rdbuf();
+
+  return content.str();
+}
+
+double NativeAutotuner::run (void){
+  this->binaryRuns++;
+
+  /*
+   * Run the binary with the configuration and collect its output.
+   */
+  auto start = std::chrono::steady_clock::now();
+  auto pid = fork();
+  if (pid < 0){
+    std::cerr << "AUTOTUNER: ERROR = cannot run the binary" << std::endl;
+    exit(1);
+  }
+  if (pid == 0){
+    setenv("NOELLE_TUNING_CONFIG", this->configurationFileName.c_str(), 1);
+    auto outputFD = open(this->outputFileName.c_str(), O_WRONLY | O_TRUNC);
+    if (outputFD >= 0){
+      dup2(outputFD, STDOUT_FILENO);
+      close(outputFD);
+    }
+    execvp(this->command[0], this->command.data());
+    _exit(127);
+  }
+  int status;
+  waitpid(pid, &status, 0);
+  auto end = std::chrono::steady_clock::now();
+
+  /*
+   * Configurations that make the binary crash are never chosen.
+   */
+  if (  false
+        || (!WIFEXITED(status))
+        || (WEXITSTATUS(status) != 0)
+     ){
+    return infiniteTime;
+  }
+
+  return std::chrono::duration<double>(end - start).count();
+}
+
+double NativeAutotuner::evaluate (const Configuration &configuration){
+
+  /*
+   * Check if the configuration has been evaluated already.
+   */
+  auto configurationStr = this->toString(configuration);
+  auto evaluatedIt = this->evaluatedConfigurations.find(configurationStr);
+  if (evaluatedIt != this->evaluatedConfigurations.end()){
+    return evaluatedIt->second;
+  }
+
+  /*
+   * Pass the configuration to the runtime.
+   */
+  {
+    std::ofstream configurationFile(this->configurationFileName);
+    configurationFile << configurationStr;
+  }
+
+  /*
+   * Run the binary several times and keep the median time.
+   */
+  std::vector<double> times;
+  for (auto i = 0u; i < this->runs; i++){
+    auto time = this->run();
+
+    /*
+     * Check the output.
+     * The first configuration evaluated is the one chosen by the compiler, which defines the reference output.
+     */
+    if (  true
+          && this->checkOutput
+          && (time != infiniteTime)
+       ){
+      auto output = this->readOutput();
+      if (this->evaluatedConfigurations.empty() && times.empty()){
+        this->referenceOutput = output;
+      } else if (output != this->referenceOutput){
+        std::cerr << "AUTOTUNER:       The output is distorted" << std::endl;
+        time = infiniteTime;
+      }
+    }
+    times.push_back(time);
+    if (time == infiniteTime){
+      break ;
+    }
+  }
+  std::sort(times.begin(), times.end());
+  auto time = (times.back() == infiniteTime) ? infiniteTime : times[times.size() / 2];
+  this->evaluatedConfigurations[configurationStr] = time;
+
+  return time;
+}
+
+Configuration NativeAutotuner::search (uint32_t rounds, double *bestTime){
+
+  /*
+   * Start from the configuration chosen by the compiler.
+   */
+  auto best = this->getCompilerConfiguration();
+  *bestTime = this->evaluate(best);
+  std::cerr << "AUTOTUNER:   Configuration chosen by the compiler: " << *bestTime << " seconds" << std::endl;
+  if (*bestTime == infiniteTime){
+    std::cerr << "AUTOTUNER: ERROR = the binary fails with the configuration chosen by the compiler" << std::endl;
+    exit(1);
+  }
+
+  /*
+   * Tune one parameter at a time while keeping the others at their best value found so far.
+   */
+  for (auto round = 0u; round < rounds; round++){
+    auto improved = false;
+    for (auto i = 0u; i < this->loops.size(); i++){
+      auto &loop = this->loops[i];
+      for (auto parameter = 0u; parameter < numberOfParameters; parameter++){
+
+        /*
+         * The parameters of the parallelized loop do not matter if it runs sequentially.
+         */
+        if (  true
+              && (parameter < 4)
+              && (best[i].parallel == 0)
+           ){
+          continue ;
+        }
+        for (auto candidate : this->getCandidates(loop, best[i], parameter)){
+          auto configuration = best;
+          auto &loopConfiguration = configuration[i];
+          switch (parameter){
+            case 0:
+              loopConfiguration.technique = candidate;
+              break ;
+            case 1:
+              loopConfiguration.cores = candidate;
+              break ;
+            case 2:
+              loopConfiguration.chunkSize = candidate;
+              break ;
+            case 3:
+              loopConfiguration.schedule = candidate;
+              break ;
+            case 4:
+              loopConfiguration.parallel = candidate;
+              break ;
+          }
+          auto time = this->evaluate(configuration);
+          if (time < *bestTime){
+            std::cerr << "AUTOTUNER:     Loop " << loop.ID << ": parallel " << loopConfiguration.parallel << ", technique " << loop.techniques[loopConfiguration.technique] << ", cores " << loopConfiguration.cores << ", chunk size " << loopConfiguration.chunkSize << ", schedule " << loopConfiguration.schedule << ": " << time << " seconds" << std::endl;
+            best = configuration;
+            *bestTime = time;
+            improved = true;
+          }
+        }
+      }
+    }
+    std::cerr << "AUTOTUNER:   Round " << round << " is over after " << this->evaluatedConfigurations.size() << " configurations and " << this->binaryRuns << " runs of the binary" << std::endl;
+    if (!improved){
+      break ;
+    }
+  }
+
+  return best;
+}
+
+void NativeAutotuner::writeConfiguration (const Configuration &configuration, const std::string &fileName) const {
+  std::ofstream configurationFile(fileName);
+  if (!configurationFile.is_open()){
+    std::cerr << "AUTOTUNER: ERROR = cannot write " << fileName << std::endl;
+    exit(1);
+  }
+  configurationFile << this->toString(configuration);
+
+  return ;
+}
+
+NativeAutotuner::~NativeAutotuner (){
+  unlink(this->configurationFileName.c_str());
+  unlink(this->outputFileName.c_str());
+
+  return ;
+}
+
+static std::vector<TunableLoop> readDesignSpace (const char *fileName){
+  std::ifstream designSpace(fileName);
+  if (!designSpace.is_open()){
+    std::cerr << "AUTOTUNER: ERROR = cannot read the design space from " << fileName << std::endl;
+    exit(1);
+  }
+
+  /*
+   * Every line is "loopID techniques maxCores chunkSize schedule sequentialFallback", where the techniques are separated by commas and the first one is chosen by the compiler.
+   */
+  std::vector<TunableLoop> loops;
+  std::string line;
+  while (std::getline(designSpace, line)){
+    if (  false
+          || line.empty()
+          || (line[0] == '#')
+       ){
+      continue ;
+    }
+    std::istringstream lineStream(line);
+    TunableLoop loop;
+    std::string techniques;
+    int64_t sequentialFallback;
+    if (!(lineStream >> loop.ID >> techniques >> loop.maxCores >> loop.chunkSize >> loop.schedule >> sequentialFallback)){
+      std::cerr << "AUTOTUNER: ERROR = the line \"" << line << "\" of the design space is malformed" << std::endl;
+      exit(1);
+    }
+    std::istringstream techniquesStream(techniques);
+    std::string technique;
+    while (std::getline(techniquesStream, technique, ',')){
+      loop.techniques.push_back(technique);
+    }
+    loop.sequentialFallback = (sequentialFallback != 0);
+    loops.push_back(loop);
+  }
+
+  return loops;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Parse the options.
+   */
+  uint32_t runs = 3;
+  uint32_t rounds = 2;
+  auto checkOutput = false;
+  auto argIndex = 1;
+  for (; argIndex < argc; argIndex++){
+    std::string option{argv[argIndex]};
+    if (  true
+          && (option == "--runs")
+          && ((argIndex + 1) < argc)
+       ){
+      runs = std::max(1, atoi(argv[++argIndex]));
+    } else if (  true
+                 && (option == "--rounds")
+                 && ((argIndex + 1) < argc)
+              ){
+      rounds = std::max(1, atoi(argv[++argIndex]));
+    } else if (option == "--check-output"){
+      checkOutput = true;
+    } else {
+      break ;
+    }
+  }
+  if ((argc - argIndex) < 3){
+    std::cerr << "USAGE: " << argv[0] << " [--runs N] [--rounds N] [--check-output] DESIGN_SPACE_FILE BEST_CONFIGURATION_FILE BINARY [BINARY_ARGS]" << std::endl;
+    return 1;
+  }
+  auto designSpaceFileName = argv[argIndex];
+  std::string bestConfigurationFileName{argv[argIndex + 1]};
+  std::vector<char *> command;
+  for (auto i = argIndex + 2; i < argc; i++){
+    command.push_back(argv[i]);
+  }
+  command.push_back(nullptr);
+
+  /*
+   * Read the design space.
+   */
+  std::cerr << "NOELLE-PARALLEL-AUTOTUNER-NATIVE: Start" << std::endl;
+  auto loops = readDesignSpace(designSpaceFileName);
+  std::cerr << "AUTOTUNER:  There are " << loops.size() << " tunable loops" << std::endl;
+  if (loops.empty()){
+    std::cerr << "NOELLE-PARALLEL-AUTOTUNER-NATIVE: Exit" << std::endl;
+    return 0;
+  }
+
+  /*
+   * Search the best configuration.
+   */
+  double bestTime;
+  NativeAutotuner autotuner{loops, command, runs, checkOutput};
+  auto best = autotuner.search(rounds, &bestTime);
+  autotuner.writeConfiguration(best, bestConfigurationFileName);
+  std::cerr << "AUTOTUNER:  The best configuration (" << bestTime << " seconds) has been written to " << bestConfigurationFileName << std::endl;
+  std::cerr << "AUTOTUNER:  Run the binary with NOELLE_TUNING_CONFIG=" << bestConfigurationFileName << " to use it" << std::endl;
+
+  std::cerr << "NOELLE-PARALLEL-AUTOTUNER-NATIVE: Exit" << std::endl;
+  return 0;
+}
@@ -0,0 +1,319 @@
+/*
+ * Copyright 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <thread>
+
+/*
+ * APIs of the NOELLE runtime.
+ */
+extern "C" {
+  class DispatcherInfo {
+    public:
+      int32_t numberOfThreadsUsed;
+      int64_t unusedVariableToPreventOptIfStructHasOnlyOneVariable;
+  };
+
+  DispatcherInfo NOELLE_DOALLDispatcher (
+    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t, void *),
+    void *env,
+    int64_t maxNumberOfCores,
+    int64_t chunkSize,
+    int64_t schedule,
+    int64_t expectedIterations
+    );
+
+  DispatcherInfo NOELLE_HELIX_dispatcher_sequentialSegments (
+    void (*parallelizedLoop)(void *, void *, void *, void *, int64_t, int64_t, uint64_t *),
+    void *env,
+    void *loopCarriedArray,
+    int64_t numCores,
+    int64_t numOfsequentialSegments
+    );
+
+  void HELIX_wait (void *sequentialSegment);
+
+  void HELIX_signal (void *sequentialSegment);
+
+  DispatcherInfo NOELLE_DSWPDispatcher (
+    void *env,
+    int64_t *queueSizes,
+    void *stages,
+    int64_t numberOfStages,
+    int64_t numberOfQueues
+    );
+
+  void queuePush8 (void *queue, int8_t *val);
+  void queuePop8 (void *queue, int8_t *val);
+  void queueFlush8 (void *queue);
+  void queuePush16 (void *queue, int16_t *val);
+  void queuePop16 (void *queue, int16_t *val);
+  void queueFlush16 (void *queue);
+  void queuePush32 (void *queue, int32_t *val);
+  void queuePop32 (void *queue, int32_t *val);
+  void queueFlush32 (void *queue);
+  void queuePush64 (void *queue, int64_t *val);
+  void queuePop64 (void *queue, int64_t *val);
+  void queueFlush64 (void *queue);
+}
+
+/*
+ * Number of repetitions of every measurement.
+ * The minimum is kept to filter out the noise (e.g., interrupts, frequency changes).
+ */
+static const int32_t samples = 5;
+
+static inline int64_t cycles (void){
+  unsigned a, d;
+  asm volatile("rdtscp" : "=a" (a), "=d" (d) : : "%rcx");
+  return ((unsigned long)a) | (((unsigned long)d) << 32);
+}
+
+/*
+ * Return the minimum number of cycles per repetition of @work, which executes @repetitions times the code to measure.
+ */
+template <class Work>
+static double measure (int64_t repetitions, Work work){
+  double best = -1;
+  for (auto i = 0; i < samples; i++){
+    auto start = cycles();
+    work();
+    auto time = ((double)(cycles() - start)) / repetitions;
+    if (  false
+          || (best < 0)
+          || (time < best)
+       ){
+      best = time;
+    }
+  }
+
+  return best;
+}
+
+/*
+ * Keep the compiler from folding or hoisting the computation of @value.
+ */
+template <class T>
+static inline void opaque (T &value){
+  asm volatile("" : "+r" (value));
+  return ;
+}
+
+/*
+ * Instructions.
+ *
+ * Every instruction class is measured as a chain of dependent instructions, so the cycles per instruction are its latency.
+ * The chain is unrolled to make the cost of the loop that repeats it negligible.
+ */
+static const int64_t chainLength = 10000000;
+
+static const int64_t unrollFactor = 8;
+
+template <class Step>
+static double measureChain (Step step){
+  return measure(chainLength * unrollFactor, [step](){
+    for (auto i = 0; i < chainLength; i++){
+      for (auto j = 0; j < unrollFactor; j++){
+        step();
+      }
+    }
+  });
+}
+
+static void __attribute__((noinline)) emptyFunction (void){
+  asm volatile("");
+  return ;
+}
+
+static void measureInstructions (FILE *table){
+  int64_t integer = 1;
+  int64_t multiplier = 1;
+  int64_t divisor = 1;
+  double real = 1.0;
+  double realOperand = 1.0;
+  opaque(multiplier);
+  opaque(divisor);
+  opaque(realOperand);
+
+  fprintf(table, "instruction_int %.2f\n", measureChain([&](){
+    integer += multiplier;
+    opaque(integer);
+  }));
+  fprintf(table, "instruction_int_mul %.2f\n", measureChain([&](){
+    integer *= multiplier;
+    opaque(integer);
+  }));
+  fprintf(table, "instruction_int_div %.2f\n", measureChain([&](){
+    integer /= divisor;
+    opaque(integer);
+  }));
+  fprintf(table, "instruction_fp %.2f\n", measureChain([&](){
+    real += realOperand;
+    asm volatile("" : "+x" (real));
+  }));
+  fprintf(table, "instruction_fp_div %.2f\n", measureChain([&](){
+    real /= realOperand;
+    asm volatile("" : "+x" (real));
+  }));
+
+  /*
+   * Loads are measured by chasing pointers within a buffer that fits in the L1 cache.
+   */
+  void *buffer[64];
+  for (auto i = 0; i < 64; i++){
+    buffer[i] = &buffer[(i + 1) % 64];
+  }
+  void *pointer = buffer[0];
+  fprintf(table, "instruction_load %.2f\n", measureChain([&](){
+    pointer = *(void **)pointer;
+    opaque(pointer);
+  }));
+
+  /*
+   * Stores are measured by storing and reloading the same location, so the store is on the chain through the store-to-load forwarding.
+   */
+  volatile int64_t location = 0;
+  fprintf(table, "instruction_store %.2f\n", measureChain([&](){
+    location = integer;
+    integer = location;
+  }));
+  fprintf(table, "instruction_call %.2f\n", measureChain([&](){
+    emptyFunction();
+  }));
+
+  return ;
+}
+
+/*
+ * DOALL: dispatch a loop without iterations, so only the cost of waking up and joining the cores is measured.
+ */
+static const int64_t dispatches = 10000;
+
+static void emptyDOALLTask (void *env, int64_t coreID, int64_t numCores, int64_t chunkSize, void *scheduler){
+  return ;
+}
+
+static void measureDOALL (FILE *table, int64_t cores){
+  int64_t env = 0;
+  auto latency = measure(dispatches, [&](){
+    for (auto i = 0; i < dispatches; i++){
+      NOELLE_DOALLDispatcher(emptyDOALLTask, &env, cores, 1, 0, 0);
+    }
+  });
+  fprintf(table, "doall_dispatch %.2f\n", latency);
+
+  return ;
+}
+
+/*
+ * HELIX: pass a sequential segment between two cores at every iteration, so every iteration is a round trip of a signal.
+ */
+static const int64_t signals = 1000000;
+
+static void HELIXTask (void *env, void *loopCarriedArray, void *ssPast, void *ssFuture, int64_t coreID, int64_t numCores, uint64_t *loopIsOverFlag){
+  auto iterations = *(int64_t *)env;
+  for (auto i = coreID; i < iterations; i += numCores){
+    HELIX_wait(ssPast);
+    HELIX_signal(ssFuture);
+  }
+
+  return ;
+}
+
+static void measureHELIX (FILE *table){
+  auto iterations = signals;
+  auto latency = measure(signals, [&](){
+    NOELLE_HELIX_dispatcher_sequentialSegments(HELIXTask, &iterations, nullptr, 2, 1);
+  });
+  fprintf(table, "helix_signal %.2f\n", latency);
+
+  return ;
+}
+
+/*
+ * DSWP: stream values between two stages through a single queue.
+ */
+static const int64_t values = 10000000;
+
+template <class T, void (*push)(void *, T *), void (*flush)(void *)>
+static void producerStage (void *env, void *queues){
+  auto queue = ((void **)queues)[0];
+  for (int64_t i = 0; i < values; i++){
+    T value = (T)i;
+    push(queue, &value);
+  }
+  flush(queue);
+
+  return ;
+}
+
+template <class T, void (*pop)(void *, T *)>
+static void consumerStage (void *env, void *queues){
+  auto queue = ((void **)queues)[0];
+  T sum = 0;
+  for (int64_t i = 0; i < values; i++){
+    T value;
+    pop(queue, &value);
+    sum += value;
+  }
+  *(T *)env = sum;
+
+  return ;
+}
+
+template <class T, void (*push)(void *, T *), void (*pop)(void *, T *), void (*flush)(void *)>
+static void measureQueue (FILE *table, int64_t bitWidth){
+  int64_t queueSizes[1] = { bitWidth };
+  void *stages[2] = { (void *)producerStage<T, push, flush>, (void *)consumerStage<T, pop> };
+  T env = 0;
+  auto latency = measure(values, [&](){
+    NOELLE_DSWPDispatcher(&env, queueSizes, stages, 2, 1);
+  });
+  fprintf(table, "dswp_queue_%lld %.2f\n", (long long)bitWidth, latency);
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s COST_TABLE_FILE [MAX_CORES]\n", argv[0]);
+    return -1;
+  }
+  int64_t cores = std::thread::hardware_concurrency();
+  if (argc > 2){
+    cores = atoll(argv[2]);
+  }
+  auto table = fopen(argv[1], "w");
+  if (table == nullptr){
+    fprintf(stderr, "noelle-calibrate: ERROR = cannot write %s\n", argv[1]);
+    return -1;
+  }
+
+  /*
+   * Measure the latencies in cycles.
+   */
+  fprintf(table, "# NOELLE cost table: name cycles\n");
+  measureInstructions(table);
+  measureDOALL(table, cores);
+  measureHELIX(table);
+  measureQueue<int8_t, queuePush8, queuePop8, queueFlush8>(table, 8);
+  measureQueue<int16_t, queuePush16, queuePop16, queueFlush16>(table, 16);
+  measureQueue<int32_t, queuePush32, queuePop32, queueFlush32>(table, 32);
+  measureQueue<int64_t, queuePush64, queuePop64, queueFlush64>(table, 64);
+  fclose(table);
+
+  return 0;
+}
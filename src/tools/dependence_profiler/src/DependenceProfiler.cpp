@@ -0,0 +1,51 @@
+/*
+ * Copyright 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DependenceProfilerPass.hpp"
+
+namespace llvm::noelle {
+
+  std::vector<Instruction *> getInstructionsToIndex (Function &F){
+    std::vector<Instruction *> insts;
+    for (auto &inst : instructions(F)){
+      insts.push_back(&inst);
+    }
+
+    return insts;
+  }
+
+  std::vector<std::pair<Value *, Value *>> getAccessedMemory (Instruction *inst, const DataLayout &DL){
+    std::vector<std::pair<Value *, Value *>> ranges;
+    auto int64Type = IntegerType::get(inst->getContext(), 64);
+
+    if (auto load = dyn_cast<LoadInst>(inst)){
+      auto bytes = DL.getTypeStoreSize(load->getType());
+      ranges.push_back({ load->getPointerOperand(), ConstantInt::get(int64Type, bytes) });
+
+    } else if (auto store = dyn_cast<StoreInst>(inst)){
+      auto bytes = DL.getTypeStoreSize(store->getValueOperand()->getType());
+      ranges.push_back({ store->getPointerOperand(), ConstantInt::get(int64Type, bytes) });
+
+    } else if (auto memTransfer = dyn_cast<MemTransferInst>(inst)){
+
+      /*
+       * The dependence could go through either the bytes read or the bytes written.
+       */
+      ranges.push_back({ memTransfer->getRawDest(), memTransfer->getLength() });
+      ranges.push_back({ memTransfer->getRawSource(), memTransfer->getLength() });
+
+    } else if (auto memSet = dyn_cast<MemSetInst>(inst)){
+      ranges.push_back({ memSet->getRawDest(), memSet->getLength() });
+    }
+
+    return ranges;
+  }
+
+}
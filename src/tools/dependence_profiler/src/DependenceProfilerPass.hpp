@@ -0,0 +1,66 @@
+/*
+ * Copyright 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/Noelle.hpp"
+
+using namespace llvm;
+
+namespace llvm::noelle {
+
+  /*
+   * Return the instructions of @F in the order used to identify them within the dependence profile: the index of an instruction is its position in the returned list.
+   */
+  std::vector<Instruction *> getInstructionsToIndex (Function &F);
+
+  /*
+   * Return the memory ranges accessed by @inst as pairs of address and number of bytes.
+   *
+   * @return An empty list if the accesses of @inst cannot be profiled (e.g., calls to non-intrinsic functions).
+   */
+  std::vector<std::pair<Value *, Value *>> getAccessedMemory (Instruction *inst, const DataLayout &DL);
+
+  /*
+   * Instrument the may loop-carried memory dependences of the loops to count how often they manifest at run time.
+   */
+  class DependenceProfilerInstrumentation : public ModulePass {
+    public:
+      static char ID; 
+
+      DependenceProfilerInstrumentation();
+
+      bool doInitialization (Module &M) override ;
+
+      bool runOnModule (Module &M) override ;
+      
+      void getAnalysisUsage(AnalysisUsage &AU) const override ;
+  };
+
+  /*
+   * Attach the dependence profile generated by the instrumented program to the instructions, where HotProfiler reads it.
+   */
+  class DependenceProfilerEmbed : public ModulePass {
+    public:
+      static char ID; 
+
+      DependenceProfilerEmbed();
+
+      bool doInitialization (Module &M) override ;
+
+      bool runOnModule (Module &M) override ;
+      
+      void getAnalysisUsage(AnalysisUsage &AU) const override ;
+
+    private:
+      std::string profileFileName;
+  };
+
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <fstream>
+#include <sstream>
+
+#include "noelle/core/SystemHeaders.hpp"
+#include "DependenceProfilerPass.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+/*
+ * Fetch the ID attached to @inst as @metadataName, attaching a new one if it does not have it.
+ */
+static MDNode * fetchID (Instruction *inst, const std::string &metadataName, uint64_t &nextID){
+  auto id = inst->getMetadata(metadataName);
+  if (id != nullptr){
+    return id;
+  }
+
+  auto &context = inst->getContext();
+  auto idConstant = ConstantInt::get(Type::getInt64Ty(context), nextID++);
+  id = MDNode::get(context, ConstantAsMetadata::get(idConstant));
+  inst->setMetadata(metadataName, id);
+
+  return id;
+}
+
+bool DependenceProfilerEmbed::runOnModule (Module &M) {
+
+  /*
+   * Read the profile.
+   */
+  std::ifstream profile(this->profileFileName);
+  if (!profile.is_open()){
+    errs() << "DependenceProfilerEmbed: ERROR = cannot open the dependence profile " << this->profileFileName << "\n";
+    abort();
+  }
+
+  /*
+   * Attach the profile of each dependence to its destination.
+   *
+   * The sources of the dependences and the loops (through the terminator of their header) get an ID, which the destinations refer to.
+   * Each destination carries a tuple with an entry per profiled dependence: the ID of the source, the ID of the loop, the checks, and the manifestations.
+   */
+  auto &context = M.getContext();
+  auto int64Type = Type::getInt64Ty(context);
+  std::unordered_map<Function *, std::vector<Instruction *>> functionInstructions;
+  std::unordered_map<Instruction *, std::vector<Metadata *>> dependencesOfInstructions;
+  uint64_t nextSourceID = 0;
+  uint64_t nextLoopID = 0;
+  std::string line;
+  while (std::getline(profile, line)){
+    std::istringstream lineStream(line);
+    uint64_t checks, manifestations, loopIndex, fromIndex, toIndex;
+    if (!(lineStream >> checks >> manifestations >> loopIndex >> fromIndex >> toIndex)){
+      continue ;
+    }
+    std::string functionName;
+    std::getline(lineStream >> std::ws, functionName);
+
+    /*
+     * Fetch the instructions of the dependence.
+     */
+    auto F = M.getFunction(functionName);
+    if (F != nullptr && functionInstructions.find(F) == functionInstructions.end()){
+      functionInstructions[F] = getInstructionsToIndex(*F);
+    }
+    if (  false
+          || (F == nullptr)
+          || (loopIndex >= functionInstructions[F].size())
+          || (fromIndex >= functionInstructions[F].size())
+          || (toIndex >= functionInstructions[F].size())
+       ){
+      errs() << "DependenceProfilerEmbed: ERROR = the dependence profile " << this->profileFileName << " does not match the program\n";
+      abort();
+    }
+    auto &insts = functionInstructions[F];
+    auto headerTerminator = insts[loopIndex];
+    auto fromInst = insts[fromIndex];
+    auto toInst = insts[toIndex];
+
+    /*
+     * Add the dependence to the ones of its destination.
+     */
+    Metadata *dependenceM[] = {
+      fetchID(fromInst, "noelle.prof.dependence.source.id", nextSourceID),
+      fetchID(headerTerminator, "noelle.prof.dependence.loop.id", nextLoopID),
+      ConstantAsMetadata::get(ConstantInt::get(int64Type, checks)),
+      ConstantAsMetadata::get(ConstantInt::get(int64Type, manifestations))
+    };
+    dependencesOfInstructions[toInst].push_back(MDNode::get(context, dependenceM));
+  }
+  for (auto &instDependences : dependencesOfInstructions){
+    instDependences.first->setMetadata("noelle.prof.dependences", MDTuple::get(context, instDependences.second));
+  }
+
+  return dependencesOfInstructions.size() > 0;
+}
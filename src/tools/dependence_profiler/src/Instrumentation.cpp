@@ -0,0 +1,185 @@
+/*
+ * Copyright 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/SystemHeaders.hpp"
+#include "DependenceProfilerPass.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+/*
+ * A may loop-carried memory dependence to profile.
+ */
+struct ProfiledDependence {
+  Instruction *fromInst;
+  Instruction *toInst;
+  int64_t loopID;
+  std::string description;
+};
+
+bool DependenceProfilerInstrumentation::runOnModule (Module &M) {
+
+  /*
+   * The state of the profiler is allocated at the entry of main.
+   */
+  auto mainF = M.getFunction("main");
+  if (mainF == nullptr || mainF->empty()){
+    errs() << "DependenceProfilerInstrumentation: ERROR = the program has no main function\n";
+    abort();
+  }
+
+  /*
+   * Fetch the outputs of the passes we rely on.
+   */
+  auto& noelle = getAnalysis<Noelle>();
+  auto &DL = M.getDataLayout();
+
+  /*
+   * Fetch the loops to profile (the hot ones when profiles are available).
+   */
+  auto loops = noelle.getLoops();
+
+  /*
+   * Select the dependences to profile.
+   *
+   * A dependence is identified within the profile by the indices of the terminator of the header of its loop and of its two instructions.
+   * Indices are computed before instrumenting the code, so they refer to the code the profile will be embedded into.
+   */
+  std::unordered_map<Function *, std::unordered_map<Instruction *, uint64_t>> instructionIndices;
+  auto getIndex = [&instructionIndices](Instruction *inst) -> uint64_t {
+    auto F = inst->getFunction();
+    if (instructionIndices.find(F) == instructionIndices.end()){
+      auto &indices = instructionIndices[F];
+      uint64_t index = 0;
+      for (auto functionInst : getInstructionsToIndex(*F)){
+        indices[functionInst] = index++;
+      }
+    }
+    return instructionIndices[F][inst];
+  };
+  std::vector<LoopStructure *> profiledLoops;
+  std::vector<ProfiledDependence> profiledDependences;
+  for (auto LDI : *loops){
+    auto loopStructure = LDI->getLoopStructure();
+    if (loopStructure->getPreHeader() == nullptr){
+      continue ;
+    }
+    auto loopID = (int64_t)profiledLoops.size();
+    auto headerTerminator = loopStructure->getHeader()->getTerminator();
+
+    /*
+     * Collect the may loop-carried memory dependences between instructions of the loop whose accesses can be observed.
+     */
+    std::set<std::pair<Instruction *, Instruction *>> dependencesOfLoop;
+    auto loopDG = LDI->getLoopDG();
+    for (auto edge : loopDG->getEdges()){
+      if (  false
+            || (!edge->isMemoryDependence())
+            || (edge->isMustDependence())
+            || (!edge->isLoopCarriedDependence())
+         ){
+        continue ;
+      }
+      auto fromInst = dyn_cast<Instruction>(edge->getOutgoingT());
+      auto toInst = dyn_cast<Instruction>(edge->getIncomingT());
+      if (  false
+            || (fromInst == nullptr)
+            || (toInst == nullptr)
+            || (!loopStructure->isIncluded(fromInst))
+            || (!loopStructure->isIncluded(toInst))
+            || (getAccessedMemory(fromInst, DL).size() == 0)
+            || (getAccessedMemory(toInst, DL).size() == 0)
+         ){
+        continue ;
+      }
+
+      /*
+       * The accesses of an instruction do not depend on the type of the dependence, so we profile each pair of instructions once.
+       */
+      if (!dependencesOfLoop.insert({ fromInst, toInst }).second){
+        continue ;
+      }
+      auto description = std::to_string(getIndex(headerTerminator)) + " " + std::to_string(getIndex(fromInst)) + " " + std::to_string(getIndex(toInst)) + " " + fromInst->getFunction()->getName().str();
+      profiledDependences.push_back({ fromInst, toInst, loopID, description });
+    }
+    if (dependencesOfLoop.size() > 0){
+      profiledLoops.push_back(loopStructure);
+    }
+  }
+  errs() << "DependenceProfilerInstrumentation: Profile " << profiledDependences.size() << " dependences of " << profiledLoops.size() << " loops\n";
+
+  /*
+   * Declare the APIs of the dependence profiler, which are implemented by the NOELLE runtime.
+   */
+  auto &context = M.getContext();
+  auto int64Type = IntegerType::get(context, 64);
+  auto int8PtrType = Type::getInt8PtrTy(context);
+  auto voidType = Type::getVoidTy(context);
+  auto initialize = M.getOrInsertFunction("NOELLE_dependenceProfilerInitialize", voidType, int64Type, int64Type, PointerType::getUnqual(int8PtrType));
+  auto invocationBegins = M.getOrInsertFunction("NOELLE_dependenceProfilerInvocationBegins", voidType, int64Type);
+  auto iterationBegins = M.getOrInsertFunction("NOELLE_dependenceProfilerIterationBegins", voidType, int64Type);
+  auto source = M.getOrInsertFunction("NOELLE_dependenceProfilerSource", voidType, int64Type, int64Type, int8PtrType, int64Type);
+  auto destination = M.getOrInsertFunction("NOELLE_dependenceProfilerDestination", voidType, int64Type, int64Type, int8PtrType, int64Type);
+
+  /*
+   * Track the invocations and the iterations of the loops.
+   */
+  for (auto loopID = 0u; loopID < profiledLoops.size(); loopID++){
+    auto loopStructure = profiledLoops[loopID];
+    auto loopIDValue = ConstantInt::get(int64Type, loopID);
+
+    IRBuilder<> preHeaderBuilder(loopStructure->getPreHeader()->getTerminator());
+    preHeaderBuilder.CreateCall(invocationBegins, ArrayRef<Value *>({ loopIDValue }));
+
+    auto header = loopStructure->getHeader();
+    IRBuilder<> headerBuilder(&*header->getFirstInsertionPt());
+    headerBuilder.CreateCall(iterationBegins, ArrayRef<Value *>({ loopIDValue }));
+  }
+
+  /*
+   * Track the accesses of the dependences.
+   * The destination is checked before the source records its access, so a dependence of an instruction with itself only manifests across iterations.
+   */
+  auto trackAccesses = [&DL, int64Type, int8PtrType](FunctionCallee track, Instruction *inst, uint64_t dependenceID, int64_t loopID){
+    IRBuilder<> builder(inst);
+    for (auto range : getAccessedMemory(inst, DL)){
+      auto address = builder.CreatePointerCast(range.first, int8PtrType);
+      auto bytes = builder.CreateZExtOrTrunc(range.second, int64Type);
+      builder.CreateCall(track, ArrayRef<Value *>({ ConstantInt::get(int64Type, dependenceID), ConstantInt::get(int64Type, loopID), address, bytes }));
+    }
+  };
+  std::vector<Constant *> descriptions;
+  for (auto dependenceID = 0u; dependenceID < profiledDependences.size(); dependenceID++){
+    auto &dependence = profiledDependences[dependenceID];
+    trackAccesses(destination, dependence.toInst, dependenceID, dependence.loopID);
+    trackAccesses(source, dependence.fromInst, dependenceID, dependence.loopID);
+
+    /*
+     * Create the description of the dependence.
+     */
+    auto descriptionArray = ConstantDataArray::getString(context, dependence.description);
+    auto descriptionGlobal = new GlobalVariable(M, descriptionArray->getType(), true, GlobalValue::PrivateLinkage, descriptionArray, "noelle.dependence.description");
+    descriptions.push_back(ConstantExpr::getPointerCast(descriptionGlobal, int8PtrType));
+  }
+
+  /*
+   * Allocate the state of the profiler.
+   */
+  auto descriptionsType = ArrayType::get(int8PtrType, descriptions.size());
+  auto descriptionsGlobal = new GlobalVariable(M, descriptionsType, true, GlobalValue::PrivateLinkage, ConstantArray::get(descriptionsType, descriptions), "noelle.dependence.descriptions");
+  IRBuilder<> mainBuilder(&*mainF->getEntryBlock().getFirstInsertionPt());
+  mainBuilder.CreateCall(initialize, ArrayRef<Value *>({
+    ConstantInt::get(int64Type, profiledLoops.size()),
+    ConstantInt::get(int64Type, profiledDependences.size()),
+    ConstantExpr::getPointerCast(descriptionsGlobal, PointerType::getUnqual(int8PtrType))
+  }));
+
+  return true;
+}
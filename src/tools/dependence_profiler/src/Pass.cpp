@@ -0,0 +1,64 @@
+/*
+ * Copyright 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/SystemHeaders.hpp"
+#include "DependenceProfilerPass.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+DependenceProfilerInstrumentation::DependenceProfilerInstrumentation()
+  :
+  ModulePass(ID)
+  {
+
+  return ;
+}
+
+bool DependenceProfilerInstrumentation::doInitialization (Module &M) {
+  return false;
+}
+
+void DependenceProfilerInstrumentation::getAnalysisUsage (AnalysisUsage &AU) const {
+
+  /*
+   * Analyses.
+   */
+  AU.addRequired<Noelle>();
+
+  return ;
+}
+
+static cl::opt<std::string> DependenceProfileFileName("noelle-dependence-profile", cl::ZeroOrMore, cl::Hidden, cl::init("default.depprof"), cl::desc("File with the dependence profile generated by a program instrumented by noelle-prof-dependences"));
+
+DependenceProfilerEmbed::DependenceProfilerEmbed()
+  :
+  ModulePass(ID)
+  {
+
+  return ;
+}
+
+bool DependenceProfilerEmbed::doInitialization (Module &M) {
+  this->profileFileName = DependenceProfileFileName.getValue();
+
+  return false;
+}
+
+void DependenceProfilerEmbed::getAnalysisUsage (AnalysisUsage &AU) const {
+  return ;
+}
+
+// Next there is code to register your passes to "opt"
+char DependenceProfilerInstrumentation::ID = 0;
+static RegisterPass<DependenceProfilerInstrumentation> X("DependenceProfilerInstrumentation", "Instrument loop-carried memory dependences to profile how often they manifest");
+
+char DependenceProfilerEmbed::ID = 0;
+static RegisterPass<DependenceProfilerEmbed> Y("DependenceProfilerEmbed", "Embed the dependence profile into the IR");
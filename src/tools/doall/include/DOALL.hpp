@@ -53,8 +53,26 @@ namespace llvm::noelle {
     protected:
       bool enabled;
       Function *taskDispatcher;
+      Function *chunkFetcher;
       Noelle &n;
 
+      /*
+       * Schedule of the iterations
+       */
+      DOALLSchedule selectIterationSchedule (
+        LoopDependenceInfo *LDI,
+        Noelle &par
+      ) const ;
+
+      /*
+       * Return how much the cost of an iteration of @loopStructure varies relative to its typical cost.
+       * The measured distribution of the cost is used when available; otherwise, its variance is modeled from the profile of the basic blocks.
+       */
+      double computeVariationOfIterationCost (
+        LoopStructure *loopStructure,
+        Hot *hot
+      ) const ;
+
       /*
        * DOALL specific generation
        */
@@ -62,6 +80,12 @@ namespace llvm::noelle {
         LoopDependenceInfo *LDI
       );
 
+      std::unordered_map<BasicBlock *, Value *> addCodeToFetchChunksAtLatches (
+        LoopDependenceInfo *LDI,
+        PHINode *chunkPHI,
+        std::unordered_map<BasicBlock *, BasicBlock *> &backEdgeBlocks
+      );
+
       void addChunkFunctionExecutionAsideOriginalLoop (
         LoopDependenceInfo *LDI,
         Function *loopFunction,
@@ -12,6 +12,7 @@
 
 #include "noelle/core/Task.hpp"
 #include "noelle/core/SCCDAGAttrs.hpp"
+#include "noelle/core/Transformations.hpp"
 
 namespace llvm::noelle {
 
@@ -31,7 +32,12 @@ namespace llvm::noelle {
       /*
        * Chunking function specific arguments
        */
-      Value *coreArg, *numCoresArg, *chunkSizeArg;
+      Value *coreArg, *numCoresArg, *chunkSizeArg, *schedulerArg;
+
+      /*
+       * Schedule of the iterations among the instances of the task
+       */
+      DOALLSchedule iterationSchedule;
 
       /*
        * Clone of original IV loop, new outer loop
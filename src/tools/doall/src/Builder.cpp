@@ -48,9 +48,31 @@ void DOALL::rewireLoopToIterateChunks (
    */
   auto clonedStepSizeMap = this->cloneIVStepValueComputation(LDI, 0, entryBuilder);
 
+  /*
+   * Compute the number of iterations that precede the first chunk of the task.
+   *
+   * With the static schedule, the chunks are assigned round-robin: the first chunk of the task is the one at core_id * chunk_size.
+   * With the dynamic and guided schedules, the chunks are assigned on demand by the runtime.
+   * In this case, we also add the code to fetch a new chunk every time the current one is completed.
+   */
+  auto isScheduleStatic = (task->iterationSchedule == DOALL_STATIC_SCHEDULE_ID);
+  Value *iterationsBeforeFirstChunk = nullptr;
+  std::unordered_map<BasicBlock *, Value *> iterationsToSkipAtLatches;
+  std::unordered_map<BasicBlock *, BasicBlock *> backEdgeBlocks;
+  if (isScheduleStatic){
+    iterationsBeforeFirstChunk = entryBuilder.CreateMul(task->coreArg, task->chunkSizeArg, "coreIdx_X_chunkSize");
+
+  } else {
+    iterationsBeforeFirstChunk = entryBuilder.CreateCall(this->chunkFetcher, ArrayRef<Value *>({
+      task->schedulerArg,
+      task->coreArg
+    }), "iterationsBeforeFirstChunk");
+    iterationsToSkipAtLatches = this->addCodeToFetchChunksAtLatches(LDI, chunkPHI, backEdgeBlocks);
+  }
+
   /*
    * Determine start value of the IV for the task
-   * core_start: original_start + original_step_size * core_id * chunk_size
+   * core_start: original_start + original_step_size * iterations_before_first_chunk
    */
   for (auto ivInfo : allIVInfo->getInductionVariables(*loopSummary)) {
     auto startOfIV = fetchClone(ivInfo->getStartValue());
@@ -60,7 +82,7 @@ void DOALL::rewireLoopToIterateChunks (
     auto nthCoreOffset = entryBuilder.CreateMul(
       stepOfIV,
       entryBuilder.CreateZExtOrTrunc(
-        entryBuilder.CreateMul(task->coreArg, task->chunkSizeArg, "coreIdx_X_chunkSize"),
+        iterationsBeforeFirstChunk,
         stepOfIV->getType()
       ),
       "stepSize_X_coreIdx_X_chunkSize"
@@ -78,6 +100,28 @@ void DOALL::rewireLoopToIterateChunks (
   for (auto ivInfo : allIVInfo->getInductionVariables(*loopSummary)) {
     auto stepOfIV = clonedStepSizeMap.at(ivInfo);
     auto ivPHI = cast<PHINode>(fetchClone(ivInfo->getLoopEntryPHI()));
+
+    /*
+     * With chunks assigned on demand, the distance to the next chunk is the one returned by the runtime at each latch.
+     * This distance is 0 while the current chunk is still in progress.
+     * chunk_step_size: original_step_size * iterations_to_skip
+     */
+    if (!isScheduleStatic){
+      for (auto latchAndIterationsToSkip : iterationsToSkipAtLatches){
+        auto latch = latchAndIterationsToSkip.first;
+        auto iterationsToSkip = latchAndIterationsToSkip.second;
+        IRBuilder<> latchBuilder(latch->getTerminator());
+        auto chunkStepSize = latchBuilder.CreateMul(
+          stepOfIV,
+          latchBuilder.CreateZExtOrTrunc(iterationsToSkip, stepOfIV->getType()),
+          "stepSizeToNextChunk"
+        );
+        auto nextValueOfIV = IVUtility::offsetIVPHI(latch, ivPHI, ivPHI->getIncomingValueForBlock(latch), chunkStepSize);
+        ivPHI->setIncomingValueForBlock(latch, nextValueOfIV);
+      }
+      continue ;
+    }
+
     auto onesValueForChunking = ConstantInt::get(chunkCounterType, 1);
     auto chunkStepSize = entryBuilder.CreateMul(
       stepOfIV,
@@ -337,8 +381,14 @@ void DOALL::rewireLoopToIterateChunks (
 
     /*
      * Fetch the latch in the loop within the task.
+     *
+     * With chunks assigned on demand, the clone of the latch is followed by the code that fetches the next chunk.
+     * In this case, the check goes in the block that jumps back to the header.
      */
     auto cloneLatch = task->getCloneOfOriginalBasicBlock(latch);
+    if (backEdgeBlocks.find(cloneLatch) != backEdgeBlocks.end()){
+      cloneLatch = backEdgeBlocks.at(cloneLatch);
+    }
 
     /*
      * Remove the old terminator because it will replace with the check.
@@ -410,4 +460,60 @@ void DOALL::rewireLoopToIterateChunks (
   return ;
 }
 
+std::unordered_map<BasicBlock *, Value *> DOALL::addCodeToFetchChunksAtLatches (
+  LoopDependenceInfo *LDI,
+  PHINode *chunkPHI,
+  std::unordered_map<BasicBlock *, BasicBlock *> &backEdgeBlocks
+  ){
+  std::unordered_map<BasicBlock *, Value *> iterationsToSkipAtLatches;
+
+  /*
+   * Fetch the task.
+   */
+  auto task = (DOALLTask *)tasks[0];
+  auto loopSummary = LDI->getLoopStructure();
+
+  for (auto latch : loopSummary->getLatches()) {
+
+    /*
+     * Fetch the latch in the loop within the task.
+     * Fetch the condition that checks whether the current chunk has been completed.
+     */
+    auto cloneLatch = task->getCloneOfOriginalBasicBlock(latch);
+    auto chunkWrap = cast<SelectInst>(chunkPHI->getIncomingValueForBlock(cloneLatch));
+    auto isChunkCompleted = chunkWrap->getCondition();
+
+    /*
+     * Fetch a new chunk only when the current one has been completed.
+     */
+    auto fetchTerminator = SplitBlockAndInsertIfThen(isChunkCompleted, cloneLatch->getTerminator(), false);
+    auto fetchBB = fetchTerminator->getParent();
+    auto newLatch = fetchTerminator->getSuccessor(0);
+    IRBuilder<> fetchBuilder(fetchTerminator);
+    auto fetchedIterationsToSkip = fetchBuilder.CreateCall(this->chunkFetcher, ArrayRef<Value *>({
+      task->schedulerArg,
+      task->coreArg
+    }), "iterationsToNextChunk");
+
+    /*
+     * Merge the distance to the next chunk: it is 0 if the current chunk is still in progress.
+     */
+    IRBuilder<> newLatchBuilder(newLatch->getFirstNonPHI());
+    auto iterationsToSkip = newLatchBuilder.CreatePHI(fetchedIterationsToSkip->getType(), 2, "iterationsToSkip");
+    iterationsToSkip->addIncoming(ConstantInt::get(fetchedIterationsToSkip->getType(), 0), cloneLatch);
+    iterationsToSkip->addIncoming(fetchedIterationsToSkip, fetchBB);
+
+    /*
+     * The new block is the one that jumps back to the header.
+     *
+     * The clone of the latch keeps being the clone of the original latch within the task: it still includes the clones of the instructions of the latch.
+     * Hence, the new block is not added to the task.
+     */
+    backEdgeBlocks[cloneLatch] = newLatch;
+    iterationsToSkipAtLatches[newLatch] = iterationsToSkip;
+  }
+
+  return iterationsToSkipAtLatches;
+}
+
 }
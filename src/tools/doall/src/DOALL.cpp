@@ -19,6 +19,7 @@ DOALL::DOALL (
     ParallelizationTechnique{*noelle.getProgram(), *noelle.getProfiles(), noelle.getVerbosity()}
   , enabled{true}
   , taskDispatcher{nullptr}
+  , chunkFetcher{nullptr}
   , n{noelle}
   {
 
@@ -30,7 +31,8 @@ DOALL::DOALL (
     tm->getVoidPointerType(),
     tm->getIntegerType(64),
     tm->getIntegerType(64),
-    tm->getIntegerType(64)
+    tm->getIntegerType(64),
+    tm->getVoidPointerType()
   });
   this->taskSignature = FunctionType::get(tm->getVoidType(), funcArgTypes, false);
 
@@ -45,6 +47,12 @@ DOALL::DOALL (
     }
   }
 
+  /*
+   * Fetch the function that assigns chunks of iterations to the tasks of loops with a dynamic or guided schedule.
+   * Without it, all loops use the static schedule.
+   */
+  this->chunkFetcher = this->n.getProgram()->getFunction("NOELLE_DOALLFetchChunk");
+
   return ;
 }
 
@@ -245,6 +253,21 @@ bool DOALL::apply (
    * Generate an empty task for the parallel DOALL execution.
    */
   auto chunkerTask = new DOALLTask(this->taskSignature, this->module);
+  chunkerTask->iterationSchedule = this->selectIterationSchedule(LDI, par);
+  if (this->verbose != Verbosity::Disabled) {
+    errs() << "DOALL:   Schedule = ";
+    switch (chunkerTask->iterationSchedule){
+      case DOALL_DYNAMIC_SCHEDULE_ID:
+        errs() << "dynamic\n";
+        break ;
+      case DOALL_GUIDED_SCHEDULE_ID:
+        errs() << "guided\n";
+        break ;
+      default:
+        errs() << "static\n";
+        break ;
+    }
+  }
   this->addPredecessorAndSuccessorsBasicBlocksToTasks(LDI, { chunkerTask });
   this->numTaskInstances = LDI->getMaximumNumberOfCores();
 
@@ -379,6 +402,23 @@ void DOALL::addChunkFunctionExecutionAsideOriginalLoop (
    */
   auto chunkSize = ConstantInt::get(par.int64, LDI->DOALLChunkSize);
 
+  /*
+   * Fetch the schedule of the iterations.
+   */
+  auto task = (DOALLTask *)tasks[0];
+  auto schedule = ConstantInt::get(par.int64, task->iterationSchedule);
+
+  /*
+   * Fetch the number of iterations the loop is expected to execute.
+   * This is only used by the guided schedule to size the chunks that are grabbed together.
+   */
+  uint64_t expectedIterations = 0;
+  auto hot = par.getProfiles();
+  if (hot->isAvailable()){
+    expectedIterations = (uint64_t)hot->getAverageLoopIterationsPerInvocation(LDI->getLoopStructure());
+  }
+  auto expectedIterationsValue = ConstantInt::get(par.int64, expectedIterations);
+
   /*
    * Call the function that incudes the parallelized loop.
    */
@@ -387,7 +427,9 @@ void DOALL::addChunkFunctionExecutionAsideOriginalLoop (
     tasks[0]->getTaskBody(),
     envPtr,
     numCores,
-    chunkSize
+    chunkSize,
+    schedule,
+    expectedIterationsValue
   }));
   auto numThreadsUsed = doallBuilder.CreateExtractValue(doallCallInst, (uint64_t)0);
 
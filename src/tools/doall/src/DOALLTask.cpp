@@ -18,6 +18,7 @@ DOALLTask::DOALLTask (
   Module &M
   )
   :Task{0, taskSignature, M}
+  , iterationSchedule{DOALL_STATIC_SCHEDULE_ID}
   {
 
   return ;
@@ -29,6 +30,7 @@ void DOALLTask::extractFuncArgs (void) {
   this->coreArg = (Value *) &*(argIter++); 
   this->numCoresArg = (Value *) &*(argIter++);
   this->chunkSizeArg = (Value *) &*(argIter++);
+  this->schedulerArg = (Value *) &*(argIter++);
   this->instanceIndexV = coreArg;
 
   return ;
@@ -91,4 +91,102 @@ std::set<SCC *> DOALL::getSCCsThatBlockDOALLToBeApplicable (
   return sccs;
 }
 
+DOALLSchedule DOALL::selectIterationSchedule (
+  LoopDependenceInfo *LDI,
+  Noelle &par
+  ) const {
+
+  /*
+   * Fetch the loop structure.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto loopHeader = loopStructure->getHeader();
+
+  /*
+   * Chunks can be assigned on demand only if the runtime provides the API to do so.
+   * Moreover, the code that fetches a new chunk is added to the latches, which must be distinct from the header.
+   */
+  auto latches = loopStructure->getLatches();
+  if (  false
+        || (this->chunkFetcher == nullptr)
+        || (latches.find(loopHeader) != latches.end())
+     ){
+    if (  true
+          && (LDI->DOALLIterationSchedule != DOALL_AUTO_SCHEDULE_ID)
+          && (LDI->DOALLIterationSchedule != DOALL_STATIC_SCHEDULE_ID)
+          && (this->verbose != Verbosity::Disabled)
+       ){
+      errs() << "DOALL:   WARNING: the requested schedule cannot be used for this loop. The static schedule will be used\n";
+    }
+    return DOALL_STATIC_SCHEDULE_ID;
+  }
+
+  /*
+   * Check if the schedule has been chosen by the user.
+   */
+  if (LDI->DOALLIterationSchedule != DOALL_AUTO_SCHEDULE_ID){
+    return LDI->DOALLIterationSchedule;
+  }
+
+  /*
+   * Without a profile, we have no evidence that iterations have different costs.
+   */
+  auto hot = par.getProfiles();
+  if (  false
+        || (!hot->isAvailable())
+        || (!hot->hasBeenExecuted(loopStructure))
+     ){
+    return DOALL_STATIC_SCHEDULE_ID;
+  }
+
+  /*
+   * Compute how much the cost of an iteration varies relative to its typical cost.
+   * Iterations with similar costs are best served by the static schedule, which has no synchronization.
+   */
+  auto variationOfCost = this->computeVariationOfIterationCost(loopStructure, hot);
+  if (variationOfCost < 0.5){
+    return DOALL_STATIC_SCHEDULE_ID;
+  }
+
+  /*
+   * Iterations have irregular costs.
+   * Loops with many iterations per core grab several chunks at once (guided) to reduce the contention on the shared iteration counter.
+   */
+  auto iterationsPerInvocation = hot->getAverageLoopIterationsPerInvocation(loopStructure);
+  auto iterationsPerRound = ((double)LDI->getMaximumNumberOfCores()) * ((double)LDI->DOALLChunkSize);
+  if (iterationsPerInvocation >= (16 * iterationsPerRound)){
+    return DOALL_GUIDED_SCHEDULE_ID;
+  }
+
+  return DOALL_DYNAMIC_SCHEDULE_ID;
+}
+
+double DOALL::computeVariationOfIterationCost (
+  LoopStructure *loopStructure,
+  Hot *hot
+  ) const {
+
+  /*
+   * Use the cycles per iteration measured by the profiler if they are available (see noelle-prof-coverage --loops).
+   * The spread between the 10th and the 90th percentiles of a normal distribution is 2.56 standard deviations, so the spread is scaled to be comparable with the coefficient of variation of the model below.
+   */
+  auto medianCycles = hot->getLoopCyclesPerIterationQuantile(loopStructure, 0.5);
+  if (medianCycles > 0){
+    auto lowCycles = hot->getLoopCyclesPerIterationQuantile(loopStructure, 0.1);
+    auto highCycles = hot->getLoopCyclesPerIterationQuantile(loopStructure, 0.9);
+
+    return (highCycles - lowCycles) / (2.56 * medianCycles);
+  }
+
+  /*
+   * Fall back to the variance modeled from the execution counts of the basic blocks of the loop.
+   */
+  auto averageCost = hot->getAverageTotalInstructionsPerIteration(loopStructure);
+  if (averageCost == 0){
+    return 0;
+  }
+
+  return std::sqrt(hot->getVarianceOfTotalInstructionsPerIteration(loopStructure)) / averageCost;
+}
+
 }
@@ -93,6 +93,7 @@ namespace llvm::noelle {
       void generateLoadsOfQueuePointers (Noelle &par, int taskIndex);
       void popValueQueues (LoopDependenceInfo *LDI, Noelle &par, int taskIndex);
       void pushValueQueues (LoopDependenceInfo *LDI, Noelle &par, int taskIndex);
+      void flushValueQueues (Noelle &par, int taskIndex);
       void createPipelineFromStages (LoopDependenceInfo *LDI, Noelle &par);
       Value * createStagesArrayFromStages (
         LoopDependenceInfo *LDI,
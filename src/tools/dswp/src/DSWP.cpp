@@ -360,6 +360,11 @@ bool DSWP::apply (
     IRBuilder<> exitBuilder(task->getExit());
     exitBuilder.CreateRetVoid();
 
+    /*
+     * Publish the values still buffered in the queues the current pipeline stage pushes to.
+     */
+    flushValueQueues(par, i);
+
     /*
      * Store final results to loop live-out variables.
      * Generate a store to propagate the information about which exit block has been taken from the parallelized loop to the code outside it.
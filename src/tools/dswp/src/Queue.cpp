@@ -374,3 +374,23 @@ void DSWP::pushValueQueues (LoopDependenceInfo *LDI, Noelle &par, int taskIndex)
 
   }
 }
+
+void DSWP::flushValueQueues (Noelle &par, int taskIndex) {
+  auto task = (DSWPTask *)this->tasks[taskIndex];
+
+  /*
+   * Queues publish values in batches, so the values produced since the last batch must be published when the stage ends.
+   *
+   * While the stage runs, the runtime publishes the pending values of all queues of the stage before the stage waits on any queue.
+   * This is what guarantees progress when a stage feeds several stages (e.g., A->B, B->C, and A->C): the flush below only publishes the values left when the stage exits.
+   */
+  IRBuilder<> builder(task->getExit()->getTerminator());
+  for (auto queueIndex : task->pushValueQueues) {
+    auto queueInstrs = task->queueInstrMap[queueIndex].get();
+    auto queueInfo = this->queues[queueIndex].get();
+    auto queueFlushFunction = par.queues.queueFlushes[par.queues.queueSizeToIndex[queueInfo->bitLength]];
+    builder.CreateCall(queueFlushFunction, ArrayRef<Value*>({ queueInstrs->queuePtr }));
+  }
+
+  return ;
+}
@@ -129,6 +129,9 @@ bool EnablersManager::runOnModule (Module &M) {
           loopInvariantCodeMotion,
           scevSimplification
           );
+      if (modifiedFunctions[f]){
+        noelle.invalidateFunctionAnalyses(f);
+      }
       modified |= modifiedFunctions[f];
 
       return false;
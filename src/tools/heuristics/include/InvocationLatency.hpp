@@ -15,12 +15,13 @@
 #include "noelle/core/SCCDAGAttrs.hpp"
 #include "noelle/core/SCCDAGPartition.hpp"
 #include "noelle/core/Hot.hpp"
+#include "noelle/core/MachineCostModel.hpp"
 
 namespace llvm::noelle {
 
   class InvocationLatency {
     public:
-      InvocationLatency (Hot *hot);
+      InvocationLatency (Hot *hot, MachineCostModel *costModel);
 
       uint64_t latencyPerInvocation (SCC *scc);
 
@@ -36,6 +37,7 @@ namespace llvm::noelle {
 
     private:
       Hot *profiles;
+      MachineCostModel *costModel;
       std::unordered_map<Function *, uint64_t> funcToCost;
       std::unordered_map<Value *, uint64_t> queueValToCost;
       std::unordered_map<SCC *, uint64_t> sccToCost;
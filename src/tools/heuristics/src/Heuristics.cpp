@@ -14,7 +14,7 @@ using namespace llvm;
 using namespace llvm::noelle;
 
 Heuristics::Heuristics (Noelle &noelle)
-  : invocationLatency{noelle.getProfiles()}
+  : invocationLatency{noelle.getProfiles(), noelle.getMachineCostModel()}
   {
 
   return ;
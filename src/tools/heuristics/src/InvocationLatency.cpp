@@ -13,8 +13,9 @@
 using namespace llvm;
 using namespace llvm::noelle;
  
-InvocationLatency::InvocationLatency (Hot *hot)
+InvocationLatency::InvocationLatency (Hot *hot, MachineCostModel *costModel)
   : profiles{hot}
+  , costModel{costModel}
   {
   return ;
 }
@@ -31,7 +32,17 @@ uint64_t InvocationLatency::latencyPerInvocation (SCC *scc){
   /*
    * Compute the latency of the SCC.
    */
-  auto cost = this->profiles->getTotalInstructions(scc);
+  uint64_t cost = 0;
+  if (this->costModel->isCalibrated()){
+    for (auto nodePair : scc->internalNodePairs()){
+      if (auto inst = dyn_cast<Instruction>(nodePair.first)){
+        cost += this->latencyPerInvocation(inst);
+      }
+    }
+
+  } else {
+    cost = this->profiles->getTotalInstructions(scc);
+  }
   sccToCost[scc] = cost;
 
   return cost;
@@ -86,15 +97,30 @@ uint64_t InvocationLatency::latencyPerInvocation (Instruction *inst){
 
   /*
    * Estimate the latency.
+   *
+   * The instructions executed by a callee are accounted as simple integer instructions because we do not know which ones they are.
    */
-  auto latency = this->profiles->getTotalInstructions(inst);
+  if (!this->costModel->isCalibrated()){
+    return this->profiles->getTotalInstructions(inst);
+  }
+  auto executions = this->profiles->getInvocations(inst);
+  auto calleeInstructions = this->profiles->getTotalInstructions(inst) - executions;
+  auto latency = executions * this->costModel->getInstructionLatency(inst) + calleeInstructions * this->costModel->getInstructionLatency();
 
-  return latency;
+  return (uint64_t)latency;
 }
 
 uint64_t InvocationLatency::queueLatency (Value *queueVal){
-  // TODO(angelo): use primitive size of bits of type of value?
-  return 100;
+
+  /*
+   * Values without a primitive size (e.g., pointers) are sent as 64-bit values.
+   */
+  uint64_t bitWidth = queueVal->getType()->getPrimitiveSizeInBits();
+  if (bitWidth == 0){
+    bitWidth = 64;
+  }
+
+  return (uint64_t)this->costModel->getQueueLatency(bitWidth);
 }
 
 /*
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <fstream>
+#include <sstream>
+
+#include "noelle/core/SystemHeaders.hpp"
+#include "LoopProfilerPass.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+static void embedHistogram (Instruction *headerTerminator, const std::string &metadataName, const std::string &histogram){
+  auto &context = headerTerminator->getContext();
+  auto histogramString = MDString::get(context, histogram);
+  auto histogramMetadata = MDNode::get(context, histogramString);
+  headerTerminator->setMetadata(metadataName, histogramMetadata);
+
+  return ;
+}
+
+bool LoopProfilerEmbed::runOnModule (Module &M) {
+
+  /*
+   * Read the profile.
+   */
+  std::ifstream profile(this->profileFileName);
+  if (!profile.is_open()){
+    errs() << "LoopProfilerEmbed: ERROR = cannot open the loop profile " << this->profileFileName << "\n";
+    abort();
+  }
+
+  /*
+   * Fetch the loops that have been profiled.
+   * They are fetched in the same order used by the instrumentation, so the position of a loop is its ID within the profile.
+   */
+  auto loops = getLoopsToProfile(M, [this](Function &F) -> LoopInfo & {
+    return getAnalysis<LoopInfoWrapperPass>(F).getLoopInfo();
+  });
+
+  /*
+   * Attach the histograms to the loops.
+   *
+   * We cannot attach metadata to loops nor to basic blocks in the current LLVM infrastructure.
+   * Hence, we attach them to the terminator of the header of the loop, like LoopMetadata does.
+   */
+  auto modified = false;
+  std::string line;
+  while (std::getline(profile, line)){
+    std::istringstream lineStream(line);
+    uint64_t loopID;
+    std::string kind;
+    if (!(lineStream >> loopID >> kind)){
+      continue ;
+    }
+    if (loopID >= loops.size()){
+      errs() << "LoopProfilerEmbed: ERROR = the loop profile " << this->profileFileName << " does not match the program\n";
+      abort();
+    }
+    std::string histogram;
+    std::getline(lineStream >> std::ws, histogram);
+
+    auto headerTerminator = loops[loopID]->getHeader()->getTerminator();
+    if (kind == "iterations"){
+      embedHistogram(headerTerminator, "noelle.prof.loop.iterations", histogram);
+
+    } else if (kind == "cycles"){
+      embedHistogram(headerTerminator, "noelle.prof.loop.iteration_cycles", histogram);
+
+    } else {
+      continue ;
+    }
+    modified = true;
+  }
+
+  return modified;
+}
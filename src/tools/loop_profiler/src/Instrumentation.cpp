@@ -0,0 +1,118 @@
+/*
+ * Copyright 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/SystemHeaders.hpp"
+#include "LoopProfilerPass.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+bool LoopProfilerInstrumentation::runOnModule (Module &M) {
+
+  /*
+   * The histograms are allocated at the entry of main.
+   */
+  auto mainF = M.getFunction("main");
+  if (mainF == nullptr || mainF->empty()){
+    errs() << "LoopProfilerInstrumentation: ERROR = the program has no main function\n";
+    abort();
+  }
+
+  /*
+   * Fetch the loops to profile.
+   */
+  auto loops = getLoopsToProfile(M, [this](Function &F) -> LoopInfo & {
+    return getAnalysis<LoopInfoWrapperPass>(F).getLoopInfo();
+  });
+
+  /*
+   * Declare the APIs of the loop profiler, which are implemented by the NOELLE runtime.
+   */
+  auto &context = M.getContext();
+  auto int64Type = IntegerType::get(context, 64);
+  auto voidType = Type::getVoidTy(context);
+  auto initialize = M.getOrInsertFunction("NOELLE_loopProfilerInitialize", voidType, int64Type);
+  auto invocationBegins = M.getOrInsertFunction("NOELLE_loopProfilerInvocationBegins", int64Type, int64Type);
+  auto invocationEnds = M.getOrInsertFunction("NOELLE_loopProfilerInvocationEnds", voidType, int64Type, int64Type, int64Type);
+
+  /*
+   * Instrument the loops.
+   *
+   * The ID of a loop is its position in the list of loops to profile, which is recomputed when the profile is embedded.
+   */
+  for (auto loopID = 0u; loopID < loops.size(); loopID++){
+    this->instrumentLoop(loops[loopID], loopID, invocationBegins, invocationEnds);
+  }
+
+  /*
+   * Allocate the histograms.
+   */
+  IRBuilder<> mainBuilder(&*mainF->getEntryBlock().getFirstInsertionPt());
+  mainBuilder.CreateCall(initialize, ArrayRef<Value *>({ ConstantInt::get(int64Type, loops.size()) }));
+
+  return true;
+}
+
+bool LoopProfilerInstrumentation::instrumentLoop (
+  Loop *loop,
+  int64_t loopID,
+  FunctionCallee invocationBegins,
+  FunctionCallee invocationEnds
+  ){
+
+  /*
+   * We need a single entry point and exit blocks that are reached only from the loop to know where an invocation begins and ends.
+   */
+  auto preHeader = loop->getLoopPreheader();
+  if (  false
+        || (preHeader == nullptr)
+        || (!loop->hasDedicatedExits())
+     ){
+    return false;
+  }
+  SmallVector<BasicBlock *, 4> exitBlocks;
+  loop->getUniqueExitBlocks(exitBlocks);
+  for (auto exitBlock : exitBlocks){
+    if (exitBlock->isEHPad()){
+      return false;
+    }
+  }
+
+  /*
+   * Count the iterations of the current invocation.
+   * The counter is incremented at the beginning of every iteration, so it holds the number of iterations executed when the loop exits.
+   */
+  auto header = loop->getHeader();
+  auto int64Type = IntegerType::get(header->getContext(), 64);
+  auto zero = ConstantInt::get(int64Type, 0);
+  IRBuilder<> headerBuilder(&*header->getFirstInsertionPt());
+  auto iterations = PHINode::Create(int64Type, pred_size(header), "noelle.loop.iterations", &header->front());
+  auto nextIterations = headerBuilder.CreateAdd(iterations, ConstantInt::get(int64Type, 1));
+  for (auto predecessor : predecessors(header)){
+    iterations->addIncoming(loop->contains(predecessor) ? nextIterations : zero, predecessor);
+  }
+
+  /*
+   * Declare the beginning of the invocation.
+   */
+  IRBuilder<> preHeaderBuilder(preHeader->getTerminator());
+  auto loopIDValue = ConstantInt::get(int64Type, loopID);
+  auto startCycles = preHeaderBuilder.CreateCall(invocationBegins, ArrayRef<Value *>({ loopIDValue }));
+
+  /*
+   * Declare the end of the invocation.
+   */
+  for (auto exitBlock : exitBlocks){
+    IRBuilder<> exitBuilder(&*exitBlock->getFirstInsertionPt());
+    exitBuilder.CreateCall(invocationEnds, ArrayRef<Value *>({ loopIDValue, nextIterations, startCycles }));
+  }
+
+  return true;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "noelle/core/SystemHeaders.hpp"
+
+using namespace llvm;
+
+namespace llvm::noelle {
+
+  /*
+   * Return the loops of @M in the order used to assign them their profile IDs: the ID of a loop is its position in the returned list.
+   *
+   * Both the instrumentation and the embedding of the loop profiles rely on it, so they must run on the same code.
+   */
+  std::vector<Loop *> getLoopsToProfile (Module &M, std::function<LoopInfo & (Function &F)> getLoopInfo);
+
+  /*
+   * Instrument the loops to collect the histograms of their iterations per invocation and of their cycles per iteration.
+   */
+  class LoopProfilerInstrumentation : public ModulePass {
+    public:
+      static char ID; 
+
+      LoopProfilerInstrumentation();
+
+      bool doInitialization (Module &M) override ;
+
+      bool runOnModule (Module &M) override ;
+      
+      void getAnalysisUsage(AnalysisUsage &AU) const override ;
+
+    private:
+      bool instrumentLoop (Loop *loop, int64_t loopID, FunctionCallee invocationBegins, FunctionCallee invocationEnds);
+  };
+
+  /*
+   * Attach the histograms collected by the instrumented program to the loops.
+   * The histograms are attached to the terminator of the header of the loop, where HotProfiler reads them.
+   */
+  class LoopProfilerEmbed : public ModulePass {
+    public:
+      static char ID; 
+
+      LoopProfilerEmbed();
+
+      bool doInitialization (Module &M) override ;
+
+      bool runOnModule (Module &M) override ;
+      
+      void getAnalysisUsage(AnalysisUsage &AU) const override ;
+
+    private:
+      std::string profileFileName;
+  };
+
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "noelle/core/SystemHeaders.hpp"
+#include "LoopProfilerPass.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+LoopProfilerInstrumentation::LoopProfilerInstrumentation()
+  :
+  ModulePass(ID)
+  {
+
+  return ;
+}
+
+bool LoopProfilerInstrumentation::doInitialization (Module &M) {
+  return false;
+}
+
+void LoopProfilerInstrumentation::getAnalysisUsage (AnalysisUsage &AU) const {
+
+  /*
+   * Analyses.
+   */
+  AU.addRequired<LoopInfoWrapperPass>();
+
+  return ;
+}
+
+static cl::opt<std::string> LoopProfileFileName("noelle-loop-profile", cl::ZeroOrMore, cl::Hidden, cl::init("default.loopprof"), cl::desc("File with the loop profile generated by a program instrumented by noelle-prof-coverage --loops"));
+
+LoopProfilerEmbed::LoopProfilerEmbed()
+  :
+  ModulePass(ID)
+  , profileFileName{LoopProfileFileName}
+  {
+
+  return ;
+}
+
+bool LoopProfilerEmbed::doInitialization (Module &M) {
+  this->profileFileName = LoopProfileFileName.getValue();
+
+  return false;
+}
+
+void LoopProfilerEmbed::getAnalysisUsage (AnalysisUsage &AU) const {
+
+  /*
+   * Analyses.
+   */
+  AU.addRequired<LoopInfoWrapperPass>();
+
+  return ;
+}
+
+// Next there is code to register your passes to "opt"
+char LoopProfilerInstrumentation::ID = 0;
+static RegisterPass<LoopProfilerInstrumentation> X("LoopProfilerInstrumentation", "Instrument loops to profile their iterations per invocation and their cost per iteration");
+
+char LoopProfilerEmbed::ID = 0;
+static RegisterPass<LoopProfilerEmbed> Y("LoopProfilerEmbed", "Embed the loop profile into the IR");
@@ -46,6 +46,25 @@ bool LoopStats::runOnModule(Module &M) {
    */
   this->collectStatsForLoops(noelle, *programLoops);
 
+  /*
+   * Print, for every analysis of loops, how many times it has been computed and the time spent computing it across all loops.
+   */
+  if (noelle.getVerbosity() > Verbosity::Disabled) {
+    std::map<std::string, LoopDependenceInfo::AnalysisTime> timeOfAnalyses;
+    for (auto LDI : *programLoops){
+      for (auto &pair : LDI->getTimeSpentInAnalyses()){
+        auto &time = timeOfAnalyses[pair.first];
+        time.invocations += pair.second.invocations;
+        time.seconds += pair.second.seconds;
+      }
+    }
+    errs() << "LoopStats: Time spent in the analyses of loops\n";
+    for (auto &pair : timeOfAnalyses){
+      auto &time = pair.second;
+      errs() << "LoopStats:   " << pair.first << ": " << time.invocations << " times, " << format("%.3f", time.seconds) << " seconds\n";
+    }
+  }
+
   /*
    * Free the memory.
    */
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "noelle/core/Noelle.hpp"
+
+using namespace llvm;
+
+namespace llvm::noelle {
+
+  struct ParallelReport : public ModulePass {
+    public:
+      static char ID;
+
+      ParallelReport();
+
+      bool doInitialization(Module &M) override;
+      void getAnalysisUsage(AnalysisUsage &AU) const override;
+      bool runOnModule(Module &M) override;
+
+    private:
+
+      /*
+       * SCC that prevents DOALL from being applied to a loop.
+       */
+      struct BlockingSCC {
+        std::string type;
+        uint64_t instructions = 0;
+        double latencyPerInvocation = 0;
+        uint64_t loopCarriedDependences = 0;
+        uint64_t loopCarriedMemoryDependences = 0;
+        std::string firstInstruction;
+      };
+
+      /*
+       * Predicted speedups of a loop.
+       *
+       * Latencies are per invocation of the loop.
+       * They are in cycles if the machine cost model is calibrated and in instructions otherwise.
+       */
+      struct LoopPrediction {
+        uint64_t loopID = 0;
+        int64_t parentLoopID = -1;
+        std::string function;
+        uint32_t nestingLevel = 0;
+        double coverage = 0;
+        uint64_t invocations = 0;
+        double iterationsPerInvocation = 0;
+        double latencyPerInvocation = 0;
+        uint32_t cores = 0;
+        double sequentialFraction = 0;
+        double biggestSCCLatencyPerInvocation = 0;
+        bool isDOALLApplicable = false;
+        bool isHELIXApplicable = false;
+        bool isDSWPApplicable = false;
+        double DOALLSpeedup = 1;
+        double HELIXSpeedup = 1;
+        double DSWPSpeedup = 1;
+        double wholeProgramSavings = 0;
+        std::vector<BlockingSCC> blockingSCCs;
+      };
+
+      LoopPrediction predictSpeedups (
+        Noelle &noelle,
+        LoopDependenceInfo *ldi
+        );
+
+      void printReport (
+        raw_ostream &stream,
+        Noelle &noelle,
+        std::vector<LoopPrediction> &predictions
+        );
+  };
+
+}
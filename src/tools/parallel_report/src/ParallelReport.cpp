@@ -0,0 +1,296 @@
+/*
+ * Copyright 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "ParallelReport.hpp"
+#include "DOALL.hpp"
+#include "InvocationLatency.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+static std::string escapeJSON (const std::string &str){
+  std::string escaped;
+  for (auto c : str){
+    switch (c){
+      case '"':
+        escaped += "\\\"";
+        break ;
+      case '\\':
+        escaped += "\\\\";
+        break ;
+      case '\n':
+        escaped += "\\n";
+        break ;
+      case '\t':
+        escaped += "\\t";
+        break ;
+      default:
+        if ((unsigned char)c < 0x20){
+          continue ;
+        }
+        escaped += c;
+    }
+  }
+
+  return escaped;
+}
+
+static std::string getSCCTypeName (SCCAttrs::SCCType type){
+  switch (type){
+    case SCCAttrs::SCCType::SEQUENTIAL:
+      return "sequential";
+    case SCCAttrs::SCCType::REDUCIBLE:
+      return "reducible";
+    case SCCAttrs::SCCType::INDEPENDENT:
+      return "independent";
+  }
+
+  return "unknown";
+}
+
+ParallelReport::LoopPrediction ParallelReport::predictSpeedups (
+  Noelle &noelle,
+  LoopDependenceInfo *ldi
+  ){
+  LoopPrediction prediction;
+
+  /*
+   * Fetch the loop.
+   */
+  auto ls = ldi->getLoopStructure();
+  auto profiles = noelle.getProfiles();
+  auto costModel = noelle.getMachineCostModel();
+  auto sccManager = ldi->getSCCManager();
+  auto sccdag = sccManager->getSCCDAG();
+  prediction.loopID = ldi->getID();
+  prediction.function = ls->getFunction()->getName().str();
+  prediction.nestingLevel = ls->getNestingLevel();
+  prediction.cores = ldi->getMaximumNumberOfCores();
+
+  /*
+   * Fetch the SCCs that block DOALL.
+   */
+  auto blockingSCCs = DOALL::getSCCsThatBlockDOALLToBeApplicable(ldi, noelle);
+  prediction.isDOALLApplicable = blockingSCCs.empty();
+
+  /*
+   * Check whether HELIX and DSWP can be applied (see their canBeAppliedToLoop).
+   * Both need the loop to exit.
+   * DSWP also needs a sequential SCC that cannot be cloned, otherwise the loop is a DOALL.
+   */
+  auto hasExits = !ls->getLoopExitBasicBlocks().empty();
+  auto hasSequentialSCC = false;
+  for (auto nodePair : sccdag->internalNodePairs()){
+    if (!sccManager->getSCCAttrs(nodePair.first)->canBeCloned()){
+      hasSequentialSCC = true;
+      break ;
+    }
+  }
+  prediction.isHELIXApplicable = hasExits;
+  prediction.isDSWPApplicable = hasExits && hasSequentialSCC;
+
+  /*
+   * Estimate the latencies with the same model used by the parallelizer to choose the technique.
+   * The model is created per loop because it memoizes the latencies of the SCCs, which are freed with the loop.
+   */
+  InvocationLatency invocationLatency(profiles, costModel);
+
+  /*
+   * Check if the loop has been executed.
+   */
+  prediction.invocations = profiles->getInvocations(ls);
+  auto invocations = (double)prediction.invocations;
+  if (prediction.invocations > 0){
+    prediction.coverage = profiles->getDynamicTotalInstructionCoverage(ls);
+    prediction.iterationsPerInvocation = profiles->getAverageLoopIterationsPerInvocation(ls);
+
+    /*
+     * Compute the latency of the loop and the fraction of it that must run sequentially.
+     */
+    double loopLatency = 0;
+    double sequentialLatency = 0;
+    for (auto nodePair : sccdag->internalNodePairs()){
+      auto scc = nodePair.first;
+      auto sccInfo = sccManager->getSCCAttrs(scc);
+      auto sccLatency = (double)invocationLatency.latencyPerInvocation(scc);
+      loopLatency += sccLatency;
+      if (  true
+            && (sccInfo->getType() == SCCAttrs::SCCType::SEQUENTIAL)
+            && (!sccInfo->canBeCloned())
+         ){
+        sequentialLatency += sccLatency;
+      }
+    }
+    prediction.latencyPerInvocation = loopLatency / invocations;
+    if (loopLatency > 0){
+      prediction.sequentialFraction = sequentialLatency / loopLatency;
+    }
+  }
+
+  /*
+   * Describe the SCCs that block DOALL, from the most expensive one.
+   */
+  for (auto scc : blockingSCCs){
+    BlockingSCC blockingSCC;
+    blockingSCC.type = getSCCTypeName(sccManager->getSCCAttrs(scc)->getType());
+    blockingSCC.instructions = scc->numInternalNodes();
+    if (prediction.invocations > 0){
+      blockingSCC.latencyPerInvocation = ((double)invocationLatency.latencyPerInvocation(scc)) / invocations;
+    }
+    sccManager->iterateOverLoopCarriedDataDependences(scc, [&blockingSCC](DGEdge<Value> *dep) -> bool {
+      blockingSCC.loopCarriedDependences++;
+      if (dep->isMemoryDependence()){
+        blockingSCC.loopCarriedMemoryDependences++;
+      }
+      return false;
+    });
+
+    /*
+     * Identify the SCC by its first instruction in the loop.
+     */
+    for (auto bb : ls->orderedBBs){
+      for (auto &inst : *bb){
+        if (!scc->isInternal(&inst)){
+          continue ;
+        }
+        raw_string_ostream instStream(blockingSCC.firstInstruction);
+        inst.print(instStream);
+        instStream.flush();
+        break ;
+      }
+      if (!blockingSCC.firstInstruction.empty()){
+        break ;
+      }
+    }
+
+    prediction.blockingSCCs.push_back(blockingSCC);
+  }
+  std::sort(prediction.blockingSCCs.begin(), prediction.blockingSCCs.end(), [](const BlockingSCC &s1, const BlockingSCC &s2) -> bool {
+    if (s1.latencyPerInvocation != s2.latencyPerInvocation){
+      return s1.latencyPerInvocation > s2.latencyPerInvocation;
+    }
+    return s1.instructions > s2.instructions;
+  });
+  if (prediction.invocations == 0){
+    return prediction;
+  }
+
+  /*
+   * Find the biggest SCC, which bounds the slowest stage of a DSWP pipeline.
+   */
+  for (auto nodePair : sccdag->internalNodePairs()){
+    auto scc = nodePair.first;
+    auto sccLatency = ((double)invocationLatency.latencyPerInvocation(scc)) / invocations;
+    prediction.biggestSCCLatencyPerInvocation = std::max(prediction.biggestSCCLatencyPerInvocation, sccLatency);
+  }
+
+  /*
+   * Predict the speedups.
+   *
+   * DOALL spreads the iterations among the cores.
+   * HELIX runs the sequential segments of consecutive iterations one after the other and pays a signal per iteration.
+   * DSWP cannot be faster than the biggest SCC.
+   * All techniques pay the dispatch of the parallel tasks.
+   * Only the speedups of the techniques that can be applied are predicted; the others are left to 1.
+   */
+  auto latency = prediction.latencyPerInvocation;
+  if (latency == 0){
+    return prediction;
+  }
+  auto cores = (double)std::max<uint32_t>(prediction.cores, 1);
+  auto dispatchLatency = costModel->getDOALLDispatchLatency();
+  if (prediction.isDOALLApplicable){
+    auto usefulCores = std::max(std::min(cores, prediction.iterationsPerInvocation), 1.0);
+    prediction.DOALLSpeedup = latency / ((latency / usefulCores) + dispatchLatency);
+  }
+  if (prediction.isHELIXApplicable){
+    auto sequentialLatency = (prediction.sequentialFraction * latency) + (prediction.iterationsPerInvocation * costModel->getHELIXSignalLatency());
+    prediction.HELIXSpeedup = latency / (std::max(sequentialLatency, latency / cores) + dispatchLatency);
+  }
+  if (prediction.isDSWPApplicable){
+    prediction.DSWPSpeedup = latency / (std::max(prediction.biggestSCCLatencyPerInvocation, latency / cores) + dispatchLatency);
+  }
+
+  /*
+   * Compute the fraction of the whole program execution saved by the best technique.
+   */
+  auto bestSpeedup = std::max(prediction.DOALLSpeedup, std::max(prediction.HELIXSpeedup, prediction.DSWPSpeedup));
+  prediction.wholeProgramSavings = prediction.coverage * (1 - (1 / bestSpeedup));
+
+  return prediction;
+}
+
+void ParallelReport::printReport (
+  raw_ostream &stream,
+  Noelle &noelle,
+  std::vector<LoopPrediction> &predictions
+  ){
+  auto costModel = noelle.getMachineCostModel();
+
+  stream << "{\n";
+  stream << "  \"latencyUnit\": \"" << (costModel->isCalibrated() ? "cycles" : "instructions") << "\",\n";
+  stream << "  \"profiles\": " << (noelle.getProfiles()->isAvailable() ? "true" : "false") << ",\n";
+  stream << "  \"loops\": [";
+  for (auto i = 0u; i < predictions.size(); i++){
+    auto &p = predictions[i];
+    stream << ((i == 0) ? "\n" : ",\n");
+    stream << "    {\n";
+    stream << "      \"id\": " << p.loopID << ",\n";
+    stream << "      \"parentID\": " << p.parentLoopID << ",\n";
+    stream << "      \"function\": \"" << escapeJSON(p.function) << "\",\n";
+    stream << "      \"nestingLevel\": " << p.nestingLevel << ",\n";
+    stream << "      \"coverage\": " << format("%.6f", p.coverage) << ",\n";
+    stream << "      \"invocations\": " << p.invocations << ",\n";
+    stream << "      \"iterationsPerInvocation\": " << format("%.2f", p.iterationsPerInvocation) << ",\n";
+    stream << "      \"latencyPerInvocation\": " << format("%.2f", p.latencyPerInvocation) << ",\n";
+    stream << "      \"biggestSCCLatencyPerInvocation\": " << format("%.2f", p.biggestSCCLatencyPerInvocation) << ",\n";
+    stream << "      \"sequentialFraction\": " << format("%.4f", p.sequentialFraction) << ",\n";
+    stream << "      \"cores\": " << p.cores << ",\n";
+    std::vector<std::pair<std::string, double>> speedups;
+    if (p.isDOALLApplicable){
+      speedups.push_back(std::make_pair("DOALL", p.DOALLSpeedup));
+    }
+    if (p.isHELIXApplicable){
+      speedups.push_back(std::make_pair("HELIX", p.HELIXSpeedup));
+    }
+    if (p.isDSWPApplicable){
+      speedups.push_back(std::make_pair("DSWP", p.DSWPSpeedup));
+    }
+    stream << "      \"speedups\": {";
+    for (auto j = 0u; j < speedups.size(); j++){
+      stream << ((j == 0) ? "\n" : ",\n");
+      stream << "        \"" << speedups[j].first << "\": " << format("%.3f", speedups[j].second);
+    }
+    stream << (speedups.empty() ? "},\n" : "\n      },\n");
+    stream << "      \"DOALLApplicable\": " << (p.isDOALLApplicable ? "true" : "false") << ",\n";
+    stream << "      \"HELIXApplicable\": " << (p.isHELIXApplicable ? "true" : "false") << ",\n";
+    stream << "      \"DSWPApplicable\": " << (p.isDSWPApplicable ? "true" : "false") << ",\n";
+    stream << "      \"wholeProgramSavings\": " << format("%.6f", p.wholeProgramSavings) << ",\n";
+    stream << "      \"blockingSCCs\": [";
+    for (auto j = 0u; j < p.blockingSCCs.size(); j++){
+      auto &scc = p.blockingSCCs[j];
+      stream << ((j == 0) ? "\n" : ",\n");
+      stream << "        {";
+      stream << "\"type\": \"" << scc.type << "\", ";
+      stream << "\"instructions\": " << scc.instructions << ", ";
+      stream << "\"latencyPerInvocation\": " << format("%.2f", scc.latencyPerInvocation) << ", ";
+      stream << "\"loopCarriedDependences\": " << scc.loopCarriedDependences << ", ";
+      stream << "\"loopCarriedMemoryDependences\": " << scc.loopCarriedMemoryDependences << ", ";
+      stream << "\"firstInstruction\": \"" << escapeJSON(scc.firstInstruction) << "\"";
+      stream << "}";
+    }
+    stream << (p.blockingSCCs.empty() ? "]\n" : "\n      ]\n");
+    stream << "    }";
+  }
+  stream << (predictions.empty() ? "]\n" : "\n  ]\n");
+  stream << "}\n";
+
+  return ;
+}
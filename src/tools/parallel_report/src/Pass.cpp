@@ -0,0 +1,98 @@
+/*
+ * Copyright 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "ParallelReport.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+static cl::opt<std::string> ReportFile("noelle-parallel-report-output", cl::ZeroOrMore, cl::Hidden, cl::init("noelle-parallel-report.json"), cl::desc("File where the JSON report of the predicted speedups is written"));
+
+ParallelReport::ParallelReport()
+  : ModulePass{ID}
+  {
+  return ;
+}
+
+bool ParallelReport::doInitialization(Module &M) {
+  return false;
+}
+
+void ParallelReport::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<Noelle>();
+  return;
+}
+
+bool ParallelReport::runOnModule(Module &M) {
+
+  /*
+   * Fetch noelle.
+   */
+  auto& noelle = getAnalysis<Noelle>();
+  errs() << "ParallelReport: Start\n";
+
+  /*
+   * Fetch all program loops and organize them in their nesting forest.
+   */
+  auto programLoops = noelle.getLoopStructures();
+  auto forest = noelle.organizeLoopsInTheirNestingForest(*programLoops);
+  delete programLoops ;
+
+  /*
+   * Predict the speedups of every loop, from the outermost to the inner ones.
+   */
+  std::vector<LoopPrediction> predictions;
+  for (auto tree : forest->getTrees()){
+    auto predictor = [this, &noelle, &predictions](StayConnectedNestedLoopForestNode *n, uint32_t treeLevel) -> bool {
+      auto ls = n->getLoop();
+      auto optimizations = { LoopDependenceInfoOptimization::MEMORY_CLONING_ID, LoopDependenceInfoOptimization::THREAD_SAFE_LIBRARY_ID};
+      auto ldi = noelle.getLoop(ls, optimizations);
+
+      auto prediction = this->predictSpeedups(noelle, ldi);
+      auto parent = n->getParent();
+      if (parent != nullptr){
+        prediction.parentLoopID = parent->getLoop()->getID();
+      }
+      predictions.push_back(prediction);
+
+      delete ldi;
+      return false;
+    };
+    tree->visitPreOrder(predictor);
+  }
+
+  /*
+   * Write the report.
+   */
+  std::error_code EC;
+  raw_fd_ostream reportStream(ReportFile, EC, sys::fs::F_Text);
+  if (EC) {
+    errs() << "ParallelReport: ERROR = cannot write the report to " << ReportFile << "\n";
+    abort();
+  }
+  this->printReport(reportStream, noelle, predictions);
+  errs() << "ParallelReport:   The report of " << predictions.size() << " loops has been written to " << ReportFile << "\n";
+
+  errs() << "ParallelReport: Exit\n";
+  return false;
+}
+
+// Next there is code to register your pass to "opt"
+char ParallelReport::ID = 0;
+static RegisterPass<ParallelReport> X("ParallelReport", "Predict the speedup of every loop under DOALL, HELIX, and DSWP");
+
+// Next there is code to register your pass to "clang"
+static ParallelReport * _PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder&, legacy::PassManagerBase& PM) {
+        if(!_PassMaker){ PM.add(_PassMaker = new ParallelReport());}}); // ** for -Ox
+static RegisterStandardPasses _RegPass2(PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder&, legacy::PassManagerBase& PM) {
+        if(!_PassMaker){ PM.add(_PassMaker = new ParallelReport()); }}); // ** for -O0
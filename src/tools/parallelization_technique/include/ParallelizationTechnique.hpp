@@ -61,6 +61,14 @@ namespace llvm::noelle {
 
       virtual void reset () ;
 
+      /*
+       * Return the fraction of the static instructions of the loop that belong to SCCs that must be synchronized.
+       */
+      static float computeSequentialFractionOfExecution (
+        LoopDependenceInfo *LDI,
+        Noelle &par
+      ) ;
+
       /*
        * Destructor.
        */
@@ -204,11 +212,6 @@ namespace llvm::noelle {
        */
       void doNestedInlineOfCalls (Function *F, std::set<CallInst *> &calls);
 
-      float computeSequentialFractionOfExecution (
-        LoopDependenceInfo *LDI,
-        Noelle &par
-      ) const ;
-
       /*
        * Debug
        */
@@ -1214,6 +1214,11 @@ void ParallelizationTechnique::doNestedInlineOfCalls (
           if (auto call = dyn_cast<CallInst>(&I)) {
             auto func = call->getCalledFunction();
             if (func == nullptr || func->empty()) continue;
+
+            /*
+             * Functions marked noinline are kept as calls (e.g., the slow paths of the runtime, which wait on queues and locks).
+             */
+            if (func->hasFnAttribute(Attribute::NoInline)) continue;
             funcToInline.insert(func);
           }
         }
@@ -1339,7 +1344,7 @@ void ParallelizationTechnique::adjustStepValueOfPointerTypeIVToReflectPointerAri
 float ParallelizationTechnique::computeSequentialFractionOfExecution (
   LoopDependenceInfo *LDI,
   Noelle &par
-) const {
+) {
 
   auto sccManager = LDI->getSCCManager();
   auto sccdag = sccManager->getSCCDAG();
@@ -1358,6 +1363,13 @@ float ParallelizationTechnique::computeSequentialFractionOfExecution (
     }
   }
 
+  /*
+   * A loop without SCCs has nothing to run sequentially.
+   */
+  if (totalInstructionCount == 0){
+    return 0;
+  }
+
   return sequentialInstructionCount / totalInstructionCount;
 }
 
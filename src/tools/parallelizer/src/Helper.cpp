@@ -18,6 +18,7 @@ namespace llvm::noelle {
   bool Parallelizer::collectThreadPoolHelperFunctionsAndTypes (Module &M, Noelle &par) {
     std::string pushers[4] = { "queuePush8", "queuePush16", "queuePush32", "queuePush64" };
     std::string poppers[4] = { "queuePop8", "queuePop16", "queuePop32", "queuePop64" };
+    std::string flushers[4] = { "queueFlush8", "queueFlush16", "queueFlush32", "queueFlush64" };
     for (auto pusher : pushers) {
       auto pushFunction = M.getFunction(pusher);
       if (pushFunction == nullptr){
@@ -34,6 +35,14 @@ namespace llvm::noelle {
       }
       par.queues.queuePops.push_back(popFunction);
     }
+    for (auto flusher : flushers) {
+      auto flushFunction = M.getFunction(flusher);
+      if (flushFunction == nullptr){
+        errs() << "Parallelizer: ERROR = function \"" << flusher << "\" could not be found\n";
+        abort();
+      }
+      par.queues.queueFlushes.push_back(flushFunction);
+    }
     for (auto queueF : par.queues.queuePushes) {
       par.queues.queueTypes.push_back(queueF->arg_begin()->getType());
     }
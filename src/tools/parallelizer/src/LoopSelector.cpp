@@ -22,7 +22,8 @@ namespace llvm::noelle {
      * Filter out loops that are not worth parallelizing.
      */
     errs() << "Parallelizer:  Filter out loops not worth considering\n";
-    auto filter = [this, forest, profiles](LoopStructure *ls) -> bool{
+    auto costModel = noelle.getMachineCostModel();
+    auto filter = [this, forest, profiles, costModel](LoopStructure *ls) -> bool{
 
       /*
        * Fetch the loop ID.
@@ -48,7 +49,15 @@ namespace llvm::noelle {
        * Check if the latency of each loop invocation is enough to justify the parallelization.
        */
       auto averageInstsPerInvocation = profiles->getAverageTotalInstructionsPerInvocation(ls);
-      auto averageInstsPerInvocationThreshold = 2000;
+      double averageInstsPerInvocationThreshold = MachineCostModel::defaultMinimumParallelInvocationInstructions;
+      if (costModel->isCalibrated()){
+
+        /*
+         * The invocation needs to amortize the cost of dispatching the parallel tasks measured on this machine.
+         */
+        auto dispatchInsts = costModel->getMinimumParallelInvocationLatency() / costModel->getInstructionLatency();
+        averageInstsPerInvocationThreshold = std::max(dispatchInsts, 1.0);
+      }
       if (  true
           && (!this->forceParallelization)
           && (averageInstsPerInvocation < averageInstsPerInvocationThreshold)
@@ -200,6 +209,32 @@ namespace llvm::noelle {
        */
       auto sequentialSCCs = DOALL::getSCCsThatBlockDOALLToBeApplicable(ldi, noelle);
 
+      /*
+       * Report the sequential SCCs that are sequential only because of memory dependences that never manifested on the profiled inputs.
+       */
+      auto sccManager = ldi->getSCCManager();
+      for (auto sequentialSCC : sequentialSCCs){
+        auto onlyUnobservedDependences = true;
+        uint64_t unobservedDependences = 0;
+        sccManager->iterateOverLoopCarriedDataDependences(sequentialSCC, [ls, profiles, &onlyUnobservedDependences, &unobservedDependences](DGEdge<Value> *dep) -> bool {
+          if (  false
+                || (!dep->isMemoryDependence())
+                || (!profiles->hasDependenceNeverManifested(ls, dep))
+             ){
+            onlyUnobservedDependences = false;
+            return true;
+          }
+          unobservedDependences++;
+          return false;
+        });
+        if (  true
+              && onlyUnobservedDependences
+              && (unobservedDependences > 0)
+           ){
+          errs() << "Parallelizer: LoopSelector:  Loop " << ldi->getID() << " has a sequential SCC whose " << unobservedDependences << " loop-carried dependences never manifested on the profiled inputs\n";
+        }
+      }
+
       /*
        * Find the biggest sequential SCC.
        */
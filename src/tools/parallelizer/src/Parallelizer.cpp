@@ -60,93 +60,86 @@ namespace llvm::noelle {
     /*
      * Parallelize the loop.
      */
-    auto codeModified = false;
     ParallelizationTechnique *usedTechnique = nullptr;
-    if (  true
-        && par.isTransformationEnabled(DOALL_ID)
-        && LDI->isTransformationEnabled(DOALL_ID)
-        && doall.canBeAppliedToLoop(LDI, par, h)
-       ){
-
-      /*
-       * Apply DOALL.
-       */
-      doall.reset();
-      codeModified = doall.apply(LDI, par, h);
-      usedTechnique = &doall;
-
-    } else if ( true
-        && par.isTransformationEnabled(HELIX_ID)
-        && LDI->isTransformationEnabled(HELIX_ID)
-        && helix.canBeAppliedToLoop(LDI, par, h)   
-        ){
-
-      /*
-       * Apply HELIX
-       */
-      helix.reset();
-      codeModified = helix.apply(LDI, par, h);
-
-      auto function = helix.getTaskFunction();
-      auto &LI = getAnalysis<LoopInfoWrapperPass>(*function).getLoopInfo();
-      auto& DT = getAnalysis<DominatorTreeWrapperPass>(*function).getDomTree();
-      auto& PDT = getAnalysis<PostDominatorTreeWrapperPass>(*function).getPostDomTree();
-      auto& SE = getAnalysis<ScalarEvolutionWrapperPass>(*function).getSE();
-
-      if (par.getVerbosity() >= Verbosity::Maximal) {
-        errs() << "HELIX:  Constructing task dependence graph\n";
+    auto usedTechniqueID = DOALL_ID;
+    for (auto techniqueID : { DOALL_ID, HELIX_ID, DSWP_ID }){
+      if (!this->canApplyTechnique(techniqueID, LDI, par, dswp, doall, helix, h)){
+        continue ;
       }
-
-      auto taskFunctionDG = helix.constructTaskInternalDependenceGraphFromOriginalLoopDG(LDI, PDT);
-
-      if (par.getVerbosity() >= Verbosity::Maximal) {
-        errs() << "HELIX:  Constructing task loop dependence info\n";
-      }
-
-      DominatorSummary DS{DT, PDT};
-      auto l = LI.getLoopsInPreorder()[0];
-      auto newLDI = new LoopDependenceInfo(taskFunctionDG, l, DS, SE, par.getCompilationOptionsManager()->getMaximumNumberOfCores(), par.canFloatsBeConsideredRealNumbers());
-      newLDI->copyParallelizationOptionsFrom(LDI);
-
-      codeModified = helix.apply(newLDI, par, h);
-      usedTechnique = &helix;
-
-    } else if ( true
-        && par.isTransformationEnabled(DSWP_ID)
-        && LDI->isTransformationEnabled(DSWP_ID)
-        && dswp.canBeAppliedToLoop(LDI, par, h)
-        ) {
-
-      /*
-       * Apply DSWP.
-       */
-      dswp.reset();
-      codeModified = dswp.apply(LDI, par, h);
-      usedTechnique = &dswp;
+      usedTechnique = this->applyTechnique(techniqueID, LDI, par, dswp, doall, helix, h);
+      usedTechniqueID = techniqueID;
+      break ;
     }
 
     /*
      * Check if the loop has been parallelized.
      */
-    if (!codeModified){
+    if (usedTechnique == nullptr){
       errs() << prefix << "  The loop has not been parallelized\n";
       errs() << prefix << "Exit\n";
       return false;
     }
 
     /*
-     * Fetch the environment array where the exit block ID has been stored.
+     * Fetch entry and exit point executed by the parallelized loop, and the environment array where the exit block ID has been stored.
+     *
+     * When the loop is tunable, the other techniques that can be applied to it generate a version of the loop as well, so the autotuner can choose among them at run time.
      */
-    assert(usedTechnique != nullptr);
-    auto envArray = usedTechnique->getEnvArray();
-    assert(envArray != nullptr);
+    std::vector<Transformation> techniqueIDs{ usedTechniqueID };
+    std::vector<BasicBlock *> entryPoints{ usedTechnique->getParLoopEntryPoint() };
+    std::vector<BasicBlock *> exitPoints{ usedTechnique->getParLoopExitPoint() };
+    std::vector<Value *> envArrays{ usedTechnique->getEnvArray() };
+    if (!this->tunableLoopsFileName.empty()){
+
+      /*
+       * An exit point gets its terminator when it is linked to the original function.
+       * Until then, the exit points are terminated temporarily so the other techniques can analyze the function that includes the loop.
+       */
+      std::vector<Instruction *> temporaryTerminators;
+      auto terminateExitPoint = [&temporaryTerminators](BasicBlock *exitPoint) {
+        if (exitPoint->getTerminator() == nullptr){
+          temporaryTerminators.push_back(new UnreachableInst(exitPoint->getContext(), exitPoint));
+        }
+      };
+      terminateExitPoint(exitPoints[0]);
+
+      for (auto techniqueID : { DOALL_ID, HELIX_ID, DSWP_ID }){
+        if (  false
+              || (techniqueID == usedTechniqueID)
+              || (!this->canApplyTechnique(techniqueID, LDI, par, dswp, doall, helix, h))
+           ){
+          continue ;
+        }
+        auto technique = this->applyTechnique(techniqueID, LDI, par, dswp, doall, helix, h);
+        if (technique == nullptr){
+          continue ;
+        }
+        if (verbose != Verbosity::Disabled) {
+          errs() << prefix << "  Generated another version of the loop with " << this->getTechniqueName(techniqueID) << "\n";
+        }
+        techniqueIDs.push_back(techniqueID);
+        entryPoints.push_back(technique->getParLoopEntryPoint());
+        exitPoints.push_back(technique->getParLoopExitPoint());
+        envArrays.push_back(technique->getEnvArray());
+        terminateExitPoint(exitPoints.back());
+      }
+      for (auto terminator : temporaryTerminators){
+        terminator->eraseFromParent();
+      }
+    }
+    for (auto i = 0u; i < techniqueIDs.size(); ++i){
+      assert(entryPoints[i] != nullptr && exitPoints[i] != nullptr);
+      assert(envArrays[i] != nullptr);
+    }
 
     /*
-     * Fetch entry and exit point executed by the parallelized loop.
+     * Ask the runtime which version to run if there is more than one.
+     * The version generated by the technique chosen by the compiler is the default one.
      */
-    auto entryPoint = usedTechnique->getParLoopEntryPoint();
-    auto exitPoint = usedTechnique->getParLoopExitPoint();
-    assert(entryPoint != nullptr && exitPoint != nullptr);
+    auto startPoint = entryPoints[0];
+    if (techniqueIDs.size() > 1){
+      startPoint = this->addTechniqueSelector(LDI, par, techniqueIDs, entryPoints);
+    }
 
     /*
      * The loop has been parallelized.
@@ -161,13 +154,36 @@ namespace llvm::noelle {
     par.linkTransformedLoopToOriginalFunction(
         loopFunction->getParent(),
         loopPreHeader,
-        entryPoint,
-        exitPoint, 
-        envArray,
+        startPoint,
+        exitPoints, 
+        envArrays,
         exitIndex,
         loopExitBlocks
         );
+
+    /*
+     * Run small invocations of the loop sequentially.
+     */
+    auto hasSequentialFallback = this->addSequentialFallback(LDI, par, loopPreHeader, exitPoints, loopExitBlocks);
+    if (  true
+          && hasSequentialFallback
+          && (verbose != Verbosity::Disabled)
+       ){
+      errs() << prefix << "  Added the sequential fallback for small invocations\n";
+    }
+
+    /*
+     * Let the autotuner configure the loop at run time.
+     */
+    if (!this->tunableLoopsFileName.empty()){
+      this->makeLoopTunable(LDI, par, entryPoints, hasSequentialFallback);
+    }
     assert(par.verifyCode());
+
+    /*
+     * The function that includes the loop has been transformed.
+     */
+    par.invalidateFunctionAnalyses(loopFunction);
     // if (verbose >= Verbosity::Maximal) {
     //   loopFunction->print(errs() << "Final printout:\n"); errs() << "\n";
     // }
@@ -178,4 +194,115 @@ namespace llvm::noelle {
 
     return true;
   }
+
+  bool Parallelizer::canApplyTechnique (
+      Transformation techniqueID,
+      LoopDependenceInfo *LDI, 
+      Noelle &par, 
+      DSWP &dswp, 
+      DOALL &doall, 
+      HELIX &helix, 
+      Heuristics *h
+      ){
+    if (  false
+        || (!par.isTransformationEnabled(techniqueID))
+        || (!LDI->isTransformationEnabled(techniqueID))
+       ){
+      return false;
+    }
+
+    switch (techniqueID){
+      case DOALL_ID:
+        return doall.canBeAppliedToLoop(LDI, par, h);
+
+      case HELIX_ID:
+        return helix.canBeAppliedToLoop(LDI, par, h);
+
+      case DSWP_ID:
+        return dswp.canBeAppliedToLoop(LDI, par, h);
+
+      default:
+        return false;
+    }
+  }
+
+  ParallelizationTechnique * Parallelizer::applyTechnique (
+      Transformation techniqueID,
+      LoopDependenceInfo *LDI, 
+      Noelle &par, 
+      DSWP &dswp, 
+      DOALL &doall, 
+      HELIX &helix, 
+      Heuristics *h
+      ){
+
+    /*
+     * Apply the technique.
+     */
+    auto codeModified = false;
+    ParallelizationTechnique *technique = nullptr;
+    switch (techniqueID){
+      case DOALL_ID:
+
+        /*
+         * Apply DOALL.
+         */
+        doall.reset();
+        codeModified = doall.apply(LDI, par, h);
+        technique = &doall;
+        break ;
+
+      case HELIX_ID: {
+
+        /*
+         * Apply HELIX
+         */
+        helix.reset();
+        codeModified = helix.apply(LDI, par, h);
+
+        auto function = helix.getTaskFunction();
+        auto &LI = getAnalysis<LoopInfoWrapperPass>(*function).getLoopInfo();
+        auto& DT = getAnalysis<DominatorTreeWrapperPass>(*function).getDomTree();
+        auto& PDT = getAnalysis<PostDominatorTreeWrapperPass>(*function).getPostDomTree();
+        auto& SE = getAnalysis<ScalarEvolutionWrapperPass>(*function).getSE();
+
+        if (par.getVerbosity() >= Verbosity::Maximal) {
+          errs() << "HELIX:  Constructing task dependence graph\n";
+        }
+
+        auto taskFunctionDG = helix.constructTaskInternalDependenceGraphFromOriginalLoopDG(LDI, PDT);
+
+        if (par.getVerbosity() >= Verbosity::Maximal) {
+          errs() << "HELIX:  Constructing task loop dependence info\n";
+        }
+
+        DominatorSummary DS{DT, PDT};
+        auto l = LI.getLoopsInPreorder()[0];
+        auto newLDI = new LoopDependenceInfo(taskFunctionDG, l, DS, SE, par.getCompilationOptionsManager()->getMaximumNumberOfCores(), par.canFloatsBeConsideredRealNumbers());
+        newLDI->copyParallelizationOptionsFrom(LDI);
+
+        codeModified = helix.apply(newLDI, par, h);
+        technique = &helix;
+        break ;
+      }
+
+      case DSWP_ID:
+
+        /*
+         * Apply DSWP.
+         */
+        dswp.reset();
+        codeModified = dswp.apply(LDI, par, h);
+        technique = &dswp;
+        break ;
+
+      default:
+        return nullptr;
+    }
+    if (!codeModified){
+      return nullptr;
+    }
+
+    return technique;
+  }
 }
@@ -66,6 +66,12 @@ namespace llvm::noelle {
       bool forceParallelization;
       bool forceNoSCCPartition;
 
+      /*
+       * File where the design space of the tunable loops is written (empty if loops are not tunable).
+       */
+      std::string tunableLoopsFileName;
+      std::vector<std::string> tunableLoops;
+
       /*
        * Methods
        */
@@ -78,10 +84,74 @@ namespace llvm::noelle {
         Heuristics *h
       );
 
+      bool canApplyTechnique (
+        Transformation techniqueID,
+        LoopDependenceInfo *LDI,
+        Noelle &par,
+        DSWP &dswp,
+        DOALL &doall,
+        HELIX &helix,
+        Heuristics *h
+      );
+
+      /*
+       * Generate the version of the loop parallelized by the technique @techniqueID.
+       *
+       * @return the technique, which holds the entry and exit points of the version, or nullptr if the loop has not been parallelized.
+       */
+      ParallelizationTechnique * applyTechnique (
+        Transformation techniqueID,
+        LoopDependenceInfo *LDI,
+        Noelle &par,
+        DSWP &dswp,
+        DOALL &doall,
+        HELIX &helix,
+        Heuristics *h
+      );
+
       std::vector<LoopDependenceInfo *> getLoopsToParallelize (Module &M, Noelle &par) ;
 
       bool collectThreadPoolHelperFunctionsAndTypes (Module &M, Noelle &par) ;
 
+      /*
+       * Let the runtime choose between the parallelized loop and the original one at every invocation, based on the trip count of the invocation.
+       *
+       * @return false if the trip count cannot be computed before the loop starts, in which case the parallelized loop is always used.
+       */
+      bool addSequentialFallback (
+        LoopDependenceInfo *LDI,
+        Noelle &par,
+        BasicBlock *loopPreHeader,
+        std::vector<BasicBlock *> &exitPointsOfParallelizedLoop,
+        std::vector<BasicBlock *> &loopExitBlocks
+      );
+
+      /*
+       * Generate the basic block that asks the runtime which version of the loop to run and jumps to its entry point (see NOELLE_TUNING_CONFIG).
+       * The version generated by the technique @techniqueIDs[i] starts at @entryPointsOfParallelizedLoop[i]; the first one is the default.
+       */
+      BasicBlock * addTechniqueSelector (
+        LoopDependenceInfo *LDI,
+        Noelle &par,
+        std::vector<Transformation> &techniqueIDs,
+        std::vector<BasicBlock *> &entryPointsOfParallelizedLoop
+      );
+
+      /*
+       * Let the autotuner choose the technique, the number of cores, the DOALL chunk size, and the DOALL schedule of the parallelized loop at run time (see NOELLE_TUNING_CONFIG).
+       * The choices the autotuner can make for the loop are appended to the design space of the tunable loops.
+       */
+      void makeLoopTunable (
+        LoopDependenceInfo *LDI,
+        Noelle &par,
+        std::vector<BasicBlock *> &entryPointsOfParallelizedLoop,
+        bool hasSequentialFallback
+      );
+
+      std::string getTechniqueName (Transformation techniqueID) const ;
+
+      void writeDesignSpaceOfTunableLoops (void) const ;
+
       void removeLoopsNotWorthParallelizing (
         Noelle &noelle, 
         Hot *profiles,
@@ -17,6 +17,7 @@ namespace llvm::noelle {
  */
 static cl::opt<bool> ForceParallelization("noelle-parallelizer-force", cl::ZeroOrMore, cl::Hidden, cl::desc("Force the parallelization"));
 static cl::opt<bool> ForceNoSCCPartition("dswp-no-scc-merge", cl::ZeroOrMore, cl::Hidden, cl::desc("Force no SCC merging when parallelizing"));
+static cl::opt<std::string> TunableLoops("noelle-parallelizer-tunable", cl::ZeroOrMore, cl::Hidden, cl::init(""), cl::desc("Make the parallelized loops tunable at run time and write their design space to the file given"));
 
 Parallelizer::Parallelizer()
   :
@@ -31,6 +32,7 @@ Parallelizer::Parallelizer()
 bool Parallelizer::doInitialization (Module &M) {
   this->forceParallelization = (ForceParallelization.getNumOccurrences() > 0);
   this->forceNoSCCPartition = (ForceNoSCCPartition.getNumOccurrences() > 0);
+  this->tunableLoopsFileName = TunableLoops;
 
   return false; 
 }
@@ -174,6 +176,13 @@ bool Parallelizer::runOnModule (Module &M) {
     }
   }
 
+  /*
+   * Write the design space of the tunable loops.
+   */
+  if (!this->tunableLoopsFileName.empty()){
+    this->writeDesignSpaceOfTunableLoops();
+  }
+
   errs() << "Parallelizer: Exit\n";
   return modified;
 }
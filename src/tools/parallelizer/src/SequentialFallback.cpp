@@ -0,0 +1,130 @@
+/*
+ * Copyright 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "Parallelizer.hpp"
+
+namespace llvm::noelle {
+
+  bool Parallelizer::addSequentialFallback (
+      LoopDependenceInfo *LDI,
+      Noelle &par,
+      BasicBlock *loopPreHeader,
+      std::vector<BasicBlock *> &exitPointsOfParallelizedLoop,
+      std::vector<BasicBlock *> &loopExitBlocks
+      ){
+    auto prefix = "Parallelizer: addSequentialFallback: " ;
+
+    /*
+     * Fetch the runtime APIs.
+     */
+    auto M = loopPreHeader->getModule();
+    auto invocationBegins = M->getFunction("NOELLE_loopInvocationBegins");
+    auto invocationEnds = M->getFunction("NOELLE_loopInvocationEnds");
+    if (  false
+          || (invocationBegins == nullptr)
+          || (invocationEnds == nullptr)
+       ){
+      errs() << prefix << "ERROR = the NOELLE runtime does not provide the APIs to track loop invocations\n";
+      abort();
+    }
+
+    /*
+     * The trip count can only be computed before the loop starts if the loop is governed by an IV.
+     */
+    auto loopStructure = LDI->getLoopStructure();
+    auto loopGoverningIVAttr = LDI->getLoopGoverningIVAttribution();
+    if (loopGoverningIVAttr == nullptr){
+      return false;
+    }
+    auto &IV = loopGoverningIVAttr->getInductionVariable();
+    auto startValue = IV.getStartValue();
+    auto stepValue = IV.getSingleComputedStepValue();
+    auto lastValue = loopGoverningIVAttr->getExitConditionValue();
+    if (  false
+          || (startValue == nullptr)
+          || (stepValue == nullptr)
+          || (lastValue == nullptr)
+          || (!startValue->getType()->isIntegerTy())
+       ){
+      return false;
+    }
+
+    /*
+     * The values the trip count depends on must be available at the preheader.
+     */
+    for (auto value : { startValue, stepValue, lastValue }){
+      auto inst = dyn_cast<Instruction>(value);
+      if (  true
+            && (inst != nullptr)
+            && loopStructure->isIncluded(inst)
+         ){
+        return false;
+      }
+    }
+
+    /*
+     * The time spent by an invocation is measured at the exit blocks of the loop.
+     * Hence, the exit blocks must be reached only from the loop, so the values computed at the preheader dominate them.
+     */
+    for (auto exitBB : loopExitBlocks){
+      for (auto predBB : predecessors(exitBB)){
+        if (  true
+              && (std::find(exitPointsOfParallelizedLoop.begin(), exitPointsOfParallelizedLoop.end(), predBB) == exitPointsOfParallelizedLoop.end())
+              && (!loopStructure->isIncluded(predBB))
+           ){
+          return false;
+        }
+      }
+    }
+
+    /*
+     * Compute the trip count of the current invocation and ask the runtime whether it is worth running it in parallel.
+     */
+    auto branch = cast<BranchInst>(loopPreHeader->getTerminator());
+    IRBuilder<> preHeaderBuilder(branch);
+    auto loopID = ConstantInt::get(par.int64, LDI->getID());
+    LoopGoverningIVUtility ivUtility(loopStructure, *LDI->getInductionVariableManager(), *loopGoverningIVAttr);
+    auto tripCount = preHeaderBuilder.CreateZExtOrTrunc(ivUtility.generateCodeToComputeTheTripCount(preHeaderBuilder), par.int64);
+    auto numCores = ConstantInt::get(par.int64, LDI->getMaximumNumberOfCores());
+    Value *ticket = preHeaderBuilder.CreateCall(invocationBegins, ArrayRef<Value *>({
+      loopID,
+      tripCount,
+      numCores
+    }));
+    auto runInParallel = preHeaderBuilder.CreateTrunc(ticket, par.int1);
+
+    /*
+     * Run the sequential loop if the runtime says so.
+     */
+    auto canRunInParallel = branch->getCondition();
+    auto willRunInParallel = preHeaderBuilder.CreateAnd(canRunInParallel, runInParallel);
+    branch->setCondition(willRunInParallel);
+
+    /*
+     * Tell the runtime the invocation is over.
+     * The invocation could have run sequentially even if the runtime chose to run it in parallel (e.g., another invocation was running in parallel), so the ticket is updated with the choice taken.
+     */
+    ticket = preHeaderBuilder.CreateOr(
+      preHeaderBuilder.CreateAnd(ticket, ConstantInt::get(par.int64, -2)),
+      preHeaderBuilder.CreateZExt(willRunInParallel, par.int64)
+    );
+    for (auto exitBB : loopExitBlocks){
+      IRBuilder<> exitBuilder(&*exitBB->getFirstInsertionPt());
+      exitBuilder.CreateCall(invocationEnds, ArrayRef<Value *>({
+        loopID,
+        tripCount,
+        ticket
+      }));
+    }
+
+    return true;
+  }
+
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "Parallelizer.hpp"
+
+namespace llvm::noelle {
+
+  BasicBlock * Parallelizer::addTechniqueSelector (
+      LoopDependenceInfo *LDI,
+      Noelle &par,
+      std::vector<Transformation> &techniqueIDs,
+      std::vector<BasicBlock *> &entryPointsOfParallelizedLoop
+      ){
+    auto prefix = "Parallelizer: addTechniqueSelector: " ;
+
+    /*
+     * Fetch the runtime APIs.
+     */
+    auto defaultEntryPoint = entryPointsOfParallelizedLoop[0];
+    auto M = defaultEntryPoint->getModule();
+    auto tunedTechnique = M->getFunction("NOELLE_tunedTechnique");
+    if (tunedTechnique == nullptr){
+      errs() << prefix << "ERROR = the NOELLE runtime does not provide the APIs to tune loops\n";
+      abort();
+    }
+
+    /*
+     * Ask the runtime for the technique chosen by the autotuner and jump to the version generated by it.
+     * The version of the technique chosen by the compiler runs if the autotuner chose a technique that cannot be applied to the loop.
+     */
+    auto selector = BasicBlock::Create(defaultEntryPoint->getContext(), "", defaultEntryPoint->getParent());
+    IRBuilder<> builder(selector);
+    auto loopID = ConstantInt::get(par.int64, LDI->getID());
+    auto technique = builder.CreateCall(tunedTechnique, ArrayRef<Value *>({
+      loopID,
+      ConstantInt::get(par.int64, techniqueIDs[0])
+    }));
+    auto techniqueSwitch = builder.CreateSwitch(technique, defaultEntryPoint);
+    for (auto i = 1u; i < techniqueIDs.size(); ++i){
+      techniqueSwitch->addCase(ConstantInt::get(par.int64, techniqueIDs[i]), entryPointsOfParallelizedLoop[i]);
+    }
+
+    return selector;
+  }
+
+  void Parallelizer::makeLoopTunable (
+      LoopDependenceInfo *LDI,
+      Noelle &par,
+      std::vector<BasicBlock *> &entryPointsOfParallelizedLoop,
+      bool hasSequentialFallback
+      ){
+    auto prefix = "Parallelizer: makeLoopTunable: " ;
+
+    /*
+     * Fetch the runtime APIs.
+     */
+    auto M = entryPointsOfParallelizedLoop[0]->getModule();
+    auto tunedNumberOfCores = M->getFunction("NOELLE_tunedNumberOfCores");
+    auto tunedChunkSize = M->getFunction("NOELLE_tunedDOALLChunkSize");
+    auto tunedSchedule = M->getFunction("NOELLE_tunedDOALLSchedule");
+    if (  false
+          || (tunedNumberOfCores == nullptr)
+          || (tunedChunkSize == nullptr)
+          || (tunedSchedule == nullptr)
+       ){
+      errs() << prefix << "ERROR = the NOELLE runtime does not provide the APIs to tune loops\n";
+      abort();
+    }
+
+    /*
+     * Tune every version of the loop.
+     */
+    std::string techniques;
+    int64_t cores = 0;
+    int64_t chunkSize = 0;
+    int64_t schedule = 0;
+    for (auto entryPointOfParallelizedLoop : entryPointsOfParallelizedLoop){
+
+      /*
+       * Fetch the call to the dispatcher of the current version.
+       */
+      CallInst *dispatcherCall = nullptr;
+      std::string technique;
+      for (auto &inst : *entryPointOfParallelizedLoop){
+        auto callInst = dyn_cast<CallInst>(&inst);
+        if (callInst == nullptr){
+          continue ;
+        }
+        auto callee = callInst->getCalledFunction();
+        if (callee == nullptr){
+          continue ;
+        }
+        auto calleeName = callee->getName();
+        if (calleeName == "NOELLE_DOALLDispatcher"){
+          technique = "DOALL";
+        } else if (calleeName.startswith("NOELLE_HELIX_dispatcher")){
+          technique = "HELIX";
+        } else if (calleeName == "NOELLE_DSWPDispatcher"){
+          technique = "DSWP";
+        } else {
+          continue ;
+        }
+        dispatcherCall = callInst;
+        break ;
+      }
+      if (dispatcherCall == nullptr){
+        errs() << prefix << "ERROR = the call to the dispatcher of loop " << LDI->getID() << " cannot be found\n";
+        abort();
+      }
+
+      /*
+       * Ask the runtime for the values of the parameters of the dispatcher chosen by the autotuner.
+       * The values chosen by the compiler are the default ones.
+       */
+      IRBuilder<> builder(dispatcherCall);
+      auto loopID = ConstantInt::get(par.int64, LDI->getID());
+      auto tuneArgument = [&builder, dispatcherCall, loopID](uint32_t argumentIndex, Function *tuner) -> int64_t {
+        auto compilerValue = dispatcherCall->getArgOperand(argumentIndex);
+        auto tunedValue = builder.CreateCall(tuner, ArrayRef<Value *>({
+          loopID,
+          compilerValue
+        }));
+        dispatcherCall->setArgOperand(argumentIndex, tunedValue);
+
+        auto compilerConstant = dyn_cast<ConstantInt>(compilerValue);
+        return (compilerConstant != nullptr) ? compilerConstant->getSExtValue() : 0;
+      };
+      if (technique == "DOALL"){
+        cores = std::max(cores, tuneArgument(2, tunedNumberOfCores));
+        chunkSize = tuneArgument(3, tunedChunkSize);
+        schedule = tuneArgument(4, tunedSchedule);
+
+      } else if (technique == "HELIX"){
+        cores = std::max(cores, tuneArgument(3, tunedNumberOfCores));
+      }
+      techniques += (techniques.empty() ? "" : ",") + technique;
+    }
+
+    /*
+     * Describe the choices the autotuner can make for the loop.
+     * The first technique is the one chosen by the compiler.
+     * The DSWP stages are fixed at compile time, so the autotuner can only choose whether its invocations run in parallel.
+     */
+    std::string description;
+    raw_string_ostream descriptionStream(description);
+    descriptionStream << LDI->getID() << " " << techniques << " " << cores << " " << chunkSize << " " << schedule << " " << (hasSequentialFallback ? 1 : 0);
+    descriptionStream.flush();
+    this->tunableLoops.push_back(description);
+
+    return ;
+  }
+
+  std::string Parallelizer::getTechniqueName (Transformation techniqueID) const {
+    switch (techniqueID){
+      case DOALL_ID:
+        return "DOALL";
+      case HELIX_ID:
+        return "HELIX";
+      case DSWP_ID:
+        return "DSWP";
+      default:
+        return "unknown";
+    }
+  }
+
+  void Parallelizer::writeDesignSpaceOfTunableLoops (void) const {
+    std::error_code EC;
+    raw_fd_ostream designSpace(this->tunableLoopsFileName, EC, sys::fs::F_Text);
+    if (EC) {
+      errs() << "Parallelizer: ERROR = cannot write the design space of the tunable loops to " << this->tunableLoopsFileName << "\n";
+      abort();
+    }
+
+    /*
+     * Write a line per tunable loop.
+     * A value of 0 means the parameter does not apply to the technique of the loop.
+     */
+    designSpace << "# loopID techniques maxCores chunkSize schedule sequentialFallback\n";
+    for (auto &loop : this->tunableLoops){
+      designSpace << loop << "\n";
+    }
+
+    return ;
+  }
+
+}
@@ -222,7 +222,8 @@ void PDGStats::collectStatsForLoopEdges (
   if (programLoops.find(&F) != programLoops.end()) {
     auto loopForest = programLoops[&F];
     for (auto loopTree : loopForest->getTrees()){
-      auto visitor = [this, &lsToLDI](StayConnectedNestedLoopForestNode *n, uint32_t level) -> bool {
+      auto profiles = noelle.getProfiles();
+      auto visitor = [this, &lsToLDI, profiles](StayConnectedNestedLoopForestNode *n, uint32_t level) -> bool {
 
         /*
          * Fetch the loop.
@@ -241,6 +242,17 @@ void PDGStats::collectStatsForLoopEdges (
          */
         for (auto edge : loopDG->getEdges()){
           this->analyzeDependence(edge);
+
+          /*
+           * Check whether the dependence has been observed on the profiled inputs.
+           */
+          if (!profiles->isDependenceProfileAvailable(currentLoop, edge)){
+            continue ;
+          }
+          this->numberOfProfiledLoopCarriedMemoryDependences++;
+          if (profiles->hasDependenceNeverManifested(currentLoop, edge)){
+            this->numberOfNeverManifestedLoopCarriedMemoryDependences++;
+          }
         }
 
         return false;
@@ -272,6 +284,8 @@ void PDGStats::printStats() {
   errs() << "     Number of memory must dependences: " << this->numberOfMemoryMustDependence << "\n";
   errs() << "     Number of memory may dependences: " << this->numberOfMemoryDependence - this->numberOfMemoryMustDependence << "\n";
   errs() << "     Number of potential memory dependences: " << this->numberOfPotentialMemoryDependences << "\n";
+  errs() << "     Number of profiled loop-carried memory may dependences: " << this->numberOfProfiledLoopCarriedMemoryDependences << "\n";
+  errs() << "       Number of them that never manifested: " << this->numberOfNeverManifestedLoopCarriedMemoryDependences << "\n";
 
   return;
 }
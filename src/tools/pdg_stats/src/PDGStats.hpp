@@ -41,6 +41,8 @@ namespace llvm::noelle {
       int64_t numberOfMemoryMustDependence = 0;
       int64_t numberOfPotentialMemoryDependences = 0;
       int64_t numberOfControlDependence = 0;
+      int64_t numberOfProfiledLoopCarriedMemoryDependences = 0;
+      int64_t numberOfNeverManifestedLoopCarriedMemoryDependences = 0;
 
       void collectStatsForNodes(Function &F);
       void collectStatsForPotentialEdges (std::unordered_map<Function *, StayConnectedNestedLoopForest *> &programLoops, Function &F) ;
@@ -35,3 +35,7 @@ patchInstallDir "noelle-loopsize" ;
 patchInstallDir "noelle-fixedpoint" ;
 patchInstallDir "noelle-pdg-stats" ;
 patchInstallDir "noelle-loop-stats" ;
+patchInstallDir "noelle-parallel-report" ;
+patchInstallDir "noelle-prof-dependences" ;
+patchInstallDir "noelle-meta-dep-embed" ;
+patchInstallDir "noelle-autotune" ;
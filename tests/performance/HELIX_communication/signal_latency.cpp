@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+
+/*
+ * APIs of the NOELLE runtime.
+ */
+extern "C" {
+  class DispatcherInfo {
+    public:
+      int32_t numberOfThreadsUsed;
+      int64_t unusedVariableToPreventOptIfStructHasOnlyOneVariable;
+  };
+
+  DispatcherInfo NOELLE_HELIX_dispatcher_sequentialSegments (
+    void (*parallelizedLoop)(void *, void *, void *, void *, int64_t, int64_t, uint64_t *),
+    void *env,
+    void *loopCarriedArray,
+    int64_t numCores,
+    int64_t numOfsequentialSegments
+    );
+
+  void HELIX_wait (void *sequentialSegment);
+
+  void HELIX_signal (void *sequentialSegment);
+}
+
+/*
+ * State shared among the cores.
+ * It is only accessed within the sequential segment, so the segment itself orders the accesses.
+ */
+typedef struct {
+  int64_t iterations;
+  int64_t lastIteration;
+  int64_t outOfOrderIterations;
+  int64_t signalTime;
+  double latency;
+  int64_t wakeUps;
+} Environment ;
+
+static int64_t now (void){
+  auto time = std::chrono::steady_clock::now().time_since_epoch();
+
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+}
+
+/*
+ * Task of a core: every iteration only executes the sequential segment, so the time is dominated by passing the segment from a core to the next one.
+ */
+static void loopTask (void *env, void *loopCarriedArray, void *ssPast, void *ssFuture, int64_t coreID, int64_t numCores, uint64_t *loopIsOverFlag){
+  auto e = (Environment *)env;
+  for (auto i = coreID; i < e->iterations; i += numCores){
+
+    /*
+     * Wait for the previous iteration.
+     */
+    auto arrival = now();
+    HELIX_wait(ssPast);
+
+    /*
+     * Check the order of the iterations.
+     */
+    if (e->lastIteration != (i - 1)){
+      e->outOfOrderIterations++;
+    }
+    e->lastIteration = i;
+
+    /*
+     * Measure the time from the signal to the wake up, if this core had to wait for the signal.
+     */
+    auto wakeUp = now();
+    if (  true
+          && (i > 0)
+          && (arrival < e->signalTime)
+       ){
+      e->latency += (wakeUp - e->signalTime);
+      e->wakeUps++;
+    }
+
+    /*
+     * Pass the segment to the next iteration.
+     */
+    e->signalTime = now();
+    HELIX_signal(ssFuture);
+  }
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 3){
+    fprintf(stderr, "USAGE: %s ITERATIONS MAX_CORES [report]\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  auto maxCores = atoll(argv[2]);
+  auto report = (argc > 3);
+
+  /*
+   * Pass a sequential segment among the cores for every iteration.
+   */
+  Environment env;
+  env.iterations = iterations;
+  env.lastIteration = -1;
+  env.outOfOrderIterations = 0;
+  env.signalTime = 0;
+  env.latency = 0;
+  env.wakeUps = 0;
+  auto start = now();
+  auto info = NOELLE_HELIX_dispatcher_sequentialSegments(loopTask, &env, nullptr, maxCores, 1);
+  auto time = now() - start;
+  printf("Iterations: %lld\n", (long long)(env.lastIteration + 1));
+  printf("Out of order iterations: %lld\n", (long long)env.outOfOrderIterations);
+  if (report){
+    fprintf(stderr, "Cores used: %d\n", info.numberOfThreadsUsed);
+    fprintf(stderr, "Time per iteration: %.3f ns\n", ((double)time) / iterations);
+    if (env.wakeUps > 0){
+      fprintf(stderr, "Signal-to-wake latency: %.3f ns (%lld wake ups)\n", env.latency / env.wakeUps, (long long)env.wakeUps);
+    }
+  }
+
+  return 0;
+}
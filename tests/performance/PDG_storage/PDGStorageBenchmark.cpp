@@ -0,0 +1,191 @@
+/*
+ * Copyright 2016 - 2021  Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <chrono>
+#include <random>
+
+#include "noelle/core/SystemHeaders.hpp"
+#include "noelle/core/PDGAnalysis.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+static cl::opt<std::string> Layout("pdg-storage-layout", cl::ZeroOrMore, cl::init("dense"), cl::desc("Layout of the dependence graph the workloads run on: dense (the one of DG<T>) or node-based"));
+static cl::opt<unsigned> Rounds("pdg-storage-rounds", cl::ZeroOrMore, cl::init(1), cl::desc("Number of times every workload runs"));
+static cl::opt<bool> Report("pdg-storage-report", cl::ZeroOrMore, cl::desc("Print the time spent in every workload"));
+
+namespace {
+
+/*
+ * Node-based layout of a dependence graph: it mirrors how DG<T> stored nodes, edges, and adjacency before switching to dense storage.
+ */
+struct NodeBasedGraph {
+  std::set<DGNode<Value> *> nodes;
+  std::set<DGEdge<Value> *> edges;
+  std::map<Value *, DGNode<Value> *> nodeMap;
+  std::unordered_map<DGNode<Value> *, std::unordered_set<DGEdge<Value> *>> outgoingEdges;
+};
+
+template <class Workload>
+double timeWorkload (uint32_t rounds, uint64_t &checksum, Workload workload){
+  auto start = std::chrono::steady_clock::now();
+  for (auto i = 0u; i < rounds; i++){
+    checksum += workload();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/*
+ * Time node lookups, node and edge scans, and adjacency walks on the PDG of the program stored with the layout given by -pdg-storage-layout.
+ * Both layouts compute the same checksum, which is the only output unless -pdg-storage-report is given.
+ */
+class PDGStorageBenchmark : public ModulePass {
+  public:
+    static char ID;
+
+    PDGStorageBenchmark () : ModulePass{ID} {}
+
+    bool runOnModule (Module &M) override ;
+
+    void getAnalysisUsage (AnalysisUsage &AU) const override {
+      AU.addRequired<PDGAnalysis>();
+      AU.setPreservesAll();
+    }
+
+  private:
+    void printWorkload (const std::string &name, double time) const ;
+};
+
+}
+
+char PDGStorageBenchmark::ID = 0;
+static RegisterPass<PDGStorageBenchmark> X("PDGStorageBenchmark", "Benchmark the storage of the dependence graph");
+
+bool PDGStorageBenchmark::runOnModule (Module &M){
+  auto pdg = getAnalysis<PDGAnalysis>().getPDG();
+  assert(pdg != nullptr);
+  if (  true
+        && (Layout != "dense")
+        && (Layout != "node-based")
+     ){
+    errs() << "PDGStorageBenchmark: -pdg-storage-layout must be dense or node-based\n";
+    abort();
+  }
+  auto isDense = (Layout == "dense");
+
+  /*
+   * Mirror the PDG in the node-based layout.
+   * The mirror is built for both layouts, so they only differ in the workloads.
+   */
+  NodeBasedGraph reference;
+  std::vector<Value *> values;
+  for (auto node : pdg->getNodes()){
+    auto value = node->getT();
+    reference.nodes.insert(node);
+    reference.nodeMap[value] = node;
+    values.push_back(value);
+  }
+  for (auto edge : pdg->getEdges()){
+    reference.edges.insert(edge);
+    reference.outgoingEdges[edge->getOutgoingNode()].insert(edge);
+  }
+
+  /*
+   * Shuffle the lookup order to avoid favoring the storage that follows the insertion order.
+   */
+  std::mt19937 generator(0);
+  std::shuffle(values.begin(), values.end(), generator);
+
+  if (Report){
+    errs() << "PDGStorageBenchmark: " << Layout << " layout (" << pdg->numNodes() << " nodes, " << pdg->numEdges() << " edges, " << Rounds << " rounds)\n";
+  }
+  uint64_t checksum = 0;
+
+  /*
+   * Workload 1: fetch the node of every value.
+   */
+  auto lookup = timeWorkload(Rounds, checksum, [&]() -> uint64_t {
+    uint64_t found = 0;
+    for (auto value : values){
+      if (isDense){
+        found += (pdg->fetchNode(value) != nullptr);
+      } else {
+        found += (reference.nodeMap.find(value) != reference.nodeMap.end());
+      }
+    }
+    return found;
+  });
+  this->printWorkload("Node lookup", lookup);
+
+  /*
+   * Workload 2: scan all nodes and edges.
+   */
+  auto scan = timeWorkload(Rounds, checksum, [&]() -> uint64_t {
+    uint64_t scanned = 0;
+    if (isDense){
+      for (auto node : pdg->getNodes()){
+        scanned += (node->getT() != nullptr);
+      }
+      for (auto edge : pdg->getEdges()){
+        scanned += edge->isMemoryDependence();
+      }
+    } else {
+      for (auto node : reference.nodes){
+        scanned += (node->getT() != nullptr);
+      }
+      for (auto edge : reference.edges){
+        scanned += edge->isMemoryDependence();
+      }
+    }
+    return scanned;
+  });
+  this->printWorkload("Node and edge scan", scan);
+
+  /*
+   * Workload 3: follow the outgoing edges of every node, which is the access pattern of SCC and reachability walks.
+   */
+  auto walk = timeWorkload(Rounds, checksum, [&]() -> uint64_t {
+    uint64_t walked = 0;
+    if (isDense){
+      for (auto node : pdg->getNodes()){
+        for (auto edge : node->getOutgoingEdges()){
+          walked += (edge->getIncomingNode() != node);
+        }
+      }
+    } else {
+      for (auto node : reference.nodes){
+        auto edgesI = reference.outgoingEdges.find(node);
+        if (edgesI == reference.outgoingEdges.end()){
+          continue ;
+        }
+        for (auto edge : edgesI->second){
+          walked += (edge->getIncomingNode() != node);
+        }
+      }
+    }
+    return walked;
+  });
+  this->printWorkload("Adjacency walk", walk);
+
+  outs() << "Checksum " << checksum << "\n";
+
+  return false;
+}
+
+void PDGStorageBenchmark::printWorkload (const std::string &name, double time) const {
+  if (!Report){
+    return ;
+  }
+  errs() << "  " << name << ": " << format("%.3f", time) << " ms\n";
+
+  return ;
+}
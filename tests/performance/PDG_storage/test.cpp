@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/*
+ * Code whose PDG is the input of the benchmark: loops over arrays, pointer chasing, and calls generate variable, memory, and control dependences.
+ */
+typedef struct node {
+  int64_t value;
+  struct node *next;
+} node_t;
+
+static int64_t G[256];
+
+static node_t * buildList (int64_t elements){
+  node_t *head = nullptr;
+  for (auto i = 0; i < elements; i++){
+    auto n = (node_t *) malloc(sizeof(node_t));
+    n->value = (i * 17) % 31;
+    n->next = head;
+    head = n;
+  }
+
+  return head;
+}
+
+static int64_t sumList (node_t *head){
+  int64_t s = 0;
+  for (auto n = head; n != nullptr; n = n->next){
+    s += n->value;
+    if (s > 1000){
+      G[s % 256]++;
+      s -= 1000;
+    }
+  }
+
+  return s;
+}
+
+static void freeList (node_t *head){
+  while (head != nullptr){
+    auto next = head->next;
+    free(head);
+    head = next;
+  }
+}
+
+static void multiply (int64_t *a, int64_t *b, int64_t *c, int64_t n){
+  for (auto i = 0; i < n; i++){
+    for (auto j = 0; j < n; j++){
+      int64_t s = 0;
+      for (auto k = 0; k < n; k++){
+        s += a[i * n + k] * b[k * n + j];
+      }
+      c[i * n + j] = s;
+    }
+  }
+}
+
+static void stencil (int64_t *in, int64_t *out, int64_t n){
+  for (auto i = 1; i < n - 1; i++){
+    for (auto j = 1; j < n - 1; j++){
+      out[i * n + j] = (in[(i - 1) * n + j] + in[(i + 1) * n + j] + in[i * n + j - 1] + in[i * n + j + 1]) / 4;
+    }
+  }
+}
+
+static int64_t histogram (int64_t *a, int64_t n){
+  int64_t maximum = 0;
+  for (auto i = 0; i < n; i++){
+    auto bin = a[i] % 256;
+    G[bin]++;
+    if (G[bin] > maximum){
+      maximum = G[bin];
+    }
+  }
+
+  return maximum;
+}
+
+int main (int argc, char *argv[]){
+  int64_t n = (argc > 1) ? atoll(argv[1]) : 16;
+
+  auto a = (int64_t *) malloc(sizeof(int64_t) * n * n);
+  auto b = (int64_t *) malloc(sizeof(int64_t) * n * n);
+  auto c = (int64_t *) malloc(sizeof(int64_t) * n * n);
+  for (auto i = 0; i < n * n; i++){
+    a[i] = i % 7;
+    b[i] = i % 5;
+  }
+
+  multiply(a, b, c, n);
+  stencil(c, a, n);
+  auto maximum = histogram(a, n * n);
+
+  auto list = buildList(n * 10);
+  auto s = sumList(list);
+  freeList(list);
+
+  printf("%lld %lld %lld\n", (long long)c[n + 1], (long long)maximum, (long long)s);
+
+  free(a);
+  free(b);
+  free(c);
+
+  return 0;
+}
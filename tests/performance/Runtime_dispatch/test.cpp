@@ -0,0 +1,151 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+
+/*
+ * APIs of the NOELLE runtime.
+ */
+extern "C" {
+  class DispatcherInfo {
+    public:
+      int32_t numberOfThreadsUsed;
+      int64_t unusedVariableToPreventOptIfStructHasOnlyOneVariable;
+  };
+
+  DispatcherInfo NOELLE_DOALLDispatcher (
+    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t, void *),
+    void *env,
+    int64_t maxNumberOfCores,
+    int64_t chunkSize,
+    int64_t schedule,
+    int64_t expectedIterations
+    );
+}
+
+#define STATIC_SCHEDULE 1
+
+typedef struct {
+  int64_t iterations;
+  int64_t innerCores;
+  std::atomic<int64_t> checksum;
+} Environment ;
+
+static bool report = false;
+
+static int64_t computeIteration (int64_t i){
+  auto v = i;
+  for (auto k = 0; k < 64; k++){
+    v = (v * 7 + k) % 1000003;
+  }
+
+  return v;
+}
+
+/*
+ * Task that does nothing but signaling its execution: it exposes the cost of dispatching and joining.
+ */
+static void emptyTask (void *env, int64_t coreID, int64_t numCores, int64_t chunkSize, void *scheduler){
+  auto e = (Environment *)env;
+  e->checksum.fetch_add(1, std::memory_order_relaxed);
+
+  return ;
+}
+
+/*
+ * Task that executes its share of the iterations of a loop.
+ */
+static void loopTask (void *env, int64_t coreID, int64_t numCores, int64_t chunkSize, void *scheduler){
+  auto e = (Environment *)env;
+  int64_t sum = 0;
+  for (auto i = coreID; i < e->iterations; i += numCores){
+    sum += computeIteration(i);
+  }
+  e->checksum.fetch_add(sum, std::memory_order_relaxed);
+
+  return ;
+}
+
+/*
+ * Task that dispatches a parallelized loop from within a parallelized loop.
+ */
+static void nestedTask (void *env, int64_t coreID, int64_t numCores, int64_t chunkSize, void *scheduler){
+  auto e = (Environment *)env;
+  Environment innerEnv;
+  innerEnv.iterations = e->iterations;
+  innerEnv.innerCores = 0;
+  innerEnv.checksum = 0;
+  NOELLE_DOALLDispatcher(loopTask, &innerEnv, e->innerCores, 1, STATIC_SCHEDULE, 0);
+  e->checksum.fetch_add(innerEnv.checksum.load(), std::memory_order_relaxed);
+
+  return ;
+}
+
+static double elapsedMicroseconds (std::chrono::steady_clock::time_point start){
+  auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 3){
+    fprintf(stderr, "USAGE: %s DISPATCHES MAX_CORES [report]\n", argv[0]);
+    return -1;
+  }
+  auto dispatches = atoll(argv[1]);
+  auto maxCores = atoll(argv[2]);
+  report = (argc > 3);
+
+  /*
+   * Dispatch latency: invoke a parallelized loop with empty tasks many times.
+   */
+  Environment env;
+  env.checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (auto i = 0; i < dispatches; i++){
+    NOELLE_DOALLDispatcher(emptyTask, &env, maxCores, 1, STATIC_SCHEDULE, 0);
+  }
+  auto time = elapsedMicroseconds(start);
+  printf("Dispatch: %lld tasks\n", (long long)env.checksum.load());
+  if (report){
+    fprintf(stderr, "Dispatch latency: %.3f us per dispatch of %lld cores\n", time / dispatches, (long long)maxCores);
+  }
+
+  /*
+   * Scalability: execute the same loop with an increasing number of cores.
+   */
+  for (auto cores = 1; cores <= maxCores; cores *= 2){
+    env.iterations = dispatches * 10;
+    env.checksum = 0;
+    start = std::chrono::steady_clock::now();
+    auto info = NOELLE_DOALLDispatcher(loopTask, &env, cores, 1, STATIC_SCHEDULE, 0);
+    time = elapsedMicroseconds(start);
+    printf("Loop with %d cores: %lld\n", cores, (long long)env.checksum.load());
+    if (report){
+      fprintf(stderr, "Scalability: %.3f us with %d cores requested (%d used)\n", time, cores, info.numberOfThreadsUsed);
+    }
+  }
+
+  /*
+   * Nested dispatches: every task of a parallelized loop invokes another parallelized loop.
+   */
+  env.iterations = dispatches / 10;
+  env.innerCores = maxCores;
+  env.checksum = 0;
+  start = std::chrono::steady_clock::now();
+  for (auto i = 0; i < 10; i++){
+    NOELLE_DOALLDispatcher(nestedTask, &env, maxCores, 1, STATIC_SCHEDULE, 0);
+  }
+  time = elapsedMicroseconds(start);
+  printf("Nested loops: %lld\n", (long long)env.checksum.load());
+  if (report){
+    fprintf(stderr, "Nested dispatch: %.3f us per outer dispatch\n", time / 10);
+  }
+
+  return 0;
+}
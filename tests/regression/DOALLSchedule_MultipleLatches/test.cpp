@@ -0,0 +1,61 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+void compute (int64_t *a, int64_t *b, int64_t iters){
+
+  /*
+   * Every "continue" jumps back to the header: the loop has three latches.
+   */
+  int64_t i = 0;
+  while (i < iters){
+    if ((a[i] % 3) == 0){
+      b[i] = a[i] * 2;
+      i++;
+      continue ;
+    }
+    if ((a[i] % 3) == 1){
+      int64_t s = 0;
+      for (int64_t j = 0; j < a[i]; j++){
+        s += j;
+      }
+      b[i] = s;
+      i++;
+      continue ;
+    }
+    b[i] = a[i] - 1;
+    i++;
+  }
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations <= 0) return 0;
+
+  int64_t *a = (int64_t *) malloc(sizeof(int64_t) * iterations);
+  int64_t *b = (int64_t *) malloc(sizeof(int64_t) * iterations);
+  for (auto i = 0; i < iterations; i++){
+    a[i] = (i * 7) % 101;
+    b[i] = 0;
+  }
+
+  compute(a, b, iterations);
+
+  int64_t checksum = 0;
+  for (auto i = 0; i < iterations; i++){
+    checksum += b[i] * (i % 13);
+  }
+  printf("%lld %lld %lld\n", (long long)checksum, (long long)b[0], (long long)b[iterations - 1]);
+
+  return 0;
+}
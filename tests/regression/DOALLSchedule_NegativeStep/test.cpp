@@ -0,0 +1,49 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+void compute (int64_t *a, int64_t *b, int64_t iters){
+
+  /*
+   * The loop-governing IV decreases.
+   */
+  for (int64_t i = iters - 1; i >= 0; i--){
+    int64_t s = a[i];
+    for (int64_t j = 0; j < (a[i] % 17); j++){
+      s = (s * 3 + j) % 1000003;
+    }
+    b[i] = s + i;
+  }
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations <= 0) return 0;
+
+  int64_t *a = (int64_t *) malloc(sizeof(int64_t) * iterations);
+  int64_t *b = (int64_t *) malloc(sizeof(int64_t) * iterations);
+  for (auto i = 0; i < iterations; i++){
+    a[i] = (i * 13) % 97;
+    b[i] = 0;
+  }
+
+  compute(a, b, iterations);
+
+  int64_t checksum = 0;
+  for (auto i = 0; i < iterations; i++){
+    checksum += b[i] * (i % 11);
+  }
+  printf("%lld %lld %lld\n", (long long)checksum, (long long)b[0], (long long)b[iterations - 1]);
+
+  return 0;
+}
@@ -0,0 +1,46 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 3){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS SPARSE_PERIOD\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  auto sparsePeriod = atoll(argv[2]);
+  if (sparsePeriod <= 0) return 0;
+
+  int64_t a = argc;
+  int64_t b = argc * 3;
+  int64_t c = argc * 7;
+  for (auto i = 0; i < iterations; ++i) {
+
+    /*
+     * SCC A produces a value for B at every iteration.
+     */
+    a = (a * 5 + i) % 1000003;
+
+    /*
+     * SCC B consumes A and produces a value for C at every iteration.
+     */
+    b = (b * 3 + a) % 1000033;
+    c = (c * 7 + b) % 1000037;
+
+    /*
+     * SCC A produces a value for C only rarely.
+     * Hence, the values A sends to C fill a batch of their queue much later than the values A sends to B, while C needs them to make progress.
+     */
+    if ((i % sparsePeriod) == 0){
+      a = (a * 11) % 1000003;
+      c = (c + a) % 1000037;
+    }
+  }
+
+  printf("%lld %lld %lld\n", (long long)a, (long long)b, (long long)c);
+  return 0;
+}
@@ -0,0 +1,233 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * APIs of the dependence profiler.
+ * "parallelized" links the NOELLE runtime; "baseline" uses the reference model below.
+ */
+extern "C" {
+  void NOELLE_dependenceProfilerInitialize (int64_t numberOfLoops, int64_t numberOfDependences, const char **descriptions);
+
+  void NOELLE_dependenceProfilerInvocationBegins (int64_t loopID);
+
+  void NOELLE_dependenceProfilerIterationBegins (int64_t loopID);
+
+  void NOELLE_dependenceProfilerSource (int64_t dependenceID, int64_t loopID, void *address, int64_t size);
+
+  void NOELLE_dependenceProfilerDestination (int64_t dependenceID, int64_t loopID, void *address, int64_t size);
+}
+
+#ifdef REFERENCE_PROFILER
+#include <map>
+#include <vector>
+
+/*
+ * Reference model of the dependence profiler.
+ * It keeps, for every dependence, the first iteration of the current invocation the source accessed each word in, without any paging.
+ * A dependence manifests when its destination accesses a word the source accessed in an earlier iteration of the same invocation.
+ */
+typedef struct {
+  int64_t invocation;
+  int64_t iteration;
+} ReferenceLoop ;
+
+typedef struct {
+  int64_t checks;
+  int64_t manifestations;
+  const char *description;
+  int64_t invocation;
+  std::map<uintptr_t, int64_t> firstIteration;
+} ReferenceDependence ;
+
+static std::vector<ReferenceLoop> referenceLoops;
+static std::vector<ReferenceDependence> referenceDependences;
+
+static void referenceDump (void){
+  auto fileName = getenv("NOELLE_DEPENDENCE_PROFILE");
+  auto profile = fopen(fileName, "w");
+  for (auto &dependence : referenceDependences){
+    fprintf(profile, "%lld %lld %s\n", (long long)dependence.checks, (long long)dependence.manifestations, dependence.description);
+  }
+  fclose(profile);
+
+  return ;
+}
+
+static ReferenceDependence & referenceFetch (int64_t dependenceID, int64_t loopID){
+  auto &dependence = referenceDependences[dependenceID];
+  if (dependence.invocation != referenceLoops[loopID].invocation){
+    dependence.firstIteration.clear();
+    dependence.invocation = referenceLoops[loopID].invocation;
+  }
+
+  return dependence;
+}
+
+extern "C" {
+  void NOELLE_dependenceProfilerInitialize (int64_t numberOfLoops, int64_t numberOfDependences, const char **descriptions){
+    referenceLoops.resize(numberOfLoops, {0, 0});
+    referenceDependences.resize(numberOfDependences);
+    for (auto dependenceID = 0; dependenceID < numberOfDependences; dependenceID++){
+      referenceDependences[dependenceID].description = descriptions[dependenceID];
+    }
+    atexit(referenceDump);
+
+    return ;
+  }
+
+  void NOELLE_dependenceProfilerInvocationBegins (int64_t loopID){
+    referenceLoops[loopID].invocation++;
+    referenceLoops[loopID].iteration = 0;
+
+    return ;
+  }
+
+  void NOELLE_dependenceProfilerIterationBegins (int64_t loopID){
+    referenceLoops[loopID].iteration++;
+
+    return ;
+  }
+
+  void NOELLE_dependenceProfilerSource (int64_t dependenceID, int64_t loopID, void *address, int64_t size){
+    auto &dependence = referenceFetch(dependenceID, loopID);
+    for (auto byte = (uintptr_t)address; byte < ((uintptr_t)address) + size; byte++){
+      dependence.firstIteration.insert({byte / 8, referenceLoops[loopID].iteration});
+    }
+
+    return ;
+  }
+
+  void NOELLE_dependenceProfilerDestination (int64_t dependenceID, int64_t loopID, void *address, int64_t size){
+    auto &dependence = referenceFetch(dependenceID, loopID);
+    dependence.checks++;
+    for (auto byte = (uintptr_t)address; byte < ((uintptr_t)address) + size; byte++){
+      auto wordIt = dependence.firstIteration.find(byte / 8);
+      if (  true
+            && (wordIt != dependence.firstIteration.end())
+            && (wordIt->second < referenceLoops[loopID].iteration)
+         ){
+        dependence.manifestations++;
+        break ;
+      }
+    }
+
+    return ;
+  }
+}
+#endif
+
+/*
+ * The shadow of the runtime is kept per word of 8 bytes, in pages of 4096 words.
+ */
+static const int64_t pageSize = 4096 * 8;
+static const int64_t pages = 8;
+alignas(4096 * 8) static char memory[pages * pageSize];
+
+static const char *descriptions[] = {
+  "same word at every iteration",
+  "new page at every iteration",
+  "different bytes of the same word",
+  "accesses that span two pages",
+  "source only in odd invocations",
+  "pseudo-random accesses"
+};
+
+static void printProfile (void){
+  auto profile = fopen(getenv("NOELLE_DEPENDENCE_PROFILE"), "r");
+  if (profile == nullptr){
+    printf("No profile\n");
+    return ;
+  }
+  char line[256];
+  while (fgets(line, sizeof(line), profile) != nullptr){
+    printf("%s", line);
+  }
+  fclose(profile);
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+  if (argc < 4){
+    fprintf(stderr, "USAGE: %s INVOCATIONS ITERATIONS RANDOM_ACCESSES\n", argv[0]);
+    return 1;
+  }
+  auto invocations = atoll(argv[1]);
+  auto iterations = atoll(argv[2]);
+  auto randomAccesses = atoll(argv[3]);
+
+  /*
+   * Print the profile once it has been dumped: exit handlers run in the reverse order of their registration.
+   */
+  setenv("NOELLE_DEPENDENCE_PROFILE", "test.depprof", 1);
+  atexit(printProfile);
+  NOELLE_dependenceProfilerInitialize(2, 6, descriptions);
+
+  uint64_t seed = 42;
+  for (auto invocation = 1; invocation <= invocations; invocation++){
+    NOELLE_dependenceProfilerInvocationBegins(0);
+    NOELLE_dependenceProfilerInvocationBegins(1);
+    for (auto iteration = 1; iteration <= iterations; iteration++){
+      NOELLE_dependenceProfilerIterationBegins(0);
+      NOELLE_dependenceProfilerIterationBegins(1);
+
+      /*
+       * Dependence 0 manifests from the second iteration of every invocation.
+       */
+      NOELLE_dependenceProfilerDestination(0, 0, &memory[8], 8);
+      NOELLE_dependenceProfilerSource(0, 0, &memory[8], 8);
+
+      /*
+       * Dependence 1 accesses a different page at every iteration, so it manifests only once the iterations come back to the first page.
+       */
+      auto pageOffset = ((iteration % pages) * pageSize) + 16;
+      NOELLE_dependenceProfilerDestination(1, 0, &memory[pageOffset], 4);
+      NOELLE_dependenceProfilerSource(1, 0, &memory[pageOffset], 4);
+
+      /*
+       * Dependence 2 manifests at the granularity of words only: the destination reads the byte after the one the source wrote in the previous iteration.
+       */
+      auto wordOffset = pageSize + (iteration * 8);
+      NOELLE_dependenceProfilerDestination(2, 0, &memory[wordOffset - 7], 1);
+      NOELLE_dependenceProfilerSource(2, 0, &memory[wordOffset], 1);
+
+      /*
+       * Dependence 3: the source writes across the boundary of two pages, and the destination reads only the part in the second page.
+       */
+      auto boundary = (2 * pageSize) + ((iteration % 4) * pageSize);
+      NOELLE_dependenceProfilerDestination(3, 0, &memory[boundary + 8], 8);
+      NOELLE_dependenceProfilerSource(3, 0, &memory[boundary - 20], 40);
+
+      /*
+       * Dependence 4 belongs to the second loop: the shadow written by an odd invocation must not leak to the next one.
+       */
+      if (  true
+            && (iteration == 1)
+            && ((invocation % 2) == 1)
+         ){
+        NOELLE_dependenceProfilerSource(4, 1, &memory[7 * pageSize], 64);
+      }
+      if (iteration == 2){
+        NOELLE_dependenceProfilerDestination(4, 1, &memory[(7 * pageSize) + 32], 8);
+      }
+
+      /*
+       * Dependence 5: accesses of random sizes and alignments across all pages.
+       */
+      for (auto access = 0; access < randomAccesses; access++){
+        seed = (seed * 6364136223846793005ULL) + 1442695040888963407ULL;
+        auto size = (int64_t)((seed >> 20) % 64) + 1;
+        auto offset = (int64_t)((seed >> 33) % (sizeof(memory) - size));
+        if ((seed >> 63) == 0){
+          NOELLE_dependenceProfilerSource(5, 0, &memory[offset], size);
+        } else {
+          NOELLE_dependenceProfilerDestination(5, 0, &memory[offset], size);
+        }
+      }
+    }
+  }
+
+  return 0;
+}
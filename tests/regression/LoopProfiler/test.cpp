@@ -0,0 +1,192 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+/*
+ * APIs of the loop profiler.
+ * "parallelized" links the NOELLE runtime; "baseline" uses the reference model below.
+ */
+extern "C" {
+  void NOELLE_loopProfilerInitialize (int64_t numberOfLoops);
+
+  int64_t NOELLE_loopProfilerInvocationBegins (int64_t loopID);
+
+  void NOELLE_loopProfilerInvocationEnds (int64_t loopID, int64_t iterations, int64_t startCycles);
+}
+
+#ifdef REFERENCE_PROFILER
+#include <mutex>
+
+/*
+ * Reference model of the loop profiler.
+ * It computes the bucket of the histograms by scanning the powers of 2, and it samples the cost of the first invocation of every 16.
+ * The cost of an iteration depends on the machine, so the model counts every sampled invocation in the bucket 0 of the cycles.
+ */
+typedef struct {
+  uint64_t invocations;
+  uint64_t iterations[65];
+  uint64_t cyclesPerIteration[65];
+} ReferenceLoop ;
+
+static std::vector<ReferenceLoop> referenceLoops;
+static std::mutex referenceLock;
+
+static void referenceDump (void){
+  auto profile = fopen(getenv("NOELLE_LOOP_PROFILE"), "w");
+  for (auto loopID = 0; loopID < referenceLoops.size(); loopID++){
+    auto &loop = referenceLoops[loopID];
+    if (loop.invocations == 0){
+      continue ;
+    }
+    fprintf(profile, "%d iterations", loopID);
+    for (auto counter : loop.iterations){
+      fprintf(profile, " %llu", (unsigned long long)counter);
+    }
+    fprintf(profile, "\n%d cycles", loopID);
+    for (auto counter : loop.cyclesPerIteration){
+      fprintf(profile, " %llu", (unsigned long long)counter);
+    }
+    fprintf(profile, "\n");
+  }
+  fclose(profile);
+
+  return ;
+}
+
+static uint32_t referenceBucket (int64_t value){
+  uint32_t bucket = 0;
+  while (  true
+           && (value > 0)
+           && (bucket < 64)
+           && ((uint64_t)value >= (1ULL << bucket))
+        ){
+    bucket++;
+  }
+
+  return bucket;
+}
+
+extern "C" {
+  void NOELLE_loopProfilerInitialize (int64_t numberOfLoops){
+    referenceLoops.resize(numberOfLoops);
+    memset(referenceLoops.data(), 0, sizeof(ReferenceLoop) * numberOfLoops);
+    atexit(referenceDump);
+
+    return ;
+  }
+
+  int64_t NOELLE_loopProfilerInvocationBegins (int64_t loopID){
+    std::lock_guard<std::mutex> guard(referenceLock);
+    auto invocation = referenceLoops[loopID].invocations++;
+
+    return (invocation % 16) == 0 ? 1 : 0;
+  }
+
+  void NOELLE_loopProfilerInvocationEnds (int64_t loopID, int64_t iterations, int64_t startCycles){
+    std::lock_guard<std::mutex> guard(referenceLock);
+    referenceLoops[loopID].iterations[referenceBucket(iterations)]++;
+    if (startCycles != 0){
+      referenceLoops[loopID].cyclesPerIteration[0]++;
+    }
+
+    return ;
+  }
+}
+#endif
+
+/*
+ * Print the profile once it has been dumped: the histograms of the iterations as they are, and only how many invocations have been sampled from the histograms of the cycles.
+ */
+static void printProfile (void){
+  auto profile = fopen(getenv("NOELLE_LOOP_PROFILE"), "r");
+  if (profile == nullptr){
+    printf("No profile\n");
+    return ;
+  }
+  char line[4096];
+  while (fgets(line, sizeof(line), profile) != nullptr){
+    if (strstr(line, " cycles ") == nullptr){
+      printf("%s", line);
+      continue ;
+    }
+    auto loopID = strtoll(line, nullptr, 10);
+    auto counters = strstr(line, " cycles ") + strlen(" cycles ");
+    uint64_t sampled = 0;
+    char *end;
+    for (auto counter = strtoull(counters, &end, 10); end != counters; counter = strtoull(counters, &end, 10)){
+      sampled += counter;
+      counters = end;
+    }
+    printf("%lld sampled %llu\n", (long long)loopID, (unsigned long long)sampled);
+  }
+  fclose(profile);
+
+  return ;
+}
+
+/*
+ * Run an invocation of the loop @loopID that executes @iterations iterations.
+ */
+static int64_t runLoop (int64_t loopID, int64_t iterations){
+  auto startCycles = NOELLE_loopProfilerInvocationBegins(loopID);
+  volatile int64_t sum = 0;
+  for (auto i = 0; i < iterations; i++){
+    sum = sum + i;
+  }
+  NOELLE_loopProfilerInvocationEnds(loopID, iterations, startCycles);
+
+  return sum;
+}
+
+int main (int argc, char *argv[]){
+  if (argc < 3){
+    fprintf(stderr, "USAGE: %s INVOCATIONS THREADS\n", argv[0]);
+    return 1;
+  }
+  auto invocations = atoll(argv[1]);
+  auto threads = atoll(argv[2]);
+
+  setenv("NOELLE_LOOP_PROFILE", "test.loopprof", 1);
+  atexit(printProfile);
+  NOELLE_loopProfilerInitialize(4);
+
+  /*
+   * Loop 0: the trip counts at the boundaries of the buckets.
+   */
+  for (int64_t iterations : {0, 1, 2, 3, 4, 7, 8, 1023, 1024, 1025}){
+    runLoop(0, iterations);
+  }
+
+  /*
+   * Loop 1: a short and a long trip count, where only the first invocation of every 16 is sampled.
+   */
+  for (auto invocation = 0; invocation < invocations; invocation++){
+    runLoop(1, (invocation % 10) == 0 ? 1000 : 4);
+  }
+
+  /*
+   * Loop 2 is never invoked, so it is not in the profile.
+   * Loop 3 is invoked by several threads at the same time.
+   */
+  std::vector<std::thread> workers;
+  for (auto thread = 0; thread < threads; thread++){
+    workers.push_back(std::thread([thread, invocations](){
+      for (auto invocation = 0; invocation < invocations; invocation++){
+        runLoop(3, thread + (invocation % 3));
+      }
+    }));
+  }
+  for (auto &worker : workers){
+    worker.join();
+  }
+
+  /*
+   * The iterations are counted up to the largest trip count.
+   */
+  NOELLE_loopProfilerInvocationEnds(0, INT64_MAX, 0);
+
+  return 0;
+}
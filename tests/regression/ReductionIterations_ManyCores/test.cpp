@@ -0,0 +1,76 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+/*
+ * The private copies of the reduced variables are combined with vector operations when there are at least 8 of them (see tests/scripts/test_regression.sh for the configuration that uses 8 cores).
+ */
+void computeIntegers (long long int iterations, long long int *sum, unsigned long long *product, unsigned long long *orBits, unsigned long long *andBits){
+  long long int s = 0;
+  unsigned long long p = 1;
+  unsigned long long o = 0;
+  unsigned long long a = ~0ULL;
+  for (long long int i = 0; i < iterations; i++){
+    s += i * 3 - 7;
+    p *= (2 * i + 1);
+    o |= (1ULL << (i % 61));
+    a &= ~(1ULL << ((i * 7) % 64)) | (i & 0xFF);
+  }
+  *sum = s;
+  *product = p;
+  *orBits = o;
+  *andBits = a;
+
+  return ;
+}
+
+/*
+ * The order the floating point values are combined changes with the number of cores, so they are compared with closed forms using a tolerance.
+ *   sum_{i=0}^{n-1} 1/((i+1)(i+2)) = 1 - 1/(n+1)
+ *   prod_{i=0}^{n-1} (i+2)/(i+1) = n+1
+ */
+void computeFloats (long long int iterations, double *sum, double *product){
+  double s = 0;
+  double p = 1;
+  for (long long int i = 0; i < iterations; i++){
+    double d = (double)i;
+    s += 1.0 / ((d + 1) * (d + 2));
+    p *= (d + 2) / (d + 1);
+  }
+  *sum = s;
+  *product = p;
+
+  return ;
+}
+
+static const char * checkWithTolerance (double value, double expected){
+  if (fabs(value - expected) <= (1e-9 * fabs(expected))){
+    return "OK";
+  }
+  return "MISMATCH";
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations <= 0) return 0;
+
+  long long int sum;
+  unsigned long long product, orBits, andBits;
+  computeIntegers(iterations, &sum, &product, &orBits, &andBits);
+  printf("%lld %llu %llu %llu\n", sum, product, orBits, andBits);
+
+  double fpSum, fpProduct;
+  computeFloats(iterations, &fpSum, &fpProduct);
+  auto n = (double)iterations;
+  printf("%s %s\n", checkWithTolerance(fpSum, 1.0 - (1.0 / (n + 1))), checkWithTolerance(fpProduct, n + 1));
+
+  return 0;
+}
@@ -0,0 +1,57 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+void compute (int64_t *a, int64_t *b, int64_t first, int64_t last){
+
+  /*
+   * The loop-governing IV decreases by 3, so the trip count of an invocation is computed by dividing by the absolute value of the step.
+   */
+  for (int64_t i = last; i > first; i -= 3){
+    int64_t s = a[i];
+    for (int64_t j = 0; j < (a[i] % 13); j++){
+      s = (s * 7 + j) % 1000003;
+    }
+    b[i] += s + i;
+  }
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations <= 0) return 0;
+
+  int64_t *a = (int64_t *) malloc(sizeof(int64_t) * iterations);
+  int64_t *b = (int64_t *) malloc(sizeof(int64_t) * iterations);
+  for (auto i = 0; i < iterations; i++){
+    a[i] = (i * 31) % 101;
+    b[i] = 0;
+  }
+
+  /*
+   * Mix small invocations of the loop, which should run sequentially, with big ones.
+   * Some invocations do not execute any iteration: their trip count must be 0 rather than a delta that wrapped around.
+   */
+  for (auto invocation = 0; invocation < 64; invocation++){
+    auto last = (invocation % 4 == 0) ? (iterations - 1) : ((invocation * 5) % iterations);
+    auto first = (invocation % 8 == 3) ? (last + 7) : -1;
+    compute(a, b, first, last);
+  }
+
+  int64_t checksum = 0;
+  for (auto i = 0; i < iterations; i++){
+    checksum += b[i] * (i % 11);
+  }
+  printf("%lld %lld %lld\n", (long long)checksum, (long long)b[0], (long long)b[iterations - 1]);
+
+  return 0;
+}
@@ -12,8 +12,15 @@ function linkParUtils {
     if ! test -f Parallelizer_utils.cpp ; then
       ln -s ${rootDir}/src/core/runtime/Parallelizer_utils.cpp ;
     fi
+    if ! test -f NoelleTopology.hpp ; then
+      ln -s ${rootDir}/src/core/runtime/NoelleTopology.hpp ;
+    fi
     if ! test -f Makefile ; then
-      ln -s ../../scripts/Makefile ;
+      if test -f Makefile.custom ; then
+        ln -s Makefile.custom Makefile ;
+      else
+        ln -s ../../scripts/Makefile ;
+      fi
     fi
     cd ../ ;
   done
@@ -12,7 +12,7 @@ function cleanTests {
 
     cd $i ;
     make clean ;
-    rm -f *_utils.cpp Makefile *.log *.dot ;
+    rm -f *_utils.cpp NoelleTopology.hpp Makefile *.log *.dot ;
     cd ../ ;
   done
 
@@ -57,6 +57,9 @@ function runTest {
   llvm-dis test.bc -o test.ll
 
   local UNIT_TEST_PASS="-load $TEST_LIB_DIR/UnitTestHelpers.so -load $TEST_LIB_DIR/$TEST_SO -UnitTester"
+  if test -f ../../options.info ; then
+    UNIT_TEST_PASS="$UNIT_TEST_PASS $(< ../../options.info)" ;
+  fi
   loadAndRunNoellePasses "$UNIT_TEST_PASS" test.bc tested.bc &> compiler_output.txt
   llvm-dis tested.bc -o tested.ll
 
@@ -12,6 +12,55 @@ function runningTestsWrapper {
   return ;
 }
 
+function runningTestsWithDOALLSchedule {
+  local schedule="$1" ;
+
+  # Force DOALL with the given schedule on every loop through the loop-filter file (see Noelle::checkToGetLoopFilteringInfo)
+  # Fields: parallelize unroll peel techniquesToDisable cores chunkFactor unused unused unused DOALLSchedule
+  local indexFile="`pwd`/doall_schedule_${schedule}.info" ;
+  echo "v2" > $indexFile ;
+  for i in `seq 1 1000` ; do
+    echo "1 0 0 4 4 0 0 0 0 ${schedule}" >> $indexFile ;
+  done
+
+  export INDEX_FILE="$indexFile" ;
+  runningTests "Testing the DOALL schedule ${schedule} forced through INDEX_FILE" "-noelle-verbose=3 -noelle-parallelizer-force" ;
+  unset INDEX_FILE ;
+  rm -f $indexFile ;
+
+  return ;
+}
+
+function runningTestsWithTechnique {
+  local technique="$1" ;
+
+  # Generate every technique that can be applied to a loop and let the runtime run the version of the given one (see NOELLE_TUNING_CONFIG)
+  # Design space: loopID techniques maxCores chunkSize schedule sequentialFallback
+  # Configuration: loopID parallel technique cores chunkSize schedule
+  local designSpace="tunable_loops.info" ;
+  local configuration="`pwd`/tuning_${technique}.config" ;
+  local chooseTechnique="grep -v '^#' ${designSpace} | awk -v t=${technique} '{ if ((\",\" \$2 \",\") ~ (\",\" t \",\")) { print \$1 \" 1 \" t \" 0 0 0\" } }' > ${configuration} ; rm -f ${designSpace}" ;
+
+  export NOELLE_TUNING_CONFIG="$configuration" ;
+  runningTests "Testing the ${technique} version of the tunable loops" "-noelle-verbose=3 -noelle-parallelizer-force -noelle-parallelizer-tunable=${designSpace}" "${chooseTechnique}" ;
+  unset NOELLE_TUNING_CONFIG ;
+  rm -f $configuration ;
+
+  return ;
+}
+
+function runningTestsWithRuntimeEnvironment {
+  local variable="$1" ;
+  local value="$2" ;
+
+  # Run the parallelized binaries with the runtime configured through the given environment variable
+  export ${variable}="${value}" ;
+  runningTests "Testing DOALL with the runtime configured by ${variable}=${value}" "-noelle-verbose=3 -noelle-parallelizer-force -noelle-disable-helix -noelle-disable-dswp" ;
+  unset ${variable} ;
+
+  return ;
+}
+
 function runningTests {
   echo $1 ;
 
@@ -48,6 +97,11 @@ function runningTests {
     # Generate the input
     make input.txt &> /dev/null ;
 
+    # Prepare the run
+    if test "$3" != "" ; then
+      eval "$3" ;
+    fi
+
     # Baseline
     ./baseline `cat input.txt` &> output_baseline.txt ;
 
@@ -100,6 +154,22 @@ runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -noelle-dis
 runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -noelle-disable-dswp ;
 runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -noelle-disable-dswp -dswp-no-scc-merge ;
 
+# Test with at least 8 cores: the private copies of reduced variables are then combined with vector operations (see EnvBuilder::reduceLiveOutVariables)
+runningTestsWrapper -noelle-parallelizer-force -noelle-max-cores=8 -noelle-disable-dswp ;
+
+# Test the schedules of DOALL: static (1), dynamic (2), and guided (3)
+runningTestsWithDOALLSchedule 1 ;
+runningTestsWithDOALLSchedule 2 ;
+runningTestsWithDOALLSchedule 3 ;
+
+# Test DOALL loops executed by the persistent team of the runtime (see NOELLE_DOALL_TEAM)
+runningTestsWithRuntimeEnvironment NOELLE_DOALL_TEAM on ;
+
+# Test the versions of the loops generated by every technique, chosen at run time
+runningTestsWithTechnique DOALL ;
+runningTestsWithTechnique HELIX ;
+runningTestsWithTechnique DSWP ;
+
 cd ../ ;
 
 exit 0;
@@ -0,0 +1,183 @@
+/*
+ * Copyright 2016 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "AliasQueryCacheTestSuite.hpp"
+
+using namespace llvm;
+
+// Register pass to "opt"
+char AliasQueryCacheTestSuite::ID = 0;
+static RegisterPass<AliasQueryCacheTestSuite> X("UnitTester", "Alias Query Cache Unit Tester");
+
+// Register pass to "clang"
+static AliasQueryCacheTestSuite * _PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder&, legacy::PassManagerBase& PM) {
+        if(!_PassMaker){ PM.add(_PassMaker = new AliasQueryCacheTestSuite());}}); // ** for -Ox
+static RegisterStandardPasses _RegPass2(PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder&, legacy::PassManagerBase& PM) {
+        if(!_PassMaker){ PM.add(_PassMaker = new AliasQueryCacheTestSuite());}});// ** for -O0
+
+/*
+ * The tests send the queries of every pair of memory locations and of calls of main to the LLVM alias analyses through an AliasQueryCache.
+ */
+const char *AliasQueryCacheTestSuite::tests[] = {
+  "alias results of the memoization",
+  "symmetric alias queries memoized once",
+  "mod/ref queries of calls not symmetric",
+  "alias queries memoized by the PDG"
+};
+
+TestFunction AliasQueryCacheTestSuite::testFns[] = {
+  AliasQueryCacheTestSuite::aliasResultsOfMemoization,
+  AliasQueryCacheTestSuite::symmetricAliasQueriesAreMemoizedOnce,
+  AliasQueryCacheTestSuite::modRefQueriesOfCallsAreNotSymmetric,
+  AliasQueryCacheTestSuite::pdgMemoizesAliasQueries
+};
+
+bool AliasQueryCacheTestSuite::doInitialization (Module &M) {
+  errs() << "AliasQueryCacheTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite = new TestSuite("AliasQueryCacheTestSuite", tests, testFns, numTests, "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void AliasQueryCacheTestSuite::getAnalysisUsage (AnalysisUsage &AU) const {
+  AU.addRequired<AAResultsWrapperPass>();
+  AU.addRequired<PDGAnalysis>();
+}
+
+bool AliasQueryCacheTestSuite::runOnModule (Module &M) {
+  errs() << "AliasQueryCacheTestSuite: Start\n";
+
+  auto mainF = M.getFunction("main");
+  auto &pdgAnalysis = getAnalysis<PDGAnalysis>();
+  pdgAnalysis.getFunctionPDG(*mainF);
+  this->memoizedQueriesOfPDG = pdgAnalysis.getNumberOfMemoizedAliasQueries();
+  this->aa = &getAnalysis<AAResultsWrapperPass>(*mainF).getAAResults();
+
+  /*
+   * Collect the distinct memory locations accessed by main and its calls.
+   */
+  DenseSet<MemoryLocation> locationsSeen;
+  for (auto &inst : instructions(*mainF)) {
+    if (auto call = dyn_cast<CallBase>(&inst)) {
+      this->calls.push_back(call);
+      continue ;
+    }
+    if (  true
+          && !isa<LoadInst>(&inst)
+          && !isa<StoreInst>(&inst)
+       ) {
+      continue ;
+    }
+    auto location = MemoryLocation::get(&inst);
+    if (locationsSeen.insert(location).second) {
+      this->locations.push_back(location);
+    }
+  }
+
+  errs() << "AliasQueryCacheTestSuite: Running tests\n";
+  suite->runTests((ModulePass &)*this);
+
+  return false;
+}
+
+Values AliasQueryCacheTestSuite::aliasResultsOfMemoization (ModulePass &pass, TestSuite &suite) {
+  AliasQueryCacheTestSuite &cachePass = static_cast<AliasQueryCacheTestSuite &>(pass);
+  auto aa = cachePass.aa;
+
+  /*
+   * The answers of the cache must be those of the alias analyses, whether they are computed or memoized.
+   */
+  noelle::AliasQueryCache cache;
+  auto sameResults = true;
+  for (auto round = 0; round < 2; round++) {
+    for (auto &loc1 : cachePass.locations) {
+      for (auto &loc2 : cachePass.locations) {
+        auto result = cache.alias(loc1, loc2, [aa, &loc1, &loc2](void) { return aa->alias(loc1, loc2); });
+        if (result != aa->alias(loc1, loc2)) {
+          sameResults = false;
+        }
+      }
+    }
+    for (auto call : cachePass.calls) {
+      for (auto &loc : cachePass.locations) {
+        auto result = cache.getModRefInfo(call, loc, [aa, call, &loc](void) { return aa->getModRefInfo(call, loc); });
+        if (result != aa->getModRefInfo(call, loc)) {
+          sameResults = false;
+        }
+      }
+    }
+  }
+
+  Values valueNames;
+  valueNames.insert(sameResults ? "true" : "false");
+  return valueNames;
+}
+
+Values AliasQueryCacheTestSuite::symmetricAliasQueriesAreMemoizedOnce (ModulePass &pass, TestSuite &suite) {
+  AliasQueryCacheTestSuite &cachePass = static_cast<AliasQueryCacheTestSuite &>(pass);
+  auto aa = cachePass.aa;
+
+  /*
+   * Ask every ordered pair of distinct memory locations: only the first of the two orders reaches the alias analyses.
+   */
+  noelle::AliasQueryCache cache;
+  for (auto &loc1 : cachePass.locations) {
+    for (auto &loc2 : cachePass.locations) {
+      cache.alias(loc1, loc2, [aa, &loc1, &loc2](void) { return aa->alias(loc1, loc2); });
+    }
+  }
+  uint64_t n = cachePass.locations.size();
+  auto pairs = (n * (n + 1)) / 2;
+
+  Values valueNames;
+  valueNames.insert((true
+      && (n > 1)
+      && (cache.getNumberOfMisses() == pairs)
+      && (cache.getNumberOfHits() == ((n * n) - pairs))
+    ) ? "true" : "false");
+  return valueNames;
+}
+
+Values AliasQueryCacheTestSuite::modRefQueriesOfCallsAreNotSymmetric (ModulePass &pass, TestSuite &suite) {
+  AliasQueryCacheTestSuite &cachePass = static_cast<AliasQueryCacheTestSuite &>(pass);
+  auto aa = cachePass.aa;
+
+  /*
+   * Ask every ordered pair of calls twice: both orders reach the alias analyses once.
+   */
+  noelle::AliasQueryCache cache;
+  for (auto round = 0; round < 2; round++) {
+    for (auto call1 : cachePass.calls) {
+      for (auto call2 : cachePass.calls) {
+        cache.getModRefInfo(call1, call2, [aa, call1, call2](void) { return aa->getModRefInfo(call1, call2); });
+      }
+    }
+  }
+  uint64_t n = cachePass.calls.size();
+
+  Values valueNames;
+  valueNames.insert((true
+      && (n > 1)
+      && (cache.getNumberOfMisses() == (n * n))
+      && (cache.getNumberOfHits() == (n * n))
+    ) ? "true" : "false");
+  return valueNames;
+}
+
+Values AliasQueryCacheTestSuite::pdgMemoizesAliasQueries (ModulePass &pass, TestSuite &suite) {
+  AliasQueryCacheTestSuite &cachePass = static_cast<AliasQueryCacheTestSuite &>(pass);
+  Values valueNames;
+  valueNames.insert(cachePass.memoizedQueriesOfPDG > 0 ? "true" : "false");
+  return valueNames;
+}
@@ -0,0 +1,25 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+static void increment (int *p){
+  (*p)++;
+}
+
+int main (int argc, char *argv[]){
+  auto a = (int *)malloc(sizeof(int) * 100);
+  auto b = (int *)malloc(sizeof(int) * 100);
+  for (auto i = 0; i < 100; i++){
+    a[i] = argc + i;
+    b[i] = a[i] * 2;
+    a[i] = b[i] + a[i];
+  }
+
+  /*
+   * The calls access the memory of both arrays.
+   */
+  increment(&a[argc]);
+  increment(&b[argc]);
+
+  printf("%d %d\n", a[5], b[5]);
+  return 0;
+}
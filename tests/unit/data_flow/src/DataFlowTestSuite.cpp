@@ -0,0 +1,491 @@
+/*
+ * Copyright 2016 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DataFlowTestSuite.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+// Register pass to "opt"
+char DataFlowTestSuite::ID = 0;
+static RegisterPass<DataFlowTestSuite> X("UnitTester", "Data-Flow Unit Tester");
+
+// Register pass to "clang"
+static DataFlowTestSuite * _PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder&, legacy::PassManagerBase& PM) {
+        if(!_PassMaker){ PM.add(_PassMaker = new DataFlowTestSuite());}}); // ** for -Ox
+static RegisterStandardPasses _RegPass2(PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder&, legacy::PassManagerBase& PM) {
+        if(!_PassMaker){ PM.add(_PassMaker = new DataFlowTestSuite());}});// ** for -O0
+
+/*
+ * The tests solve GEN/KILL problems on main with the dense engine, storing the sets of every instruction or only those at the boundaries of basic blocks.
+ * Their results are compared with the solution computed by iterating the data-flow equations on every instruction until nothing changes.
+ */
+const char *DataFlowTestSuite::tests[] = {
+  "reaching stores",
+  "available loads",
+  "live values",
+  "sets of dense results",
+  "reaching stores at basic block boundaries",
+  "available loads at basic block boundaries",
+  "live values at basic block boundaries",
+  "reachable instructions"
+};
+
+TestFunction DataFlowTestSuite::testFns[] = {
+  DataFlowTestSuite::reachingStoresOfDenseEngine,
+  DataFlowTestSuite::availableLoadsOfDenseEngine,
+  DataFlowTestSuite::liveValuesOfDenseEngine,
+  DataFlowTestSuite::setsOfDenseResult,
+  DataFlowTestSuite::reachingStoresAtBasicBlockBoundaries,
+  DataFlowTestSuite::availableLoadsAtBasicBlockBoundaries,
+  DataFlowTestSuite::liveValuesAtBasicBlockBoundaries,
+  DataFlowTestSuite::reachableInstructions
+};
+
+namespace {
+
+  typedef std::function<void (Instruction *, DataFlowResult *)> TransferFunction;
+
+  typedef std::unordered_map<Instruction *, std::set<Value *>> Sets;
+
+  /*
+   * Return the pointer accessed by @inst or nullptr if @inst is neither a load nor a store.
+   */
+  Value * pointerOf (Instruction *inst) {
+    if (auto load = dyn_cast<LoadInst>(inst)) {
+      return load->getPointerOperand();
+    }
+    if (auto store = dyn_cast<StoreInst>(inst)) {
+      return store->getPointerOperand();
+    }
+    return nullptr;
+  }
+
+  /*
+   * Reaching stores: a store kills the other stores to the same pointer.
+   */
+  void genOfReachingStores (Instruction *inst, DataFlowResult *df) {
+    if (isa<StoreInst>(inst)) {
+      df->GEN(inst).insert(inst);
+    }
+  }
+
+  void killOfReachingStores (Instruction *inst, DataFlowResult *df) {
+    if (!isa<StoreInst>(inst)) {
+      return ;
+    }
+    for (auto &other : instructions(*inst->getFunction())) {
+      if (  true
+            && (&other != inst)
+            && isa<StoreInst>(&other)
+            && (pointerOf(&other) == pointerOf(inst))
+         ) {
+        df->KILL(inst).insert(&other);
+      }
+    }
+  }
+
+  /*
+   * Available loads: a store kills the loads from the same pointer.
+   */
+  void genOfAvailableLoads (Instruction *inst, DataFlowResult *df) {
+    if (isa<LoadInst>(inst)) {
+      df->GEN(inst).insert(inst);
+    }
+  }
+
+  void killOfAvailableLoads (Instruction *inst, DataFlowResult *df) {
+    if (!isa<StoreInst>(inst)) {
+      return ;
+    }
+    for (auto &other : instructions(*inst->getFunction())) {
+      if (  true
+            && isa<LoadInst>(&other)
+            && (pointerOf(&other) == pointerOf(inst))
+         ) {
+        df->KILL(inst).insert(&other);
+      }
+    }
+  }
+
+  /*
+   * Live values: an instruction uses its operands and defines itself.
+   */
+  void genOfLiveValues (Instruction *inst, DataFlowResult *df) {
+    for (auto &use : inst->operands()) {
+      if (isa<Instruction>(use.get())) {
+        df->GEN(inst).insert(use.get());
+      }
+    }
+  }
+
+  void killOfLiveValues (Instruction *inst, DataFlowResult *df) {
+    df->KILL(inst).insert(inst);
+  }
+
+  /*
+   * Solve the GEN/KILL problem of @f by iterating its equations on every instruction until nothing changes.
+   * IN and OUT are stored in @ins and @outs.
+   */
+  void solveIteratively (
+    Function *f,
+    TransferFunction computeGEN,
+    TransferFunction computeKILL,
+    bool isForward,
+    bool meetIsIntersection,
+    Sets &ins,
+    Sets &outs
+    ) {
+
+    /*
+     * Compute GEN and KILL, and the universe of the values.
+     */
+    DataFlowResult genAndKill;
+    std::set<Value *> universe;
+    for (auto &inst : instructions(*f)) {
+      computeGEN(&inst, &genAndKill);
+      computeKILL(&inst, &genAndKill);
+      universe.insert(genAndKill.GEN(&inst).begin(), genAndKill.GEN(&inst).end());
+      universe.insert(genAndKill.KILL(&inst).begin(), genAndKill.KILL(&inst).end());
+    }
+
+    /*
+     * Fetch the instructions whose sets flow into @inst.
+     */
+    auto flowingInto = [isForward](Instruction *inst) -> std::vector<Instruction *> {
+      std::vector<Instruction *> instructions;
+      auto bb = inst->getParent();
+      if (isForward) {
+        if (inst != &*bb->begin()) {
+          instructions.push_back(inst->getPrevNode());
+          return instructions;
+        }
+        for (auto predecessorBB : predecessors(bb)) {
+          instructions.push_back(predecessorBB->getTerminator());
+        }
+        return instructions;
+      }
+      if (inst != bb->getTerminator()) {
+        instructions.push_back(inst->getNextNode());
+        return instructions;
+      }
+      for (auto successorBB : successors(bb)) {
+        instructions.push_back(&*successorBB->begin());
+      }
+      return instructions;
+    };
+
+    /*
+     * Initialize the sets.
+     */
+    for (auto &inst : instructions(*f)) {
+      ins[&inst];
+      outs[&inst];
+      if (meetIsIntersection) {
+        outs[&inst] = universe;
+      }
+    }
+
+    /*
+     * Iterate the equations.
+     */
+    auto changed = true;
+    while (changed) {
+      changed = false;
+      for (auto &inst : instructions(*f)) {
+        auto &gen = genAndKill.GEN(&inst);
+        auto &kill = genAndKill.KILL(&inst);
+
+        /*
+         * Meet the sets flowing into the instruction.
+         */
+        std::set<Value *> meet;
+        auto isFirst = true;
+        for (auto other : flowingInto(&inst)) {
+          auto &otherSet = isForward ? outs[other] : ins[other];
+          if (  false
+                || !meetIsIntersection
+                || isFirst
+             ) {
+            meet.insert(otherSet.begin(), otherSet.end());
+          } else {
+            std::set<Value *> intersection;
+            std::set_intersection(meet.begin(), meet.end(), otherSet.begin(), otherSet.end(), std::inserter(intersection, intersection.begin()));
+            meet = intersection;
+          }
+          isFirst = false;
+        }
+
+        /*
+         * Apply the transfer function: GEN U (meet - KILL).
+         */
+        std::set<Value *> transferred(gen.begin(), gen.end());
+        for (auto v : meet) {
+          if (kill.find(v) == kill.end()) {
+            transferred.insert(v);
+          }
+        }
+
+        auto &meetSet = isForward ? ins[&inst] : outs[&inst];
+        auto &transferredSet = isForward ? outs[&inst] : ins[&inst];
+        if (  false
+              || (meetSet != meet)
+              || (transferredSet != transferred)
+           ) {
+          meetSet = meet;
+          transferredSet = transferred;
+          changed = true;
+        }
+      }
+    }
+  }
+
+  std::set<Value *> valuesOf (DataFlowResult *df, BitVector &bits) {
+    std::set<Value *> values;
+    for (auto index : bits.set_bits()) {
+      values.insert(df->getValueOfIndex(index));
+    }
+    return values;
+  }
+
+  /*
+   * Check the IN and OUT bit vectors of every instruction of @f against @ins and @outs.
+   * The instructions are visited in the order given by @instructionsToCheck.
+   */
+  bool haveSameSets (
+    DataFlowResult *df,
+    std::vector<Instruction *> const &instructionsToCheck,
+    Sets &ins,
+    Sets &outs
+    ) {
+    for (auto inst : instructionsToCheck) {
+      if (valuesOf(df, df->INBits(inst)) != ins[inst]) {
+        errs() << "DataFlowTestSuite: IN differs for " << *inst << "\n";
+        return false;
+      }
+      if (valuesOf(df, df->OUTBits(inst)) != outs[inst]) {
+        errs() << "DataFlowTestSuite: OUT differs for " << *inst << "\n";
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /*
+   * Check the IN and OUT bit vectors of every basic block of @f against the sets of its first instruction and of its terminator.
+   */
+  bool haveSameBasicBlockSets (
+    DataFlowResult *df,
+    Function *f,
+    Sets &ins,
+    Sets &outs
+    ) {
+    for (auto &bb : *f) {
+      if (  false
+            || (valuesOf(df, df->INBits(&bb)) != ins[&*bb.begin()])
+            || (valuesOf(df, df->OUTBits(&bb)) != outs[bb.getTerminator()])
+         ) {
+        errs() << "DataFlowTestSuite: the sets of a basic block differ\n";
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::vector<Instruction *> instructionsOf (Function *f) {
+    std::vector<Instruction *> insts;
+    for (auto &inst : instructions(*f)) {
+      insts.push_back(&inst);
+    }
+    return insts;
+  }
+
+  /*
+   * Return the instructions of @f in an order that jumps among basic blocks at every query: the first instruction of every basic block, then the second one, and so on.
+   * Then, the instructions of @f in reverse order.
+   * If the sets are stored only at the boundaries of basic blocks, this order rebuilds the sets of more basic blocks than those kept by the result.
+   */
+  std::vector<Instruction *> instructionsAcrossBasicBlocksOf (Function *f) {
+    std::vector<Instruction *> insts;
+    for (auto position = 0; ; position++) {
+      auto added = false;
+      for (auto &bb : *f) {
+        if (position >= bb.size()) {
+          continue ;
+        }
+        insts.push_back(&*std::next(bb.begin(), position));
+        added = true;
+      }
+      if (!added) {
+        break ;
+      }
+    }
+    auto instsInOrder = instructionsOf(f);
+    insts.insert(insts.end(), instsInOrder.rbegin(), instsInOrder.rend());
+    return insts;
+  }
+
+  /*
+   * Solve a GEN/KILL problem with the dense engine and check its solution.
+   */
+  Values checkDenseEngine (
+    Function *f,
+    TransferFunction computeGEN,
+    TransferFunction computeKILL,
+    bool isForward,
+    bool meetIsIntersection,
+    bool onlyBasicBlockBoundaries
+    ) {
+    Sets ins, outs;
+    solveIteratively(f, computeGEN, computeKILL, isForward, meetIsIntersection, ins, outs);
+
+    DataFlowEngine dfe;
+    auto df = isForward
+      ? dfe.applyForwardUsingBitVectors(f, computeGEN, computeKILL, meetIsIntersection, onlyBasicBlockBoundaries)
+      : dfe.applyBackwardUsingBitVectors(f, computeGEN, computeKILL, onlyBasicBlockBoundaries);
+    auto sameSets = haveSameSets(df, instructionsOf(f), ins, outs);
+    if (onlyBasicBlockBoundaries) {
+      sameSets &= haveSameSets(df, instructionsAcrossBasicBlocksOf(f), ins, outs);
+      sameSets &= haveSameBasicBlockSets(df, f, ins, outs);
+    }
+    delete df;
+
+    Values valueNames;
+    valueNames.insert(sameSets ? "true" : "false");
+    return valueNames;
+  }
+}
+
+bool DataFlowTestSuite::doInitialization (Module &M) {
+  errs() << "DataFlowTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite = new TestSuite("DataFlowTestSuite", tests, testFns, numTests, "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void DataFlowTestSuite::getAnalysisUsage (AnalysisUsage &AU) const {
+  return ;
+}
+
+bool DataFlowTestSuite::runOnModule (Module &M) {
+  errs() << "DataFlowTestSuite: Start\n";
+
+  this->mainF = M.getFunction("main");
+
+  errs() << "DataFlowTestSuite: Running tests\n";
+  suite->runTests((ModulePass &)*this);
+
+  return false;
+}
+
+Values DataFlowTestSuite::reachingStoresOfDenseEngine (ModulePass &pass, TestSuite &suite) {
+  DataFlowTestSuite &dfPass = static_cast<DataFlowTestSuite &>(pass);
+  return checkDenseEngine(dfPass.mainF, genOfReachingStores, killOfReachingStores, true, false, false);
+}
+
+Values DataFlowTestSuite::availableLoadsOfDenseEngine (ModulePass &pass, TestSuite &suite) {
+  DataFlowTestSuite &dfPass = static_cast<DataFlowTestSuite &>(pass);
+  return checkDenseEngine(dfPass.mainF, genOfAvailableLoads, killOfAvailableLoads, true, true, false);
+}
+
+Values DataFlowTestSuite::liveValuesOfDenseEngine (ModulePass &pass, TestSuite &suite) {
+  DataFlowTestSuite &dfPass = static_cast<DataFlowTestSuite &>(pass);
+  return checkDenseEngine(dfPass.mainF, genOfLiveValues, killOfLiveValues, false, false, false);
+}
+
+Values DataFlowTestSuite::setsOfDenseResult (ModulePass &pass, TestSuite &suite) {
+  DataFlowTestSuite &dfPass = static_cast<DataFlowTestSuite &>(pass);
+  auto f = dfPass.mainF;
+
+  /*
+   * The set-based API of a dense result must return the sets of its bit vectors.
+   * The second round checks that every set has been stored with its instruction: the references returned by the first round must still be valid.
+   */
+  Sets ins, outs;
+  solveIteratively(f, genOfLiveValues, killOfLiveValues, false, false, ins, outs);
+  DataFlowEngine dfe;
+  auto sameSets = true;
+  for (auto onlyBasicBlockBoundaries : { false, true }) {
+    auto df = dfe.applyBackwardUsingBitVectors(f, genOfLiveValues, killOfLiveValues, onlyBasicBlockBoundaries);
+    std::unordered_map<Instruction *, std::set<Value *> *> setsOfFirstRound;
+    for (auto round = 0; round < 2; round++) {
+      for (auto &inst : instructions(*f)) {
+        auto &in = df->IN(&inst);
+        auto &out = df->OUT(&inst);
+        if (  false
+              || (in != ins[&inst])
+              || (out != outs[&inst])
+           ) {
+          sameSets = false;
+        }
+        if (round == 0) {
+          setsOfFirstRound[&inst] = &in;
+        } else if (setsOfFirstRound[&inst] != &in) {
+          sameSets = false;
+        }
+      }
+    }
+    delete df;
+  }
+
+  Values valueNames;
+  valueNames.insert(sameSets ? "true" : "false");
+  return valueNames;
+}
+
+Values DataFlowTestSuite::reachingStoresAtBasicBlockBoundaries (ModulePass &pass, TestSuite &suite) {
+  DataFlowTestSuite &dfPass = static_cast<DataFlowTestSuite &>(pass);
+  return checkDenseEngine(dfPass.mainF, genOfReachingStores, killOfReachingStores, true, false, true);
+}
+
+Values DataFlowTestSuite::availableLoadsAtBasicBlockBoundaries (ModulePass &pass, TestSuite &suite) {
+  DataFlowTestSuite &dfPass = static_cast<DataFlowTestSuite &>(pass);
+  return checkDenseEngine(dfPass.mainF, genOfAvailableLoads, killOfAvailableLoads, true, true, true);
+}
+
+Values DataFlowTestSuite::liveValuesAtBasicBlockBoundaries (ModulePass &pass, TestSuite &suite) {
+  DataFlowTestSuite &dfPass = static_cast<DataFlowTestSuite &>(pass);
+  return checkDenseEngine(dfPass.mainF, genOfLiveValues, killOfLiveValues, false, false, true);
+}
+
+Values DataFlowTestSuite::reachableInstructions (ModulePass &pass, TestSuite &suite) {
+  DataFlowTestSuite &dfPass = static_cast<DataFlowTestSuite &>(pass);
+  auto f = dfPass.mainF;
+
+  /*
+   * The instructions reachable from an instruction are those in OUT, which is what the PDG queries.
+   */
+  auto genOfReachability = [](Instruction *inst, DataFlowResult *df) {
+    df->GEN(inst).insert(inst);
+  };
+  auto noKill = [](Instruction *inst, DataFlowResult *df) {
+    return ;
+  };
+  Sets ins, outs;
+  solveIteratively(f, genOfReachability, noKill, false, false, ins, outs);
+
+  DataFlowAnalysis dfa;
+  auto df = dfa.runReachableAnalysis(f);
+  auto sameSets = true;
+  for (auto inst : instructionsAcrossBasicBlocksOf(f)) {
+    if (valuesOf(df, df->OUTBits(inst)) != outs[inst]) {
+      sameSets = false;
+    }
+  }
+  delete df;
+
+  Values valueNames;
+  valueNames.insert(sameSets ? "true" : "false");
+  return valueNames;
+}
@@ -0,0 +1,30 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+static int G;
+static int H;
+
+int main (int argc, char *argv[]){
+  int a[10];
+  for (auto i = 0; i < 10; i++){
+    a[i] = i;
+  }
+
+  G = argc;
+  for (auto i = 0; i < argc * 10; i++){
+    if ((i % 3) == 0){
+      G = G + a[i % 10];
+      H = G;
+    } else if ((i % 3) == 1){
+      H = H + a[(i + 1) % 10];
+    } else {
+      for (auto j = 0; j < i; j++){
+        G = G - H;
+      }
+    }
+    a[i % 10] = G + H;
+  }
+
+  printf("%d %d %d\n", G, H, a[3]);
+  return 0;
+}
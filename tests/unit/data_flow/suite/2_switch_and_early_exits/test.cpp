@@ -0,0 +1,43 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+static int G;
+static int H;
+
+int main (int argc, char *argv[]){
+  int a[10];
+  for (auto i = 0; i < 10; i++){
+    a[i] = argc;
+  }
+
+  auto i = 0;
+  while (true){
+    switch (a[i % 10] % 4){
+      case 0:
+        G = a[i % 10];
+        break ;
+      case 1:
+        H = G;
+        a[i % 10] = H + 2;
+        break ;
+      case 2:
+        if (G > 100){
+          printf("%d\n", G);
+          return 0;
+        }
+        G = G + H;
+        a[i % 10] = G;
+        break ;
+      default:
+        H = H + 1;
+        a[i % 10]++;
+    }
+    if (i > 1000){
+      break ;
+    }
+    i++;
+  }
+
+  printf("%d %d\n", G, H);
+  return 0;
+}
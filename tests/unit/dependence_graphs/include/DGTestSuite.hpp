@@ -20,6 +20,8 @@
 #include "noelle/core/SCC.hpp"
 #include "noelle/core/SCCDAG.hpp"
 #include "noelle/core/PDGAnalysis.hpp"
+#include "noelle/core/DGGraphTraits.hpp"
+#include "llvm/ADT/SCCIterator.h"
 #include "TestSuite.hpp"
 
 #include <sstream>
@@ -55,6 +57,9 @@ namespace llvm {
       static Values pdgIdentifiesDisconnectedValueSets (ModulePass &pass, TestSuite &suite) ;
       static Values sccdagInternalNodesOfOutermostLoop (ModulePass &pass, TestSuite &suite) ;
       static Values sccdagExternalNodesOfOutermostLoop (ModulePass &pass, TestSuite &suite) ;
+      static Values dgRemovesNodesWhileIterating (ModulePass &pass, TestSuite &suite) ;
+      static Values dgCompactsStorageAfterRemovals (ModulePass &pass, TestSuite &suite) ;
+      static Values sccdagOfDisconnectedComponents (ModulePass &pass, TestSuite &suite) ;
 
       Values getSCCValues(std::set<SCC *> sccs) ;
 
@@ -33,7 +33,10 @@ const char *DGTestSuite::tests[] = {
   "pdg leaf values",
   "pdg disjoint values",
   "sccdag internal nodes (of outermost loop)",
-  "sccdag external nodes (of outermost loop)"
+  "sccdag external nodes (of outermost loop)",
+  "dg removal while iterating",
+  "dg compaction after removals",
+  "sccdag of disconnected components"
 };
 
 TestFunction DGTestSuite::testFns[] = {
@@ -44,9 +47,81 @@ TestFunction DGTestSuite::testFns[] = {
   DGTestSuite::pdgIdentifiesLeafValues,
   DGTestSuite::pdgIdentifiesDisconnectedValueSets,
   DGTestSuite::sccdagInternalNodesOfOutermostLoop,
-  DGTestSuite::sccdagExternalNodesOfOutermostLoop
+  DGTestSuite::sccdagExternalNodesOfOutermostLoop,
+  DGTestSuite::dgRemovesNodesWhileIterating,
+  DGTestSuite::dgCompactsStorageAfterRemovals,
+  DGTestSuite::sccdagOfDisconnectedComponents
 };
 
+namespace {
+
+  /*
+   * Dependence graph that exposes the number of slots used to store its nodes and edges.
+   */
+  class DGWithStorageSlots : public DG<Value> {
+    public:
+      uint64_t numberOfNodeSlots (void) const { return this->allNodes.size(); }
+      uint64_t numberOfEdgeSlots (void) const { return this->allEdges.size(); }
+  };
+
+  /*
+   * Create a graph whose nodes are the constants 0 to @numberOfNodes - 1.
+   * The constants are unique within the context, so they identify the nodes.
+   */
+  void addConstantNodes (DGWithStorageSlots &graph, Module &M, int64_t firstConstant, int64_t numberOfNodes) {
+    auto intType = Type::getInt64Ty(M.getContext());
+    for (auto i = firstConstant; i < (firstConstant + numberOfNodes); i++) {
+      graph.addNode(ConstantInt::get(intType, i), /*inclusion=*/ true);
+    }
+  }
+
+  Value * constantOf (Module &M, int64_t i) {
+    return ConstantInt::get(Type::getInt64Ty(M.getContext()), i);
+  }
+
+  int64_t valueOf (DGNode<Value> *node) {
+    return cast<ConstantInt>(node->getT())->getSExtValue();
+  }
+
+  /*
+   * Name a set of constants by listing them in increasing order.
+   */
+  std::string nameOfConstants (std::set<int64_t> const &constants) {
+    std::string name;
+    for (auto c : constants) {
+      name += (name.empty() ? "" : ",") + std::to_string(c);
+    }
+    return name;
+  }
+
+  /*
+   * Compute the SCCs of @pdg the way the SCCDAG used to: by restarting scc_iterator from every node that has not been visited yet.
+   */
+  std::set<std::string> computeSCCsWithSCCIterator (PDG *pdg) {
+    std::set<std::string> sccs;
+    std::set<DGNode<Value> *> visited;
+    auto originalEntryNode = pdg->getEntryNode();
+    for (auto nodeToVisit : pdg->getNodes()) {
+      if (visited.find(nodeToVisit) != visited.end()) continue;
+      pdg->setEntryNode(nodeToVisit);
+      DGGraphWrapper<PDG, Value> pdgWrapper(pdg);
+      for (auto pdgI = scc_begin(&pdgWrapper); pdgI != scc_end(&pdgWrapper); ++pdgI) {
+        auto &sccNodes = *pdgI;
+        if (visited.find((*sccNodes.begin())->wrappedNode) != visited.end()) continue;
+        std::set<int64_t> constants;
+        for (auto sccNode : sccNodes) {
+          visited.insert(sccNode->wrappedNode);
+          constants.insert(valueOf(sccNode->wrappedNode));
+        }
+        sccs.insert(nameOfConstants(constants));
+      }
+    }
+    pdg->setEntryNode(originalEntryNode);
+
+    return sccs;
+  }
+}
+
 bool DGTestSuite::doInitialization (Module &M) {
   errs() << "DGTestSuite: Initialize\n";
   const int numTests = sizeof(tests) / sizeof(tests[0]);
@@ -188,4 +263,230 @@ Values DGTestSuite::getSCCValues(std::set<SCC *> sccs) {
     sccStrings.insert(valuesDelimited);
   }
   return sccStrings;
-}
\ No newline at end of file
+}
+
+Values DGTestSuite::dgRemovesNodesWhileIterating (ModulePass &pass, TestSuite &suite) {
+  DGTestSuite &dgPass = static_cast<DGTestSuite &>(pass);
+  auto &M = *dgPass.M;
+
+  /*
+   * Create the graph: the node k depends on the node k - 2.
+   */
+  DGWithStorageSlots graph;
+  addConstantNodes(graph, M, 0, 200);
+  for (auto k = 0; k < 198; k++) {
+    graph.addEdge(constantOf(M, k), constantOf(M, k + 2));
+  }
+
+  /*
+   * Remove nodes while iterating over the graph.
+   * Even nodes are removed when they are visited.
+   * Some odd nodes remove a node that has not been visited yet.
+   */
+  Values results;
+  int64_t visitedNodes = 0;
+  int64_t lastVisited = -1;
+  auto inOrder = true;
+  for (auto node : graph.getNodes()) {
+    auto k = valueOf(node);
+    visitedNodes++;
+    inOrder &= (k > lastVisited);
+    lastVisited = k;
+
+    if ((k % 2) == 0) {
+      graph.removeNode(node);
+    } else if ((k % 10) == 1) {
+      graph.removeNode(graph.fetchNode(constantOf(M, k + 2)));
+    }
+  }
+  results.insert("visited nodes: " + std::to_string(visitedNodes));
+  results.insert(inOrder ? "nodes visited in insertion order" : "nodes not visited in insertion order");
+
+  /*
+   * Check the graph left after the iteration.
+   */
+  results.insert("nodes: " + std::to_string(graph.numNodes()));
+  results.insert("edges: " + std::to_string(graph.numEdges()));
+  results.insert("node slots: " + std::to_string(graph.numberOfNodeSlots()));
+  auto consistent = true;
+  for (auto k = 0; k < 200; k++) {
+    auto isLive = ((k % 2) == 1) && ((k % 10) != 3);
+    auto node = graph.fetchNode(constantOf(M, k));
+    consistent &= (isLive == (node != nullptr));
+  }
+  for (auto edge : graph.getEdges()) {
+    auto from = valueOf(edge->getOutgoingNode());
+    auto to = valueOf(edge->getIncomingNode());
+    consistent &= (to == (from + 2));
+    consistent &= (graph.fetchNode(constantOf(M, from)) == edge->getOutgoingNode());
+    consistent &= (graph.fetchNode(constantOf(M, to)) == edge->getIncomingNode());
+  }
+  results.insert(consistent ? "live nodes and edges are consistent" : "live nodes and edges are inconsistent");
+
+  return results;
+}
+
+Values DGTestSuite::dgCompactsStorageAfterRemovals (ModulePass &pass, TestSuite &suite) {
+  DGTestSuite &dgPass = static_cast<DGTestSuite &>(pass);
+  auto &M = *dgPass.M;
+  Values results;
+
+  /*
+   * Create a chain of nodes and remove most of them once the graph has been built.
+   */
+  DGWithStorageSlots graph;
+  addConstantNodes(graph, M, 0, 200);
+  for (auto k = 0; k < 199; k++) {
+    graph.addEdge(constantOf(M, k), constantOf(M, k + 1));
+  }
+  for (auto k = 0; k < 150; k++) {
+    graph.removeNode(graph.fetchNode(constantOf(M, k)));
+  }
+  results.insert("nodes after removals: " + std::to_string(graph.numNodes()));
+  results.insert("edges after removals: " + std::to_string(graph.numEdges()));
+  results.insert("node slots after removals: " + std::to_string(graph.numberOfNodeSlots()));
+  results.insert("edge slots after removals: " + std::to_string(graph.numberOfEdgeSlots()));
+
+  /*
+   * Removed nodes and edges now outnumber the live ones, so adding to the graph compacts its storage.
+   */
+  graph.addNode(constantOf(M, 200), /*inclusion=*/ true);
+  graph.addEdge(constantOf(M, 199), constantOf(M, 200));
+  results.insert("nodes after compaction: " + std::to_string(graph.numNodes()));
+  results.insert("edges after compaction: " + std::to_string(graph.numEdges()));
+  results.insert("node slots after compaction: " + std::to_string(graph.numberOfNodeSlots()));
+  results.insert("edge slots after compaction: " + std::to_string(graph.numberOfEdgeSlots()));
+
+  /*
+   * Compaction must preserve the insertion order, the lookup of nodes, and the dependences.
+   */
+  auto expected = 150;
+  auto consistent = true;
+  for (auto node : graph.getNodes()) {
+    consistent &= (valueOf(node) == expected);
+    consistent &= (graph.fetchNode(node->getT()) == node);
+    expected++;
+  }
+  consistent &= (expected == 201);
+  expected = 150;
+  for (auto edge : graph.getEdges()) {
+    consistent &= (valueOf(edge->getOutgoingNode()) == expected);
+    consistent &= (valueOf(edge->getIncomingNode()) == (expected + 1));
+    expected++;
+  }
+  consistent &= (expected == 200);
+  results.insert(consistent ? "compacted graph is consistent" : "compacted graph is inconsistent");
+
+  /*
+   * The storage is compacted only when the removed nodes are at least 64 and they are at least as many as the live ones.
+   */
+  for (auto removedNodes : { 63, 99, 100 }) {
+    DGWithStorageSlots otherGraph;
+    addConstantNodes(otherGraph, M, 0, 200);
+    for (auto k = 0; k < removedNodes; k++) {
+      otherGraph.removeNode(otherGraph.fetchNode(constantOf(M, k)));
+    }
+    otherGraph.addNode(constantOf(M, 200), /*inclusion=*/ true);
+    results.insert("node slots after removing " + std::to_string(removedNodes) + " of 200 nodes and adding one: " + std::to_string(otherGraph.numberOfNodeSlots()));
+  }
+
+  return results;
+}
+
+Values DGTestSuite::sccdagOfDisconnectedComponents (ModulePass &pass, TestSuite &suite) {
+  DGTestSuite &dgPass = static_cast<DGTestSuite &>(pass);
+  auto &M = *dgPass.M;
+
+  /*
+   * Create a PDG made of many disconnected components of different shapes: isolated nodes, self loops, chains, rings, and chains with a back edge.
+   * A few dependences connect some of the components so that the SCCDAG has edges as well.
+   */
+  std::vector<Value *> values;
+  for (auto i = 0; i < 400; i++) {
+    values.push_back(constantOf(M, i));
+  }
+  auto pdg = new PDG(values);
+  int64_t firstNode = 0;
+  std::vector<int64_t> firstNodeOfComponents;
+  for (auto component = 0; firstNode < 400; component++) {
+    auto size = std::min<int64_t>((component % 7) + 1, 400 - firstNode);
+    firstNodeOfComponents.push_back(firstNode);
+    for (auto i = firstNode; i < (firstNode + size - 1); i++) {
+      pdg->addEdge(values[i], values[i + 1]);
+    }
+    switch (component % 4) {
+      case 0:
+        break ;
+      case 1:
+        pdg->addEdge(values[firstNode + size - 1], values[firstNode]);
+        break ;
+      case 2:
+        pdg->addEdge(values[firstNode + size - 1], values[firstNode + (size / 2)]);
+        break ;
+      case 3:
+        pdg->addEdge(values[firstNode], values[firstNode]);
+        break ;
+    }
+    firstNode += size;
+  }
+  for (auto i = 0u; (i + 5) < firstNodeOfComponents.size(); i += 10) {
+    pdg->addEdge(values[firstNodeOfComponents[i + 5]], values[firstNodeOfComponents[i]]);
+  }
+
+  /*
+   * Compute the SCCs with the SCCDAG and with scc_iterator.
+   */
+  auto sccdag = new SCCDAG(pdg);
+  auto expectedSCCs = computeSCCsWithSCCIterator(pdg);
+  std::set<std::string> sccs;
+  std::unordered_map<int64_t, std::string> sccOfConstant;
+  auto eachValueInOneSCC = true;
+  for (auto sccNode : sccdag->getNodes()) {
+    std::set<int64_t> constants;
+    for (auto valuePair : sccNode->getT()->internalNodePairs()) {
+      constants.insert(cast<ConstantInt>(valuePair.first)->getSExtValue());
+    }
+    auto name = nameOfConstants(constants);
+    sccs.insert(name);
+    for (auto c : constants) {
+      eachValueInOneSCC &= sccOfConstant.insert(std::make_pair(c, name)).second;
+      eachValueInOneSCC &= (sccdag->sccOfValue(constantOf(M, c)) == sccNode->getT());
+    }
+  }
+  eachValueInOneSCC &= (sccOfConstant.size() == values.size());
+
+  /*
+   * The SCCDAG must have exactly one edge for each pair of SCCs connected by a dependence.
+   */
+  std::set<std::string> expectedEdges;
+  for (auto edge : pdg->getEdges()) {
+    auto from = sccOfConstant[valueOf(edge->getOutgoingNode())];
+    auto to = sccOfConstant[valueOf(edge->getIncomingNode())];
+    if (from == to) continue;
+    expectedEdges.insert(from + " -> " + to);
+  }
+  std::set<std::string> edges;
+  auto edgesAreUnique = true;
+  for (auto edge : sccdag->getEdges()) {
+    std::set<int64_t> fromConstants, toConstants;
+    for (auto valuePair : edge->getOutgoingT()->internalNodePairs()) {
+      fromConstants.insert(cast<ConstantInt>(valuePair.first)->getSExtValue());
+    }
+    for (auto valuePair : edge->getIncomingT()->internalNodePairs()) {
+      toConstants.insert(cast<ConstantInt>(valuePair.first)->getSExtValue());
+    }
+    edgesAreUnique &= edges.insert(nameOfConstants(fromConstants) + " -> " + nameOfConstants(toConstants)).second;
+  }
+
+  Values results;
+  results.insert("sccs: " + std::to_string(sccs.size()));
+  results.insert("sccdag edges: " + std::to_string(edges.size()));
+  results.insert((sccs == expectedSCCs) ? "sccs match scc_iterator" : "sccs do not match scc_iterator");
+  results.insert(eachValueInOneSCC ? "each value belongs to one scc" : "some value does not belong to exactly one scc");
+  results.insert(((edges == expectedEdges) && edgesAreUnique) ? "sccdag edges match the dependences between sccs" : "sccdag edges do not match the dependences between sccs");
+
+  delete sccdag;
+  delete pdg;
+
+  return results;
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2016 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "PDGCacheTestSuite.hpp"
+
+using namespace llvm;
+
+// Register pass to "opt"
+char PDGCacheTestSuite::ID = 0;
+static RegisterPass<PDGCacheTestSuite> X("UnitTester", "PDG Cache Unit Tester");
+
+// Register pass to "clang"
+static PDGCacheTestSuite * _PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder&, legacy::PassManagerBase& PM) {
+        if(!_PassMaker){ PM.add(_PassMaker = new PDGCacheTestSuite());}}); // ** for -Ox
+static RegisterStandardPasses _RegPass2(PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder&, legacy::PassManagerBase& PM) {
+        if(!_PassMaker){ PM.add(_PassMaker = new PDGCacheTestSuite());}});// ** for -O0
+
+/*
+ * The tests of the suite share the same cache of dependences (see ../options.info) and they run in alphabetical order.
+ * They have the same callee, but different callers: a cached callee must not be reused when only its caller changes.
+ * The last test changes only a function that cannot affect the callee: the cached callee must be reused.
+ * SVF is disabled (see ../options.info) because it makes the dependences of a function rely on the whole module.
+ */
+const char *PDGCacheTestSuite::tests[] = {
+  "memory dependences of the callee",
+  "dependences of the callee loaded from the cache"
+};
+
+TestFunction PDGCacheTestSuite::testFns[] = {
+  PDGCacheTestSuite::memoryDependencesOfCallee,
+  PDGCacheTestSuite::dependencesOfCalleeLoadedFromCache
+};
+
+bool PDGCacheTestSuite::doInitialization (Module &M) {
+  errs() << "PDGCacheTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite = new TestSuite("PDGCacheTestSuite", tests, testFns, numTests, "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void PDGCacheTestSuite::getAnalysisUsage (AnalysisUsage &AU) const {
+  AU.addRequired<PDGAnalysis>();
+}
+
+bool PDGCacheTestSuite::runOnModule (Module &M) {
+  errs() << "PDGCacheTestSuite: Start\n";
+
+  this->callee = M.getFunction("compute");
+  auto &pdgAnalysis = getAnalysis<PDGAnalysis>();
+  this->fdg = pdgAnalysis.getFunctionPDG(*this->callee);
+  this->isCalleeFromCache = pdgAnalysis.areDependencesOfFunctionFromCache(*this->callee);
+
+  errs() << "PDGCacheTestSuite: Running tests\n";
+  suite->runTests((ModulePass &)*this);
+
+  return false;
+}
+
+Values PDGCacheTestSuite::memoryDependencesOfCallee (ModulePass &pass, TestSuite &suite) {
+  PDGCacheTestSuite &cachePass = static_cast<PDGCacheTestSuite &>(pass);
+  Values valueNames;
+  for (auto edge : cachePass.fdg->getEdges()) {
+    if (!edge->isMemoryDependence()) {
+      continue ;
+    }
+
+    /*
+     * Only dependences between different instructions depend on the caller.
+     */
+    auto src = dyn_cast<Instruction>(edge->getOutgoingT());
+    auto dst = dyn_cast<Instruction>(edge->getIncomingT());
+    if (  false
+          || (src == nullptr)
+          || (dst == nullptr)
+          || (src == dst)
+       ) {
+      continue ;
+    }
+    std::string srcName = src->getOpcodeName();
+    std::string dstName = dst->getOpcodeName();
+    valueNames.insert(srcName + suite.orderedValueDelimiter + dstName);
+  }
+  return valueNames;
+}
+
+Values PDGCacheTestSuite::dependencesOfCalleeLoadedFromCache (ModulePass &pass, TestSuite &suite) {
+  PDGCacheTestSuite &cachePass = static_cast<PDGCacheTestSuite &>(pass);
+  Values valueNames;
+  valueNames.insert(cachePass.isCalleeFromCache ? "true" : "false");
+  return valueNames;
+}
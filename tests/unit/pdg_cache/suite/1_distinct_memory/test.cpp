@@ -0,0 +1,25 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+static int G[100];
+
+extern "C" void compute (int *p, int n){
+  for (auto i = 0; i < n; i++){
+    G[i] = p[i] + 1;
+  }
+}
+
+int main (int argc, char *argv[]){
+  int local[100];
+  for (auto i = 0; i < 100; i++){
+    local[i] = i * argc;
+  }
+
+  /*
+   * The address of G is never taken, so p cannot point to G.
+   */
+  compute(local, 99);
+
+  printf("%d\n", G[98]);
+  return 0;
+}
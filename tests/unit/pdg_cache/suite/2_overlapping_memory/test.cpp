@@ -0,0 +1,22 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+static int G[100];
+
+extern "C" void compute (int *p, int n){
+  for (auto i = 0; i < n; i++){
+    G[i] = p[i] + 1;
+  }
+}
+
+int main (int argc, char *argv[]){
+  G[0] = argc;
+
+  /*
+   * Only the caller differs from 1_distinct_memory: now p points to G.
+   */
+  compute(G + 1, 99);
+
+  printf("%d\n", G[98]);
+  return 0;
+}
@@ -0,0 +1,33 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+static int G[100];
+
+extern "C" void compute (int *p, int n){
+  for (auto i = 0; i < n; i++){
+    G[i] = p[i] + 1;
+  }
+}
+
+int main (int argc, char *argv[]){
+  G[0] = argc;
+
+  /*
+   * The code that can affect the dependences of compute is the same as 2_overlapping_memory.
+   */
+  compute(G + 1, 99);
+
+  printf("%d\n", G[98]);
+  return 0;
+}
+
+/*
+ * Only this function differs from 2_overlapping_memory: the dependences of compute must be loaded from the cache.
+ */
+int unrelated (int x){
+  auto y = 0;
+  for (auto i = 0; i < x; i++){
+    y += i * 3;
+  }
+  return y;
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2016 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "PDGThreadsTestSuite.hpp"
+
+using namespace llvm;
+
+// Register pass to "opt"
+char PDGThreadsTestSuite::ID = 0;
+static RegisterPass<PDGThreadsTestSuite> X("UnitTester", "PDG Threads Unit Tester");
+
+// Register pass to "clang"
+static PDGThreadsTestSuite * _PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder&, legacy::PassManagerBase& PM) {
+        if(!_PassMaker){ PM.add(_PassMaker = new PDGThreadsTestSuite());}}); // ** for -Ox
+static RegisterStandardPasses _RegPass2(PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder&, legacy::PassManagerBase& PM) {
+        if(!_PassMaker){ PM.add(_PassMaker = new PDGThreadsTestSuite());}});// ** for -O0
+
+/*
+ * The PDG of the module is built by a single thread first, and then by multiple threads (see -noelle-pdg-threads).
+ * Every PDG built by multiple threads must have the same nodes and dependences of the one built by a single thread.
+ */
+const char *PDGThreadsTestSuite::tests[] = {
+  "memory dependences of the serial PDG",
+  "dependences with two threads",
+  "dependences with more threads than functions"
+};
+
+TestFunction PDGThreadsTestSuite::testFns[] = {
+  PDGThreadsTestSuite::memoryDependencesOfTheSerialPDG,
+  PDGThreadsTestSuite::dependencesWithTwoThreads,
+  PDGThreadsTestSuite::dependencesWithMoreThreadsThanFunctions
+};
+
+namespace {
+
+  std::string nameOf (Value *value) {
+    return std::to_string(reinterpret_cast<uintptr_t>(value));
+  }
+
+  /*
+   * Describe the nodes and the dependences of @pdg without relying on the order they have been added with.
+   */
+  std::multiset<std::string> describe (PDG *pdg) {
+    std::multiset<std::string> description;
+    for (auto pair : pdg->internalNodePairs()) {
+      description.insert("node " + nameOf(pair.first));
+    }
+    for (auto edge : pdg->getEdges()) {
+      std::string dependence = "edge " + nameOf(edge->getOutgoingT()) + " " + nameOf(edge->getIncomingT());
+      dependence += edge->isMemoryDependence() ? " memory" : "";
+      dependence += edge->isMustDependence() ? " must" : " may";
+      dependence += edge->isControlDependence() ? " control" : "";
+      dependence += " " + edge->dataDepToString();
+      description.insert(dependence);
+    }
+    return description;
+  }
+
+}
+
+bool PDGThreadsTestSuite::doInitialization (Module &M) {
+  errs() << "PDGThreadsTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite = new TestSuite("PDGThreadsTestSuite", tests, testFns, numTests, "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void PDGThreadsTestSuite::getAnalysisUsage (AnalysisUsage &AU) const {
+  AU.addRequired<PDGAnalysis>();
+}
+
+bool PDGThreadsTestSuite::runOnModule (Module &M) {
+  errs() << "PDGThreadsTestSuite: Start\n";
+
+  /*
+   * Build the PDG with a single thread.
+   */
+  auto &pdgAnalysis = getAnalysis<PDGAnalysis>();
+  pdgAnalysis.releaseMemory();
+  pdgAnalysis.setNumberOfThreads(1);
+  auto pdg = pdgAnalysis.getPDG();
+  this->serialPDG = describe(pdg);
+  this->hasSerialPDGMemoryDependences = false;
+  for (auto edge : pdg->getEdges()) {
+    this->hasSerialPDGMemoryDependences |= edge->isMemoryDependence();
+  }
+
+  /*
+   * Build the PDG with multiple threads.
+   */
+  auto numberOfFunctions = 0u;
+  for (auto &F : M) {
+    numberOfFunctions += F.empty() ? 0 : 1;
+  }
+  this->isPDGCorrectWithTwoThreads = this->isPDGTheSameAsTheSerialOne(pdgAnalysis, 2);
+  this->isPDGCorrectWithMoreThreadsThanFunctions = this->isPDGTheSameAsTheSerialOne(pdgAnalysis, numberOfFunctions + 1);
+
+  errs() << "PDGThreadsTestSuite: Running tests\n";
+  suite->runTests((ModulePass &)*this);
+
+  return false;
+}
+
+bool PDGThreadsTestSuite::isPDGTheSameAsTheSerialOne (PDGAnalysis &pdgAnalysis, uint32_t numberOfThreads) {
+
+  /*
+   * Drop the current PDG, so the next request builds it from scratch.
+   */
+  pdgAnalysis.releaseMemory();
+  pdgAnalysis.setNumberOfThreads(numberOfThreads);
+  auto parallelPDG = describe(pdgAnalysis.getPDG());
+
+  return parallelPDG == this->serialPDG;
+}
+
+Values PDGThreadsTestSuite::memoryDependencesOfTheSerialPDG (ModulePass &pass, TestSuite &suite) {
+  PDGThreadsTestSuite &threadsPass = static_cast<PDGThreadsTestSuite &>(pass);
+  Values valueNames;
+  valueNames.insert(threadsPass.hasSerialPDGMemoryDependences ? "true" : "false");
+  return valueNames;
+}
+
+Values PDGThreadsTestSuite::dependencesWithTwoThreads (ModulePass &pass, TestSuite &suite) {
+  PDGThreadsTestSuite &threadsPass = static_cast<PDGThreadsTestSuite &>(pass);
+  Values valueNames;
+  valueNames.insert(threadsPass.isPDGCorrectWithTwoThreads ? "true" : "false");
+  return valueNames;
+}
+
+Values PDGThreadsTestSuite::dependencesWithMoreThreadsThanFunctions (ModulePass &pass, TestSuite &suite) {
+  PDGThreadsTestSuite &threadsPass = static_cast<PDGThreadsTestSuite &>(pass);
+  Values valueNames;
+  valueNames.insert(threadsPass.isPDGCorrectWithMoreThreadsThanFunctions ? "true" : "false");
+  return valueNames;
+}
@@ -0,0 +1,58 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+static int G[100];
+static int *H;
+
+extern "C" void initialize (int *p, int n){
+  for (auto i = 0; i < n; i++){
+    p[i] = i;
+  }
+}
+
+extern "C" void scale (int *p, int *q, int n){
+  for (auto i = 0; i < n; i++){
+    q[i] = p[i] * 2;
+    if (q[i] > 50){
+      G[i % 100] += q[i];
+    }
+  }
+}
+
+extern "C" int accumulate (int *p, int n){
+  auto s = 0;
+  for (auto i = 0; i < n; i++){
+    s += p[i] + G[i];
+    H[i] = s;
+  }
+  return s;
+}
+
+extern "C" void swap (int *a, int *b){
+  auto t = *a;
+  *a = *b;
+  *b = t;
+}
+
+extern "C" void reverse (int *p, int n){
+  for (auto i = 0; i < n / 2; i++){
+    swap(&p[i], &p[n - i - 1]);
+  }
+}
+
+int main (int argc, char *argv[]){
+  auto p = (int *)malloc(sizeof(int) * 100);
+  auto q = (int *)malloc(sizeof(int) * 100);
+  H = (int *)malloc(sizeof(int) * 100);
+
+  initialize(p, 100);
+  scale(p, q, argc + 98);
+  reverse(q, 100);
+  auto s = accumulate(q, 100);
+
+  printf("%d %d %d\n", s, G[42], H[7]);
+  free(p);
+  free(q);
+  free(H);
+  return 0;
+}
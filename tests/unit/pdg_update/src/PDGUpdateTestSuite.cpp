@@ -0,0 +1,174 @@
+/*
+ * Copyright 2016 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "llvm/IR/InstIterator.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+
+#include "PDGUpdateTestSuite.hpp"
+
+using namespace llvm;
+
+// Register pass to "opt"
+char PDGUpdateTestSuite::ID = 0;
+static RegisterPass<PDGUpdateTestSuite> X("UnitTester", "PDG Update Unit Tester");
+
+// Register pass to "clang"
+static PDGUpdateTestSuite * _PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder&, legacy::PassManagerBase& PM) {
+        if(!_PassMaker){ PM.add(_PassMaker = new PDGUpdateTestSuite());}}); // ** for -Ox
+static RegisterStandardPasses _RegPass2(PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder&, legacy::PassManagerBase& PM) {
+        if(!_PassMaker){ PM.add(_PassMaker = new PDGUpdateTestSuite());}});// ** for -O0
+
+/*
+ * The code of the function "compute" is changed twice, and every time the PDG updated by PDGAnalysis is compared with the one built from scratch.
+ * First, the stores of "compute" are duplicated and "compute" is cloned into a new function.
+ * Then, the duplicated stores and the new function are erased.
+ * SVF is enabled, so the first update also computes again the dependences of "main" without SVF (see PDGAnalysis::updatePDG).
+ */
+const char *PDGUpdateTestSuite::tests[] = {
+  "dependences after adding code",
+  "memory dependences of the new function",
+  "dependences after removing code"
+};
+
+TestFunction PDGUpdateTestSuite::testFns[] = {
+  PDGUpdateTestSuite::dependencesAfterAddingCode,
+  PDGUpdateTestSuite::memoryDependencesOfNewFunction,
+  PDGUpdateTestSuite::dependencesAfterRemovingCode
+};
+
+namespace {
+
+  std::string nameOf (Value *value) {
+    return std::to_string(reinterpret_cast<uintptr_t>(value));
+  }
+
+  /*
+   * Describe the nodes and the dependences of @pdg without relying on the order they have been added with.
+   */
+  std::multiset<std::string> describe (PDG *pdg) {
+    std::multiset<std::string> description;
+    for (auto pair : pdg->internalNodePairs()) {
+      description.insert("node " + nameOf(pair.first));
+    }
+    for (auto edge : pdg->getEdges()) {
+      std::string dependence = "edge " + nameOf(edge->getOutgoingT()) + " " + nameOf(edge->getIncomingT());
+      dependence += edge->isMemoryDependence() ? " memory" : "";
+      dependence += edge->isMustDependence() ? " must" : " may";
+      dependence += edge->isControlDependence() ? " control" : "";
+      dependence += " " + edge->dataDepToString();
+      description.insert(dependence);
+    }
+    return description;
+  }
+
+}
+
+bool PDGUpdateTestSuite::doInitialization (Module &M) {
+  errs() << "PDGUpdateTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite = new TestSuite("PDGUpdateTestSuite", tests, testFns, numTests, "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void PDGUpdateTestSuite::getAnalysisUsage (AnalysisUsage &AU) const {
+  AU.addRequired<PDGAnalysis>();
+}
+
+bool PDGUpdateTestSuite::runOnModule (Module &M) {
+  errs() << "PDGUpdateTestSuite: Start\n";
+
+  auto compute = M.getFunction("compute");
+  auto &pdgAnalysis = getAnalysis<PDGAnalysis>();
+  pdgAnalysis.getPDG();
+
+  /*
+   * Add code: duplicate the stores of "compute" and clone "compute".
+   */
+  pdgAnalysis.notifyFunctionModified(*compute);
+  std::vector<StoreInst *> stores;
+  for (auto &inst : instructions(*compute)) {
+    if (auto store = dyn_cast<StoreInst>(&inst)) {
+      stores.push_back(store);
+    }
+  }
+  std::vector<Instruction *> newStores;
+  for (auto store : stores) {
+    auto newStore = store->clone();
+    newStore->insertBefore(store);
+    newStores.push_back(newStore);
+  }
+  ValueToValueMapTy cloneMap;
+  auto newFunction = CloneFunction(compute, cloneMap);
+  pdgAnalysis.notifyFunctionCreated(*newFunction);
+  pdgAnalysis.updatePDG();
+
+  this->hasNewFunctionMemoryDependences = false;
+  auto pdg = pdgAnalysis.getPDG();
+  for (auto &inst : instructions(*newFunction)) {
+    for (auto edge : pdg->fetchNode(&inst)->getOutgoingEdges()) {
+      this->hasNewFunctionMemoryDependences |= edge->isMemoryDependence();
+    }
+  }
+  this->isPDGCorrectAfterAddingCode = this->isUpdatedPDGTheSameAsTheOneBuiltFromScratch(pdgAnalysis);
+
+  /*
+   * Remove code: erase the duplicated stores and the new function.
+   */
+  pdgAnalysis.notifyFunctionModified(*compute);
+  for (auto newStore : newStores) {
+    newStore->eraseFromParent();
+  }
+  pdgAnalysis.notifyFunctionErased(*newFunction);
+  newFunction->eraseFromParent();
+  pdgAnalysis.updatePDG();
+  this->isPDGCorrectAfterRemovingCode = this->isUpdatedPDGTheSameAsTheOneBuiltFromScratch(pdgAnalysis);
+
+  errs() << "PDGUpdateTestSuite: Running tests\n";
+  suite->runTests((ModulePass &)*this);
+
+  return true;
+}
+
+bool PDGUpdateTestSuite::isUpdatedPDGTheSameAsTheOneBuiltFromScratch (PDGAnalysis &pdgAnalysis) {
+  auto updatedPDG = describe(pdgAnalysis.getPDG());
+
+  /*
+   * Drop the updated PDG, so the next request builds it from scratch.
+   */
+  pdgAnalysis.releaseMemory();
+  auto pdgFromScratch = describe(pdgAnalysis.getPDG());
+
+  return updatedPDG == pdgFromScratch;
+}
+
+Values PDGUpdateTestSuite::dependencesAfterAddingCode (ModulePass &pass, TestSuite &suite) {
+  PDGUpdateTestSuite &updatePass = static_cast<PDGUpdateTestSuite &>(pass);
+  Values valueNames;
+  valueNames.insert(updatePass.isPDGCorrectAfterAddingCode ? "true" : "false");
+  return valueNames;
+}
+
+Values PDGUpdateTestSuite::memoryDependencesOfNewFunction (ModulePass &pass, TestSuite &suite) {
+  PDGUpdateTestSuite &updatePass = static_cast<PDGUpdateTestSuite &>(pass);
+  Values valueNames;
+  valueNames.insert(updatePass.hasNewFunctionMemoryDependences ? "true" : "false");
+  return valueNames;
+}
+
+Values PDGUpdateTestSuite::dependencesAfterRemovingCode (ModulePass &pass, TestSuite &suite) {
+  PDGUpdateTestSuite &updatePass = static_cast<PDGUpdateTestSuite &>(pass);
+  Values valueNames;
+  valueNames.insert(updatePass.isPDGCorrectAfterRemovingCode ? "true" : "false");
+  return valueNames;
+}
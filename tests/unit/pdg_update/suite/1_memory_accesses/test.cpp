@@ -0,0 +1,24 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+static int G[100];
+
+extern "C" void compute (int *p, int n){
+  for (auto i = 0; i < n; i++){
+    G[i] = p[i] + 1;
+    p[i] = G[i] * 2;
+  }
+}
+
+int main (int argc, char *argv[]){
+  auto p = (int *)malloc(sizeof(int) * 100);
+  for (auto i = 0; i < 100; i++){
+    p[i] = argc + i;
+  }
+
+  compute(p, 99);
+
+  printf("%d %d\n", G[98], p[3]);
+  free(p);
+  return 0;
+}
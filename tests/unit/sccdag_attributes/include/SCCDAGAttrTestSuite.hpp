@@ -26,6 +26,7 @@
 #include "noelle/core/SCCDAGAttrs.hpp"
 #include "noelle/core/Invariants.hpp"
 #include "noelle/core/InductionVariables.hpp"
+#include "noelle/core/BitMatrix.hpp"
 
 #include "TestSuite.hpp"
 
@@ -67,6 +68,8 @@ namespace llvm::noelle {
 
       static Values loopCarriedDependencies (ModulePass &pass, TestSuite &suite) ;
 
+      static Values bitMatrixClosesRelations (ModulePass &pass, TestSuite &suite) ;
+
       static Values printSCCs (ModulePass &pass, TestSuite &suite, std::set<SCC *> sccs) ;
 
       TestSuite *suite;
@@ -32,7 +32,8 @@ const char *SCCDAGAttrTestSuite::tests[] = {
   "reducible SCC",
   "clonable SCC",
   "clonable SCC into local memory",
-  "loop carried dependencies (top loop)"
+  "loop carried dependencies (top loop)",
+  "bit matrix closure"
 };
 TestFunction SCCDAGAttrTestSuite::testFns[] = {
   SCCDAGAttrTestSuite::sccdagHasCorrectSCCs,
@@ -40,9 +41,74 @@ TestFunction SCCDAGAttrTestSuite::testFns[] = {
   SCCDAGAttrTestSuite::reducibleSCCsAreFound,
   SCCDAGAttrTestSuite::clonableSCCsAreFound,
   SCCDAGAttrTestSuite::clonableSCCsIntoLocalMemoryAreFound,
-  SCCDAGAttrTestSuite::loopCarriedDependencies
+  SCCDAGAttrTestSuite::loopCarriedDependencies,
+  SCCDAGAttrTestSuite::bitMatrixClosesRelations
 };
 
+namespace {
+
+  typedef std::vector<std::pair<uint32_t, uint32_t>> Relation;
+
+  /*
+   * Compute the pairs (i,j) such that j can be reached from i by following at least one element of @relation.
+   */
+  std::vector<std::vector<bool>> computeReachability (uint32_t n, Relation const &relation) {
+    std::vector<std::vector<uint32_t>> successors(n);
+    for (auto &pair : relation) {
+      successors[pair.first].push_back(pair.second);
+    }
+
+    std::vector<std::vector<bool>> reachable(n, std::vector<bool>(n, false));
+    for (auto i = 0u; i < n; i++) {
+      std::vector<uint32_t> worklist(successors[i].begin(), successors[i].end());
+      while (!worklist.empty()) {
+        auto j = worklist.back();
+        worklist.pop_back();
+        if (reachable[i][j]) continue;
+        reachable[i][j] = true;
+        worklist.insert(worklist.end(), successors[j].begin(), successors[j].end());
+      }
+    }
+
+    return reachable;
+  }
+
+  /*
+   * Check that @matrix relates exactly the pairs in @reachable.
+   */
+  bool isTheClosure (BitMatrix const &matrix, std::vector<std::vector<bool>> const &reachable) {
+    auto n = reachable.size();
+    for (auto i = 0u; i < n; i++) {
+      uint32_t related = 0;
+      for (auto j = 0u; j < n; j++) {
+        if (matrix.test(i, j) != reachable[i][j]) return false;
+        if (reachable[i][j]) related++;
+      }
+      if (matrix.countRow(i) != related) return false;
+    }
+
+    return true;
+  }
+
+  BitMatrix createMatrix (uint32_t n, Relation const &relation) {
+    BitMatrix matrix(n);
+    for (auto &pair : relation) {
+      matrix.set(pair.first, pair.second);
+    }
+
+    return matrix;
+  }
+
+  uint64_t countPairs (BitMatrix const &matrix, uint32_t n) {
+    uint64_t pairs = 0;
+    for (auto i = 0u; i < n; i++) {
+      pairs += matrix.countRow(i);
+    }
+
+    return pairs;
+  }
+}
+
 bool SCCDAGAttrTestSuite::doInitialization (Module &M) {
   errs() << "SCCDAGAttrTestSuite: Initialize\n";
   const int numTests = sizeof(tests) / sizeof(tests[0]);
@@ -193,4 +259,70 @@ Values SCCDAGAttrTestSuite::loopCarriedDependencies (ModulePass &pass, TestSuite
   return valueNames;
 }
 
+Values SCCDAGAttrTestSuite::bitMatrixClosesRelations (ModulePass &pass, TestSuite &suite) {
+  Values results;
+
+  /*
+   * The relations span several 64-bit words per row, so they exercise the word-parallel row operations across word boundaries.
+   */
+  const uint32_t n = 150;
+
+  /*
+   * Acyclic relation: pairs of consecutive elements plus forward elements chosen by a fixed pattern.
+   */
+  Relation acyclic;
+  for (auto i = 0u; (i + 1) < n; i += 2) {
+    acyclic.push_back(std::make_pair(i, i + 1));
+  }
+  for (auto i = 0u; i < n; i++) {
+    for (auto j = i + 2; j < n; j++) {
+      if (((i * 31) + (j * 17)) % 97 == 0) {
+        acyclic.push_back(std::make_pair(i, j));
+      }
+    }
+  }
+  auto reachable = computeReachability(n, acyclic);
+  auto matrix = createMatrix(n, acyclic);
+  matrix.transitiveClosure();
+  results.insert(isTheClosure(matrix, reachable) ? "acyclic closure matches reachability" : "acyclic closure does not match reachability");
+  results.insert("acyclic related pairs: " + std::to_string(countPairs(matrix, n)));
+
+  /*
+   * Close the same relation given its reverse topological order: elements only relate to later ones, so the reverse order is a reverse topological one.
+   */
+  std::vector<uint32_t> reverseTopologicalOrder;
+  for (auto i = n; i > 0; i--) {
+    reverseTopologicalOrder.push_back(i - 1);
+  }
+  auto dagMatrix = createMatrix(n, acyclic);
+  dagMatrix.transitiveClosureOfDAG(reverseTopologicalOrder);
+  results.insert(isTheClosure(dagMatrix, reachable) ? "closure of DAG given its order matches reachability" : "closure of DAG given its order does not match reachability");
+
+  /*
+   * Cyclic relation: a ring of 70 elements that reaches a chain with a cycle in its middle, a self loop, and elements that relate to the ring without being reachable from it.
+   */
+  Relation cyclic;
+  for (auto i = 0u; i < 70; i++) {
+    cyclic.push_back(std::make_pair(i, (i + 1) % 70));
+  }
+  cyclic.push_back(std::make_pair(69u, 70u));
+  for (auto i = 70u; i < 130; i++) {
+    cyclic.push_back(std::make_pair(i, i + 1));
+  }
+  cyclic.push_back(std::make_pair(120u, 100u));
+  cyclic.push_back(std::make_pair(140u, 140u));
+  for (auto i = 131u; i < n; i++) {
+    cyclic.push_back(std::make_pair(i, i % 64));
+  }
+  reachable = computeReachability(n, cyclic);
+  matrix = createMatrix(n, cyclic);
+  matrix.transitiveClosure();
+  results.insert(isTheClosure(matrix, reachable) ? "cyclic closure matches reachability" : "cyclic closure does not match reachability");
+  results.insert("cyclic related pairs: " + std::to_string(countPairs(matrix, n)));
+  results.insert(matrix.test(140, 140) ? "self loop is kept" : "self loop is lost");
+  results.insert(matrix.test(130, 130) ? "element outside cycles relates to itself" : "element outside cycles does not relate to itself");
+
+  return results;
+}
+
 }
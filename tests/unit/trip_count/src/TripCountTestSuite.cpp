@@ -0,0 +1,131 @@
+/*
+ * Copyright 2016 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "TripCountTestSuite.hpp"
+
+namespace llvm::noelle {
+
+// Register pass to "opt"
+char TripCountTestSuite::ID = 0;
+static RegisterPass<TripCountTestSuite> X("UnitTester", "Trip Count Unit Tester");
+
+// Register pass to "clang"
+static TripCountTestSuite * _PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder&, legacy::PassManagerBase& PM) {
+        if(!_PassMaker){ PM.add(_PassMaker = new TripCountTestSuite());}}); // ** for -Ox
+static RegisterStandardPasses _RegPass2(PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder&, legacy::PassManagerBase& PM) {
+        if(!_PassMaker){ PM.add(_PassMaker = new TripCountTestSuite());}});// ** for -O0
+
+/*
+ * The loops of main have constant bounds, so the code generated to compute their trip count folds into a constant (see LoopGoverningIVUtility::generateCodeToComputeTheTripCount).
+ */
+const char *TripCountTestSuite::tests[] = {
+  "verifyTripCounts"
+};
+
+TestFunction TripCountTestSuite::testFns[] = {
+  TripCountTestSuite::verifyTripCounts
+};
+
+bool TripCountTestSuite::doInitialization (Module &M) {
+  errs() << "TripCountTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite = new TestSuite("TripCountTestSuite", tests, testFns, numTests, "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void TripCountTestSuite::getAnalysisUsage (AnalysisUsage &AU) const {
+  AU.addRequired<PDGAnalysis>();
+  AU.addRequired<ScalarEvolutionWrapperPass>();
+  AU.addRequired<LoopInfoWrapperPass>();
+}
+
+bool TripCountTestSuite::runOnModule (Module &M) {
+  errs() << "TripCountTestSuite: Start\n";
+  auto mainFunction = M.getFunction("main");
+
+  /*
+   * Compute the trip count of every outermost loop of main.
+   */
+  auto &LI = getAnalysis<LoopInfoWrapperPass>(*mainFunction).getLoopInfo();
+  for (auto loop : LI.getLoopsInPreorder()) {
+    if (loop->getParentLoop() != nullptr) continue;
+    this->tripCounts.insert(this->describeTripCount(*mainFunction, loop));
+  }
+
+  errs() << "TripCountTestSuite: Running tests\n";
+  suite->runTests((ModulePass &)*this);
+
+  return false;
+}
+
+std::string TripCountTestSuite::describeTripCount (Function &F, Loop *loop) {
+
+  /*
+   * Fetch the loop-governing IV of @loop.
+   */
+  auto &SE = getAnalysis<ScalarEvolutionWrapperPass>(F).getSE();
+  auto fdg = getAnalysis<PDGAnalysis>().getFunctionPDG(F);
+  auto loopDG = fdg->createLoopsSubgraph(loop);
+  auto sccdag = new SCCDAG(loopDG);
+  auto LIS = new LoopsSummary(loop);
+  auto loopStructure = LIS->getLoopNestingTreeRoot();
+  InvariantManager invariantManager(loopStructure, loopDG);
+  auto exitBlocks = loopStructure->getLoopExitBasicBlocks();
+  auto environment = new LoopEnvironment(loopDG, exitBlocks);
+  auto IVs = new InductionVariableManager(*LIS, invariantManager, SE, *sccdag, *environment);
+  auto IV = IVs->getLoopGoverningInductionVariable(*loopStructure);
+
+  /*
+   * Compute the trip count.
+   * Its inputs are constants, so the builder folds it without adding instructions to the preheader.
+   */
+  std::string description = "no loop-governing IV";
+  if (IV != nullptr) {
+    auto scc = sccdag->sccOfValue(IV->getLoopEntryPHI());
+    LoopGoverningIVAttribution attribution(*IV, *scc, exitBlocks);
+    if (attribution.isSCCContainingIVWellFormed()) {
+      LoopGoverningIVUtility ivUtility(loopStructure, *IVs, attribution);
+      IRBuilder<> builder(loopStructure->getPreHeader()->getTerminator());
+      auto tripCount = ivUtility.generateCodeToComputeTheTripCount(builder);
+
+      auto start = dyn_cast<ConstantInt>(IV->getStartValue());
+      auto step = dyn_cast<ConstantInt>(IV->getSingleComputedStepValue());
+      auto last = dyn_cast<ConstantInt>(attribution.getExitConditionValue());
+      auto tripCountConstant = dyn_cast<ConstantInt>(tripCount);
+      if (start && step && last && tripCountConstant) {
+        description = "start " + std::to_string(start->getSExtValue())
+          + " step " + std::to_string(step->getSExtValue())
+          + " last " + std::to_string(last->getSExtValue())
+          + " iterations " + std::to_string(tripCountConstant->getZExtValue());
+      } else {
+        description = "trip count is not a constant";
+      }
+    }
+  }
+
+  delete IVs;
+  delete environment;
+  delete LIS;
+  delete sccdag;
+  delete loopDG;
+
+  return description;
+}
+
+Values TripCountTestSuite::verifyTripCounts (ModulePass &pass, TestSuite &suite) {
+  TripCountTestSuite &tripCountPass = static_cast<TripCountTestSuite &>(pass);
+  return tripCountPass.tripCounts;
+}
+
+}
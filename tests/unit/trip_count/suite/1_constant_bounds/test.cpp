@@ -0,0 +1,49 @@
+#include <stdio.h>
+#include <stdint.h>
+
+int main (int argc, char *argv[]){
+  int64_t a[64];
+  for (auto i = 0; i < 64; i++){
+    a[i] = i * 3;
+  }
+  int64_t s = 0;
+
+  /*
+   * The step divides the distance between the start and the last value.
+   */
+  for (int64_t i = 0; i < 12; i += 3){
+    s += a[i];
+  }
+
+  /*
+   * The step does not divide the distance: the last iteration goes past the last value.
+   */
+  for (int64_t i = 1; i < 11; i += 4){
+    s += a[i];
+  }
+
+  /*
+   * The IV decreases and its step does not divide the distance.
+   */
+  for (int64_t i = 40; i > 30; i -= 3){
+    s += a[i];
+  }
+
+  /*
+   * The loop does not execute any iteration.
+   */
+  for (int64_t i = 20; i < 10; i += 2){
+    s += a[i];
+  }
+
+  /*
+   * The loop exits on equality.
+   */
+  for (int64_t i = 2; i != 50; i += 4){
+    s += a[i];
+  }
+
+  printf("%lld\n", (long long)s);
+
+  return 0;
+}